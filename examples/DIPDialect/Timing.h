@@ -0,0 +1,36 @@
+//===- Timing.h - Timing helper of the DIP benchmarks ---------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the timing helper shared by the DIP benchmark examples.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef EXAMPLES_DIPDIALECT_TIMING
+#define EXAMPLES_DIPDIALECT_TIMING
+
+#include <chrono>
+
+// Average wall time of `repeat` calls of `func`, in milliseconds.
+template <typename Func> double timeMs(Func &&func, int repeat) {
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < repeat; ++i)
+    func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         repeat;
+}
+
+#endif
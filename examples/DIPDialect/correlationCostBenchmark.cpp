@@ -0,0 +1,145 @@
+//===- correlationCostBenchmark.cpp - Calibrate dip::Correlation2D --------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file times dip.corr_2d against dip.corrfft_2d on random images and
+// kernels, checks that both agree for every boundary option, and writes the
+// cost table read by dip::Correlation2D (see BUDDY_DIP_CORRELATION_COST).
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include "Timing.h"
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+double median(vector<double> values) {
+  sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+int main(int argc, char *argv[]) {
+  string tableName = "correlation_cost.txt";
+  if (argc == 2) {
+    tableName = argv[1];
+  }
+  cout << "Usage: correlationCostBenchmark [tablePath]" << endl;
+
+  const int repeat = 3;
+  const dip::BOUNDARY_OPTION options[2] = {
+      dip::BOUNDARY_OPTION::CONSTANT_PADDING,
+      dip::BOUNDARY_OPTION::REPLICATE_PADDING};
+  const char *optionNames[2] = {"constant", "replicate"};
+
+  RNG rng(0);
+  vector<double> directCosts, fftCosts;
+  ostringstream rows;
+  bool agree = true;
+
+  for (int size : {128, 256, 512}) {
+    Mat image(size, size, CV_8UC1);
+    rng.fill(image, RNG::UNIFORM, 0, 256);
+    Img<float, 2> input(image);
+    intptr_t sizesOutput[2] = {size, size};
+
+    for (intptr_t kernelSize : {3, 7, 11, 17, 25}) {
+      // Random kernels are not separable, so Corr2D takes the direct path.
+      intptr_t sizesKernel[2] = {kernelSize, kernelSize};
+      MemRef<float, 2> kernel(sizesKernel);
+      float kernelNorm = 0;
+      for (intptr_t i = 0; i < kernelSize * kernelSize; ++i) {
+        kernel[i] = rng.uniform(-1.0f, 1.0f);
+        kernelNorm += fabs(kernel[i]);
+      }
+
+      // Check both paths for a centered and a corner anchor.
+      for (int o = 0; o < 2; ++o) {
+        for (unsigned int center : {unsigned(kernelSize / 2), 0u}) {
+          MemRef<float, 2> direct(sizesOutput);
+          MemRef<float, 2> fft(sizesOutput);
+          dip::Corr2D(&input, &kernel, &direct, center, kernelSize - 1 - center,
+                      options[o]);
+          dip::CorrFFT2D(&input, &kernel, &fft, center, kernelSize - 1 - center,
+                         options[o]);
+          float err = 0;
+          for (intptr_t i = 0; i < size * size; ++i)
+            err = max(err, fabs(direct[i] - fft[i]));
+          if (err > 1e-4f * 255 * kernelNorm) {
+            cout << size << "x" << size << " image, " << kernelSize << "x"
+                 << kernelSize << " kernel, " << optionNames[o]
+                 << ": paths differ by " << err << endl;
+            agree = false;
+          }
+        }
+      }
+
+      // Corr2D accumulates into its output, so every run starts from a
+      // zeroed buffer.
+      unsigned int center = kernelSize / 2;
+      MemRef<float, 2> output(sizesOutput);
+      double directTime = timeMs(
+          [&] {
+            output = MemRef<float, 2>(sizesOutput);
+            dip::Corr2D(&input, &kernel, &output, center, center,
+                        dip::BOUNDARY_OPTION::CONSTANT_PADDING);
+          },
+          repeat);
+      double fftTime = timeMs(
+          [&] {
+            dip::CorrFFT2D(&input, &kernel, &output, center, center,
+                           dip::BOUNDARY_OPTION::CONSTANT_PADDING);
+          },
+          repeat);
+
+      double points = double(dip::detail::fftLength(size + kernelSize - 1)) *
+                      dip::detail::fftLength(size + kernelSize - 1);
+      // The table is in nanoseconds.
+      directCosts.push_back(directTime * 1e6 /
+                            (double(size) * size * kernelSize * kernelSize));
+      fftCosts.push_back(fftTime * 1e6 / (points * log2(points)));
+      rows << "# " << size << " " << kernelSize << " " << directTime << " "
+           << fftTime << "\n";
+      cout << size << "x" << size << " image, " << kernelSize << "x"
+           << kernelSize << " kernel: corr_2d " << directTime
+           << " ms, corrfft_2d " << fftTime << " ms" << endl;
+    }
+  }
+
+  if (!agree) {
+    cout << "The direct and FFT paths disagree, no table written." << endl;
+    return 1;
+  }
+
+  ofstream table(tableName);
+  table << "# Correlation cost table of BuddyLibDIP, in nanoseconds.\n"
+        << "# image kernel corr_2d_ms corrfft_2d_ms\n"
+        << rows.str() << "direct " << median(directCosts) << "\n"
+        << "fft " << median(fftCosts) << "\n";
+  cout << "Save: " << tableName << endl;
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+//===- cvtColor.cpp - Compare dip color conversions with OpenCV -----------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file converts a color image to gray and HSV, and an I420 frame of it
+// back to RGB, with the dip interfaces and with cv::cvtColor, and reports
+// the largest differences.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <iostream>
+
+using namespace cv;
+using namespace std;
+
+static double maxDifference(const Mat &a, const Mat &b) {
+  Mat diff;
+  absdiff(a, b, diff);
+  double maxErr;
+  minMaxLoc(diff.reshape(1), nullptr, &maxErr);
+  return maxErr;
+}
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  if (argc == 2) {
+    fileName = argv[1];
+  }
+  cout << "Usage: cvtColor [loadPath]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat loaded = imread(fileName, IMREAD_COLOR);
+  if (loaded.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  // YUV 4:2:0 frames need even sizes.
+  Mat image = loaded(Rect(0, 0, loaded.cols & ~1, loaded.rows & ~1)).clone();
+  // NHWC with RGB channels, in [0, 255].
+  Img<float, 4> input(image);
+  Mat rgb;
+  cvtColor(image, rgb, COLOR_BGR2RGB);
+  rgb.convertTo(rgb, CV_32FC3, 1.0 / 255);
+
+  intptr_t graySizes[2] = {image.rows, image.cols};
+  MemRef<float, 2> gray(graySizes);
+  dip::RGBToGray(&input, &gray, 1.0f / 255);
+  Mat ocvGray;
+  cvtColor(rgb, ocvGray, COLOR_RGB2GRAY);
+  cout << "RGB to gray: max difference "
+       << maxDifference(Mat(image.rows, image.cols, CV_32FC1, gray.getData()),
+                        ocvGray)
+       << endl;
+
+  intptr_t colorSizes[4] = {1, image.rows, image.cols, 3};
+  MemRef<float, 4> hsv(colorSizes);
+  dip::CvtColor(&input, &hsv, dip::COLOR_CONVERSION::RGB2HSV, 1.0f / 255);
+  Mat ocvHsv;
+  cvtColor(rgb, ocvHsv, COLOR_RGB2HSV);
+  cout << "RGB to HSV: max difference "
+       << maxDifference(Mat(image.rows, image.cols, CV_32FC3, hsv.getData()),
+                        ocvHsv)
+       << endl;
+
+  // cv::cvtColor rounds u8 results, so they are at most 0.5 / 255 apart.
+  Mat i420;
+  cvtColor(image, i420, COLOR_BGR2YUV_I420);
+  intptr_t frameSizes[2] = {i420.rows, i420.cols};
+  MemRef<unsigned char, 2> frame(i420.data, frameSizes);
+  MemRef<float, 4> fromI420(colorSizes);
+  dip::YUV420ToRGB(&frame, &fromI420, dip::YUV420_FORMAT::I420);
+  Mat ocvFromI420;
+  cvtColor(i420, ocvFromI420, COLOR_YUV2RGB_I420);
+  ocvFromI420.convertTo(ocvFromI420, CV_32FC3, 1.0 / 255);
+  cout << "I420 to RGB: max difference "
+       << maxDifference(
+              Mat(image.rows, image.cols, CV_32FC3, fromI420.getData()),
+              ocvFromI420)
+       << endl;
+
+  return 0;
+}
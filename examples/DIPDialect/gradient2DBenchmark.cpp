@@ -0,0 +1,98 @@
+//===- gradient2DBenchmark.cpp - Compare dip gradient with OpenCV ---------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file computes the Sobel gradient of a gray image with dip::Gradient2D,
+// in a single pass, and with cv::Sobel followed by cv::magnitude and
+// cv::phase, in four. It reports the times of both and the largest
+// difference of the magnitudes, and thins the edges with the non-maximum
+// suppression of the Canny edge detector, which reads the quantized direction
+// of dip::Gradient2D.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include "Timing.h"
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <iostream>
+
+using namespace cv;
+using namespace std;
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  if (argc == 2) {
+    fileName = argv[1];
+  }
+  cout << "Usage: gradient2DBenchmark [loadPath]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat image = imread(fileName, IMREAD_GRAYSCALE);
+  if (image.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  Img<float, 2> input(image);
+  intptr_t sizes[2] = {image.rows, image.cols};
+  MemRef<float, 2> magnitude(sizes);
+  MemRef<unsigned char, 2> direction(sizes);
+  const int repeat = 20;
+
+  double dipTime = timeMs(
+      [&] {
+        dip::Gradient2D(&input, &magnitude, &direction,
+                        dip::GRADIENT_OPERATOR::SOBEL,
+                        dip::GRADIENT_NORM::L2_NORM,
+                        dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+      },
+      repeat);
+  Mat floatImage, gx, gy, ocvMagnitude, ocvAngle;
+  image.convertTo(floatImage, CV_32FC1);
+  double ocvTime = timeMs(
+      [&] {
+        Sobel(floatImage, gx, CV_32F, 1, 0, 3, 1, 0, BORDER_REPLICATE);
+        Sobel(floatImage, gy, CV_32F, 0, 1, 3, 1, 0, BORDER_REPLICATE);
+        cv::magnitude(gx, gy, ocvMagnitude);
+        cv::phase(gx, gy, ocvAngle, true);
+      },
+      repeat);
+
+  Mat dipMagnitude(image.rows, image.cols, CV_32FC1, magnitude.getData());
+  double maxDiff = norm(dipMagnitude, ocvMagnitude, NORM_INF);
+  cout << "dip " << dipTime << " ms, OpenCV " << ocvTime
+       << " ms, largest magnitude difference " << maxDiff << endl;
+
+  // Keep the pixels whose magnitude is a maximum across the edge, i.e. along
+  // the gradient, and above a fixed threshold.
+  const int neighbours[4][2] = {{0, 1}, {1, 1}, {1, 0}, {1, -1}};
+  Mat dipDirection(image.rows, image.cols, CV_8UC1, direction.getData());
+  Mat edges = Mat::zeros(image.rows, image.cols, CV_8UC1);
+  for (int y = 1; y < image.rows - 1; ++y) {
+    for (int x = 1; x < image.cols - 1; ++x) {
+      float m = dipMagnitude.at<float>(y, x);
+      const int *d = neighbours[dipDirection.at<uchar>(y, x)];
+      if (m > 100 && m >= dipMagnitude.at<float>(y - d[0], x - d[1]) &&
+          m > dipMagnitude.at<float>(y + d[0], x + d[1]))
+        edges.at<uchar>(y, x) = 255;
+    }
+  }
+  imwrite("dip_edges.png", edges);
+  return 0;
+}
@@ -0,0 +1,110 @@
+//===- histogram2D.cpp - Compare dip histogram operations with OpenCV -----===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file computes the histogram, the equalized image, the CLAHE image and
+// a gamma lookup of an image with the dip interfaces and with cv::calcHist,
+// cv::equalizeHist, cv::CLAHE and cv::LUT, and reports how many values
+// differ.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <cmath>
+#include <iostream>
+
+using namespace cv;
+using namespace std;
+
+// Counts the pixels of the dip result that differ from the 8-bit OpenCV one.
+static int countMismatches(MemRef<float, 2> &dipOutput, const Mat &ocvOutput) {
+  Mat dipImage(dipOutput.getSizes()[0], dipOutput.getSizes()[1], CV_32FC1,
+               dipOutput.getData());
+  Mat ocvImage;
+  ocvOutput.convertTo(ocvImage, CV_32FC1);
+  return countNonZero(dipImage != ocvImage);
+}
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  if (argc == 2) {
+    fileName = argv[1];
+  }
+  cout << "Usage: histogram2D [loadPath]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat loaded = imread(fileName, IMREAD_GRAYSCALE);
+  if (loaded.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  // OpenCV pads images whose size is not a multiple of the CLAHE tiles, dip
+  // makes the last tiles smaller, so compare on a multiple of 8 x 8 tiles.
+  Mat image = loaded(Rect(0, 0, loaded.cols & ~7, loaded.rows & ~7)).clone();
+  Img<float, 2> input(image);
+  intptr_t sizes[2] = {image.rows, image.cols};
+
+  intptr_t bins[1] = {256};
+  MemRef<int, 1> hist(bins);
+  dip::Histogram2D(&input, &hist, 0, 256);
+  Mat ocvHist;
+  int histSize = 256;
+  float range[] = {0, 256};
+  const float *ranges[] = {range};
+  calcHist(&image, 1, 0, Mat(), ocvHist, 1, &histSize, ranges);
+  int histMismatches = 0;
+  for (int i = 0; i < 256; ++i)
+    histMismatches += hist.getData()[i] != (int)ocvHist.at<float>(i);
+  cout << "Histogram: " << histMismatches << " bins differ" << endl;
+
+  MemRef<float, 2> equalized(sizes);
+  dip::EqualizeHist2D(&input, &equalized);
+  Mat ocvEqualized;
+  equalizeHist(image, ocvEqualized);
+  cout << "Equalization: " << countMismatches(equalized, ocvEqualized)
+       << " pixels differ" << endl;
+
+  MemRef<float, 2> clahe(sizes);
+  dip::CLAHE2D(&input, &clahe, 40, 8, 8);
+  Mat ocvClahe;
+  createCLAHE(40, Size(8, 8))->apply(image, ocvClahe);
+  cout << "CLAHE: " << countMismatches(clahe, ocvClahe) << " pixels differ"
+       << endl;
+
+  MemRef<float, 1> gamma(bins);
+  Mat ocvGamma(1, 256, CV_8UC1);
+  for (int i = 0; i < 256; ++i) {
+    gamma.getData()[i] = std::round(255 * std::pow(i / 255.0f, 0.5f));
+    ocvGamma.at<uchar>(i) = (uchar)gamma.getData()[i];
+  }
+  MemRef<float, 2> mapped(sizes);
+  dip::LUT2D(&input, &gamma, &mapped);
+  Mat ocvMapped;
+  LUT(image, ocvGamma, ocvMapped);
+  cout << "Lookup table: " << countMismatches(mapped, ocvMapped)
+       << " pixels differ" << endl;
+
+  imwrite("dip_equalized.png", Mat(image.rows, image.cols, CV_32FC1,
+                                   equalized.getData()));
+  imwrite("dip_clahe.png",
+          Mat(image.rows, image.cols, CV_32FC1, clahe.getData()));
+  return 0;
+}
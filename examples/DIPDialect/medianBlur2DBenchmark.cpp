@@ -0,0 +1,83 @@
+//===- medianBlur2DBenchmark.cpp - Compare dip median filter with OpenCV --===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file adds salt-and-pepper noise to a gray image and removes it with
+// dip::MedianBlur2D and cv::medianBlur for 3x3, 5x5 and 7x7 windows. It
+// reports the times of both, on the float image for dip and on the 8-bit
+// image for OpenCV (its float version takes only 3x3 and 5x5 windows), and
+// how many pixels differ.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include "Timing.h"
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <iostream>
+
+using namespace cv;
+using namespace std;
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  if (argc == 2) {
+    fileName = argv[1];
+  }
+  cout << "Usage: medianBlur2DBenchmark [loadPath]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat image = imread(fileName, IMREAD_GRAYSCALE);
+  if (image.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  // Turn 5% of the pixels into salt or pepper.
+  RNG rng(0);
+  for (int i = 0; i < image.rows * image.cols / 20; ++i)
+    image.at<uchar>(rng.uniform(0, image.rows), rng.uniform(0, image.cols)) =
+        rng.uniform(0, 2) ? 255 : 0;
+  Img<float, 2> input(image);
+  intptr_t sizes[2] = {image.rows, image.cols};
+  const int repeat = 20;
+
+  for (unsigned int kernelSize : {3u, 5u, 7u}) {
+    MemRef<float, 2> output(sizes);
+    double dipTime = timeMs(
+        [&] {
+          dip::MedianBlur2D(&input, &output, kernelSize,
+                            dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+        },
+        repeat);
+    Mat ocvOutput;
+    double ocvTime =
+        timeMs([&] { medianBlur(image, ocvOutput, kernelSize); }, repeat);
+
+    // cv::medianBlur replicates the edge pixels as well.
+    Mat dipImage(image.rows, image.cols, CV_32FC1, output.getData());
+    Mat ocvImage;
+    ocvOutput.convertTo(ocvImage, CV_32FC1);
+    cout << kernelSize << "x" << kernelSize << ": dip " << dipTime
+         << " ms, OpenCV " << ocvTime << " ms, "
+         << countNonZero(dipImage != ocvImage) << " pixels differ" << endl;
+    if (kernelSize == 5)
+      imwrite("dip_median.png", dipImage);
+  }
+  return 0;
+}
@@ -0,0 +1,100 @@
+//===- pyramid2D.cpp - Example of dip Gaussian and Laplacian pyramids -----===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file builds the Gaussian and Laplacian pyramids of an image with
+// dip::GaussianPyramid2D and dip::LaplacianPyramid2D, compares the Gaussian
+// levels with cv::pyrDown and writes every level to a file.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <iostream>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  int numLevels = 4;
+  if (argc >= 2) {
+    fileName = argv[1];
+  }
+  if (argc == 3) {
+    numLevels = atoi(argv[2]);
+  }
+  cout << "Usage: pyramid2D [loadPath] [levels]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat image = imread(fileName, IMREAD_GRAYSCALE);
+  if (image.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  Img<float, 2> input(image);
+
+  // Level i + 1 of an R x C level is ((R + 1) / 2) x ((C + 1) / 2).
+  vector<MemRef<float, 2>> gaussian, laplacian;
+  intptr_t sizes[2] = {image.rows, image.cols};
+  laplacian.emplace_back(sizes);
+  for (int i = 0; i < numLevels; ++i) {
+    sizes[0] = (sizes[0] + 1) / 2;
+    sizes[1] = (sizes[1] + 1) / 2;
+    gaussian.emplace_back(sizes);
+    laplacian.emplace_back(sizes);
+  }
+  vector<MemRef<float, 2> *> gaussianLevels, laplacianLevels;
+  for (auto &level : gaussian)
+    gaussianLevels.push_back(&level);
+  for (auto &level : laplacian)
+    laplacianLevels.push_back(&level);
+
+  dip::GaussianPyramid2D(&input, gaussianLevels,
+                         dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+  dip::LaplacianPyramid2D(&input, laplacianLevels,
+                          dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+
+  Mat ocvLevel;
+  image.convertTo(ocvLevel, CV_32FC1);
+  for (int i = 0; i < numLevels; ++i) {
+    pyrDown(ocvLevel, ocvLevel, Size(), BORDER_REPLICATE);
+    Mat dipLevel(gaussian[i].getSizes()[0], gaussian[i].getSizes()[1],
+                 CV_32FC1, gaussian[i].getData());
+    double maxErr;
+    minMaxLoc(abs(dipLevel - ocvLevel), nullptr, &maxErr);
+    cout << "Level " << i + 1 << ": " << dipLevel.cols << "x" << dipLevel.rows
+         << ", max error against cv::pyrDown " << maxErr << endl;
+    imwrite("dip_gaussian_" + to_string(i + 1) + ".png", dipLevel);
+  }
+
+  // Laplacian levels are signed, so they are shifted to mid-gray before they
+  // are saved; the last entry is the Gaussian residual.
+  for (int i = 0; i <= numLevels; ++i) {
+    Mat level(laplacian[i].getSizes()[0], laplacian[i].getSizes()[1],
+              CV_32FC1, laplacian[i].getData());
+    if (i < numLevels)
+      level += 128;
+    imwrite("dip_laplacian_" + to_string(i) + ".png", level);
+  }
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+//===- resize2DQuality.cpp - Compare dip.resize_2d with OpenCV ------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file resizes an image with the filtering interpolations of
+// dip.resize_2d and with cv::resize, and reports how far the results are
+// apart. Area interpolation is expected to match INTER_AREA. OpenCV does not
+// widen its bicubic and Lanczos filters when downscaling, so those rows show
+// how much aliasing the antialiased modes remove rather than an error.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <iostream>
+
+using namespace cv;
+using namespace std;
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  if (argc == 2) {
+    fileName = argv[1];
+  }
+  cout << "Usage: resize2DQuality [loadPath]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat image = imread(fileName, IMREAD_GRAYSCALE);
+  if (image.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  Img<float, 2> input(image);
+  Mat imageF32;
+  image.convertTo(imageF32, CV_32FC1);
+
+  const dip::INTERPOLATION_TYPE types[4] = {
+      dip::INTERPOLATION_TYPE::BILINEAR_INTERPOLATION,
+      dip::INTERPOLATION_TYPE::AREA_INTERPOLATION,
+      dip::INTERPOLATION_TYPE::BICUBIC_INTERPOLATION,
+      dip::INTERPOLATION_TYPE::LANCZOS_INTERPOLATION};
+  const int ocvTypes[4] = {INTER_LINEAR, INTER_AREA, INTER_CUBIC,
+                           INTER_LANCZOS4};
+  const char *typeNames[4] = {"bilinear", "area", "bicubic", "lanczos"};
+
+  // {cols, rows} of the outputs: a model input, an integer and a fractional
+  // downscale.
+  const intptr_t sizes[3][2] = {{224, 224},
+                                {image.cols / 4, image.rows / 4},
+                                {image.cols * 2 / 5, image.rows * 2 / 5}};
+
+  for (auto &size : sizes) {
+    for (int t = 0; t < 4; ++t) {
+      intptr_t outputSize[2] = {size[0], size[1]};
+      MemRef<float, 2> output = dip::Resize2D(&input, types[t], outputSize);
+      Mat dipOutput(output.getSizes()[0], output.getSizes()[1], CV_32FC1,
+                    output.getData());
+
+      Mat ocvOutput;
+      resize(imageF32, ocvOutput, dipOutput.size(), 0, 0, ocvTypes[t]);
+
+      Mat diff;
+      absdiff(dipOutput, ocvOutput, diff);
+      double maxErr;
+      minMaxLoc(diff, nullptr, &maxErr);
+      cout << size[0] << "x" << size[1] << ", " << typeNames[t] << ": PSNR "
+           << PSNR(dipOutput, ocvOutput, 255) << " dB, mean error "
+           << mean(diff)[0] << ", max error " << maxErr << endl;
+      imwrite(string("dip_resize_") + typeNames[t] + "_" +
+                  to_string(size[0]) + "x" + to_string(size[1]) + ".png",
+              dipOutput);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+//===- resizeNormalize2DBenchmark.cpp - Fused model input preparation -----===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file prepares a 224x224 ImageNet input batch, as taken by
+// examples/DLModel/ResNet-18.mlir, from a u8 RGB image in two ways and
+// reports their times:
+//   - dip::ResizeNormalize2D, which resizes, converts, normalizes and writes
+//     the NCHW batch image in one pass;
+//   - dip::Resize2D of every channel, a per channel normalization and a copy
+//     into the batch image, i.e. three passes.
+// The fused result is also compared with cv::resize and the same
+// normalization.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include "Timing.h"
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <iostream>
+
+using namespace cv;
+using namespace std;
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  if (argc == 2) {
+    fileName = argv[1];
+  }
+  cout << "Usage: resizeNormalize2DBenchmark [loadPath]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat image = imread(fileName, IMREAD_COLOR);
+  if (image.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  Mat rgb;
+  cvtColor(image, rgb, COLOR_BGR2RGB);
+  intptr_t frameSizes[4] = {1, rgb.rows, rgb.cols, 3};
+  MemRef<unsigned char, 4> frame(rgb.data, frameSizes);
+
+  const intptr_t batchSize = 4, size = 224;
+  const float mean[3] = {0.485f, 0.456f, 0.406f};
+  const float stdDev[3] = {0.229f, 0.224f, 0.225f};
+  intptr_t batchSizes[4] = {batchSize, 3, size, size};
+  const intptr_t planeSize = size * size;
+  const int repeat = 20;
+
+  MemRef<float, 4> fused(batchSizes);
+  double fusedTime = timeMs(
+      [&] {
+        for (intptr_t n = 0; n < batchSize; ++n)
+          dip::ResizeNormalize2D(&frame, &fused, n, mean, stdDev);
+      },
+      repeat);
+
+  // dip::Resize2D takes single channel images, so the channels are split
+  // once beforehand.
+  vector<Mat> channels;
+  split(rgb, channels);
+  vector<Img<float, 2>> planes;
+  for (const Mat &channel : channels)
+    planes.emplace_back(channel);
+  MemRef<float, 4> threeStep(batchSizes);
+  double threeStepTime = timeMs(
+      [&] {
+        for (intptr_t n = 0; n < batchSize; ++n) {
+          float *slot = threeStep.getData() + n * 3 * planeSize;
+          for (int c = 0; c < 3; ++c) {
+            intptr_t outputSize[2] = {size, size};
+            MemRef<float, 2> resized = dip::Resize2D(
+                &planes[c], dip::INTERPOLATION_TYPE::BILINEAR_INTERPOLATION,
+                outputSize);
+            float *data = resized.getData();
+            for (intptr_t i = 0; i < planeSize; ++i)
+              data[i] = (data[i] / 255 - mean[c]) / stdDev[c];
+            copy(data, data + planeSize, slot + c * planeSize);
+          }
+        }
+      },
+      repeat);
+
+  Mat rgbF32, ocvResized;
+  rgb.convertTo(rgbF32, CV_32FC3);
+  resize(rgbF32, ocvResized, Size(size, size), 0, 0, INTER_LINEAR);
+  vector<Mat> ocvChannels;
+  split(ocvResized, ocvChannels);
+  double maxErr = 0;
+  for (intptr_t n = 0; n < batchSize; ++n)
+    for (int c = 0; c < 3; ++c) {
+      Mat expected = (ocvChannels[c] / 255 - mean[c]) / stdDev[c];
+      Mat result(size, size, CV_32FC1,
+                 fused.getData() + (n * 3 + c) * planeSize);
+      Mat diff;
+      absdiff(result, expected, diff);
+      double err;
+      minMaxLoc(diff, nullptr, &err);
+      maxErr = max(maxErr, err);
+    }
+
+  cout << batchSize << " images of " << size << "x" << size
+       << ": three passes " << threeStepTime << " ms, fused " << fusedTime
+       << " ms, speedup " << threeStepTime / fusedTime << "x" << endl;
+  cout << "Max difference from cv::resize: " << maxErr << endl;
+
+  return 0;
+}
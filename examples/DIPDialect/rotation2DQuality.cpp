@@ -0,0 +1,91 @@
+//===- rotation2DQuality.cpp - Compare dip.rotate_2d with OpenCV ----------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file rotates an image with every interpolation of dip.rotate_2d and
+// with cv::warpAffine using the same matrix and interpolation, and reports
+// how far the results are apart.
+// This file will be linked with the object file generated by mlir to generate
+// the executable file.
+//
+//===----------------------------------------------------------------------===//
+
+#include <opencv2/opencv.hpp>
+
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <cmath>
+#include <iostream>
+
+using namespace cv;
+using namespace std;
+
+int main(int argc, char *argv[]) {
+  string fileName = "../../examples/images/YuTu.png";
+  if (argc == 2) {
+    fileName = argv[1];
+  }
+  cout << "Usage: rotation2DQuality [loadPath]" << endl;
+  cout << "Load: " << fileName << endl;
+
+  Mat image = imread(fileName, IMREAD_GRAYSCALE);
+  if (image.empty()) {
+    cout << "Could not read the image: " << fileName << endl;
+    return 1;
+  }
+  Img<float, 2> input(image);
+  Mat imageF32;
+  image.convertTo(imageF32, CV_32FC1);
+
+  const dip::INTERPOLATION_TYPE types[4] = {
+      dip::INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION,
+      dip::INTERPOLATION_TYPE::BILINEAR_INTERPOLATION,
+      dip::INTERPOLATION_TYPE::BICUBIC_INTERPOLATION,
+      dip::INTERPOLATION_TYPE::LANCZOS_INTERPOLATION};
+  const int ocvTypes[4] = {INTER_NEAREST, INTER_LINEAR, INTER_CUBIC,
+                           INTER_LANCZOS4};
+  const char *typeNames[4] = {"nearest", "bilinear", "bicubic", "lanczos"};
+
+  for (float angle : {30.0f, 45.0f, 100.0f}) {
+    for (int t = 0; t < 4; ++t) {
+      MemRef<float, 2> output =
+          dip::Rotate2D(&input, angle, dip::ANGLE_TYPE::DEGREE, types[t]);
+      Mat dipOutput(output.getSizes()[0], output.getSizes()[1], CV_32FC1,
+                    output.getData());
+
+      // dip.rotate_2d rotates about the integer center of the input and
+      // centers the result in the output.
+      Point2f center(image.cols >> 1, image.rows >> 1);
+      Mat matrix = getRotationMatrix2D(center, angle, 1.0);
+      matrix.at<double>(0, 2) += (dipOutput.cols - image.cols) >> 1;
+      matrix.at<double>(1, 2) += (dipOutput.rows - image.rows) >> 1;
+      Mat ocvOutput;
+      warpAffine(imageF32, ocvOutput, matrix, dipOutput.size(), ocvTypes[t],
+                 BORDER_CONSTANT, Scalar(0));
+
+      Mat diff;
+      absdiff(dipOutput, ocvOutput, diff);
+      double maxErr;
+      minMaxLoc(diff, nullptr, &maxErr);
+      cout << angle << " degrees, " << typeNames[t] << ": PSNR "
+           << PSNR(dipOutput, ocvOutput, 255) << " dB, mean error "
+           << mean(diff)[0] << ", max error " << maxErr << endl;
+      imwrite(string("dip_rotate_") + typeNames[t] + ".png", dipOutput);
+    }
+  }
+
+  return 0;
+}
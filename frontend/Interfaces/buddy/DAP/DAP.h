@@ -26,5 +26,8 @@
 #include "buddy/DAP/DSP/Biquad.h"
 #include "buddy/DAP/DSP/FIR.h"
 #include "buddy/DAP/DSP/IIR.h"
+#include "buddy/DAP/DSP/MFCC.h"
+#include "buddy/DAP/DSP/Resample.h"
+#include "buddy/DAP/DSP/STFT.h"
 
 #endif // FRONTEND_INTERFACES_BUDDY_DAP_DAP
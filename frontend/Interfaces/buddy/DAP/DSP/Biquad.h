@@ -21,16 +21,34 @@
 
 #include "buddy/Core/Container.h"
 #include "buddy/DAP/AudioContainer.h"
+#include "buddy/DAP/DSP/Math.h"
 
 #include <cmath>
+#include <type_traits>
 
 namespace dap {
 namespace detail {
 extern "C" {
-// TODO: support both float and double.
 void _mlir_ciface_buddy_biquad(MemRef<float, 1> *input,
                                MemRef<float, 1> *kernel,
                                MemRef<float, 1> *output);
+
+void _mlir_ciface_buddy_biquad_f64(MemRef<double, 1> *input,
+                                   MemRef<double, 1> *kernel,
+                                   MemRef<double, 1> *output);
+
+void _mlir_ciface_buddy_biquad_f16(MemRef<half, 1> *input,
+                                   MemRef<half, 1> *kernel,
+                                   MemRef<half, 1> *output);
+
+// Q15 samples, Q14 coefficients, see BIQUAD_COEFF_FRAC_BITS.
+void _mlir_ciface_buddy_biquad_q15(MemRef<int16_t, 1> *input,
+                                   MemRef<int16_t, 1> *kernel,
+                                   MemRef<int16_t, 1> *output);
+
+void _mlir_ciface_buddy_biquad_multichannel(MemRef<float, 2> *input,
+                                            MemRef<float, 1> *kernel,
+                                            MemRef<float, 2> *output);
 }
 } // namespace detail
 
@@ -57,12 +75,31 @@ void biquadLowpass(MemRef<T, N> &input, T frequency, T Q) {
   input[5] = b2;
 }
 
+// T: float, double, half, or int16_t for Q15 fixed point.
 template <typename T, size_t N>
-void biquad(MemRef<float, N> *input, MemRef<T, N> *filter,
-            MemRef<float, N> *output) {
+void biquad(MemRef<T, N> *input, MemRef<T, N> *filter, MemRef<T, N> *output) {
   if (N != 1)
     assert(0 && "Only mono audio is supported for now.");
-  detail::_mlir_ciface_buddy_biquad(input, filter, output);
+  if constexpr (std::is_same_v<T, float>)
+    detail::_mlir_ciface_buddy_biquad(input, filter, output);
+  else if constexpr (std::is_same_v<T, double>)
+    detail::_mlir_ciface_buddy_biquad_f64(input, filter, output);
+  else if constexpr (std::is_same_v<T, half>)
+    detail::_mlir_ciface_buddy_biquad_f16(input, filter, output);
+  else if constexpr (std::is_same_v<T, int16_t>)
+    detail::_mlir_ciface_buddy_biquad_q15(input, filter, output);
+  else
+    assert(0 && "Unsupported element type.");
+}
+
+// Multichannel biquad.
+// input/output: [channels, samples] buffers, every channel is filtered with the
+// same coefficients. The channels are processed together, one vector lane per
+// channel.
+template <typename T>
+void biquad(MemRef<float, 2> *input, MemRef<T, 1> *filter,
+            MemRef<float, 2> *output) {
+  detail::_mlir_ciface_buddy_biquad_multichannel(input, filter, output);
 }
 
 } // namespace dap
@@ -23,22 +23,36 @@
 
 #include "buddy/Core/Container.h"
 #include "buddy/DAP/AudioContainer.h"
+#include "buddy/DAP/DSP/Math.h"
 #include "buddy/DAP/DSP/Window.h"
 
+#include <type_traits>
+
 namespace dap {
 namespace detail {
 // Declare the Fir C interface.
 extern "C" {
-// TODO: support both float and double.
 void _mlir_ciface_buddy_fir(MemRef<float, 1> *inputBuddyConv1D,
                                MemRef<float, 1> *kernelBuddyConv1D,
                                MemRef<float, 1> *outputBuddyConv1D);
+
+void _mlir_ciface_buddy_fir_f64(MemRef<double, 1> *input,
+                                MemRef<double, 1> *kernel,
+                                MemRef<double, 1> *output);
+
+void _mlir_ciface_buddy_fir_f16(MemRef<half, 1> *input, MemRef<half, 1> *kernel,
+                                MemRef<half, 1> *output);
+
+// Q15 samples and taps, see Q15_FRAC_BITS.
+void _mlir_ciface_buddy_fir_q15(MemRef<int16_t, 1> *input,
+                                MemRef<int16_t, 1> *kernel,
+                                MemRef<int16_t, 1> *output);
 }
 } // namespace detail
 
 // type: see WINDOW_TYPE
 // len: filter length
-// cutoff: Lowpass cutoff frequency
+// cutoff: Lowpass cutoff frequency, as a fraction of the sample rate (0, 0.5)
 // args: filter-specific arguments, size is limited using WINDOW_TYPE
 template <typename T, size_t N>
 void firLowpass(MemRef<T, N> &input, WINDOW_TYPE type, size_t len, T cutoff,
@@ -66,12 +80,21 @@ void firLowpass(MemRef<T, N> &input, WINDOW_TYPE type, size_t len, T cutoff,
   }
 }
 
+// T: float, double, half, or int16_t for Q15 fixed point.
 template <typename T, size_t N>
-void fir(MemRef<float, N> *input, MemRef<T, N> *filter,
-         MemRef<float, N> *output) {
+void fir(MemRef<T, N> *input, MemRef<T, N> *filter, MemRef<T, N> *output) {
   if (N != 1)
     assert(0 && "Only mono audio is supported for now.");
-  detail::_mlir_ciface_buddy_fir(input, filter, output);
+  if constexpr (std::is_same_v<T, float>)
+    detail::_mlir_ciface_buddy_fir(input, filter, output);
+  else if constexpr (std::is_same_v<T, double>)
+    detail::_mlir_ciface_buddy_fir_f64(input, filter, output);
+  else if constexpr (std::is_same_v<T, half>)
+    detail::_mlir_ciface_buddy_fir_f16(input, filter, output);
+  else if constexpr (std::is_same_v<T, int16_t>)
+    detail::_mlir_ciface_buddy_fir_q15(input, filter, output);
+  else
+    assert(0 && "Unsupported element type.");
 }
 } // namespace dap
 
@@ -24,12 +24,14 @@
 #include "buddy/Core/Container.h"
 #include "buddy/DAP/AudioContainer.h"
 #include "buddy/DAP/DSP/IIRDesign.h"
+#include "buddy/DAP/DSP/Math.h"
+
+#include <type_traits>
 
 namespace dap {
 namespace detail {
 // Declare the Fir C interface.
 extern "C" {
-// TODO: support both float and double.
 void _mlir_ciface_mlir_iir(MemRef<float, 1> *inputBuddyConv1D,
                            MemRef<float, 2> *kernelBuddyConv1D,
                            MemRef<float, 1> *outputBuddyConv1D);
@@ -37,39 +39,100 @@ void _mlir_ciface_mlir_iir(MemRef<float, 1> *inputBuddyConv1D,
 void _mlir_ciface_buddy_iir(MemRef<float, 1> *inputBuddyConv1D,
                             MemRef<float, 2> *kernelBuddyConv1D,
                             MemRef<float, 1> *outputBuddyConv1D);
+
+void _mlir_ciface_buddy_iir_f64(MemRef<double, 1> *input,
+                                MemRef<double, 2> *kernel,
+                                MemRef<double, 1> *output);
+
+void _mlir_ciface_buddy_iir_f16(MemRef<half, 1> *input, MemRef<half, 2> *kernel,
+                                MemRef<half, 1> *output);
+
+// Q15 samples, Q14 coefficients, see BIQUAD_COEFF_FRAC_BITS.
+void _mlir_ciface_buddy_iir_q15(MemRef<int16_t, 1> *input,
+                                MemRef<int16_t, 2> *kernel,
+                                MemRef<int16_t, 1> *output);
+
+void _mlir_ciface_buddy_iir_multichannel(MemRef<float, 2> *input,
+                                         MemRef<float, 2> *kernel,
+                                         MemRef<float, 2> *output);
+}
+} // namespace detail
+
+namespace detail {
+// Digitize the analog filter with the bilinear transform and store it as
+// second order sections, one row of [b0, b1, b2, a0, a1, a2] per section.
+template <typename T, size_t N>
+void _store_sos(MemRef<T, N> &sos, const zpk<T> &analog) {
+  zpk<T> digital = bilinear<T>(analog, 2.0);
+  auto bqs = to_sos(digital);
+  size_t M = bqs[0].size();
+  for (size_t i = 0; i < bqs.size(); i++) {
+    for (size_t j = 0; j < M; j++) {
+      sos[i * M + j] = bqs[i][j];
+    }
+  }
 }
 } // namespace detail
 
-// filter: lowpass filter, Supports butterworth filter upto order 12 for now.
+// The designers below take an analog lowpass prototype (butterworth,
+// chebyshev1, chebyshev2, bessel or elliptic of order n) and write its SOS
+// matrix to `input`, which needs (n + 1) / 2 rows for lowpass and highpass
+// filters and n rows for bandpass and bandstop filters.
 // frequency: cutoff frequency
 // fs: frequency at which data is sampled
 template <typename T, size_t N>
 void iirLowpass(MemRef<T, N> &input, const zpk<T> &filter, T frequency, T fs) {
   // only N=2 is supported for now .
   // TODO: check input range.
+  T warped = detail::warp_freq(frequency, fs);
+  detail::_store_sos(input, detail::lp2lp_zpk(filter, warped));
+}
 
+template <typename T, size_t N>
+void iirHighpass(MemRef<T, N> &input, const zpk<T> &filter, T frequency,
+                 T fs) {
   T warped = detail::warp_freq(frequency, fs);
+  detail::_store_sos(input, detail::lp2hp_zpk(filter, warped));
+}
 
-  zpk<T> result = filter;
-  result = detail::lp2lp_zpk(result, warped);
-  result = detail::bilinear<float>(result, 2.0);
-  auto bqs = detail::to_sos(result);
-  int M = bqs[0].size();
-  for (size_t i = 0; i < bqs.size(); i++) {
-    for (size_t j = 0; j < M; j++) {
-      input[i * M + j] = bqs[i][j];
-    }
-  }
+// lowFrequency, highFrequency: band edges
+template <typename T, size_t N>
+void iirBandpass(MemRef<T, N> &input, const zpk<T> &filter, T lowFrequency,
+                 T highFrequency, T fs) {
+  T low = detail::warp_freq(lowFrequency, fs);
+  T high = detail::warp_freq(highFrequency, fs);
+  detail::_store_sos(
+      input, detail::lp2bp_zpk(filter, std::sqrt(low * high), high - low));
+}
+
+template <typename T, size_t N>
+void iirBandstop(MemRef<T, N> &input, const zpk<T> &filter, T lowFrequency,
+                 T highFrequency, T fs) {
+  T low = detail::warp_freq(lowFrequency, fs);
+  T high = detail::warp_freq(highFrequency, fs);
+  detail::_store_sos(
+      input, detail::lp2bs_zpk(filter, std::sqrt(low * high), high - low));
 }
 
+// N = 1: mono audio, T is float, double, half, or int16_t for Q15 fixed point.
+// N = 2: [channels, samples] float buffers, every channel is filtered with the
+// same SOS matrix, one vector lane per channel. The input is left untouched.
 template <typename T, size_t N, size_t M>
-void iir(MemRef<float, N> *input, MemRef<T, M> *filter,
-         MemRef<float, N> *output) {
-  if (N != 1)
-    assert(0 && "Only mono audio is supported for now.");
+void iir(MemRef<T, N> *input, MemRef<T, M> *filter, MemRef<T, N> *output) {
   if (M != 2)
     assert(0 && "Second Order Section (SOS) filter is only supported for now.");
-  detail::_mlir_ciface_buddy_iir(input, filter, output);
+  if constexpr (N == 1 && std::is_same_v<T, float>)
+    detail::_mlir_ciface_buddy_iir(input, filter, output);
+  else if constexpr (N == 1 && std::is_same_v<T, double>)
+    detail::_mlir_ciface_buddy_iir_f64(input, filter, output);
+  else if constexpr (N == 1 && std::is_same_v<T, half>)
+    detail::_mlir_ciface_buddy_iir_f16(input, filter, output);
+  else if constexpr (N == 1 && std::is_same_v<T, int16_t>)
+    detail::_mlir_ciface_buddy_iir_q15(input, filter, output);
+  else if constexpr (N == 2 && std::is_same_v<T, float>)
+    detail::_mlir_ciface_buddy_iir_multichannel(input, filter, output);
+  else
+    assert(0 && "Unsupported element type or audio layout.");
 }
 } // namespace dap
 
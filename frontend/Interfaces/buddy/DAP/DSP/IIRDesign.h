@@ -22,10 +22,14 @@
 #ifndef FRONTEND_INTERFACES_BUDDY_DAP_DSP_IIRDESIGN
 #define FRONTEND_INTERFACES_BUDDY_DAP_DSP_IIRDESIGN
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <complex>
 #include <functional>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
 #include <vector>
 
 namespace dap {
@@ -38,125 +42,333 @@ template <typename T> struct zpk {
   T k;
 };
 
-// TODO: Add bessel
-// TODO: Add chebyshev1, chebyshev2
+namespace detail {
+// Numerical helpers for the elliptic prototype.
+// References: scipy.signal (ellipap), S. J. Orfanidis, "Lecture Notes on
+// Elliptic Filter Design".
+
+// Complete elliptic integral of the first kind K(m), m = k^2, computed with
+// the arithmetic-geometric mean. ellipkm1(p) is K(1 - p), which stays
+// accurate when p is tiny.
+template <typename T> T ellipkm1(T p) {
+  T a = 1, b = std::sqrt(p);
+  while (std::abs(a - b) > std::numeric_limits<T>::epsilon() * a) {
+    T an = (a + b) / 2;
+    b = std::sqrt(a * b);
+    a = an;
+  }
+  return M_PI / (2 * a);
+}
+
+template <typename T> T ellipk(T m) { return ellipkm1<T>(1 - m); }
+
+// Jacobi elliptic functions sn, cn and dn of a real argument, computed with
+// the descending Landen transformation (Abramowitz and Stegun 16.4).
+template <typename T> void ellipj(T u, T m, T &sn, T &cn, T &dn) {
+  std::vector<T> a{1}, c{std::sqrt(m)};
+  T b = std::sqrt(1 - m);
+  while (std::abs(c.back()) > std::numeric_limits<T>::epsilon() &&
+         a.size() < 16) {
+    T an = (a.back() + b) / 2;
+    c.push_back((a.back() - b) / 2);
+    b = std::sqrt(a.back() * b);
+    a.push_back(an);
+  }
+  size_t n = a.size() - 1;
+  T phi = std::ldexp(a[n] * u, n);
+  T prev = phi;
+  for (size_t i = n; i > 0; --i) {
+    prev = phi;
+    phi = (phi + std::asin(c[i] / a[i] * std::sin(phi))) / 2;
+  }
+  sn = std::sin(phi);
+  cn = std::cos(phi);
+  dn = n == 0 ? T(1) : cn / std::cos(prev - phi);
+}
+
+// Inverse of sn for a complex argument, by ascending Landen iteration.
+template <typename T>
+std::complex<T> arc_jac_sn(const std::complex<T> &w, T m) {
+  T k = std::sqrt(m);
+  std::vector<T> ks{k};
+  while (ks.back() != 0 && ks.size() < 16) {
+    T kn = ks.back();
+    T knp = std::sqrt((1 - kn) * (1 + kn));
+    ks.push_back((1 - knp) / (1 + knp));
+  }
+  T K = M_PI / 2;
+  for (size_t i = 1; i < ks.size(); ++i)
+    K *= 1 + ks[i];
+  std::complex<T> wn = w;
+  for (size_t i = 0; i + 1 < ks.size(); ++i)
+    wn = T(2) * wn /
+         ((1 + ks[i + 1]) * (T(1) + std::sqrt(T(1) - ks[i] * ks[i] * wn * wn)));
+  return K * T(2) / T(M_PI) * std::asin(wn);
+}
+
+// Solve the degree equation: the modulus m of an order N elliptic filter with
+// discrimination modulus m1, using its nome series.
+template <typename T> T ellipdeg(int N, T m1) {
+  T q1 = std::exp(-M_PI * ellipkm1<T>(m1) / ellipk<T>(m1));
+  T q = std::pow(q1, T(1) / N);
+  T num = 0, den = 1;
+  for (int i = 0; i <= 7; ++i)
+    num += std::pow(q, T(i * (i + 1)));
+  for (int i = 1; i <= 8; ++i)
+    den += 2 * std::pow(q, T(i * i));
+  return 16 * q * std::pow(num / den, T(4));
+}
+
+// Roots of a degree n polynomial with the Aberth-Ehrlich iteration.
+// newton(x) returns the Newton step f(x) / f'(x) of the polynomial f. The
+// polynomial should be scaled so that the geometric mean of its roots has
+// magnitude one, which is where the initial guesses are placed.
+template <typename T, typename Newton>
+std::vector<std::complex<T>> aberth_roots(size_t n, Newton newton) {
+  std::vector<std::complex<T>> roots(n);
+  // Spread over the unit circle and off the real axis, which a real
+  // polynomial's iteration could not leave.
+  for (size_t i = 0; i < n; ++i)
+    roots[i] = std::polar(T(1), T(2 * M_PI * i / n + 0.4));
+  for (int iter = 0; iter < 100; ++iter) {
+    T change = 0;
+    for (size_t i = 0; i < n; ++i) {
+      std::complex<T> step = newton(roots[i]);
+      if (step == std::complex<T>(0))
+        continue;
+      std::complex<T> repulsion = 0;
+      for (size_t j = 0; j < n; ++j)
+        if (j != i)
+          repulsion += T(1) / (roots[i] - roots[j]);
+      std::complex<T> delta = step / (T(1) - step * repulsion);
+      roots[i] -= delta;
+      change = std::max(change,
+                        std::abs(delta) / std::max(T(1), std::abs(roots[i])));
+    }
+    if (change <= std::numeric_limits<T>::epsilon() * 4)
+      break;
+  }
+  return roots;
+}
+
+// Newton step theta_N(s) / theta_N'(s) of the reverse Bessel polynomial
+// theta_n = (2n - 1) theta_(n-1) + s^2 theta_(n-2). Evaluated with this
+// recurrence, the polynomial cancels badly near its roots in the left half
+// plane from order 15 on. There, with w = -s and nu = N + 1/2, it is
+// proportional to e^(-2w) (-w)^N (pi I_nu(w) + (-1)^N K_nu(w)), the zeros
+// scipy finds through K_nu(-w), and both Bessel functions have stable
+// recurrences: K_nu upwards, and I_nu downwards from a higher order and
+// normalized by I_(+-1/2) (Miller's algorithm). Both are scaled by
+// sqrt(2w / pi) e^w, which leaves K_(+-1/2) at one.
+template <typename T>
+std::complex<T> bessel_newton_step(int N, const std::complex<T> &s) {
+  if (s.real() >= 0) {
+    std::complex<T> prev = 1, dprev = 0, y = s + T(1), dy = 1;
+    for (int n = 2; n <= N; ++n) {
+      std::complex<T> next = T(2 * n - 1) * y + s * s * prev;
+      std::complex<T> dnext =
+          T(2 * n - 1) * dy + T(2) * s * prev + s * s * dprev;
+      prev = y;
+      dprev = dy;
+      y = next;
+      dy = dnext;
+    }
+    return y / dy;
+  }
+
+  std::complex<T> w = -s;
+  // K_(n+1/2) for n = N - 1 and N.
+  std::complex<T> kPrev = 1, k = 1;
+  for (int n = 1; n <= N; ++n) {
+    std::complex<T> next = kPrev + T(2 * n - 1) / w * k;
+    kPrev = k;
+    k = next;
+  }
+
+  // I_(n+1/2) for n = N - 1, N, and 0 and -1 to normalize them, from an
+  // arbitrary start far enough above N and |w|.
+  int M = N + 20 + 2 * static_cast<int>(std::abs(w));
+  T limit = std::sqrt(std::numeric_limits<T>::max());
+  std::complex<T> next = 0, cur = 1, i, iPrev;
+  for (int n = M; n >= 0; --n) {
+    if (n == N)
+      i = cur;
+    if (n == N - 1)
+      iPrev = cur;
+    std::complex<T> prev = next + T(2 * n + 1) / w * cur;
+    next = cur;
+    cur = prev;
+    if (std::abs(cur) > limit) {
+      cur /= limit;
+      next /= limit;
+      i /= limit;
+      iPrev /= limit;
+    }
+  }
+  // After scaling, pi I_(1/2) = e^(2w) - 1 and pi I_(-1/2) = e^(2w) + 1; next
+  // holds I_(1/2) and cur I_(-1/2). Everything is multiplied by e^(-2w),
+  // which stays bounded for Re(w) > 0, and the larger one normalizes.
+  std::complex<T> decay = std::exp(T(-2) * w);
+  std::complex<T> norm = std::abs(T(1) - decay) > std::abs(T(1) + decay)
+                             ? (T(1) - decay) / next
+                             : (T(1) + decay) / cur;
+  T sign = N % 2 == 0 ? 1 : -1;
+  std::complex<T> g = norm * i + sign * decay * k;
+  std::complex<T> h = norm * iPrev - sign * decay * kPrev;
+  // d/dw log theta_N(-w) = h / g - 1.
+  return g / (g - h);
+}
+
+// Clean up the roots of a real polynomial: tiny imaginary parts are dropped,
+// and complex roots are replaced by exact conjugate pairs, negative imaginary
+// part first.
+template <typename T>
+std::vector<std::complex<T>>
+conjugate_pairs(const std::vector<std::complex<T>> &roots) {
+  T tol = std::sqrt(std::numeric_limits<T>::epsilon());
+  std::vector<std::complex<T>> result;
+  for (const std::complex<T> &r : roots) {
+    if (std::abs(r.imag()) <= tol * std::abs(r))
+      result.push_back(std::complex<T>(r.real(), 0));
+    else if (r.imag() > 0) {
+      result.push_back(std::conj(r));
+      result.push_back(r);
+    }
+  }
+  return result;
+}
+} // namespace detail
+
+// Analog lowpass prototypes in zpk form, with a cutoff of 1 rad/s. The poles
+// of every family are listed as conjugate pairs, matching scipy.signal.
+
+// N: filter order
 template <typename T> zpk<T> butterworth(int N) {
-  switch (N) {
-  case 1:
-    return {{}, {std::complex<T>(-1., +0.)}, 1};
-  case 2:
-    return {{},
-            {std::complex<T>(-0.7071067811865476, -0.7071067811865476),
-             std::complex<T>(-0.7071067811865476, +0.7071067811865476)},
-            1};
-  case 3:
-    return {{},
-            {std::complex<T>(-0.5000000000000001, -0.8660254037844386),
-             std::complex<T>(-1., +0.),
-             std::complex<T>(-0.5000000000000001, +0.8660254037844386)},
-            1};
-  case 4:
-    return {{},
-            {std::complex<T>(-0.38268343236508984, -0.9238795325112867),
-             std::complex<T>(-0.9238795325112867, -0.3826834323650898),
-             std::complex<T>(-0.9238795325112867, +0.3826834323650898),
-             std::complex<T>(-0.38268343236508984, +0.9238795325112867)},
-            1};
-  case 5:
-    return {{},
-            {std::complex<T>(-0.30901699437494745, -0.9510565162951535),
-             std::complex<T>(-0.8090169943749475, -0.5877852522924731),
-             std::complex<T>(-1., +0.),
-             std::complex<T>(-0.8090169943749475, +0.5877852522924731),
-             std::complex<T>(-0.30901699437494745, +0.9510565162951535)},
-            1};
-  case 6:
-    return {{},
-            {std::complex<T>(-0.25881904510252096, -0.9659258262890682),
-             std::complex<T>(-0.7071067811865476, -0.7071067811865476),
-             std::complex<T>(-0.9659258262890683, -0.25881904510252074),
-             std::complex<T>(-0.9659258262890683, +0.25881904510252074),
-             std::complex<T>(-0.7071067811865476, +0.7071067811865476),
-             std::complex<T>(-0.25881904510252096, +0.9659258262890682)},
-            1};
-  case 7:
-    return {{},
-            {std::complex<T>(-0.22252093395631445, -0.9749279121818236),
-             std::complex<T>(-0.6234898018587336, -0.7818314824680298),
-             std::complex<T>(-0.9009688679024191, -0.4338837391175581),
-             std::complex<T>(-1., +0.),
-             std::complex<T>(-0.9009688679024191, +0.4338837391175581),
-             std::complex<T>(-0.6234898018587336, +0.7818314824680298),
-             std::complex<T>(-0.22252093395631445, +0.9749279121818236)},
-            1};
-  case 8:
-    return {{},
-            {std::complex<T>(-0.19509032201612833, -0.9807852804032304),
-             std::complex<T>(-0.5555702330196023, -0.8314696123025452),
-             std::complex<T>(-0.8314696123025452, -0.5555702330196022),
-             std::complex<T>(-0.9807852804032304, -0.19509032201612825),
-             std::complex<T>(-0.9807852804032304, +0.19509032201612825),
-             std::complex<T>(-0.8314696123025452, +0.5555702330196022),
-             std::complex<T>(-0.5555702330196023, +0.8314696123025452),
-             std::complex<T>(-0.19509032201612833, +0.9807852804032304)},
-            1};
-  case 9:
-    return {{},
-            {std::complex<T>(-0.17364817766693041, -0.984807753012208),
-             std::complex<T>(-0.5000000000000001, -0.8660254037844386),
-             std::complex<T>(-0.766044443118978, -0.6427876096865393),
-             std::complex<T>(-0.9396926207859084, -0.3420201433256687),
-             std::complex<T>(-1., +0.),
-             std::complex<T>(-0.9396926207859084, +0.3420201433256687),
-             std::complex<T>(-0.766044443118978, +0.6427876096865393),
-             std::complex<T>(-0.5000000000000001, +0.8660254037844386),
-             std::complex<T>(-0.17364817766693041, +0.984807753012208)},
-            1};
-  case 10:
-    return {{},
-            {std::complex<T>(-0.15643446504023092, -0.9876883405951378),
-             std::complex<T>(-0.4539904997395468, -0.8910065241883678),
-             std::complex<T>(-0.7071067811865476, -0.7071067811865476),
-             std::complex<T>(-0.8910065241883679, -0.45399049973954675),
-             std::complex<T>(-0.9876883405951378, -0.15643446504023087),
-             std::complex<T>(-0.9876883405951378, +0.15643446504023087),
-             std::complex<T>(-0.8910065241883679, +0.45399049973954675),
-             std::complex<T>(-0.7071067811865476, +0.7071067811865476),
-             std::complex<T>(-0.4539904997395468, +0.8910065241883678),
-             std::complex<T>(-0.15643446504023092, +0.9876883405951378)},
-            1};
-  case 11:
-    return {{},
-            {std::complex<T>(-0.14231483827328512, -0.9898214418809327),
-             std::complex<T>(-0.41541501300188644, -0.9096319953545183),
-             std::complex<T>(-0.654860733945285, -0.7557495743542583),
-             std::complex<T>(-0.8412535328311812, -0.5406408174555976),
-             std::complex<T>(-0.9594929736144974, -0.28173255684142967),
-             std::complex<T>(-1., +0.),
-             std::complex<T>(-0.9594929736144974, +0.28173255684142967),
-             std::complex<T>(-0.8412535328311812, +0.5406408174555976),
-             std::complex<T>(-0.654860733945285, +0.7557495743542583),
-             std::complex<T>(-0.41541501300188644, +0.9096319953545183),
-             std::complex<T>(-0.14231483827328512, +0.9898214418809327)},
-            1};
-  case 12:
-    return {{},
-            {std::complex<T>(-0.13052619222005193, -0.9914448613738104),
-             std::complex<T>(-0.38268343236508984, -0.9238795325112867),
-             std::complex<T>(-0.6087614290087207, -0.7933533402912352),
-             std::complex<T>(-0.7933533402912353, -0.6087614290087205),
-             std::complex<T>(-0.9238795325112867, -0.3826834323650898),
-             std::complex<T>(-0.9914448613738104, -0.13052619222005157),
-             std::complex<T>(-0.9914448613738104, +0.13052619222005157),
-             std::complex<T>(-0.9238795325112867, +0.3826834323650898),
-             std::complex<T>(-0.7933533402912353, +0.6087614290087205),
-             std::complex<T>(-0.6087614290087207, +0.7933533402912352),
-             std::complex<T>(-0.38268343236508984, +0.9238795325112867),
-             std::complex<T>(-0.13052619222005193, +0.9914448613738104)},
-            1};
-  default:
-    return {{}, {}, 1.0};
+  zpk<T> result{{}, {}, 1};
+  for (int m = -N + 1; m < N; m += 2)
+    result.p.push_back(-std::exp(std::complex<T>(0, -M_PI * m / (2 * N))));
+  return result;
+}
+
+// N: filter order
+// rp: passband ripple in dB, the response is -rp dB at the cutoff
+template <typename T> zpk<T> chebyshev1(int N, T rp) {
+  T eps = std::sqrt(std::pow(T(10), T(0.1) * rp) - 1);
+  T mu = std::asinh(1 / eps) / N;
+  zpk<T> result{{}, {}, 1};
+  std::complex<T> k = 1;
+  for (int m = -N + 1; m < N; m += 2) {
+    std::complex<T> p = -std::sinh(std::complex<T>(mu, M_PI * m / (2 * N)));
+    result.p.push_back(p);
+    k *= -p;
+  }
+  result.k = k.real();
+  if (N % 2 == 0)
+    result.k /= std::sqrt(1 + eps * eps);
+  return result;
+}
+
+// N: filter order
+// rs: stopband attenuation in dB, reached at the cutoff
+template <typename T> zpk<T> chebyshev2(int N, T rs) {
+  T de = 1 / std::sqrt(std::pow(T(10), T(0.1) * rs) - 1);
+  T mu = std::asinh(1 / de) / N;
+  zpk<T> result{{}, {}, 1};
+  std::complex<T> k = 1;
+  for (int m = -N + 1; m < N; m += 2) {
+    // The odd order middle pole has no zero, its zero is at infinity.
+    if (m != 0) {
+      std::complex<T> z(0, 1 / std::sin(m * M_PI / (2 * N)));
+      result.z.push_back(z);
+      k /= -z;
+    }
+    std::complex<T> p = -std::exp(std::complex<T>(0, M_PI * m / (2 * N)));
+    p = std::complex<T>(std::sinh(mu) * p.real(), std::cosh(mu) * p.imag());
+    p = T(1) / p;
+    result.p.push_back(p);
+    k *= -p;
+  }
+  result.k = k.real();
+  return result;
+}
+
+// Bessel (Thomson) prototype normalized for a phase response of -N * pi / 4
+// rad at the cutoff, like the default of scipy.signal.bessel.
+// N: filter order
+template <typename T> zpk<T> bessel(int N) {
+  // The reverse Bessel polynomial has a_0 = (2N)! / (2^N N!), which outgrows
+  // double from order 90, so the poles are found in long double. Its roots
+  // have the product a_0, and dividing them by a_0^(1/N) is the phase
+  // normalization.
+  long double scale = 0;
+  for (int k = 1; k <= N; ++k)
+    scale += std::log(2.0L * N - k + 1) - std::log(2.0L);
+  scale = std::exp(scale / N);
+  auto newton = [&](const std::complex<long double> &x) {
+    return detail::bessel_newton_step(N, scale * x) / scale;
+  };
+  std::vector<std::complex<long double>> roots =
+      detail::aberth_roots<long double>(N, newton);
+  // The roots of theta_N sum to -N (N + 1) / 2, as scipy checks; a NaN fails
+  // the comparison too.
+  std::complex<long double> sum = 0;
+  for (const std::complex<long double> &r : roots)
+    sum += r;
+  long double expected = -N * (N + 1.0L) / (2 * scale);
+  if (!(std::abs(sum - expected) <= 1e-12L * std::abs(expected)))
+    throw std::runtime_error("The Bessel polynomial roots did not converge.");
+  zpk<T> result{{}, {}, 1};
+  for (const std::complex<long double> &p : detail::conjugate_pairs(roots))
+    result.p.push_back(std::complex<T>(p));
+  if (result.p.size() != static_cast<size_t>(N))
+    throw std::runtime_error("The Bessel poles do not form conjugate pairs.");
+  return result;
+}
+
+// N: filter order
+// rp: passband ripple in dB, the response is -rp dB at the cutoff
+// rs: stopband attenuation in dB
+template <typename T> zpk<T> elliptic(int N, T rp, T rs) {
+  T epsSq = std::pow(T(10), T(0.1) * rp) - 1;
+  if (N == 1) {
+    T p = -std::sqrt(1 / epsSq);
+    return {{}, {std::complex<T>(p, 0)}, -p};
   }
+  T eps = std::sqrt(epsSq);
+  T m1 = epsSq / (std::pow(T(10), T(0.1) * rs) - 1);
+  T m = detail::ellipdeg<T>(N, m1);
+  T capk = detail::ellipk<T>(m);
+  T r = detail::arc_jac_sn<T>(std::complex<T>(0, 1 / eps), m1).imag();
+  T v0 = capk * r / (N * detail::ellipk<T>(m1));
+  T sv, cv, dv;
+  detail::ellipj<T>(v0, 1 - m, sv, cv, dv);
+
+  zpk<T> result{{}, {}, 1};
+  std::complex<T> k = 1;
+  for (int j = 1 - N % 2; j < N; j += 2) {
+    T s, c, d;
+    detail::ellipj<T>(j * capk / N, m, s, c, d);
+    if (std::abs(s) > std::numeric_limits<T>::epsilon()) {
+      std::complex<T> z(0, 1 / (std::sqrt(m) * s));
+      result.z.push_back(std::conj(z));
+      result.z.push_back(z);
+      k /= z * std::conj(z);
+    }
+    std::complex<T> p = -std::complex<T>(c * d * sv * cv, s * dv) /
+                        (1 - (d * sv) * (d * sv));
+    if (std::abs(p.imag()) > std::numeric_limits<T>::epsilon() * std::abs(p)) {
+      result.p.push_back(std::conj(p));
+      result.p.push_back(p);
+      k *= p * std::conj(p);
+    } else {
+      result.p.push_back(std::complex<T>(p.real(), 0));
+      k *= -p.real();
+    }
+  }
+  result.k = k.real();
+  if (N % 2 == 0)
+    result.k /= std::sqrt(1 + epsSq);
+  return result;
 }
 
 namespace detail {
@@ -198,82 +410,96 @@ template <typename T> zpk<T> bilinear(const zpk<T> &filter, T fs) {
   return result;
 }
 
-template <typename T> struct zero_pole_pairs {
-  std::complex<T> p1, p2, z1, z2;
-};
-
-template <typename T>
-std::vector<T> zpk2tf_poly(const std::complex<T> &x, const std::complex<T> &y) {
-  return {T(1), -(x.real() + y.real()),
-          x.real() * y.real() - x.imag() * y.imag()};
-}
-
-template <typename T>
-std::vector<T> zpk2tf(const zero_pole_pairs<T> &pairs, T k) {
-  // std::vector<T> zz = k * zpk2tf_poly(pairs.z1, pairs.z2);
-  std::vector<T> zz = zpk2tf_poly(pairs.z1, pairs.z2);
-  std::for_each(zz.begin(), zz.end(),
-                [&k](auto &element) { return element = k * element; });
-
-  std::vector<T> pp = zpk2tf_poly(pairs.p1, pairs.p2);
-  return {zz[0], zz[1], zz[2], pp[0], pp[1], pp[2]};
-}
-
 template <typename T> bool isreal(const std::complex<T> &x) {
   return x.imag() == 0;
 }
 
+// Split `list` into one representative (positive imaginary part) of every
+// complex conjugate pair followed by the purely real values, both sorted by
+// real part. Pairs with almost equal real parts are ordered by imaginary part.
 template <typename T>
 std::vector<std::complex<T>>
 cplxreal(const std::vector<std::complex<T>> &list) {
-  std::vector<std::complex<T>> x = list;
-  std::sort(x.begin(), x.end(),
-            [](const std::complex<T> &a, const std::complex<T> &b) {
-              return a.real() < b.real();
-            });
   T tol = std::numeric_limits<T>::epsilon() * 100;
-  std::vector<std::complex<T>> result = x;
-  for (size_t i = result.size(); i > 1; i--) {
-    if (!isreal(result[i - 1]) && !isreal(result[i - 2])) {
-
-      if (std::abs(result[i - 1].real() - result[i - 2].real()) < tol &&
-          std::abs(result[i - 1].imag() + result[i - 2].imag()) < tol) {
-        result.erase(result.begin() + i - 1);
-
-        result[i - 2].imag(std::abs(result[i - 2].imag()));
-      }
-    }
+  auto byReal = [](const std::complex<T> &a, const std::complex<T> &b) {
+    if (a.real() != b.real())
+      return a.real() < b.real();
+    return std::abs(a.imag()) < std::abs(b.imag());
+  };
+
+  std::vector<std::complex<T>> reals, positive, negative;
+  for (const std::complex<T> &x : list) {
+    if (std::abs(x.imag()) <= tol * std::abs(x))
+      reals.push_back(x.real());
+    else if (x.imag() > 0)
+      positive.push_back(x);
+    else
+      negative.push_back(x);
+  }
+  assert(positive.size() == negative.size() &&
+         "complex value with no matching conjugate");
+  std::sort(reals.begin(), reals.end(), byReal);
+  std::sort(positive.begin(), positive.end(), byReal);
+  std::sort(negative.begin(), negative.end(), byReal);
+
+  // Sort runs of (approximately) the same real part by imaginary part.
+  auto byImag = [](const std::complex<T> &a, const std::complex<T> &b) {
+    return std::abs(a.imag()) < std::abs(b.imag());
+  };
+  for (size_t start = 0; start < positive.size();) {
+    size_t stop = start + 1;
+    while (stop < positive.size() &&
+           positive[stop].real() - positive[stop - 1].real() <=
+               tol * std::abs(positive[stop - 1]))
+      stop++;
+    std::stable_sort(positive.begin() + start, positive.begin() + stop, byImag);
+    std::stable_sort(negative.begin() + start, negative.begin() + stop, byImag);
+    start = stop;
   }
 
+  std::vector<std::complex<T>> result;
+  for (size_t i = 0; i < positive.size(); i++)
+    result.push_back((positive[i] + std::conj(negative[i])) / T(2));
+  result.insert(result.end(), reals.begin(), reals.end());
   return result;
 }
 
+enum class root_kind { any, real, complex };
+
+// Index of the element of `list` of the requested kind nearest to `val`.
 template <typename T>
 size_t nearest_real_or_complex(const std::vector<std::complex<T>> &list,
-                               const std::complex<T> &val,
-                               bool mustbereal = true) {
-  std::vector<std::complex<T>> filtered;
-  for (std::complex<T> v : list) {
-    if (isreal(v) == mustbereal) {
-      filtered.push_back(v);
-    }
-  }
-
-  if (filtered.empty())
-    return std::numeric_limits<size_t>::max();
-
-  size_t minidx = 0;
-  T minval = std::abs(val - filtered[0]);
-  for (size_t i = 1; i < list.size(); i++) {
-    T newminval = std::abs(val - filtered[i]);
+                               const std::complex<T> &val, root_kind kind) {
+  size_t minidx = std::numeric_limits<size_t>::max();
+  T minval = std::numeric_limits<T>::infinity();
+  for (size_t i = 0; i < list.size(); i++) {
+    if (kind != root_kind::any && isreal(list[i]) != (kind == root_kind::real))
+      continue;
+    T newminval = std::abs(val - list[i]);
     if (newminval < minval) {
       minval = newminval;
       minidx = i;
     }
   }
+  assert(minidx < list.size() && "no root of the requested kind left");
   return minidx;
 }
 
+// Index of the pole closest to the unit circle.
+template <typename T>
+size_t worst_pole(const std::vector<std::complex<T>> &list) {
+  size_t worstidx = 0;
+  T worstval = std::abs(1 - std::abs(list[0]));
+  for (size_t i = 1; i < list.size(); i++) {
+    T val = std::abs(1 - std::abs(list[i]));
+    if (val < worstval) {
+      worstidx = i;
+      worstval = val;
+    }
+  }
+  return worstidx;
+}
+
 template <typename T> int countreal(const std::vector<std::complex<T>> &list) {
   int nreal = 0;
   for (std::complex<T> c : list) {
@@ -283,6 +509,34 @@ template <typename T> int countreal(const std::vector<std::complex<T>> &list) {
   return nreal;
 }
 
+// Real polynomial coefficients of prod(x - roots), highest power first.
+template <typename T>
+std::vector<T> zpk2tf_poly(const std::vector<std::complex<T>> &roots) {
+  std::vector<std::complex<T>> poly = {std::complex<T>(1)};
+  for (const std::complex<T> &r : roots) {
+    poly.push_back(0);
+    for (size_t i = poly.size() - 1; i > 0; i--)
+      poly[i] -= r * poly[i - 1];
+  }
+  std::vector<T> result;
+  for (const std::complex<T> &c : poly)
+    result.push_back(c.real());
+  return result;
+}
+
+// One second order section from up to two zeros and two poles. Missing
+// powers are padded at the front, as in scipy's zpk2sos.
+template <typename T>
+std::vector<T> zpk2tf(const std::vector<std::complex<T>> &z,
+                      const std::vector<std::complex<T>> &p) {
+  std::vector<T> b = zpk2tf_poly(z);
+  std::vector<T> a = zpk2tf_poly(p);
+  std::vector<T> sos(6, T(0));
+  std::copy(b.begin(), b.end(), sos.begin() + 3 - b.size());
+  std::copy(a.begin(), a.end(), sos.begin() + 6 - a.size());
+  return sos;
+}
+
 template <typename T> T warp_freq(T frequency, T fs) {
   frequency = 2 * frequency / fs;
   fs = 2.0;
@@ -304,6 +558,82 @@ template <typename T> zpk<T> lp2lp_zpk(const zpk<T> &filter, T wo) {
   return result;
 }
 
+// Lowpass to highpass transform, the cutoff 1 rad/s moves to wo.
+template <typename T> zpk<T> lp2hp_zpk(const zpk<T> &filter, T wo) {
+  zpk<T> result;
+  std::complex<T> gain = filter.k;
+  for (const std::complex<T> &z : filter.z) {
+    result.z.push_back(wo / z);
+    gain *= -z;
+  }
+  for (const std::complex<T> &p : filter.p) {
+    result.p.push_back(wo / p);
+    gain /= -p;
+  }
+  // Zeros at infinity move to the origin.
+  result.z.resize(filter.p.size(), std::complex<T>(0));
+  result.k = gain.real();
+  return result;
+}
+
+// Lowpass to bandpass transform around the center frequency wo with
+// bandwidth bw. The order doubles.
+template <typename T> zpk<T> lp2bp_zpk(const zpk<T> &filter, T wo, T bw) {
+  zpk<T> result;
+  auto transform = [&](const std::vector<std::complex<T>> &roots,
+                       std::vector<std::complex<T>> &out) {
+    for (const std::complex<T> &r : roots) {
+      std::complex<T> scaled = r * bw / T(2);
+      out.push_back(scaled + std::sqrt(scaled * scaled - wo * wo));
+    }
+    for (const std::complex<T> &r : roots) {
+      std::complex<T> scaled = r * bw / T(2);
+      out.push_back(scaled - std::sqrt(scaled * scaled - wo * wo));
+    }
+  };
+  transform(filter.z, result.z);
+  transform(filter.p, result.p);
+  // Zeros at infinity move to the origin.
+  size_t degree = filter.p.size() - filter.z.size();
+  result.z.resize(result.z.size() + degree, std::complex<T>(0));
+  result.k = filter.k * std::pow(bw, T(degree));
+  return result;
+}
+
+// Lowpass to bandstop transform around the center frequency wo with
+// bandwidth bw. The order doubles.
+template <typename T> zpk<T> lp2bs_zpk(const zpk<T> &filter, T wo, T bw) {
+  zpk<T> result;
+  std::complex<T> gain = filter.k;
+  auto transform = [&](const std::vector<std::complex<T>> &roots,
+                       std::vector<std::complex<T>> &out) {
+    for (const std::complex<T> &r : roots) {
+      std::complex<T> inverted = bw / T(2) / r;
+      out.push_back(inverted + std::sqrt(inverted * inverted - wo * wo));
+    }
+    for (const std::complex<T> &r : roots) {
+      std::complex<T> inverted = bw / T(2) / r;
+      out.push_back(inverted - std::sqrt(inverted * inverted - wo * wo));
+    }
+  };
+  transform(filter.z, result.z);
+  transform(filter.p, result.p);
+  for (const std::complex<T> &z : filter.z)
+    gain *= -z;
+  for (const std::complex<T> &p : filter.p)
+    gain /= -p;
+  // Zeros at infinity move to +-j wo.
+  size_t degree = filter.p.size() - filter.z.size();
+  result.z.insert(result.z.end(), degree, std::complex<T>(0, wo));
+  result.z.insert(result.z.end(), degree, std::complex<T>(0, -wo));
+  result.k = gain.real();
+  return result;
+}
+
+// Group the zeros and poles of a digital filter into second order sections,
+// pairing every pole with its nearest zero. The poles closest to the unit
+// circle go to the last sections and the gain to the first one. This follows
+// scipy's zpk2sos with pairing='nearest', so the sections match scipy's.
 template <typename T> std::vector<std::vector<T>> to_sos(const zpk<T> &filter) {
   if (filter.p.empty() && filter.z.empty())
     return {{filter.k, 0., 0., 1., 0., 0}};
@@ -322,100 +652,62 @@ template <typename T> std::vector<std::vector<T>> to_sos(const zpk<T> &filter) {
   filt.z = cplxreal(filt.z);
   filt.p = cplxreal(filt.p);
 
-  std::vector<zero_pole_pairs<T>> pairs(n_sections);
-
-  for (size_t si = 0; si < n_sections; si++) {
-    size_t worstidx = 0;
-    T worstval = std::abs(1.0 - std::abs(filt.p[0]));
-
-    for (size_t i = 1; i < filt.p.size(); i++) {
-      T val = std::abs(1 - std::abs(filt.p[i]));
-
-      if (val < worstval) {
-        worstidx = i;
-        worstval = val;
-      }
-    }
+  auto take = [](std::vector<std::complex<T>> &list, size_t idx) {
+    std::complex<T> val = list[idx];
+    list.erase(list.begin() + idx);
+    return val;
+  };
 
-    std::complex<T> p1 = filt.p[worstidx];
-
-    filt.p.erase(filt.p.begin() + worstidx);
+  std::vector<std::vector<T>> result(n_sections);
+  for (size_t si = n_sections; si-- > 0;) {
+    std::complex<T> p1 = take(filt.p, worst_pole(filt.p));
 
-    std::complex<T> z1, p2, z2;
     if (isreal(p1) && countreal(filt.p) == 0) {
-      size_t z1_idx = nearest_real_or_complex(filt.z, p1, true);
-      z1 = filt.z[z1_idx];
-      filt.z.erase(filt.z.begin() + z1_idx);
-      p2 = z2 = 0;
+      // Last remaining real pole.
+      std::complex<T> z1 = take(
+          filt.z, nearest_real_or_complex(filt.z, p1, root_kind::real));
+      result[si] = zpk2tf<T>({z1, 0}, {p1, 0});
+    } else if (filt.p.size() + 1 == filt.z.size() && !isreal(p1) &&
+               countreal(filt.p) == 1 && countreal(filt.z) == 1) {
+      // One real pole and one real zero left: p1 must take a complex zero.
+      std::complex<T> z1 = take(
+          filt.z, nearest_real_or_complex(filt.z, p1, root_kind::complex));
+      result[si] = zpk2tf<T>({z1, std::conj(z1)}, {p1, std::conj(p1)});
     } else {
-      size_t z1_idx;
-      if (!isreal(p1) && countreal(filt.z) == 1) {
-        z1_idx = nearest_real_or_complex(filt.z, p1, false);
-      } else {
-        size_t minidx = 0;
-        T minval = std::abs(p1 - filt.z[0]);
-        for (size_t i = 1; i < filt.z.size(); i++) {
-          T newminval = std::abs(p1 - filt.z[i]);
-          if (newminval < minval) {
-            minidx = i;
-            minval = newminval;
+      std::complex<T> p2;
+      if (isreal(p1)) {
+        std::vector<size_t> realIdx;
+        std::vector<std::complex<T>> realPoles;
+        for (size_t i = 0; i < filt.p.size(); i++)
+          if (isreal(filt.p[i])) {
+            realIdx.push_back(i);
+            realPoles.push_back(filt.p[i]);
           }
-        }
-        z1_idx = minidx;
+        p2 = take(filt.p, realIdx[worst_pole(realPoles)]);
+      } else {
+        p2 = std::conj(p1);
+      }
+
+      if (filt.z.empty()) {
+        result[si] = zpk2tf<T>({}, {p1, p2});
+        continue;
       }
-      z1 = filt.z[z1_idx];
-      filt.z.erase(filt.z.begin() + z1_idx);
-      if (!isreal(p1)) {
-        if (!isreal(z1)) {
-          p2 = std::conj(p1);
-          z2 = std::conj(z1);
-        } else {
-          p2 = std::conj(p1);
-          size_t z2_idx = nearest_real_or_complex(filt.z, p1, true);
-          z2 = filt.z[z2_idx];
-          // TESTO_ASSERT(isreal(z2));
-          filt.z.erase(filt.z.begin() + z2_idx);
-        }
+      std::complex<T> z1 =
+          take(filt.z, nearest_real_or_complex(filt.z, p1, root_kind::any));
+      if (!isreal(z1)) {
+        result[si] = zpk2tf<T>({z1, std::conj(z1)}, {p1, p2});
+      } else if (!filt.z.empty()) {
+        std::complex<T> z2 = take(
+            filt.z, nearest_real_or_complex(filt.z, p1, root_kind::real));
+        result[si] = zpk2tf<T>({z1, z2}, {p1, p2});
       } else {
-        size_t p2_idx;
-        size_t z2_idx;
-        if (!isreal(z1)) {
-          z2 = std::conj(z1);
-          p2_idx = nearest_real_or_complex(filt.z, p1, true);
-          p2 = filt.p[p2_idx];
-          // TESTO_ASSERT(isreal(p2));
-        } else {
-          size_t worstidx = 0;
-          T worstval = std::abs(std::abs(filt.p[0]) - 1);
-          for (size_t i = 1; i < filt.p.size(); i++) {
-            T val = std::abs(std::abs(filt.p[i]) - 1);
-            if (val < worstval) {
-              worstidx = i;
-              worstval = val;
-            }
-          }
-          p2_idx = worstidx;
-          p2 = filt.p[p2_idx];
-
-          // TESTO_ASSERT(isreal(p2));
-          z2_idx = nearest_real_or_complex(filt.z, p2, true);
-          z2 = filt.z[z2_idx];
-          // TESTO_ASSERT(isreal(z2));
-          filt.z.erase(filt.z.begin() + z2_idx);
-        }
-        filt.p.erase(filt.p.begin() + p2_idx);
+        result[si] = zpk2tf<T>({z1}, {p1, p2});
       }
     }
-    pairs[si].p1 = p1;
-    pairs[si].p2 = p2;
-    pairs[si].z1 = z1;
-    pairs[si].z2 = z2;
   }
 
-  std::vector<std::vector<T>> result(n_sections);
-  for (size_t si = 0; si < n_sections; si++) {
-    result[si] = zpk2tf(pairs[n_sections - 1 - si], si == 0 ? filt.k : T(1));
-  }
+  for (size_t i = 0; i < 3; i++)
+    result[0][i] *= filt.k;
   return result;
 }
 } // namespace detail
@@ -0,0 +1,105 @@
+//===- MFCC.h -------------------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// Header file for mel filterbank and MFCC operations and other entities in DAP
+// dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FRONTEND_INTERFACES_BUDDY_DAP_DSP_MFCC
+#define FRONTEND_INTERFACES_BUDDY_DAP_DSP_MFCC
+
+#include "buddy/Core/Container.h"
+#include "buddy/DAP/DSP/STFT.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace dap {
+namespace detail {
+// Declare the mel filterbank and MFCC C interface.
+extern "C" {
+void _mlir_ciface_buddy_mel_filterbank(MemRef<float, 2> *real,
+                                       MemRef<float, 2> *imag,
+                                       MemRef<float, 2> *filterbank,
+                                       MemRef<float, 2> *output);
+
+void _mlir_ciface_buddy_mfcc(MemRef<float, 2> *mel, MemRef<float, 2> *dct,
+                             MemRef<float, 2> *output);
+}
+} // namespace detail
+
+// HTK mel scale.
+inline double hzToMel(double hz) { return 2595.0 * std::log10(1.0 + hz / 700.0); }
+
+inline double melToHz(double mel) {
+  return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0);
+}
+
+// filterbank: [mels, nfft / 2 + 1], filled with triangular filters whose
+// centers are evenly spaced on the mel scale between fmin and fmax.
+template <typename T>
+void melFilterbankMatrix(MemRef<T, 2> &filterbank, size_t nfft, T sampleRate,
+                         T fmin, T fmax) {
+  size_t mels = filterbank.getSizes()[0];
+  size_t bins = filterbank.getSizes()[1];
+  double melMin = hzToMel(fmin);
+  double melMax = hzToMel(fmax);
+  // Band m spans edges[m] .. edges[m + 2] and peaks at edges[m + 1].
+  std::vector<double> edges(mels + 2);
+  for (size_t i = 0; i < mels + 2; ++i)
+    edges[i] = melToHz(melMin + (melMax - melMin) * i / (mels + 1));
+  for (size_t m = 0; m < mels; ++m) {
+    for (size_t k = 0; k < bins; ++k) {
+      double freq = (double)k * sampleRate / nfft;
+      double rising = (freq - edges[m]) / (edges[m + 1] - edges[m]);
+      double falling = (edges[m + 2] - freq) / (edges[m + 2] - edges[m + 1]);
+      filterbank[m * bins + k] = std::max(0.0, std::min(rising, falling));
+    }
+  }
+}
+
+// dct: [coefficients, mels], filled with the orthonormal DCT-II basis.
+template <typename T> void dctMatrix(MemRef<T, 2> &dct) {
+  size_t coeffs = dct.getSizes()[0];
+  size_t mels = dct.getSizes()[1];
+  for (size_t c = 0; c < coeffs; ++c) {
+    double scale = c == 0 ? std::sqrt(1.0 / mels) : std::sqrt(2.0 / mels);
+    for (size_t m = 0; m < mels; ++m)
+      dct[c * mels + m] = scale * std::cos(M_PI * c * (m + 0.5) / mels);
+  }
+}
+
+// real, imag: [frames, bins] spectrum, see stft
+// filterbank: [mels, bins], see melFilterbankMatrix
+// output: [frames, mels] mel energies
+inline void melFilterbank(MemRef<float, 2> *real, MemRef<float, 2> *imag,
+                          MemRef<float, 2> *filterbank,
+                          MemRef<float, 2> *output) {
+  detail::_mlir_ciface_buddy_mel_filterbank(real, imag, filterbank, output);
+}
+
+// mel: [frames, mels] mel energies, see melFilterbank
+// dct: [coefficients, mels], see dctMatrix
+// output: [frames, coefficients] cepstral coefficients
+inline void mfcc(MemRef<float, 2> *mel, MemRef<float, 2> *dct,
+                 MemRef<float, 2> *output) {
+  detail::_mlir_ciface_buddy_mfcc(mel, dct, output);
+}
+} // namespace dap
+
+#endif // FRONTEND_INTERFACES_BUDDY_DAP_DSP_MFCC
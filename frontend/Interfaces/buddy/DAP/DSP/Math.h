@@ -22,10 +22,17 @@
 #define FRONTEND_INTERFACES_BUDDY_DAP_DSP_MATH
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace dap {
 // Basic math functions
-template <typename T> T sinc(T x) { return sin(x) / x; }
+// Normalized sinc, sin(pi * x) / (pi * x).
+template <typename T> T sinc(T x) {
+  if (x == (T)0)
+    return (T)1;
+  return sin((T)M_PI * x) / ((T)M_PI * x);
+}
 
 template <typename T> T besseli0(T x) {
   assert(0 && "Not implemented.");
@@ -34,6 +41,96 @@ template <typename T> T besseli0(T x) {
 }
 
 // More math functions with higher complexity
+
+// Fixed-point formats of the int16_t (Q15) entry points: samples and FIR taps
+// are Q15, biquad/IIR coefficients are Q14 so that |a1| < 2 is representable.
+constexpr int Q15_FRAC_BITS = 15;
+constexpr int BIQUAD_COEFF_FRAC_BITS = 14;
+
+// Convert to fixed point with `fracBits` fractional bits, rounding to nearest
+// and saturating to the int16_t range.
+template <typename T> int16_t toFixedPoint(T x, int fracBits) {
+  T scaled = std::round(x * (T)(1 << fracBits));
+  if (scaled > (T)INT16_MAX)
+    return INT16_MAX;
+  if (scaled < (T)INT16_MIN)
+    return INT16_MIN;
+  return (int16_t)scaled;
+}
+
+template <typename T> T fromFixedPoint(int16_t x, int fracBits) {
+  return (T)x / (T)(1 << fracBits);
+}
+
+// IEEE 754 binary16 storage type for the f16 entry points. Arithmetic is done
+// by the library, on the host side values are only converted from/to float.
+struct half {
+  uint16_t bits = 0;
+
+  half() = default;
+  half(float value) : bits(fromFloat(value)) {}
+  operator float() const { return toFloat(bits); }
+
+private:
+  // Round to nearest even, overflow goes to infinity.
+  static uint16_t fromFloat(float value) {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+    uint16_t sign = (f >> 16) & 0x8000;
+    uint32_t absF = f & 0x7fffffff;
+    // NaN and infinity.
+    if (absF >= 0x7f800000)
+      return sign | 0x7c00 | (absF > 0x7f800000 ? 0x200 : 0);
+    // Overflow.
+    if (absF >= 0x477ff000)
+      return sign | 0x7c00;
+    // Subnormal results (and zero).
+    if (absF < 0x38800000) {
+      uint32_t mant = (absF & 0x7fffff) | 0x800000;
+      int shift = 113 - (absF >> 23);
+      if (shift > 24)
+        return sign;
+      uint32_t res = mant >> (shift + 13);
+      uint32_t rem = mant & ((1u << (shift + 13)) - 1);
+      uint32_t halfway = 1u << (shift + 12);
+      if (rem > halfway || (rem == halfway && (res & 1)))
+        ++res;
+      return sign | res;
+    }
+    // Normal results, rebias the exponent and round the mantissa.
+    uint32_t res = ((absF >> 13) - (112 << 10));
+    uint32_t rem = absF & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (res & 1)))
+      ++res;
+    return sign | res;
+  }
+
+  static float toFloat(uint16_t h) {
+    uint32_t sign = uint32_t(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    uint32_t f;
+    if (exp == 0x1f) {
+      f = sign | 0x7f800000 | (mant << 13);
+    } else if (exp != 0) {
+      f = sign | ((exp + 112) << 23) | (mant << 13);
+    } else if (mant == 0) {
+      f = sign;
+    } else {
+      // Normalize the subnormal half.
+      exp = 113;
+      while (!(mant & 0x400)) {
+        mant <<= 1;
+        --exp;
+      }
+      f = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+    }
+    float value;
+    std::memcpy(&value, &f, sizeof(value));
+    return value;
+  }
+};
+
 } // namespace dap
 
 #endif // FRONTEND_INTERFACES_BUDDY_DAP_DSP_MATH
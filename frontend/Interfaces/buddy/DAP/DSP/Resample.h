@@ -0,0 +1,139 @@
+//===- Resample.h ---------------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// Header file for Resample operation and other entities in DAP dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FRONTEND_INTERFACES_BUDDY_DAP_DSP_RESAMPLE
+#define FRONTEND_INTERFACES_BUDDY_DAP_DSP_RESAMPLE
+
+#include "buddy/Core/Container.h"
+#include "buddy/DAP/DSP/FIR.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace dap {
+namespace detail {
+// Declare the Resample C interface.
+extern "C" {
+void _mlir_ciface_buddy_resample(MemRef<float, 1> *input,
+                                 MemRef<float, 2> *kernel,
+                                 MemRef<float, 1> *output, intptr_t down,
+                                 intptr_t start);
+}
+
+// Delay of the prototype filter of a [up, taps] filter bank, in samples of the
+// upsampled signal.
+inline intptr_t _resample_delay(intptr_t up, intptr_t taps) {
+  return (up * taps - 1) / 2;
+}
+} // namespace detail
+
+// Design the [up, taps] polyphase filter bank for resampling by up / down, the
+// rate is up = kernel rows and taps = kernel columns per phase. The prototype
+// is a firLowpass filter at the upsampled rate, cut off at `rolloff` times the
+// lower of the two Nyquist frequencies.
+// type: see WINDOW_TYPE
+// args: window-specific arguments, size is limited using WINDOW_TYPE
+template <typename T>
+void resampleKernel(MemRef<T, 2> &kernel, intptr_t down,
+                    WINDOW_TYPE type = WINDOW_TYPE::BLACKMANHARRIS,
+                    T *args = nullptr, T rolloff = 0.9) {
+  intptr_t up = kernel.getSizes()[0];
+  intptr_t taps = kernel.getSizes()[1];
+  // Use an odd prototype length so that its delay is a whole number of
+  // samples, the unused last tap stays zero.
+  intptr_t delay = detail::_resample_delay(up, taps);
+  intptr_t len = 2 * delay + 1;
+  intptr_t protoSize = up * taps;
+  MemRef<T, 1> proto(&protoSize);
+  firLowpass<T, 1>(proto, type, len, rolloff * (T)0.5 / std::max(up, down),
+                   args);
+  // firLowpass has unity DC gain, every phase needs a gain of 1 / up of that.
+  for (intptr_t p = 0; p < up; ++p)
+    for (intptr_t j = 0; j < taps; ++j)
+      kernel[p * taps + j] = proto[p + up * j] * (T)up;
+}
+
+// Number of output samples for `samples` input samples.
+inline intptr_t resampleLength(intptr_t samples, intptr_t up, intptr_t down) {
+  return (samples * up + down - 1) / down;
+}
+
+// Whole signal conversion by up / down, where up is the number of kernel rows.
+// The filter delay is compensated, output[n] is aligned with input time
+// n * down / up.
+// output: resampleLength(input size, up, down) samples
+inline void resample(MemRef<float, 1> *input, MemRef<float, 2> *kernel,
+                     MemRef<float, 1> *output, intptr_t down) {
+  intptr_t up = kernel->getSizes()[0];
+  intptr_t taps = kernel->getSizes()[1];
+  detail::_mlir_ciface_buddy_resample(input, kernel, output, down,
+                                      detail::_resample_delay(up, taps));
+}
+
+// Stateful conversion of a stream split into blocks of any size. The output
+// of all blocks concatenated is the whole signal output of the concatenated
+// blocks, except for the tail that still waits for future input.
+class Resampler {
+public:
+  // kernel: see resampleKernel, it must outlive the resampler.
+  Resampler(MemRef<float, 2> *kernel, intptr_t down)
+      : kernel(kernel), up(kernel->getSizes()[0]),
+        taps(kernel->getSizes()[1]), down(down), history(taps - 1, 0.0f) {
+    // Outputs are positioned on the history followed by the block, the first
+    // block starts after taps - 1 history samples.
+    time = (taps - 1) * up + detail::_resample_delay(up, taps);
+  }
+
+  // Convert the next block, the result holds every output whose input is
+  // complete.
+  MemRef<float, 1> process(MemRef<float, 1> &block) {
+    intptr_t blockSize = block.getSize();
+    intptr_t extendedSize = history.size() + blockSize;
+    intptr_t count = 0;
+    if (time < extendedSize * up)
+      count = (extendedSize * up - time + down - 1) / down;
+
+    MemRef<float, 1> extended(&extendedSize);
+    std::copy(history.begin(), history.end(), extended.getData());
+    std::copy(block.getData(), block.getData() + blockSize,
+              extended.getData() + history.size());
+    MemRef<float, 1> output(&count);
+    if (count > 0)
+      detail::_mlir_ciface_buddy_resample(&extended, kernel, &output, down,
+                                          time);
+
+    // Drop the block from the front, keep the last taps - 1 samples.
+    time += count * down - blockSize * up;
+    std::copy(extended.getData() + blockSize,
+              extended.getData() + extendedSize, history.begin());
+    return output;
+  }
+
+private:
+  MemRef<float, 2> *kernel;
+  intptr_t up;
+  intptr_t taps;
+  intptr_t down;
+  std::vector<float> history;
+  intptr_t time;
+};
+} // namespace dap
+
+#endif // FRONTEND_INTERFACES_BUDDY_DAP_DSP_RESAMPLE
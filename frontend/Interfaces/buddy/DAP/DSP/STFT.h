@@ -0,0 +1,70 @@
+//===- STFT.h -------------------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// Header file for STFT operation and other entities in DAP dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FRONTEND_INTERFACES_BUDDY_DAP_DSP_STFT
+#define FRONTEND_INTERFACES_BUDDY_DAP_DSP_STFT
+
+#include "buddy/Core/Container.h"
+#include "buddy/DAP/DSP/Window.h"
+
+namespace dap {
+namespace detail {
+// Declare the STFT C interface.
+extern "C" {
+void _mlir_ciface_buddy_stft(MemRef<float, 1> *input, MemRef<float, 1> *window,
+                             intptr_t hop, MemRef<float, 2> *outputReal,
+                             MemRef<float, 2> *outputImag);
+}
+} // namespace detail
+
+// Fill `window` with a window function of its own length.
+// type: see WINDOW_TYPE
+// args: window-specific arguments, size is limited using WINDOW_TYPE
+template <typename T>
+void makeWindow(MemRef<T, 1> &window, WINDOW_TYPE type, T *args = nullptr) {
+  size_t len = window.getSize();
+  auto func = detail::_bind_window(type, args);
+  for (size_t i = 0; i < len; ++i)
+    window[i] = func(i, len);
+}
+
+// Number of frames of length nfft and hop `hop` needed to cover `samples`
+// samples, the last frame is zero padded.
+inline intptr_t stftFrames(intptr_t samples, intptr_t nfft, intptr_t hop) {
+  if (samples <= nfft)
+    return 1;
+  return 1 + (samples - nfft + hop - 1) / hop;
+}
+
+// input: mono signal
+// window: analysis window, its length is the FFT size and must be a power of 2
+// hop: distance between the first samples of consecutive frames
+// outputReal, outputImag: [frames, nfft / 2 + 1] spectrum of every frame
+inline void stft(MemRef<float, 1> *input, MemRef<float, 1> *window,
+                 intptr_t hop, MemRef<float, 2> *outputReal,
+                 MemRef<float, 2> *outputImag) {
+  size_t nfft = window->getSize();
+  if (nfft == 0 || (nfft & (nfft - 1)) != 0)
+    assert(0 && "The window length must be a power of 2.");
+  detail::_mlir_ciface_buddy_stft(input, window, hop, outputReal, outputImag);
+}
+} // namespace dap
+
+#endif // FRONTEND_INTERFACES_BUDDY_DAP_DSP_STFT
@@ -23,10 +23,27 @@
 
 #include "buddy/Core/Container.h"
 #include "buddy/DIP/ImageContainer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace dip {
 // Availale types of boundary extrapolation techniques provided in DIP dialect.
-enum class BOUNDARY_OPTION { CONSTANT_PADDING, REPLICATE_PADDING };
+enum class BOUNDARY_OPTION {
+  CONSTANT_PADDING,
+  REPLICATE_PADDING,
+  REFLECT_PADDING,
+  REFLECT_101_PADDING,
+  WRAP_PADDING
+};
+
+// Fixed kernels of examples/kernels.h, for which the DIP library provides
+// correlations specialized at compile time.
+enum class FIXED_KERNEL { PREWITT, SOBEL_3X3, SOBEL_5X5, LAPLACIAN, LOG };
 
 // Available ways of specifying angles in image processing operations provided
 // by the DIP dialect.
@@ -36,9 +53,25 @@ enum class ANGLE_TYPE { DEGREE, RADIAN };
 // provided by the DIP dialect.
 enum class INTERPOLATION_TYPE {
   NEAREST_NEIGHBOUR_INTERPOLATION,
-  BILINEAR_INTERPOLATION
+  BILINEAR_INTERPOLATION,
+  BICUBIC_INTERPOLATION,
+  LANCZOS_INTERPOLATION,
+  AREA_INTERPOLATION
 };
 
+// Available color conversions between 4-D color images provided by the DIP
+// dialect.
+enum class COLOR_CONVERSION { RGB2YUV, YUV2RGB, RGB2HSV, HSV2RGB };
+
+// Available layouts of YUV 4:2:0 frames, with interleaved (NV12) or planar
+// (I420) chroma.
+enum class YUV420_FORMAT { NV12, I420 };
+
+// Available derivative kernels and magnitude norms of the gradient provided
+// by the DIP dialect.
+enum class GRADIENT_OPERATOR { SOBEL, SCHARR };
+enum class GRADIENT_NORM { L1_NORM, L2_NORM };
+
 namespace detail {
 // Functions present inside dip::detail are not meant to be called by users
 // directly.
@@ -53,17 +86,158 @@ void _mlir_ciface_corr_2d_replicate_padding(
     Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     unsigned int centerX, unsigned int centerY, float constantValue);
 
-void _mlir_ciface_corrfft_2d(MemRef<float, 2> *inputReal,
-                             MemRef<float, 2> *inputImag,
-                             MemRef<float, 2> *kernelReal,
-                             MemRef<float, 2> *kernelImag,
-                             MemRef<float, 2> *intermediateReal,
-                             MemRef<float, 2> *intermediateImag);
+void _mlir_ciface_corr_2d_reflect_padding(
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, float constantValue);
+
+void _mlir_ciface_corr_2d_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, float constantValue);
+
+void _mlir_ciface_corr_2d_wrap_padding(
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, float constantValue);
+
+// Declare the C interfaces of Corr2D with the kernels of examples/kernels.h.
+void _mlir_ciface_corr_2d_prewitt_constant_padding(Img<float, 2> *input,
+                                                   MemRef<float, 2> *output,
+                                                   float constantValue);
+
+void _mlir_ciface_corr_2d_prewitt_replicate_padding(Img<float, 2> *input,
+                                                    MemRef<float, 2> *output,
+                                                    float constantValue);
+
+void _mlir_ciface_corr_2d_prewitt_reflect_padding(Img<float, 2> *input,
+                                                  MemRef<float, 2> *output,
+                                                  float constantValue);
+
+void _mlir_ciface_corr_2d_prewitt_reflect_101_padding(Img<float, 2> *input,
+                                                      MemRef<float, 2> *output,
+                                                      float constantValue);
+
+void _mlir_ciface_corr_2d_prewitt_wrap_padding(Img<float, 2> *input,
+                                               MemRef<float, 2> *output,
+                                               float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_3x3_constant_padding(Img<float, 2> *input,
+                                                     MemRef<float, 2> *output,
+                                                     float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_3x3_replicate_padding(Img<float, 2> *input,
+                                                      MemRef<float, 2> *output,
+                                                      float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_3x3_reflect_padding(Img<float, 2> *input,
+                                                    MemRef<float, 2> *output,
+                                                    float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_3x3_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_3x3_wrap_padding(Img<float, 2> *input,
+                                                 MemRef<float, 2> *output,
+                                                 float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_5x5_constant_padding(Img<float, 2> *input,
+                                                     MemRef<float, 2> *output,
+                                                     float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_5x5_replicate_padding(Img<float, 2> *input,
+                                                      MemRef<float, 2> *output,
+                                                      float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_5x5_reflect_padding(Img<float, 2> *input,
+                                                    MemRef<float, 2> *output,
+                                                    float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_5x5_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, float constantValue);
+
+void _mlir_ciface_corr_2d_sobel_5x5_wrap_padding(Img<float, 2> *input,
+                                                 MemRef<float, 2> *output,
+                                                 float constantValue);
+
+void _mlir_ciface_corr_2d_laplacian_constant_padding(Img<float, 2> *input,
+                                                     MemRef<float, 2> *output,
+                                                     float constantValue);
+
+void _mlir_ciface_corr_2d_laplacian_replicate_padding(Img<float, 2> *input,
+                                                      MemRef<float, 2> *output,
+                                                      float constantValue);
+
+void _mlir_ciface_corr_2d_laplacian_reflect_padding(Img<float, 2> *input,
+                                                    MemRef<float, 2> *output,
+                                                    float constantValue);
+
+void _mlir_ciface_corr_2d_laplacian_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, float constantValue);
+
+void _mlir_ciface_corr_2d_laplacian_wrap_padding(Img<float, 2> *input,
+                                                 MemRef<float, 2> *output,
+                                                 float constantValue);
+
+void _mlir_ciface_corr_2d_log_constant_padding(Img<float, 2> *input,
+                                               MemRef<float, 2> *output,
+                                               float constantValue);
+
+void _mlir_ciface_corr_2d_log_replicate_padding(Img<float, 2> *input,
+                                                MemRef<float, 2> *output,
+                                                float constantValue);
+
+void _mlir_ciface_corr_2d_log_reflect_padding(Img<float, 2> *input,
+                                              MemRef<float, 2> *output,
+                                              float constantValue);
+
+void _mlir_ciface_corr_2d_log_reflect_101_padding(Img<float, 2> *input,
+                                                  MemRef<float, 2> *output,
+                                                  float constantValue);
+
+void _mlir_ciface_corr_2d_log_wrap_padding(Img<float, 2> *input,
+                                           MemRef<float, 2> *output,
+                                           float constantValue);
+
+void _mlir_ciface_sep_corr_2d_constant_padding(
+    Img<float, 2> *input, MemRef<float, 1> *kernelX, MemRef<float, 1> *kernelY,
+    MemRef<float, 2> *output, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+void _mlir_ciface_sep_corr_2d_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 1> *kernelX, MemRef<float, 1> *kernelY,
+    MemRef<float, 2> *output, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+void _mlir_ciface_corrfft_2d(MemRef<float, 2> *input, MemRef<float, 2> *kernel,
+                             MemRef<float, 2> *output, unsigned int strideX,
+                             unsigned int strideY);
+
+void _mlir_ciface_rfft_2d(MemRef<float, 2> *input,
+                          MemRef<float, 2> *spectrumReal,
+                          MemRef<float, 2> *spectrumImag,
+                          MemRef<float, 2> *rowTwiddles,
+                          MemRef<float, 2> *colTwiddles);
+
+void _mlir_ciface_corrfft_2d_planned(
+    MemRef<float, 2> *input, MemRef<float, 2> *kernelReal,
+    MemRef<float, 2> *kernelImag, MemRef<float, 2> *rowTwiddles,
+    MemRef<float, 2> *colTwiddles, MemRef<float, 2> *output,
+    unsigned int strideX, unsigned int strideY);
 
 // Declare the Rotate2D C interface.
 void _mlir_ciface_rotate_2d(Img<float, 2> *input, float angleValue,
                             MemRef<float, 2> *output);
 
+void _mlir_ciface_rotate_2d_bilinear_interpolation(Img<float, 2> *input,
+                                                   float angleValue,
+                                                   MemRef<float, 2> *output);
+
+void _mlir_ciface_rotate_2d_bicubic_interpolation(Img<float, 2> *input,
+                                                  float angleValue,
+                                                  MemRef<float, 2> *output);
+
+void _mlir_ciface_rotate_2d_lanczos_interpolation(Img<float, 2> *input,
+                                                  float angleValue,
+                                                  MemRef<float, 2> *output);
+
 // Declare the Resize2D C interface.
 void _mlir_ciface_resize_2d_nearest_neighbour_interpolation(
     Img<float, 2> *input, float horizontalScalingFactor,
@@ -73,98 +247,648 @@ void _mlir_ciface_resize_2d_bilinear_interpolation(
     Img<float, 2> *input, float horizontalScalingFactor,
     float verticalScalingFactor, MemRef<float, 2> *output);
 
+void _mlir_ciface_resize_2d_bicubic_interpolation(
+    Img<float, 2> *input, float horizontalScalingFactor,
+    float verticalScalingFactor, MemRef<float, 2> *output);
+
+void _mlir_ciface_resize_2d_lanczos_interpolation(
+    Img<float, 2> *input, float horizontalScalingFactor,
+    float verticalScalingFactor, MemRef<float, 2> *output);
+
+void _mlir_ciface_resize_2d_area_interpolation(
+    Img<float, 2> *input, float horizontalScalingFactor,
+    float verticalScalingFactor, MemRef<float, 2> *output);
+
+// Declare the WarpAffine2D and WarpPerspective2D C interfaces.
+void _mlir_ciface_warp_affine_2d_nearest_neighbour_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_affine_2d_nearest_neighbour_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_affine_2d_bilinear_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_affine_2d_bilinear_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_affine_2d_bicubic_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_affine_2d_bicubic_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_affine_2d_lanczos_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_affine_2d_lanczos_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_nearest_neighbour_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_nearest_neighbour_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_bilinear_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_bilinear_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_bicubic_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_bicubic_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_lanczos_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_lanczos_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+// Declare the GaussianPyramid2D and LaplacianPyramid2D C interfaces, which
+// compute a single level.
+void _mlir_ciface_gaussian_pyramid_2d_constant_padding(
+    MemRef<float, 2> *input, MemRef<float, 2> *level);
+
+void _mlir_ciface_gaussian_pyramid_2d_replicate_padding(
+    MemRef<float, 2> *input, MemRef<float, 2> *level);
+
+void _mlir_ciface_laplacian_pyramid_2d_constant_padding(
+    MemRef<float, 2> *input, MemRef<float, 2> *laplacian,
+    MemRef<float, 2> *residual);
+
+void _mlir_ciface_laplacian_pyramid_2d_replicate_padding(
+    MemRef<float, 2> *input, MemRef<float, 2> *laplacian,
+    MemRef<float, 2> *residual);
+
+// Declare the IntegralImage2D and BoxFilter2D C interfaces.
+void _mlir_ciface_integral_image_2d(Img<float, 2> *input,
+                                    MemRef<double, 2> *sum);
+
+void _mlir_ciface_integral_image_2d_square(Img<float, 2> *input,
+                                           MemRef<double, 2> *sum,
+                                           MemRef<double, 2> *squareSum);
+
+void _mlir_ciface_box_filter_2d_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelWidth,
+    unsigned int kernelHeight, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+void _mlir_ciface_box_filter_2d_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelWidth,
+    unsigned int kernelHeight, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+// Declare the MedianBlur2D C interfaces.
+void _mlir_ciface_median_blur_2d_3x3_constant_padding(Img<float, 2> *input,
+                                                      MemRef<float, 2> *output,
+                                                      float constantValue);
+
+void _mlir_ciface_median_blur_2d_3x3_replicate_padding(Img<float, 2> *input,
+                                                       MemRef<float, 2> *output,
+                                                       float constantValue);
+
+void _mlir_ciface_median_blur_2d_3x3_reflect_padding(Img<float, 2> *input,
+                                                     MemRef<float, 2> *output,
+                                                     float constantValue);
+
+void _mlir_ciface_median_blur_2d_3x3_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, float constantValue);
+
+void _mlir_ciface_median_blur_2d_3x3_wrap_padding(Img<float, 2> *input,
+                                                  MemRef<float, 2> *output,
+                                                  float constantValue);
+
+void _mlir_ciface_median_blur_2d_5x5_constant_padding(Img<float, 2> *input,
+                                                      MemRef<float, 2> *output,
+                                                      float constantValue);
+
+void _mlir_ciface_median_blur_2d_5x5_replicate_padding(Img<float, 2> *input,
+                                                       MemRef<float, 2> *output,
+                                                       float constantValue);
+
+void _mlir_ciface_median_blur_2d_5x5_reflect_padding(Img<float, 2> *input,
+                                                     MemRef<float, 2> *output,
+                                                     float constantValue);
+
+void _mlir_ciface_median_blur_2d_5x5_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, float constantValue);
+
+void _mlir_ciface_median_blur_2d_5x5_wrap_padding(Img<float, 2> *input,
+                                                  MemRef<float, 2> *output,
+                                                  float constantValue);
+
+void _mlir_ciface_median_blur_2d_7x7_constant_padding(Img<float, 2> *input,
+                                                      MemRef<float, 2> *output,
+                                                      float constantValue);
+
+void _mlir_ciface_median_blur_2d_7x7_replicate_padding(Img<float, 2> *input,
+                                                       MemRef<float, 2> *output,
+                                                       float constantValue);
+
+void _mlir_ciface_median_blur_2d_7x7_reflect_padding(Img<float, 2> *input,
+                                                     MemRef<float, 2> *output,
+                                                     float constantValue);
+
+void _mlir_ciface_median_blur_2d_7x7_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, float constantValue);
+
+void _mlir_ciface_median_blur_2d_7x7_wrap_padding(Img<float, 2> *input,
+                                                  MemRef<float, 2> *output,
+                                                  float constantValue);
+
+// Declare the Gradient2D C interfaces.
+void _mlir_ciface_gradient_2d_sobel_l1_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_reflect_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_wrap_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_reflect_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_wrap_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_reflect_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_wrap_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_reflect_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_reflect_101_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_wrap_padding(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude,
+    MemRef<unsigned char, 2> *direction, float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_constant_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_replicate_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_reflect_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_reflect_101_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l1_wrap_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_constant_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_replicate_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_reflect_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_reflect_101_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_sobel_l2_wrap_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_constant_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_replicate_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_reflect_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_reflect_101_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l1_wrap_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_constant_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_replicate_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_reflect_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_reflect_101_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+void _mlir_ciface_gradient_2d_scharr_l2_wrap_padding_dxdy(
+    Img<float, 2> *input, MemRef<float, 2> *magnitude, MemRef<float, 2> *gx,
+    MemRef<float, 2> *gy, MemRef<unsigned char, 2> *direction,
+    float constantValue);
+
+// Declare the histogram, equalization and lookup table C interfaces.
+void _mlir_ciface_histogram_2d(Img<float, 2> *input, MemRef<int, 1> *hist,
+                               float low, float high);
+
+void _mlir_ciface_equalize_hist_2d(Img<float, 2> *input,
+                                   MemRef<float, 2> *output);
+
+void _mlir_ciface_clahe_2d(Img<float, 2> *input, MemRef<float, 2> *output,
+                           unsigned int tilesX, unsigned int tilesY,
+                           float clipLimit);
+
+void _mlir_ciface_lut_2d(Img<float, 2> *input, MemRef<float, 1> *lut,
+                         MemRef<float, 2> *output);
+
+// Declare the color conversion C interfaces.
+void _mlir_ciface_cvt_color_rgb2gray_nhwc(
+    MemRef<float, 4> *input, MemRef<float, 2> *output, float scale);
+
+void _mlir_ciface_cvt_color_rgb2gray_nchw(
+    MemRef<float, 4> *input, MemRef<float, 2> *output, float scale);
+
+void _mlir_ciface_cvt_color_rgb2yuv_nhwc(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_rgb2yuv_nchw(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_yuv2rgb_nhwc(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_yuv2rgb_nchw(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_rgb2hsv_nhwc(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_rgb2hsv_nchw(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_hsv2rgb_nhwc(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_hsv2rgb_nchw(
+    MemRef<float, 4> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_yuv2rgb_nv12_nhwc(
+    MemRef<unsigned char, 2> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_yuv2rgb_nv12_nchw(
+    MemRef<unsigned char, 2> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_yuv2rgb_i420_nhwc(
+    MemRef<unsigned char, 2> *input, MemRef<float, 4> *output, float scale);
+
+void _mlir_ciface_cvt_color_yuv2rgb_i420_nchw(
+    MemRef<unsigned char, 2> *input, MemRef<float, 4> *output, float scale);
+
+// Declare the fused resize and normalization C interfaces.
+void _mlir_ciface_resize_normalize_2d_u8(MemRef<unsigned char, 4> *input,
+                                         MemRef<float, 4> *batch,
+                                         intptr_t batchIndex, float scale,
+                                         MemRef<float, 1> *mean,
+                                         MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_resize_normalize_2d_f32(MemRef<float, 4> *input,
+                                          MemRef<float, 4> *batch,
+                                          intptr_t batchIndex, float scale,
+                                          MemRef<float, 1> *mean,
+                                          MemRef<float, 1> *stdDev);
+
 // Declare the Morphology 2D C interface.
 void _mlir_ciface_erosion_2d_constant_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_erosion_2d_replicate_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_erosion_2d_reflect_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_erosion_2d_reflect_101_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_erosion_2d_wrap_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_dilation_2d_constant_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_dilation_2d_replicate_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_dilation_2d_reflect_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_dilation_2d_reflect_101_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_dilation_2d_wrap_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_opening_2d_constant_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_opening_2d_replicate_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_opening_2d_reflect_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_opening_2d_reflect_101_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_opening_2d_wrap_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_closing_2d_constant_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_closing_2d_replicate_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_closing_2d_reflect_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_closing_2d_reflect_101_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_closing_2d_wrap_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_tophat_2d_constant_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *output2,
-    MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_tophat_2d_replicate_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *output2,
-    MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_tophat_2d_reflect_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_tophat_2d_reflect_101_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_tophat_2d_wrap_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_bottomhat_2d_constant_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *output2,
-    MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_bottomhat_2d_replicate_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *output2,
-    MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_bottomhat_2d_reflect_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_bottomhat_2d_reflect_101_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_bottomhat_2d_wrap_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_morphgrad_2d_constant_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *output2,
-    MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
 
 void _mlir_ciface_morphgrad_2d_replicate_padding(
     Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
-    MemRef<float, 2> *output1, MemRef<float, 2> *output2,
-    MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
-    MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
-    unsigned int iterations, float constantValue);
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_morphgrad_2d_reflect_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_morphgrad_2d_reflect_101_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+
+void _mlir_ciface_morphgrad_2d_wrap_padding(
+    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    unsigned int centerX, unsigned int centerY, unsigned int iterations,
+    float constantValue);
+}
+
+// Smallest FFT length >= n. Lengths whose only prime factors are 2, 3 and 5
+// are the cheapest for the mixed-radix transforms of dip.corrfft_2d.
+inline intptr_t fftLength(intptr_t n) {
+  for (intptr_t length = std::max<intptr_t>(n, 1);; ++length) {
+    intptr_t rest = length;
+    for (intptr_t radix : {2, 3, 5})
+      while (rest % radix == 0)
+        rest /= radix;
+    if (rest == 1)
+      return length;
+  }
+}
+
+// Whether the boundary option extrapolates from the image edge only. The
+// separable correlation, box filter, pyramids and warps support no others.
+inline bool isEdgeBoundary(BOUNDARY_OPTION option) {
+  return option == BOUNDARY_OPTION::CONSTANT_PADDING ||
+         option == BOUNDARY_OPTION::REPLICATE_PADDING;
+}
+
+// Index of the pixel that a non-constant boundary option reads at position p
+// of a row or column of len pixels, as cv::borderInterpolate.
+inline intptr_t borderInterpolate(intptr_t p, intptr_t len,
+                                  BOUNDARY_OPTION option) {
+  intptr_t period;
+  switch (option) {
+  case BOUNDARY_OPTION::WRAP_PADDING:
+    return (p % len + len) % len;
+  case BOUNDARY_OPTION::REFLECT_PADDING:
+    period = 2 * len;
+    p = (p % period + period) % period;
+    return p < len ? p : period - 1 - p;
+  case BOUNDARY_OPTION::REFLECT_101_PADDING:
+    period = std::max<intptr_t>(2 * len - 2, 1);
+    p = (p % period + period) % period;
+    return p < len ? p : period - p;
+  default:
+    return std::min(std::max<intptr_t>(p, 0), len - 1);
+  }
 }
 
 // Pad kernel as per the requirements for using FFT in convolution.
 inline void padKernel(MemRef<float, 2> *kernel, unsigned int centerX,
                       unsigned int centerY, intptr_t *paddedSizes,
-                      MemRef<float, 2> *kernelPaddedReal) {
+                      MemRef<float, 2> *kernelPadded) {
   // Apply padding so that the center of kernel is at top left of 2D padded
   // container.
   for (long i = -static_cast<long>(centerY);
@@ -173,13 +897,95 @@ inline void padKernel(MemRef<float, 2> *kernel, unsigned int centerX,
     for (long j = -static_cast<long>(centerX);
          j < static_cast<long>(kernel->getSizes()[1]) - centerX; ++j) {
       uint32_t c = (j < 0) ? (j + paddedSizes[1]) : j;
-      kernelPaddedReal->getData()[r * paddedSizes[1] + c] =
+      kernelPadded->getData()[r * paddedSizes[1] + c] =
           kernel
               ->getData()[(i + centerY) * kernel->getSizes()[1] + j + centerX];
     }
   }
 }
 
+// Pad input image as per the requirements for using FFT in correlation.
+inline void padInput(Img<float, 2> *input, intptr_t *kernelSizes,
+                     unsigned int centerX, unsigned int centerY,
+                     intptr_t *paddedSizes, BOUNDARY_OPTION option,
+                     float constantValue, MemRef<float, 2> *inputPadded) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+    for (uint32_t i = 0; i < paddedSizes[0]; ++i) {
+      for (uint32_t j = 0; j < paddedSizes[1]; ++j) {
+        if (i < input->getSizes()[0] && j < input->getSizes()[1])
+          inputPadded->getData()[i * paddedSizes[1] + j] =
+              input->getData()[i * input->getSizes()[1] + j];
+        else
+          inputPadded->getData()[i * paddedSizes[1] + j] = constantValue;
+      }
+    }
+  } else {
+    // The taps below / right of the anchor read the rows / columns directly
+    // past the image, the taps above / left of it the ones wrapping around
+    // from the end of the padded container, i.e. at negative positions.
+    intptr_t rows = input->getSizes()[0];
+    intptr_t cols = input->getSizes()[1];
+    for (intptr_t i = 0; i < paddedSizes[0]; ++i) {
+      intptr_t r = borderInterpolate(
+          (i < rows + kernelSizes[0] - 1 - centerY) ? i : i - paddedSizes[0],
+          rows, option);
+      for (intptr_t j = 0; j < paddedSizes[1]; ++j) {
+        intptr_t c = borderInterpolate(
+            (j < cols + kernelSizes[1] - 1 - centerX) ? j : j - paddedSizes[1],
+            cols, option);
+        inputPadded->getData()[i * paddedSizes[1] + j] =
+            input->getData()[r * cols + c];
+      }
+    }
+  }
+}
+
+// Fill a [2, n] twiddle table with cos(2 * pi * t / n) and -sin(2 * pi * t /
+// n). The angles are evaluated in double precision.
+inline void fftTwiddles(MemRef<float, 2> *twiddles) {
+  intptr_t n = twiddles->getSizes()[1];
+  for (intptr_t t = 0; t < n; ++t) {
+    double angle = 2 * M_PI * t / n;
+    twiddles->getData()[t] = std::cos(angle);
+    twiddles->getData()[n + t] = -std::sin(angle);
+  }
+}
+
+// Factorize a rank-1 kernel as kernel[i][j] = kernelY[i] * kernelX[j]. The
+// factor sizes must match the kernel rows / columns. Returns false, leaving
+// the factors unspecified, if the kernel is not separable.
+inline bool factorizeKernel(MemRef<float, 2> *kernel,
+                            MemRef<float, 1> *kernelX,
+                            MemRef<float, 1> *kernelY) {
+  intptr_t rows = kernel->getSizes()[0];
+  intptr_t cols = kernel->getSizes()[1];
+  const float *data = kernel->getData();
+
+  // Use the row and column of the largest element as the factors.
+  intptr_t pivot = 0;
+  for (intptr_t i = 1; i < rows * cols; ++i)
+    if (std::fabs(data[i]) > std::fabs(data[pivot]))
+      pivot = i;
+  float maxAbs = std::fabs(data[pivot]);
+  if (maxAbs == 0)
+    return false;
+
+  intptr_t pivotRow = pivot / cols;
+  intptr_t pivotCol = pivot % cols;
+  for (intptr_t j = 0; j < cols; ++j)
+    kernelX->getData()[j] = data[pivotRow * cols + j];
+  for (intptr_t i = 0; i < rows; ++i)
+    kernelY->getData()[i] = data[i * cols + pivotCol] / data[pivot];
+
+  for (intptr_t i = 0; i < rows; ++i)
+    for (intptr_t j = 0; j < cols; ++j)
+      if (std::fabs(data[i * cols + j] -
+                    kernelY->getData()[i] * kernelX->getData()[j]) >
+          1e-5f * maxAbs)
+        return false;
+  return true;
+}
+
 // Helper function for applying 2D resize operation on images.
 inline MemRef<float, 2> Resize2D_Impl(Img<float, 2> *input,
                                       INTERPOLATION_TYPE type,
@@ -193,113 +999,286 @@ inline MemRef<float, 2> Resize2D_Impl(Img<float, 2> *input,
   } else if (type == INTERPOLATION_TYPE::BILINEAR_INTERPOLATION) {
     detail::_mlir_ciface_resize_2d_bilinear_interpolation(
         input, scalingRatios[0], scalingRatios[1], &output);
+  } else if (type == INTERPOLATION_TYPE::BICUBIC_INTERPOLATION) {
+    detail::_mlir_ciface_resize_2d_bicubic_interpolation(
+        input, scalingRatios[0], scalingRatios[1], &output);
+  } else if (type == INTERPOLATION_TYPE::LANCZOS_INTERPOLATION) {
+    detail::_mlir_ciface_resize_2d_lanczos_interpolation(
+        input, scalingRatios[0], scalingRatios[1], &output);
   } else {
-    throw std::invalid_argument(
-        "Please chose a supported type of interpolation "
-        "(Nearest neighbour interpolation or Bilinear interpolation)\n");
+    detail::_mlir_ciface_resize_2d_area_interpolation(
+        input, scalingRatios[0], scalingRatios[1], &output);
   }
 
   return output;
 }
+
+// Cost model of the correlation paths in nanoseconds. The direct kernels
+// take directPerTap per output pixel and kernel tap, the FFT path fftPerPoint
+// per padded point and bit of the padded area. Both depend on the vector
+// width BuddyLibDIP was built with, so the defaults are replaced by the table
+// of the machine when BUDDY_DIP_CORRELATION_COST names one. Such a table is
+// written by the dip-correlation-cost target.
+struct CorrelationCost {
+  double directPerTap = 0.25;
+  double fftPerPoint = 4.0;
+};
+
+// Read a cost table. Lines starting with '#' are comments, the others hold a
+// path name ("direct" or "fft") and its coefficient.
+inline CorrelationCost loadCorrelationCost(const char *path) {
+  CorrelationCost cost;
+  std::ifstream table(path);
+  std::string line;
+  while (std::getline(table, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    std::istringstream fields(line);
+    std::string name;
+    double value;
+    if (!(fields >> name >> value))
+      continue;
+    if (name == "direct")
+      cost.directPerTap = value;
+    else if (name == "fft")
+      cost.fftPerPoint = value;
+  }
+  return cost;
+}
+
+inline const CorrelationCost &correlationCost() {
+  static const CorrelationCost cost = [] {
+    const char *path = std::getenv("BUDDY_DIP_CORRELATION_COST");
+    return path ? loadCorrelationCost(path) : CorrelationCost();
+  }();
+  return cost;
+}
+
+// Whether the FFT path is predicted to be faster than a direct correlation
+// with `taps` multiply-adds per output pixel.
+inline bool fftIsCheaper(intptr_t rows, intptr_t cols, intptr_t kernelRows,
+                         intptr_t kernelCols, intptr_t taps) {
+  const CorrelationCost &cost = correlationCost();
+  double direct = cost.directPerTap * rows * cols * taps;
+  double points = double(fftLength(rows + kernelRows - 1)) *
+                  fftLength(cols + kernelCols - 1);
+  return cost.fftPerPoint * points * std::log2(points) < direct;
+}
+
+using Corr2DFunc = void (*)(Img<float, 2> *, MemRef<float, 2> *,
+                            MemRef<float, 2> *, unsigned int, unsigned int,
+                            float);
+using FixedCorr2DFunc = void (*)(Img<float, 2> *, MemRef<float, 2> *, float);
 } // namespace detail
 
+// User interface for 2D Correlation with a separable kernel, given as its
+// column factor kernelY and row factor kernelX.
+inline void SepCorr2D(Img<float, 2> *input, MemRef<float, 1> *kernelX,
+                      MemRef<float, 1> *kernelY, MemRef<float, 2> *output,
+                      unsigned int centerX, unsigned int centerY,
+                      BOUNDARY_OPTION option, float constantValue = 0) {
+  if (!detail::isEdgeBoundary(option))
+    throw std::invalid_argument("SepCorr2D supports only constant and "
+                                "replicate padding.\n");
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+    detail::_mlir_ciface_sep_corr_2d_constant_padding(
+        input, kernelX, kernelY, output, centerX, centerY, constantValue);
+  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+    detail::_mlir_ciface_sep_corr_2d_replicate_padding(
+        input, kernelX, kernelY, output, centerX, centerY, 0);
+  }
+}
+
 // User interface for 2D Correlation.
 inline void Corr2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
                    MemRef<float, 2> *output, unsigned int centerX,
                    unsigned int centerY, BOUNDARY_OPTION option,
                    float constantValue = 0) {
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_corr_2d_constant_padding(
-        input, kernel, output, centerX, centerY, constantValue);
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_corr_2d_replicate_padding(input, kernel, output,
-                                                   centerX, centerY, 0);
+  // Rank-1 kernels go through the separable path when its two passes
+  // (kernelRows + kernelCols taps per pixel, plus the traffic of the
+  // intermediate buffer) are clearly cheaper than the full kernel, i.e. from
+  // 5x5 upwards. The separable path extrapolates from the image edge only.
+  intptr_t kernelRows = kernel->getSizes()[0];
+  intptr_t kernelCols = kernel->getSizes()[1];
+  if (detail::isEdgeBoundary(option) &&
+      kernelRows * kernelCols > 2 * (kernelRows + kernelCols)) {
+    MemRef<float, 1> kernelX(&kernelCols);
+    MemRef<float, 1> kernelY(&kernelRows);
+    if (detail::factorizeKernel(kernel, &kernelX, &kernelY)) {
+      SepCorr2D(input, &kernelX, &kernelY, output, centerX, centerY, option,
+                constantValue);
+      return;
+    }
+  }
+
+  static const detail::Corr2DFunc funcs[5] = {
+      detail::_mlir_ciface_corr_2d_constant_padding,
+      detail::_mlir_ciface_corr_2d_replicate_padding,
+      detail::_mlir_ciface_corr_2d_reflect_padding,
+      detail::_mlir_ciface_corr_2d_reflect_101_padding,
+      detail::_mlir_ciface_corr_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  constantValue);
+}
+
+// User interface for 2D Correlation with a fixed kernel, anchored at its
+// center. The taps are unrolled when the library is built, so zero
+// coefficients cost nothing. As with Corr2D, the result is added to output.
+inline void Corr2D(Img<float, 2> *input, MemRef<float, 2> *output,
+                   FIXED_KERNEL kernel, BOUNDARY_OPTION option,
+                   float constantValue = 0) {
+  static const detail::FixedCorr2DFunc funcs[5][5] = {
+      {detail::_mlir_ciface_corr_2d_prewitt_constant_padding,
+       detail::_mlir_ciface_corr_2d_prewitt_replicate_padding,
+       detail::_mlir_ciface_corr_2d_prewitt_reflect_padding,
+       detail::_mlir_ciface_corr_2d_prewitt_reflect_101_padding,
+       detail::_mlir_ciface_corr_2d_prewitt_wrap_padding},
+      {detail::_mlir_ciface_corr_2d_sobel_3x3_constant_padding,
+       detail::_mlir_ciface_corr_2d_sobel_3x3_replicate_padding,
+       detail::_mlir_ciface_corr_2d_sobel_3x3_reflect_padding,
+       detail::_mlir_ciface_corr_2d_sobel_3x3_reflect_101_padding,
+       detail::_mlir_ciface_corr_2d_sobel_3x3_wrap_padding},
+      {detail::_mlir_ciface_corr_2d_sobel_5x5_constant_padding,
+       detail::_mlir_ciface_corr_2d_sobel_5x5_replicate_padding,
+       detail::_mlir_ciface_corr_2d_sobel_5x5_reflect_padding,
+       detail::_mlir_ciface_corr_2d_sobel_5x5_reflect_101_padding,
+       detail::_mlir_ciface_corr_2d_sobel_5x5_wrap_padding},
+      {detail::_mlir_ciface_corr_2d_laplacian_constant_padding,
+       detail::_mlir_ciface_corr_2d_laplacian_replicate_padding,
+       detail::_mlir_ciface_corr_2d_laplacian_reflect_padding,
+       detail::_mlir_ciface_corr_2d_laplacian_reflect_101_padding,
+       detail::_mlir_ciface_corr_2d_laplacian_wrap_padding},
+      {detail::_mlir_ciface_corr_2d_log_constant_padding,
+       detail::_mlir_ciface_corr_2d_log_replicate_padding,
+       detail::_mlir_ciface_corr_2d_log_reflect_padding,
+       detail::_mlir_ciface_corr_2d_log_reflect_101_padding,
+       detail::_mlir_ciface_corr_2d_log_wrap_padding}};
+  funcs[static_cast<int>(kernel)][static_cast<int>(option)](input, output,
+                                                            constantValue);
+}
+
+// FFT correlation of rows x cols images with a fixed kernel. The kernel
+// spectrum and the twiddle tables are computed once, when the plan is built,
+// and reused by every execute() call.
+class CorrFFT2DPlan {
+public:
+  CorrFFT2DPlan(intptr_t rows, intptr_t cols, MemRef<float, 2> *kernel,
+                unsigned int centerX, unsigned int centerY,
+                BOUNDARY_OPTION option, float constantValue = 0)
+      : centerX(centerX), centerY(centerY), option(option),
+        constantValue(constantValue),
+        kernelSizes{kernel->getSizes()[0], kernel->getSizes()[1]},
+        paddedSizes{detail::fftLength(rows + kernel->getSizes()[0] - 1),
+                    detail::fftLength(cols + kernel->getSizes()[1] - 1)},
+        inputPadded(std::vector<size_t>{size_t(paddedSizes[0]),
+                                        size_t(paddedSizes[1])}),
+        kernelReal(std::vector<size_t>{size_t(paddedSizes[0]),
+                                       size_t(paddedSizes[1] / 2 + 1)}),
+        kernelImag(std::vector<size_t>{size_t(paddedSizes[0]),
+                                       size_t(paddedSizes[1] / 2 + 1)}),
+        rowTwiddles(std::vector<size_t>{2, size_t(paddedSizes[1])}),
+        colTwiddles(std::vector<size_t>{2, size_t(paddedSizes[0])}) {
+    detail::fftTwiddles(&rowTwiddles);
+    detail::fftTwiddles(&colTwiddles);
+
+    intptr_t kernelRows = kernel->getSizes()[0];
+    intptr_t kernelCols = kernel->getSizes()[1];
+    intptr_t flippedKernelSizes[2] = {kernelRows, kernelCols};
+    MemRef<float, 2> flippedKernel(flippedKernelSizes);
+    for (intptr_t i = 0; i < kernelRows; ++i)
+      for (intptr_t j = 0; j < kernelCols; ++j)
+        flippedKernel.getData()[i * kernelCols + j] =
+            kernel->getData()[(kernelRows - 1 - i) * kernelCols +
+                              kernelCols - 1 - j];
+
+    MemRef<float, 2> kernelPadded(paddedSizes);
+    detail::padKernel(&flippedKernel, centerX, centerY, paddedSizes,
+                      &kernelPadded);
+    detail::_mlir_ciface_rfft_2d(&kernelPadded, &kernelReal, &kernelImag,
+                                 &rowTwiddles, &colTwiddles);
   }
+
+  // output[i][j] is the correlation at [i * strideY][j * strideX], so the
+  // output should have ceil(rows / strideY) x ceil(cols / strideX) elements.
+  void execute(Img<float, 2> *input, MemRef<float, 2> *output,
+               unsigned int strideX = 1, unsigned int strideY = 1) {
+    detail::padInput(input, kernelSizes, centerX, centerY, paddedSizes,
+                     option, constantValue, &inputPadded);
+    detail::_mlir_ciface_corrfft_2d_planned(
+        &inputPadded, &kernelReal, &kernelImag, &rowTwiddles, &colTwiddles,
+        output, strideX, strideY);
+  }
+
+private:
+  unsigned int centerX;
+  unsigned int centerY;
+  BOUNDARY_OPTION option;
+  float constantValue;
+  intptr_t kernelSizes[2];
+  intptr_t paddedSizes[2];
+  MemRef<float, 2> inputPadded;
+  MemRef<float, 2> kernelReal;
+  MemRef<float, 2> kernelImag;
+  MemRef<float, 2> rowTwiddles;
+  MemRef<float, 2> colTwiddles;
+};
+
+// Strided 2D correlation using FFT. output[i][j] is the correlation at
+// [i * strideY][j * strideX], so the output should have
+// ceil(rows / strideY) x ceil(cols / strideX) elements. Use CorrFFT2DPlan
+// directly to apply one kernel to many images.
+inline void CorrFFT2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
+                      MemRef<float, 2> *output, unsigned int centerX,
+                      unsigned int centerY, unsigned int strideX,
+                      unsigned int strideY, BOUNDARY_OPTION option,
+                      float constantValue = 0) {
+  CorrFFT2DPlan plan(input->getSizes()[0], input->getSizes()[1], kernel,
+                     centerX, centerY, option, constantValue);
+  plan.execute(input, output, strideX, strideY);
 }
 
 inline void CorrFFT2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
                       MemRef<float, 2> *output, unsigned int centerX,
                       unsigned int centerY, BOUNDARY_OPTION option,
                       float constantValue = 0) {
-  // Calculate padding sizes.
-  intptr_t paddedSizes[2] = {
-      1 << static_cast<intptr_t>(
-          ceil(log2(input->getSizes()[0] + kernel->getSizes()[0] - 1))),
-      1 << static_cast<intptr_t>(
-          ceil(log2(input->getSizes()[1] + kernel->getSizes()[1] - 1)))};
-  intptr_t paddedTSizes[2] = {paddedSizes[1], paddedSizes[0]};
-
-  // Declare padded containers for input image and kernel.
-  // Also declare an intermediate container for calculation convenience.
-  MemRef<float, 2> inputPaddedReal(paddedSizes);
-  MemRef<float, 2> inputPaddedImag(paddedSizes);
-
-  MemRef<float, 2> kernelPaddedReal(paddedSizes);
-  MemRef<float, 2> kernelPaddedImag(paddedSizes);
-
-  MemRef<float, 2> intermediateReal(paddedTSizes);
-  MemRef<float, 2> intermediateImag(paddedTSizes);
-
-  intptr_t flippedKernelSizeRows = kernel->getSizes()[0];
-  intptr_t flippedKernelSizeCols = kernel->getSizes()[1];
-  intptr_t flippedKernelSizes[2] = {flippedKernelSizeRows,
-                                    flippedKernelSizeCols};
-  MemRef<float, 2> flippedKernel(flippedKernelSizes);
-
-  for (uint32_t i = 0; i < kernel->getSizes()[0]; ++i)
-    for (uint32_t j = 0; j < kernel->getSizes()[1]; ++j) {
-      flippedKernel.getData()[i * kernel->getSizes()[1] + j] =
-          kernel->getData()[(kernel->getSizes()[0] - 1 - i) *
-                                kernel->getSizes()[1] +
-                            kernel->getSizes()[1] - 1 - j];
-    }
+  CorrFFT2D(input, kernel, output, centerX, centerY, 1, 1, option,
+            constantValue);
+}
 
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    for (uint32_t i = 0; i < paddedSizes[0]; ++i) {
-      for (uint32_t j = 0; j < paddedSizes[1]; ++j) {
-        if (i < input->getSizes()[0] && j < input->getSizes()[1])
-          inputPaddedReal.getData()[i * paddedSizes[1] + j] =
-              input->getData()[i * input->getSizes()[1] + j];
-        else
-          inputPaddedReal.getData()[i * paddedSizes[1] + j] = constantValue;
-      }
-    }
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    for (uint32_t i = 0; i < paddedSizes[0]; ++i) {
-      uint32_t r = (i < input->getSizes()[0])
-                       ? i
-                       : ((i < input->getSizes()[0] + centerY)
-                              ? (input->getSizes()[0] - 1)
-                              : 0);
-      for (uint32_t j = 0; j < paddedSizes[1]; ++j) {
-        uint32_t c = (j < input->getSizes()[1])
-                         ? j
-                         : ((j < input->getSizes()[1] + centerX)
-                                ? (input->getSizes()[1] - 1)
-                                : 0);
-        inputPaddedReal.getData()[i * paddedSizes[1] + j] =
-            input->getData()[r * input->getSizes()[1] + c];
-      }
-    }
+// User interface for 2D Correlation that picks the faster of Corr2D (with its
+// separable path) and CorrFFT2D from the cost model above. Unlike Corr2D, the
+// output is overwritten instead of accumulated into.
+inline void Correlation2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
+                          MemRef<float, 2> *output, unsigned int centerX,
+                          unsigned int centerY, BOUNDARY_OPTION option,
+                          float constantValue = 0) {
+  intptr_t rows = input->getSizes()[0];
+  intptr_t cols = input->getSizes()[1];
+  intptr_t kernelRows = kernel->getSizes()[0];
+  intptr_t kernelCols = kernel->getSizes()[1];
+
+  // Count the taps of the path Corr2D would take.
+  intptr_t taps = kernelRows * kernelCols;
+  if (detail::isEdgeBoundary(option) && taps > 2 * (kernelRows + kernelCols)) {
+    MemRef<float, 1> kernelX(&kernelCols);
+    MemRef<float, 1> kernelY(&kernelRows);
+    if (detail::factorizeKernel(kernel, &kernelX, &kernelY))
+      taps = kernelRows + kernelCols;
   }
 
-  // Obtain padded kernel.
-  detail::padKernel(&flippedKernel, centerX, centerY, paddedSizes,
-                    &kernelPaddedReal);
-
-  detail::_mlir_ciface_corrfft_2d(&inputPaddedReal, &inputPaddedImag,
-                                  &kernelPaddedReal, &kernelPaddedImag,
-                                  &intermediateReal, &intermediateImag);
-
-  for (uint32_t i = 0; i < output->getSizes()[0]; ++i)
-    for (uint32_t j = 0; j < output->getSizes()[1]; ++j)
-      output->getData()[i * output->getSizes()[1] + j] =
-          inputPaddedReal.getData()[i * paddedSizes[1] + j];
+  if (detail::fftIsCheaper(rows, cols, kernelRows, kernelCols, taps)) {
+    CorrFFT2D(input, kernel, output, centerX, centerY, option, constantValue);
+    return;
+  }
+  std::fill(output->getData(), output->getData() + rows * cols, 0.0f);
+  Corr2D(input, kernel, output, centerX, centerY, option, constantValue);
 }
 
-// User interface for 2D Rotation.
-inline MemRef<float, 2> Rotate2D(Img<float, 2> *input, float angle,
-                                 ANGLE_TYPE angleType) {
+// User interface for 2D Rotation. Pixels outside of the rotated input are 0.
+inline MemRef<float, 2>
+Rotate2D(Img<float, 2> *input, float angle, ANGLE_TYPE angleType,
+         INTERPOLATION_TYPE type =
+             INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION) {
   float angleRad;
 
   if (angleType == ANGLE_TYPE::DEGREE)
@@ -318,7 +1297,20 @@ inline MemRef<float, 2> Rotate2D(Img<float, 2> *input, float angle,
   intptr_t sizesOutput[2] = {outputRows, outputCols};
   MemRef<float, 2> output(sizesOutput);
 
-  detail::_mlir_ciface_rotate_2d(input, angleRad, &output);
+  if (type == INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION)
+    detail::_mlir_ciface_rotate_2d(input, angleRad, &output);
+  else if (type == INTERPOLATION_TYPE::BILINEAR_INTERPOLATION)
+    detail::_mlir_ciface_rotate_2d_bilinear_interpolation(input, angleRad,
+                                                          &output);
+  else if (type == INTERPOLATION_TYPE::BICUBIC_INTERPOLATION)
+    detail::_mlir_ciface_rotate_2d_bicubic_interpolation(input, angleRad,
+                                                         &output);
+  else if (type == INTERPOLATION_TYPE::LANCZOS_INTERPOLATION)
+    detail::_mlir_ciface_rotate_2d_lanczos_interpolation(input, angleRad,
+                                                         &output);
+  else
+    throw std::invalid_argument("Rotate2D does not support area "
+                                "interpolation.\n");
 
   return output;
 }
@@ -362,154 +1354,557 @@ inline MemRef<float, 2> Resize2D(Img<float, 2> *input, INTERPOLATION_TYPE type,
   return detail::Resize2D_Impl(input, type, scalingRatios, outputSize);
 }
 
-inline void Erosion2D(Img<float, 2> input, MemRef<float, 2> *kernel,
-                      MemRef<float, 2> *output, unsigned int centerX,
-                      unsigned int centerY, unsigned int iterations,
-                      BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
-  MemRef<float, 2> copymemref(sizesOutput, 256.f);
+namespace detail {
+using Warp2DFunc = void (*)(Img<float, 2> *, MemRef<float, 2> *,
+                            MemRef<float, 2> *, float);
+
+// Pick the C interface of a warp by interpolation and boundary option.
+inline Warp2DFunc warp2DFunc(const Warp2DFunc funcs[8], INTERPOLATION_TYPE type,
+                             BOUNDARY_OPTION option) {
+  if (type == INTERPOLATION_TYPE::AREA_INTERPOLATION)
+    throw std::invalid_argument("Warps do not support area interpolation.\n");
+  if (!isEdgeBoundary(option))
+    throw std::invalid_argument(
+        "Warps support only constant and replicate padding.\n");
+  return funcs[2 * static_cast<int>(type) + static_cast<int>(option)];
+}
+} // namespace detail
+
+// User interface for 2D affine warps. The 2x3 matrix maps input to output
+// coordinates, as the matrix of cv::warpAffine, and the sizes of output give
+// the size of the result. With CONSTANT_PADDING, pixels mapped outside of the
+// input read constantValue.
+inline void WarpAffine2D(Img<float, 2> *input, MemRef<float, 2> *matrix,
+                         MemRef<float, 2> *output, INTERPOLATION_TYPE type,
+                         BOUNDARY_OPTION option, float constantValue = 0) {
+  if (matrix->getSizes()[0] != 2 || matrix->getSizes()[1] != 3)
+    throw std::invalid_argument("The affine matrix must be 2x3.\n");
+  static const detail::Warp2DFunc funcs[8] = {
+      detail::_mlir_ciface_warp_affine_2d_nearest_neighbour_constant_padding,
+      detail::_mlir_ciface_warp_affine_2d_nearest_neighbour_replicate_padding,
+      detail::_mlir_ciface_warp_affine_2d_bilinear_constant_padding,
+      detail::_mlir_ciface_warp_affine_2d_bilinear_replicate_padding,
+      detail::_mlir_ciface_warp_affine_2d_bicubic_constant_padding,
+      detail::_mlir_ciface_warp_affine_2d_bicubic_replicate_padding,
+      detail::_mlir_ciface_warp_affine_2d_lanczos_constant_padding,
+      detail::_mlir_ciface_warp_affine_2d_lanczos_replicate_padding};
+  detail::warp2DFunc(funcs, type, option)(input, matrix, output,
+                                          constantValue);
+}
+
+// User interface for 2D perspective warps. The 3x3 matrix maps input to
+// output coordinates, as the matrix of cv::warpPerspective. Everything else
+// works as for WarpAffine2D.
+inline void WarpPerspective2D(Img<float, 2> *input, MemRef<float, 2> *matrix,
+                              MemRef<float, 2> *output, INTERPOLATION_TYPE type,
+                              BOUNDARY_OPTION option,
+                              float constantValue = 0) {
+  if (matrix->getSizes()[0] != 3 || matrix->getSizes()[1] != 3)
+    throw std::invalid_argument("The perspective matrix must be 3x3.\n");
+  static const detail::Warp2DFunc funcs[8] = {
+      detail::_mlir_ciface_warp_perspective_2d_nearest_neighbour_constant_padding,
+      detail::_mlir_ciface_warp_perspective_2d_nearest_neighbour_replicate_padding,
+      detail::_mlir_ciface_warp_perspective_2d_bilinear_constant_padding,
+      detail::_mlir_ciface_warp_perspective_2d_bilinear_replicate_padding,
+      detail::_mlir_ciface_warp_perspective_2d_bicubic_constant_padding,
+      detail::_mlir_ciface_warp_perspective_2d_bicubic_replicate_padding,
+      detail::_mlir_ciface_warp_perspective_2d_lanczos_constant_padding,
+      detail::_mlir_ciface_warp_perspective_2d_lanczos_replicate_padding};
+  detail::warp2DFunc(funcs, type, option)(input, matrix, output,
+                                          constantValue);
+}
+
+namespace detail {
+// Check that `level` has the size of the next pyramid level of `finer`.
+inline void checkPyramidLevel(MemRef<float, 2> *finer,
+                              MemRef<float, 2> *level) {
+  if (level->getSizes()[0] != (finer->getSizes()[0] + 1) / 2 ||
+      level->getSizes()[1] != (finer->getSizes()[1] + 1) / 2)
+    throw std::invalid_argument(
+        "Every pyramid level must be ((rows + 1) / 2) x ((cols + 1) / 2) of "
+        "the previous one.\n");
+}
+} // namespace detail
+
+// User interface for 2D Gaussian pyramids. levels[i] receives level i + 1 of
+// the pyramid of input, as cv::pyrDown applied i + 1 times. The caller
+// allocates the levels with the sizes checked by detail::checkPyramidLevel.
+inline void GaussianPyramid2D(Img<float, 2> *input,
+                              const std::vector<MemRef<float, 2> *> &levels,
+                              BOUNDARY_OPTION option) {
+  if (!detail::isEdgeBoundary(option))
+    throw std::invalid_argument(
+        "Pyramids support only constant and replicate padding.\n");
+  MemRef<float, 2> *source = input;
+  for (MemRef<float, 2> *level : levels) {
+    detail::checkPyramidLevel(source, level);
+    if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+      detail::_mlir_ciface_gaussian_pyramid_2d_constant_padding(source, level);
+    else
+      detail::_mlir_ciface_gaussian_pyramid_2d_replicate_padding(source,
+                                                                 level);
+    source = level;
+  }
+}
+
+// User interface for 2D Laplacian pyramids. levels[i] receives level i of the
+// Laplacian pyramid of input for all but the last entry, which receives the
+// coarsest Gaussian level, so that the pyramid has levels.size() - 1
+// Laplacian levels. Sizes work as for GaussianPyramid2D.
+inline void LaplacianPyramid2D(Img<float, 2> *input,
+                               const std::vector<MemRef<float, 2> *> &levels,
+                               BOUNDARY_OPTION option) {
+  if (levels.size() < 2)
+    throw std::invalid_argument(
+        "A Laplacian pyramid needs a level and a residual.\n");
+  if (!detail::isEdgeBoundary(option))
+    throw std::invalid_argument(
+        "Pyramids support only constant and replicate padding.\n");
+  // Each call leaves Gaussian level i + 1 in levels[i + 1], from which the
+  // next call computes the Laplacian level in place.
+  MemRef<float, 2> *source = input;
+  for (size_t i = 0; i + 1 < levels.size(); ++i) {
+    if (levels[i]->getSizes()[0] != source->getSizes()[0] ||
+        levels[i]->getSizes()[1] != source->getSizes()[1])
+      throw std::invalid_argument(
+          "A Laplacian level must have the size of its Gaussian level.\n");
+    detail::checkPyramidLevel(source, levels[i + 1]);
+    if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+      detail::_mlir_ciface_laplacian_pyramid_2d_constant_padding(
+          source, levels[i], levels[i + 1]);
+    else
+      detail::_mlir_ciface_laplacian_pyramid_2d_replicate_padding(
+          source, levels[i], levels[i + 1]);
+    source = levels[i + 1];
+  }
+}
 
+// User interface for 2D integral images. sum and, if given, squareSum must be
+// (rows + 1) x (cols + 1) and receive the sums of the input pixels and of
+// their squares above and left of each position, as cv::integral.
+inline void IntegralImage2D(Img<float, 2> *input, MemRef<double, 2> *sum,
+                            MemRef<double, 2> *squareSum = nullptr) {
+  for (MemRef<double, 2> *table : {sum, squareSum}) {
+    if (table && (table->getSizes()[0] != input->getSizes()[0] + 1 ||
+                  table->getSizes()[1] != input->getSizes()[1] + 1))
+      throw std::invalid_argument(
+          "Integral images must be (rows + 1) x (cols + 1).\n");
+  }
+  if (squareSum)
+    detail::_mlir_ciface_integral_image_2d_square(input, sum, squareSum);
+  else
+    detail::_mlir_ciface_integral_image_2d(input, sum);
+}
+
+// User interface for 2D box filters. Every output pixel is the mean of the
+// kernelWidth x kernelHeight window whose anchor (centerX, centerY) lies on
+// it, as cv::blur, at a cost that does not depend on the window size.
+inline void BoxFilter2D(Img<float, 2> *input, MemRef<float, 2> *output,
+                        unsigned int kernelWidth, unsigned int kernelHeight,
+                        unsigned int centerX, unsigned int centerY,
+                        BOUNDARY_OPTION option, float constantValue = 0) {
+  if (kernelWidth == 0 || kernelHeight == 0 || centerX >= kernelWidth ||
+      centerY >= kernelHeight)
+    throw std::invalid_argument(
+        "The anchor must lie inside of a non-empty box.\n");
+  if (!detail::isEdgeBoundary(option))
+    throw std::invalid_argument(
+        "BoxFilter2D supports only constant and replicate padding.\n");
   if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_erosion_2d_constant_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations,
+    detail::_mlir_ciface_box_filter_2d_constant_padding(
+        input, output, kernelWidth, kernelHeight, centerX, centerY,
         constantValue);
   } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_erosion_2d_replicate_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations, 0);
+    detail::_mlir_ciface_box_filter_2d_replicate_padding(
+        input, output, kernelWidth, kernelHeight, centerX, centerY, 0);
   }
 }
 
+namespace detail {
+using MedianBlur2DFunc = void (*)(Img<float, 2> *, MemRef<float, 2> *, float);
+} // namespace detail
+
+// User interface for 2D median filters. Every output pixel is the median of
+// the kernelSize x kernelSize window centered on it, as cv::medianBlur.
+inline void MedianBlur2D(Img<float, 2> *input, MemRef<float, 2> *output,
+                         unsigned int kernelSize, BOUNDARY_OPTION option,
+                         float constantValue = 0) {
+  static const detail::MedianBlur2DFunc funcs[3][5] = {
+      {detail::_mlir_ciface_median_blur_2d_3x3_constant_padding,
+       detail::_mlir_ciface_median_blur_2d_3x3_replicate_padding,
+       detail::_mlir_ciface_median_blur_2d_3x3_reflect_padding,
+       detail::_mlir_ciface_median_blur_2d_3x3_reflect_101_padding,
+       detail::_mlir_ciface_median_blur_2d_3x3_wrap_padding},
+      {detail::_mlir_ciface_median_blur_2d_5x5_constant_padding,
+       detail::_mlir_ciface_median_blur_2d_5x5_replicate_padding,
+       detail::_mlir_ciface_median_blur_2d_5x5_reflect_padding,
+       detail::_mlir_ciface_median_blur_2d_5x5_reflect_101_padding,
+       detail::_mlir_ciface_median_blur_2d_5x5_wrap_padding},
+      {detail::_mlir_ciface_median_blur_2d_7x7_constant_padding,
+       detail::_mlir_ciface_median_blur_2d_7x7_replicate_padding,
+       detail::_mlir_ciface_median_blur_2d_7x7_reflect_padding,
+       detail::_mlir_ciface_median_blur_2d_7x7_reflect_101_padding,
+       detail::_mlir_ciface_median_blur_2d_7x7_wrap_padding}};
+  if (kernelSize != 3 && kernelSize != 5 && kernelSize != 7)
+    throw std::invalid_argument(
+        "MedianBlur2D supports kernel sizes 3, 5 and 7.\n");
+  funcs[kernelSize / 2 - 1][static_cast<int>(option)](input, output,
+                                                      constantValue);
+}
+
+namespace detail {
+using Gradient2DFunc = void (*)(Img<float, 2> *, MemRef<float, 2> *,
+                                MemRef<unsigned char, 2> *, float);
+using Gradient2DDerivativesFunc =
+    void (*)(Img<float, 2> *, MemRef<float, 2> *, MemRef<float, 2> *,
+             MemRef<float, 2> *, MemRef<unsigned char, 2> *, float);
+} // namespace detail
+
+// User interface for 2D gradients. The magnitude of the Sobel or Scharr
+// derivatives and the direction of the gradient, quantized to the four
+// sectors 0 (horizontal), 1 (diagonal with gx and gy of the same sign), 2
+// (vertical) and 3 (the other diagonal), are computed in a single pass, as
+// the first steps of a Canny edge detector.
+inline void Gradient2D(Img<float, 2> *input, MemRef<float, 2> *magnitude,
+                       MemRef<unsigned char, 2> *direction,
+                       GRADIENT_OPERATOR gradientOperator, GRADIENT_NORM norm,
+                       BOUNDARY_OPTION option, float constantValue = 0) {
+  static const detail::Gradient2DFunc funcs[2][2][5] = {
+      {{detail::_mlir_ciface_gradient_2d_sobel_l1_constant_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_replicate_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_reflect_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_reflect_101_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_wrap_padding},
+       {detail::_mlir_ciface_gradient_2d_sobel_l2_constant_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_replicate_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_reflect_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_reflect_101_padding,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_wrap_padding}},
+      {{detail::_mlir_ciface_gradient_2d_scharr_l1_constant_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_replicate_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_reflect_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_reflect_101_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_wrap_padding},
+       {detail::_mlir_ciface_gradient_2d_scharr_l2_constant_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_replicate_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_reflect_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_reflect_101_padding,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_wrap_padding}}};
+  funcs[static_cast<int>(gradientOperator)][static_cast<int>(norm)]
+       [static_cast<int>(option)](input, magnitude, direction, constantValue);
+}
+
+// As above, and writes the derivatives to gx and gy as well.
+inline void Gradient2D(Img<float, 2> *input, MemRef<float, 2> *magnitude,
+                       MemRef<float, 2> *gx, MemRef<float, 2> *gy,
+                       MemRef<unsigned char, 2> *direction,
+                       GRADIENT_OPERATOR gradientOperator, GRADIENT_NORM norm,
+                       BOUNDARY_OPTION option, float constantValue = 0) {
+  static const detail::Gradient2DDerivativesFunc funcs[2][2][5] = {
+      {{detail::_mlir_ciface_gradient_2d_sobel_l1_constant_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_replicate_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_reflect_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_reflect_101_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l1_wrap_padding_dxdy},
+       {detail::_mlir_ciface_gradient_2d_sobel_l2_constant_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_replicate_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_reflect_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_reflect_101_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_sobel_l2_wrap_padding_dxdy}},
+      {{detail::_mlir_ciface_gradient_2d_scharr_l1_constant_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_replicate_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_reflect_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_reflect_101_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l1_wrap_padding_dxdy},
+       {detail::_mlir_ciface_gradient_2d_scharr_l2_constant_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_replicate_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_reflect_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_reflect_101_padding_dxdy,
+        detail::_mlir_ciface_gradient_2d_scharr_l2_wrap_padding_dxdy}}};
+  funcs[static_cast<int>(gradientOperator)][static_cast<int>(norm)]
+       [static_cast<int>(option)](input, magnitude, gx, gy, direction,
+                                  constantValue);
+}
+
+// User interface for 2D histograms. The bins of hist split [low, high)
+// evenly and receive the number of input pixels they hold, as cv::calcHist
+// with a uniform range; pixels outside of the range are not counted.
+inline void Histogram2D(Img<float, 2> *input, MemRef<int, 1> *hist, float low,
+                        float high) {
+  if (hist->getSizes()[0] == 0 || !(low < high))
+    throw std::invalid_argument(
+        "A histogram needs bins and a non-empty range.\n");
+  detail::_mlir_ciface_histogram_2d(input, hist, low, high);
+}
+
+// User interface for histogram equalization of images with values in
+// [0, 256), as cv::equalizeHist.
+inline void EqualizeHist2D(Img<float, 2> *input, MemRef<float, 2> *output) {
+  if (output->getSizes()[0] != input->getSizes()[0] ||
+      output->getSizes()[1] != input->getSizes()[1])
+    throw std::invalid_argument(
+        "The output must have the size of the input.\n");
+  detail::_mlir_ciface_equalize_hist_2d(input, output);
+}
+
+// User interface for contrast limited adaptive histogram equalization of
+// images with values in [0, 256), with the defaults of cv::createCLAHE.
+inline void CLAHE2D(Img<float, 2> *input, MemRef<float, 2> *output,
+                    float clipLimit = 40, unsigned int tilesX = 8,
+                    unsigned int tilesY = 8) {
+  if (tilesX == 0 || tilesY == 0)
+    throw std::invalid_argument("CLAHE needs at least one tile.\n");
+  if (output->getSizes()[0] != input->getSizes()[0] ||
+      output->getSizes()[1] != input->getSizes()[1])
+    throw std::invalid_argument(
+        "The output must have the size of the input.\n");
+  detail::_mlir_ciface_clahe_2d(input, output, tilesX, tilesY, clipLimit);
+}
+
+// User interface for lookup tables: every output pixel is lut[int(pixel)],
+// with the index clamped to the table, as cv::LUT.
+inline void LUT2D(Img<float, 2> *input, MemRef<float, 1> *lut,
+                  MemRef<float, 2> *output) {
+  if (lut->getSizes()[0] == 0)
+    throw std::invalid_argument("The lookup table must not be empty.\n");
+  if (output->getSizes()[0] != input->getSizes()[0] ||
+      output->getSizes()[1] != input->getSizes()[1])
+    throw std::invalid_argument(
+        "The output must have the size of the input.\n");
+  detail::_mlir_ciface_lut_2d(input, lut, output);
+}
+
+namespace detail {
+typedef void (*ColorConversionFunc)(MemRef<float, 4> *, MemRef<float, 4> *,
+                                    float);
+
+// Tells an NHWC color image from an NCHW one, and checks that it has three
+// channels.
+inline bool isNHWC(MemRef<float, 4> *image) {
+  if (image->getSizes()[3] == 3)
+    return true;
+  if (image->getSizes()[1] != 3)
+    throw std::invalid_argument(
+        "Color images must be NHWC or NCHW with 3 channels.\n");
+  return false;
+}
+} // namespace detail
+
+// User interface for conversions between color images, as cv::cvtColor on
+// float images. Input and output are NHWC or NCHW images of the same size
+// and layout, and the input pixels are multiplied by scale before the
+// conversion. YUV conversions expect channels in [0, 1] after scaling, and
+// HSV hues are in degrees.
+inline void CvtColor(MemRef<float, 4> *input, MemRef<float, 4> *output,
+                     COLOR_CONVERSION code, float scale = 1) {
+  bool nhwc = detail::isNHWC(input);
+  for (int i = 0; i < 4; ++i)
+    if (output->getSizes()[i] != input->getSizes()[i])
+      throw std::invalid_argument(
+          "The output must have the size and layout of the input.\n");
+  static const detail::ColorConversionFunc funcs[8] = {
+      detail::_mlir_ciface_cvt_color_rgb2yuv_nhwc,
+      detail::_mlir_ciface_cvt_color_rgb2yuv_nchw,
+      detail::_mlir_ciface_cvt_color_yuv2rgb_nhwc,
+      detail::_mlir_ciface_cvt_color_yuv2rgb_nchw,
+      detail::_mlir_ciface_cvt_color_rgb2hsv_nhwc,
+      detail::_mlir_ciface_cvt_color_rgb2hsv_nchw,
+      detail::_mlir_ciface_cvt_color_hsv2rgb_nhwc,
+      detail::_mlir_ciface_cvt_color_hsv2rgb_nchw};
+  funcs[2 * static_cast<int>(code) + (nhwc ? 0 : 1)](input, output, scale);
+}
+
+// User interface for RGB to gray conversion of a single NHWC or NCHW image,
+// as cv::cvtColor. The input pixels are multiplied by scale.
+inline void RGBToGray(MemRef<float, 4> *input, MemRef<float, 2> *output,
+                      float scale = 1) {
+  bool nhwc = detail::isNHWC(input);
+  intptr_t rows = input->getSizes()[nhwc ? 1 : 2];
+  intptr_t cols = input->getSizes()[nhwc ? 2 : 3];
+  if (input->getSizes()[0] != 1 || output->getSizes()[0] != rows ||
+      output->getSizes()[1] != cols)
+    throw std::invalid_argument(
+        "The output must have the size of the single input image.\n");
+  if (nhwc)
+    detail::_mlir_ciface_cvt_color_rgb2gray_nhwc(input, output, scale);
+  else
+    detail::_mlir_ciface_cvt_color_rgb2gray_nchw(input, output, scale);
+}
+
+// User interface for YUV 4:2:0 to RGB conversion, as cv::cvtColor with
+// COLOR_YUV2RGB_NV12 or COLOR_YUV2RGB_I420. The u8 frame is
+// (3 * rows / 2) x cols for even rows and cols and the output a single NHWC
+// or NCHW image. The default scale normalizes the result to [0, 1] in the
+// same pass.
+inline void YUV420ToRGB(MemRef<unsigned char, 2> *frame,
+                        MemRef<float, 4> *output, YUV420_FORMAT format,
+                        float scale = 1.0f / 255) {
+  bool nhwc = detail::isNHWC(output);
+  intptr_t rows = output->getSizes()[nhwc ? 1 : 2];
+  intptr_t cols = output->getSizes()[nhwc ? 2 : 3];
+  if (rows % 2 != 0 || cols % 2 != 0 || output->getSizes()[0] != 1 ||
+      frame->getSizes()[0] != rows * 3 / 2 || frame->getSizes()[1] != cols)
+    throw std::invalid_argument(
+        "A YUV 4:2:0 frame must be (3 * rows / 2) x cols of a single image "
+        "with even sizes.\n");
+  if (format == YUV420_FORMAT::NV12) {
+    if (nhwc)
+      detail::_mlir_ciface_cvt_color_yuv2rgb_nv12_nhwc(frame, output, scale);
+    else
+      detail::_mlir_ciface_cvt_color_yuv2rgb_nv12_nchw(frame, output, scale);
+  } else {
+    if (nhwc)
+      detail::_mlir_ciface_cvt_color_yuv2rgb_i420_nhwc(frame, output, scale);
+    else
+      detail::_mlir_ciface_cvt_color_yuv2rgb_i420_nchw(frame, output, scale);
+  }
+}
+
+namespace detail {
+// Checks that the input is a single NHWC RGB image and batchIndex an image
+// of the NCHW batch.
+inline void checkModelInput(const intptr_t *inputSizes,
+                            MemRef<float, 4> *batch, intptr_t batchIndex) {
+  if (inputSizes[0] != 1 || inputSizes[3] != 3)
+    throw std::invalid_argument("The input must be a single NHWC image.\n");
+  if (batch->getSizes()[1] != 3 || batchIndex < 0 ||
+      batchIndex >= batch->getSizes()[0])
+    throw std::invalid_argument(
+        "The batch must be NCHW with 3 channels and hold batchIndex.\n");
+}
+} // namespace detail
+
+// User interface for preparing image batchIndex of the NCHW input batch of a
+// model from an NHWC RGB image, e.g. a camera frame: the image is resized to
+// the rows and columns of the batch with bilinear interpolation, as
+// cv::resize with INTER_LINEAR, and every channel c is normalized to
+// (pixel * scale - mean[c]) / stdDev[c], all in one pass. The default scale
+// maps u8 pixels to [0, 1] first.
+inline void ResizeNormalize2D(MemRef<unsigned char, 4> *input,
+                              MemRef<float, 4> *batch, intptr_t batchIndex,
+                              const float mean[3], const float stdDev[3],
+                              float scale = 1.0f / 255) {
+  detail::checkModelInput(input->getSizes(), batch, batchIndex);
+  intptr_t channels = 3;
+  MemRef<float, 1> meanMemRef(mean, &channels);
+  MemRef<float, 1> stdMemRef(stdDev, &channels);
+  detail::_mlir_ciface_resize_normalize_2d_u8(input, batch, batchIndex, scale,
+                                              &meanMemRef, &stdMemRef);
+}
+
+inline void ResizeNormalize2D(MemRef<float, 4> *input, MemRef<float, 4> *batch,
+                              intptr_t batchIndex, const float mean[3],
+                              const float stdDev[3], float scale = 1) {
+  detail::checkModelInput(input->getSizes(), batch, batchIndex);
+  intptr_t channels = 3;
+  MemRef<float, 1> meanMemRef(mean, &channels);
+  MemRef<float, 1> stdMemRef(stdDev, &channels);
+  detail::_mlir_ciface_resize_normalize_2d_f32(input, batch, batchIndex, scale,
+                                               &meanMemRef, &stdMemRef);
+}
+
+namespace detail {
+using Morph2DFunc = void (*)(Img<float, 2>, MemRef<float, 2> *,
+                             MemRef<float, 2> *, unsigned int, unsigned int,
+                             unsigned int, float);
+} // namespace detail
+
+inline void Erosion2D(Img<float, 2> input, MemRef<float, 2> *kernel,
+                      MemRef<float, 2> *output, unsigned int centerX,
+                      unsigned int centerY, unsigned int iterations,
+                      BOUNDARY_OPTION option, float constantValue = 0) {
+  static const detail::Morph2DFunc funcs[5] = {
+      detail::_mlir_ciface_erosion_2d_constant_padding,
+      detail::_mlir_ciface_erosion_2d_replicate_padding,
+      detail::_mlir_ciface_erosion_2d_reflect_padding,
+      detail::_mlir_ciface_erosion_2d_reflect_101_padding,
+      detail::_mlir_ciface_erosion_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  iterations, constantValue);
+}
+
 inline void Dilation2D(Img<float, 2> input, MemRef<float, 2> *kernel,
                        MemRef<float, 2> *output, unsigned int centerX,
                        unsigned int centerY, unsigned int iterations,
                        BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
-  MemRef<float, 2> copymemref(sizesOutput, -1.f);
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_dilation_2d_constant_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations,
-        constantValue);
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_dilation_2d_replicate_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations, 0);
-  }
+  static const detail::Morph2DFunc funcs[5] = {
+      detail::_mlir_ciface_dilation_2d_constant_padding,
+      detail::_mlir_ciface_dilation_2d_replicate_padding,
+      detail::_mlir_ciface_dilation_2d_reflect_padding,
+      detail::_mlir_ciface_dilation_2d_reflect_101_padding,
+      detail::_mlir_ciface_dilation_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  iterations, constantValue);
 }
 
 inline void Opening2D(Img<float, 2> input, MemRef<float, 2> *kernel,
                       MemRef<float, 2> *output, unsigned int centerX,
                       unsigned int centerY, unsigned int iterations,
                       BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
-  MemRef<float, 2> output1(sizesOutput);
-  MemRef<float, 2> copymemref(sizesOutput, 256.f);
-  MemRef<float, 2> copymemref1(sizesOutput, -1.f);
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_opening_2d_constant_padding(
-        input, kernel, output, &output1, &copymemref, &copymemref1, centerX,
-        centerY, iterations, constantValue);
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_opening_2d_replicate_padding(
-        input, kernel, output, &output1, &copymemref, &copymemref1, centerX,
-        centerY, iterations, 0);
-  }
+  static const detail::Morph2DFunc funcs[5] = {
+      detail::_mlir_ciface_opening_2d_constant_padding,
+      detail::_mlir_ciface_opening_2d_replicate_padding,
+      detail::_mlir_ciface_opening_2d_reflect_padding,
+      detail::_mlir_ciface_opening_2d_reflect_101_padding,
+      detail::_mlir_ciface_opening_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  iterations, constantValue);
 }
 
 inline void Closing2D(Img<float, 2> input, MemRef<float, 2> *kernel,
                       MemRef<float, 2> *output, unsigned int centerX,
                       unsigned int centerY, unsigned int iterations,
                       BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
-  MemRef<float, 2> output1(sizesOutput);
-  MemRef<float, 2> copymemref(sizesOutput, -1.f);
-  MemRef<float, 2> copymemref1(sizesOutput, 256.f);
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_closing_2d_constant_padding(
-        input, kernel, output, &output1, &copymemref, &copymemref1, centerX,
-        centerY, iterations, constantValue);
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_closing_2d_replicate_padding(
-        input, kernel, output, &output1, &copymemref, &copymemref1, centerX,
-        centerY, iterations, 0);
-  }
+  static const detail::Morph2DFunc funcs[5] = {
+      detail::_mlir_ciface_closing_2d_constant_padding,
+      detail::_mlir_ciface_closing_2d_replicate_padding,
+      detail::_mlir_ciface_closing_2d_reflect_padding,
+      detail::_mlir_ciface_closing_2d_reflect_101_padding,
+      detail::_mlir_ciface_closing_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  iterations, constantValue);
 }
 
 inline void TopHat2D(Img<float, 2> input, MemRef<float, 2> *kernel,
                      MemRef<float, 2> *output, unsigned int centerX,
                      unsigned int centerY, unsigned int iterations,
                      BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
-  MemRef<float, 2> output1(sizesOutput);
-  MemRef<float, 2> output2(sizesOutput);
-  MemRef<float, 2> input1(sizesOutput);
-  MemRef<float, 2> copymemref(sizesOutput, 256.f);
-  MemRef<float, 2> copymemref1(sizesOutput, -1.f);
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_tophat_2d_constant_padding(
-        input, kernel, output, &output1, &output2, &input1, &copymemref,
-        &copymemref1, centerX, centerY, iterations, constantValue);
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_tophat_2d_replicate_padding(
-        input, kernel, output, &output1, &output2, &input1, &copymemref,
-        &copymemref1, centerX, centerY, iterations, 0);
-  }
+  static const detail::Morph2DFunc funcs[5] = {
+      detail::_mlir_ciface_tophat_2d_constant_padding,
+      detail::_mlir_ciface_tophat_2d_replicate_padding,
+      detail::_mlir_ciface_tophat_2d_reflect_padding,
+      detail::_mlir_ciface_tophat_2d_reflect_101_padding,
+      detail::_mlir_ciface_tophat_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  iterations, constantValue);
 }
 
 inline void BottomHat2D(Img<float, 2> input, MemRef<float, 2> *kernel,
                         MemRef<float, 2> *output, unsigned int centerX,
                         unsigned int centerY, unsigned int iterations,
                         BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
-  MemRef<float, 2> output1(sizesOutput);
-  MemRef<float, 2> output2(sizesOutput);
-  MemRef<float, 2> input1(sizesOutput);
-  MemRef<float, 2> copymemref(sizesOutput, -1.f);
-  MemRef<float, 2> copymemref1(sizesOutput, 256.f);
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_bottomhat_2d_constant_padding(
-        input, kernel, output, &output1, &output2, &input1, &copymemref,
-        &copymemref1, centerX, centerY, iterations, constantValue);
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_bottomhat_2d_replicate_padding(
-        input, kernel, output, &output1, &output2, &input1, &copymemref,
-        &copymemref1, centerX, centerY, iterations, 0);
-  }
+  static const detail::Morph2DFunc funcs[5] = {
+      detail::_mlir_ciface_bottomhat_2d_constant_padding,
+      detail::_mlir_ciface_bottomhat_2d_replicate_padding,
+      detail::_mlir_ciface_bottomhat_2d_reflect_padding,
+      detail::_mlir_ciface_bottomhat_2d_reflect_101_padding,
+      detail::_mlir_ciface_bottomhat_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  iterations, constantValue);
 }
 
 inline void MorphGrad2D(Img<float, 2> input, MemRef<float, 2> *kernel,
                         MemRef<float, 2> *output, unsigned int centerX,
                         unsigned int centerY, unsigned int iterations,
                         BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
-  MemRef<float, 2> output1(sizesOutput);
-  MemRef<float, 2> output2(sizesOutput);
-  MemRef<float, 2> input1(sizesOutput);
-  MemRef<float, 2> copymemref(sizesOutput, -1.f);
-  MemRef<float, 2> copymemref1(sizesOutput, 256.f);
-  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    detail::_mlir_ciface_morphgrad_2d_constant_padding(
-        input, kernel, output, &output1, &output2, &input1, &copymemref,
-        &copymemref1, centerX, centerY, iterations, constantValue);
-  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    detail::_mlir_ciface_morphgrad_2d_replicate_padding(
-        input, kernel, output, &output1, &output2, &input1, &copymemref,
-        &copymemref1, centerX, centerY, iterations, 0);
-  }
+  static const detail::Morph2DFunc funcs[5] = {
+      detail::_mlir_ciface_morphgrad_2d_constant_padding,
+      detail::_mlir_ciface_morphgrad_2d_replicate_padding,
+      detail::_mlir_ciface_morphgrad_2d_reflect_padding,
+      detail::_mlir_ciface_morphgrad_2d_reflect_101_padding,
+      detail::_mlir_ciface_morphgrad_2d_wrap_padding};
+  funcs[static_cast<int>(option)](input, kernel, output, centerX, centerY,
+                                  iterations, constantValue);
 }
 } // namespace dip
 
@@ -32,3 +32,78 @@ func.func @buddy_biquad(%in : memref<?xf32>, %filter : memref<?xf32>, %out : mem
   dap.biquad %in, %filter, %out : memref<?xf32>, memref<?xf32>, memref<?xf32>
   return
 }
+
+func.func @buddy_biquad_multichannel(%in : memref<?x?xf32>, %filter : memref<?xf32>, %out : memref<?x?xf32>) -> () {
+  dap.biquad %in, %filter, %out : memref<?x?xf32>, memref<?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_iir_multichannel(%in : memref<?x?xf32>, %filter : memref<?x?xf32>, %out : memref<?x?xf32>) -> () {
+  dap.iir %in, %filter, %out : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_fir_f64(%in : memref<?xf64>, %filter : memref<?xf64>, %out : memref<?xf64>) -> () {
+  dap.fir %in, %filter, %out : memref<?xf64>, memref<?xf64>, memref<?xf64>
+  return
+}
+
+func.func @buddy_iir_f64(%in : memref<?xf64>, %filter : memref<?x?xf64>, %out : memref<?xf64>) -> () {
+  dap.iir %in, %filter, %out : memref<?xf64>, memref<?x?xf64>, memref<?xf64>
+  return
+}
+
+func.func @buddy_biquad_f64(%in : memref<?xf64>, %filter : memref<?xf64>, %out : memref<?xf64>) -> () {
+  dap.biquad %in, %filter, %out : memref<?xf64>, memref<?xf64>, memref<?xf64>
+  return
+}
+
+func.func @buddy_fir_f16(%in : memref<?xf16>, %filter : memref<?xf16>, %out : memref<?xf16>) -> () {
+  dap.fir %in, %filter, %out : memref<?xf16>, memref<?xf16>, memref<?xf16>
+  return
+}
+
+func.func @buddy_iir_f16(%in : memref<?xf16>, %filter : memref<?x?xf16>, %out : memref<?xf16>) -> () {
+  dap.iir %in, %filter, %out : memref<?xf16>, memref<?x?xf16>, memref<?xf16>
+  return
+}
+
+func.func @buddy_biquad_f16(%in : memref<?xf16>, %filter : memref<?xf16>, %out : memref<?xf16>) -> () {
+  dap.biquad %in, %filter, %out : memref<?xf16>, memref<?xf16>, memref<?xf16>
+  return
+}
+
+func.func @buddy_fir_q15(%in : memref<?xi16>, %filter : memref<?xi16>, %out : memref<?xi16>) -> () {
+  dap.fir %in, %filter, %out : memref<?xi16>, memref<?xi16>, memref<?xi16>
+  return
+}
+
+func.func @buddy_iir_q15(%in : memref<?xi16>, %filter : memref<?x?xi16>, %out : memref<?xi16>) -> () {
+  dap.iir %in, %filter, %out : memref<?xi16>, memref<?x?xi16>, memref<?xi16>
+  return
+}
+
+func.func @buddy_biquad_q15(%in : memref<?xi16>, %filter : memref<?xi16>, %out : memref<?xi16>) -> () {
+  dap.biquad %in, %filter, %out : memref<?xi16>, memref<?xi16>, memref<?xi16>
+  return
+}
+
+func.func @buddy_stft(%in : memref<?xf32>, %window : memref<?xf32>, %hop : index, %outReal : memref<?x?xf32>, %outImag : memref<?x?xf32>) -> () {
+  dap.stft %in, %window, %hop, %outReal, %outImag : memref<?xf32>, memref<?xf32>, index, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_mel_filterbank(%real : memref<?x?xf32>, %imag : memref<?x?xf32>, %filterbank : memref<?x?xf32>, %out : memref<?x?xf32>) -> () {
+  dap.mel_filterbank %real, %imag, %filterbank, %out : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_mfcc(%mel : memref<?x?xf32>, %dct : memref<?x?xf32>, %out : memref<?x?xf32>) -> () {
+  dap.mfcc %mel, %dct, %out : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_resample(%in : memref<?xf32>, %kernel : memref<?x?xf32>, %out : memref<?xf32>, %down : index, %start : index) -> () {
+  dap.resample %in, %kernel, %out, %down, %start : memref<?xf32>, memref<?x?xf32>, memref<?xf32>, index, index
+  return
+}
@@ -30,15 +30,302 @@ func.func @corr_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : me
   return
 }
 
-func.func @corrfft_2d(%inputImageReal : memref<?x?xf32>, %inputImageImag : memref<?x?xf32>, %kernelReal : memref<?x?xf32>, %kernelImag : memref<?x?xf32>, %intermediateReal : memref<?x?xf32>, %intermediateImag : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+func.func @corr_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.corrfft_2d %inputImageReal, %inputImageImag, %kernelReal, %kernelImag, %intermediateReal, %intermediateImag : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  dip.corr_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY , %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY , %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY , %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+// The kernels of examples/kernels.h. dip.corr_2d unrolls the taps of
+// constant kernels at compile time.
+
+memref.global "private" constant @prewitt_kernel : memref<3x3xf32> = dense<[[-1., 0., 1.],
+                                                                            [-1., 0., 1.],
+                                                                            [-1., 0., 1.]]>
+
+memref.global "private" constant @sobel_3x3_kernel : memref<3x3xf32> = dense<[[1., 0., -1.],
+                                                                              [2., 0., -2.],
+                                                                              [1., 0., -1.]]>
+
+memref.global "private" constant @sobel_5x5_kernel : memref<5x5xf32> = dense<[[2., 1., 0., -1., -2.],
+                                                                              [3., 2., 0., -2., -3.],
+                                                                              [4., 3., 0., -3., -4.],
+                                                                              [3., 2., 0., -2., -3.],
+                                                                              [2., 1., 0., -1., -2.]]>
+
+memref.global "private" constant @laplacian_kernel : memref<3x3xf32> = dense<[[1., 1., 1.],
+                                                                              [1., -8., 1.],
+                                                                              [1., 1., 1.]]>
+
+memref.global "private" constant @log_kernel : memref<5x5xf32> = dense<[[0., 0., 1., 0., 0.],
+                                                                        [0., 1., 2., 1., 0.],
+                                                                        [1., 2., -16., 2., 1.],
+                                                                        [0., 1., 2., 1., 0.],
+                                                                        [0., 0., 1., 0., 0.]]>
+
+func.func @corr_2d_prewitt_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @prewitt_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_prewitt_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @prewitt_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_prewitt_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @prewitt_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_prewitt_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @prewitt_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_prewitt_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @prewitt_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_3x3_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_3x3_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_3x3_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_3x3_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_3x3_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_3x3_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_3x3_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_3x3_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_3x3_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_3x3_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_5x5_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_5x5_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_5x5_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_5x5_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_5x5_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_5x5_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_5x5_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_5x5_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_sobel_5x5_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @sobel_5x5_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_laplacian_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @laplacian_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_laplacian_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @laplacian_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_laplacian_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @laplacian_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_laplacian_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @laplacian_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_laplacian_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @laplacian_kernel : memref<3x3xf32>
+  %center = arith.constant 1 : index
+  dip.corr_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_log_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @log_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_log_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @log_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_log_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @log_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_log_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @log_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_log_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  %kernel = memref.get_global @log_kernel : memref<5x5xf32>
+  %center = arith.constant 2 : index
+  dip.corr_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %center, %center, %constantValue : memref<?x?xf32>, memref<5x5xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @sep_corr_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernelX : memref<?xf32>, %kernelY : memref<?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.sep_corr_2d <CONSTANT_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?xf32>, memref<?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @sep_corr_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernelX : memref<?xf32>, %kernelY : memref<?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.sep_corr_2d <REPLICATE_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?xf32>, memref<?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corrfft_2d(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %strideX : index, %strideY : index) attributes{llvm.emit_c_interface}
+{
+  dip.corrfft_2d %inputImage, %kernel, %outputImage, %strideX, %strideY : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index
+  return
+}
+
+func.func @rfft_2d(%input : memref<?x?xf32>, %spectrumReal : memref<?x?xf32>, %spectrumImag : memref<?x?xf32>, %rowTwiddles : memref<?x?xf32>, %colTwiddles : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.rfft_2d %input, %spectrumReal, %spectrumImag, %rowTwiddles, %colTwiddles : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @corrfft_2d_planned(%inputImage : memref<?x?xf32>, %kernelReal : memref<?x?xf32>, %kernelImag : memref<?x?xf32>, %rowTwiddles : memref<?x?xf32>, %colTwiddles : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %strideX : index, %strideY : index) attributes{llvm.emit_c_interface}
+{
+  dip.corrfft_2d_planned %inputImage, %kernelReal, %kernelImag, %rowTwiddles, %colTwiddles, %outputImage, %strideX, %strideY : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index
   return
 }
 
 func.func @rotate_2d(%inputImage : memref<?x?xf32>, %angle : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
 {
-  dip.rotate_2d %inputImage, %angle, %outputImage : memref<?x?xf32>, f32, memref<?x?xf32>
+  dip.rotate_2d NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %angle, %outputImage : memref<?x?xf32>, f32, memref<?x?xf32>
+  return
+}
+
+func.func @rotate_2d_bilinear_interpolation(%inputImage : memref<?x?xf32>, %angle : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.rotate_2d BILINEAR_INTERPOLATION %inputImage, %angle, %outputImage : memref<?x?xf32>, f32, memref<?x?xf32>
+  return
+}
+
+func.func @rotate_2d_bicubic_interpolation(%inputImage : memref<?x?xf32>, %angle : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.rotate_2d BICUBIC_INTERPOLATION %inputImage, %angle, %outputImage : memref<?x?xf32>, f32, memref<?x?xf32>
+  return
+}
+
+func.func @rotate_2d_lanczos_interpolation(%inputImage : memref<?x?xf32>, %angle : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.rotate_2d LANCZOS_INTERPOLATION %inputImage, %angle, %outputImage : memref<?x?xf32>, f32, memref<?x?xf32>
   return
 }
 
@@ -54,86 +341,824 @@ func.func @resize_2d_bilinear_interpolation(%inputImage : memref<?x?xf32>, %hori
   return
 }
 
-func.func @erosion_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
+func.func @resize_2d_bicubic_interpolation(%inputImage : memref<?x?xf32>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BICUBIC_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xf32>, f32, f32, memref<?x?xf32>
+  return
+}
+
+func.func @resize_2d_lanczos_interpolation(%inputImage : memref<?x?xf32>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d LANCZOS_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xf32>, f32, f32, memref<?x?xf32>
+  return
+}
+
+func.func @resize_2d_area_interpolation(%inputImage : memref<?x?xf32>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d AREA_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xf32>, f32, f32, memref<?x?xf32>
+  return
+}
+
+func.func @warp_affine_2d_nearest_neighbour_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d NEAREST_NEIGHBOUR_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_nearest_neighbour_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d NEAREST_NEIGHBOUR_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_bilinear_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d BILINEAR_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_bilinear_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d BILINEAR_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_bicubic_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d BICUBIC_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_bicubic_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d BICUBIC_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_lanczos_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d LANCZOS_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_lanczos_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<2x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d LANCZOS_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_nearest_neighbour_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d NEAREST_NEIGHBOUR_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_nearest_neighbour_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d NEAREST_NEIGHBOUR_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_bilinear_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d BILINEAR_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_bilinear_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d BILINEAR_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_bicubic_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d BICUBIC_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_bicubic_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d BICUBIC_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_lanczos_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d LANCZOS_INTERPOLATION <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_lanczos_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<3x3xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d LANCZOS_INTERPOLATION <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<3x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gaussian_pyramid_2d_constant_padding(%inputImage : memref<?x?xf32>, %level : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.gaussian_pyramid_2d <CONSTANT_PADDING> %inputImage, %level : memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @gaussian_pyramid_2d_replicate_padding(%inputImage : memref<?x?xf32>, %level : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.gaussian_pyramid_2d <REPLICATE_PADDING> %inputImage, %level : memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @laplacian_pyramid_2d_constant_padding(%inputImage : memref<?x?xf32>, %laplacian : memref<?x?xf32>, %residual : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.laplacian_pyramid_2d <CONSTANT_PADDING> %inputImage, %laplacian, %residual : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @laplacian_pyramid_2d_replicate_padding(%inputImage : memref<?x?xf32>, %laplacian : memref<?x?xf32>, %residual : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.laplacian_pyramid_2d <REPLICATE_PADDING> %inputImage, %laplacian, %residual : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @integral_image_2d(%inputImage : memref<?x?xf32>, %sum : memref<?x?xf64>) attributes{llvm.emit_c_interface}
+{
+  dip.integral_image_2d %inputImage, %sum : memref<?x?xf32>, memref<?x?xf64>
+  return
+}
+
+func.func @integral_image_2d_square(%inputImage : memref<?x?xf32>, %sum : memref<?x?xf64>, %squareSum : memref<?x?xf64>) attributes{llvm.emit_c_interface}
+{
+  dip.integral_image_2d %inputImage, %sum, %squareSum : memref<?x?xf32>, memref<?x?xf64>, memref<?x?xf64>
+  return
+}
+
+func.func @box_filter_2d_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelWidth : index, %kernelHeight : index, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.box_filter_2d <CONSTANT_PADDING> %inputImage, %outputImage, %kernelWidth, %kernelHeight, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, index, index, index, f32
+  return
+}
+
+func.func @box_filter_2d_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelWidth : index, %kernelHeight : index, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.box_filter_2d <REPLICATE_PADDING> %inputImage, %outputImage, %kernelWidth, %kernelHeight, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, index, index, index, f32
+  return
+}
+
+func.func @median_blur_2d_3x3_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <CONSTANT_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 3} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_3x3_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REPLICATE_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 3} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_3x3_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REFLECT_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 3} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_3x3_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REFLECT_101_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 3} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_3x3_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <WRAP_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 3} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_5x5_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <CONSTANT_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 5} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_5x5_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REPLICATE_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 5} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_5x5_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REFLECT_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 5} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_5x5_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REFLECT_101_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 5} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_5x5_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <WRAP_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 5} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_7x7_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <CONSTANT_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 7} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_7x7_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REPLICATE_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 7} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_7x7_reflect_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REFLECT_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 7} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_7x7_reflect_101_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <REFLECT_101_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 7} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @median_blur_2d_7x7_wrap_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_blur_2d <WRAP_PADDING> %inputImage, %outputImage, %constantValue {kernel_size = 7} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_constant_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_replicate_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_reflect_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_reflect_101_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_wrap_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_constant_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_replicate_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_reflect_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_reflect_101_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_wrap_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_constant_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_replicate_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_reflect_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_reflect_101_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_wrap_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_constant_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_replicate_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_reflect_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_reflect_101_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_wrap_padding(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_constant_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_replicate_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_reflect_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_reflect_101_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l1_wrap_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L1_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_constant_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_replicate_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_reflect_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_reflect_101_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_sobel_l2_wrap_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SOBEL L2_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_constant_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_replicate_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_reflect_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_reflect_101_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l1_wrap_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L1_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_constant_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <CONSTANT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_replicate_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <REPLICATE_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_reflect_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <REFLECT_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_reflect_101_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <REFLECT_101_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @gradient_2d_scharr_l2_wrap_padding_dxdy(%inputImage : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %gx : memref<?x?xf32>, %gy : memref<?x?xf32>, %direction : memref<?x?xi8>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gradient_2d SCHARR L2_NORM <WRAP_PADDING> %inputImage, %magnitude, %constantValue derivatives(%gx, %gy : memref<?x?xf32>, memref<?x?xf32>) direction(%direction : memref<?x?xi8>) : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @histogram_2d(%inputImage : memref<?x?xf32>, %hist : memref<?xi32>, %low : f32, %high : f32) attributes{llvm.emit_c_interface}
+{
+  dip.histogram_2d %inputImage, %hist, %low, %high : memref<?x?xf32>, memref<?xi32>, f32, f32
+  return
+}
+
+func.func @equalize_hist_2d(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.equalize_hist_2d %inputImage, %outputImage : memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @clahe_2d(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %tilesX : index, %tilesY : index, %clipLimit : f32) attributes{llvm.emit_c_interface}
+{
+  dip.clahe_2d %inputImage, %outputImage, %tilesX, %tilesY, %clipLimit : memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @lut_2d(%inputImage : memref<?x?xf32>, %lut : memref<?xf32>, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.lut_2d %inputImage, %lut, %outputImage : memref<?x?xf32>, memref<?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @cvt_color_rgb2gray_nhwc(%inputImage : memref<1x?x?x3xf32>, %outputImage : memref<?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color RGB2GRAY %inputImage, %outputImage, %scale : memref<1x?x?x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @cvt_color_rgb2gray_nchw(%inputImage : memref<1x3x?x?xf32>, %outputImage : memref<?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color RGB2GRAY %inputImage, %outputImage, %scale : memref<1x3x?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @cvt_color_rgb2yuv_nhwc(%inputImage : memref<?x?x?x3xf32>, %outputImage : memref<?x?x?x3xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color RGB2YUV %inputImage, %outputImage, %scale : memref<?x?x?x3xf32>, memref<?x?x?x3xf32>, f32
+  return
+}
+
+func.func @cvt_color_rgb2yuv_nchw(%inputImage : memref<?x3x?x?xf32>, %outputImage : memref<?x3x?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color RGB2YUV %inputImage, %outputImage, %scale : memref<?x3x?x?xf32>, memref<?x3x?x?xf32>, f32
+  return
+}
+
+func.func @cvt_color_yuv2rgb_nhwc(%inputImage : memref<?x?x?x3xf32>, %outputImage : memref<?x?x?x3xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color YUV2RGB %inputImage, %outputImage, %scale : memref<?x?x?x3xf32>, memref<?x?x?x3xf32>, f32
+  return
+}
+
+func.func @cvt_color_yuv2rgb_nchw(%inputImage : memref<?x3x?x?xf32>, %outputImage : memref<?x3x?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color YUV2RGB %inputImage, %outputImage, %scale : memref<?x3x?x?xf32>, memref<?x3x?x?xf32>, f32
+  return
+}
+
+func.func @cvt_color_rgb2hsv_nhwc(%inputImage : memref<?x?x?x3xf32>, %outputImage : memref<?x?x?x3xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color RGB2HSV %inputImage, %outputImage, %scale : memref<?x?x?x3xf32>, memref<?x?x?x3xf32>, f32
+  return
+}
+
+func.func @cvt_color_rgb2hsv_nchw(%inputImage : memref<?x3x?x?xf32>, %outputImage : memref<?x3x?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color RGB2HSV %inputImage, %outputImage, %scale : memref<?x3x?x?xf32>, memref<?x3x?x?xf32>, f32
+  return
+}
+
+func.func @cvt_color_hsv2rgb_nhwc(%inputImage : memref<?x?x?x3xf32>, %outputImage : memref<?x?x?x3xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color HSV2RGB %inputImage, %outputImage, %scale : memref<?x?x?x3xf32>, memref<?x?x?x3xf32>, f32
+  return
+}
+
+func.func @cvt_color_hsv2rgb_nchw(%inputImage : memref<?x3x?x?xf32>, %outputImage : memref<?x3x?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color HSV2RGB %inputImage, %outputImage, %scale : memref<?x3x?x?xf32>, memref<?x3x?x?xf32>, f32
+  return
+}
+
+func.func @cvt_color_yuv2rgb_nv12_nhwc(%inputImage : memref<?x?xi8>, %outputImage : memref<1x?x?x3xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color YUV2RGB_NV12 %inputImage, %outputImage, %scale : memref<?x?xi8>, memref<1x?x?x3xf32>, f32
+  return
+}
+
+func.func @cvt_color_yuv2rgb_nv12_nchw(%inputImage : memref<?x?xi8>, %outputImage : memref<1x3x?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color YUV2RGB_NV12 %inputImage, %outputImage, %scale : memref<?x?xi8>, memref<1x3x?x?xf32>, f32
+  return
+}
+
+func.func @cvt_color_yuv2rgb_i420_nhwc(%inputImage : memref<?x?xi8>, %outputImage : memref<1x?x?x3xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color YUV2RGB_I420 %inputImage, %outputImage, %scale : memref<?x?xi8>, memref<1x?x?x3xf32>, f32
+  return
+}
+
+func.func @cvt_color_yuv2rgb_i420_nchw(%inputImage : memref<?x?xi8>, %outputImage : memref<1x3x?x?xf32>, %scale : f32) attributes{llvm.emit_c_interface}
+{
+  dip.cvt_color YUV2RGB_I420 %inputImage, %outputImage, %scale : memref<?x?xi8>, memref<1x3x?x?xf32>, f32
+  return
+}
+
+func.func @resize_normalize_2d_u8(%inputImage : memref<1x?x?x3xi8>, %batch : memref<?x3x?x?xf32>, %batchIndex : index, %scale : f32, %mean : memref<3xf32>, %std : memref<3xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_normalize_2d %inputImage, %batch, %batchIndex, %scale, %mean, %std : memref<1x?x?x3xi8>, memref<?x3x?x?xf32>, index, f32, memref<3xf32>, memref<3xf32>
+  return
+}
+
+func.func @resize_normalize_2d_f32(%inputImage : memref<1x?x?x3xf32>, %batch : memref<?x3x?x?xf32>, %batchIndex : index, %scale : f32, %mean : memref<3xf32>, %std : memref<3xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_normalize_2d %inputImage, %batch, %batchIndex, %scale, %mean, %std : memref<1x?x?x3xf32>, memref<?x3x?x?xf32>, index, f32, memref<3xf32>, memref<3xf32>
+  return
+}
+
+func.func @erosion_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.erosion_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @erosion_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.erosion_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @erosion_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.erosion_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @erosion_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.erosion_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @erosion_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.erosion_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @dilation_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.dilation_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @dilation_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.dilation_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @dilation_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.dilation_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @dilation_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.dilation_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @dilation_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.dilation_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @opening_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.opening_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @opening_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.opening_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @opening_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.opening_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @opening_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.opening_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @opening_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.opening_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @closing_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.closing_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @closing_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.closing_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @closing_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.closing_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @closing_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.closing_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @closing_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.closing_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @tophat_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.tophat_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
+
+func.func @tophat_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.erosion_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %copymemref, %centerX, %centerY, %iterations, %constantValue: memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.tophat_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @erosion_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+func.func @tophat_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.erosion_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %copymemref, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.tophat_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @dilation_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
+func.func @tophat_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.dilation_2d <CONSTANT_PADDING> %inputImage,  %kernel, %outputImage, %copymemref, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.tophat_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @dilation_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+func.func @tophat_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.dilation_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %copymemref, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.tophat_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @opening_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
+func.func @bottomhat_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.opening_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.bottomhat_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @opening_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+func.func @bottomhat_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.opening_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.bottomhat_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @closing_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
+func.func @bottomhat_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.closing_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.bottomhat_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @closing_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+func.func @bottomhat_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.closing_2d <REPLICATE_PADDING> %inputImage,  %kernel, %outputImage, %outputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>,memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.bottomhat_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @tophat_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>,%outputImage2 : memref<?x?xf32>, %inputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
+func.func @bottomhat_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.tophat_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %outputImage2, %inputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.bottomhat_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @tophat_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>, %outputImage2 : memref<?x?xf32>, %inputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+func.func @morphgrad_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.tophat_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %outputImage2, %inputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.morphgrad_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @bottomhat_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>, %outputImage2 : memref<?x?xf32>, %inputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
+func.func @morphgrad_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.bottomhat_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %outputImage2, %inputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.morphgrad_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @bottomhat_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>, %outputImage2 : memref<?x?xf32>, %inputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+func.func @morphgrad_2d_reflect_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.bottomhat_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %outputImage2, %inputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.morphgrad_2d <REFLECT_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @morphgrad_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>,%outputImage2 : memref<?x?xf32>, %inputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index,%iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
+func.func @morphgrad_2d_reflect_101_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.morphgrad_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %outputImage1, %outputImage2,  %inputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index,index, f32
+  dip.morphgrad_2d <REFLECT_101_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
 
-func.func @morphgrad_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %outputImage1 : memref<?x?xf32>,%outputImage2 : memref<?x?xf32>, %inputImage1 : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %copymemref1 : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+func.func @morphgrad_2d_wrap_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue : f32) attributes{llvm.emit_c_interface}
 {
-  dip.morphgrad_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %outputImage1,%outputImage2, %inputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.morphgrad_2d <WRAP_PADDING> %inputImage, %kernel, %outputImage, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
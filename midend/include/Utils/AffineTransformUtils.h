@@ -24,30 +24,50 @@
 using namespace mlir;
 
 namespace buddy {
+// Border handling of the remaps. By default, pixels mapped outside of the
+// input keep their output value with nearest neighbour interpolation and
+// read 0 with the interpolating remaps. A replicating border clamps the
+// source coordinates to the input, and a constant border reads `value` (of
+// the element type) outside of the input.
+struct RemapBorder {
+  bool replicate = false;
+  Value value;
+};
+
 // Given x*m0+m2(and x*m3+m5) and m1(and m4), compute new x and y, then remap
-// origin pixels to new pixels
+// origin pixels to new pixels. interp_type is a dip::InterpolationType. A
+// positive rowGrain runs the blocks of rows in an scf.parallel.
 void affineTransformCore(OpBuilder &builder, Location loc, Value input,
                          Value output, Value yStart, Value yEnd, Value xStart,
                          Value xEnd, Value m1, Value m4, Value xAddr1,
                          Value xAddr2, int64_t stride, const int &RSV_BITS,
-                         int interp_type);
+                         int interp_type, int64_t rowGrain,
+                         const RemapBorder &border = RemapBorder());
+
+// Compute the source pixel (m0*x+m1*y+m2, m3*x+m4*y+m5) / (m6*x+m7*y+m8) of
+// every output pixel in [yStart, yEnd) x [xStart, xEnd), block by block, and
+// remap it like affineTransformCore.
+void perspectiveTransformCore(OpBuilder &builder, Location loc, Value input,
+                              Value output, Value yStart, Value yEnd,
+                              Value xStart, Value xEnd, ArrayRef<Value> m,
+                              int64_t stride, const int &RSV_BITS,
+                              int interp_type, int64_t rowGrain,
+                              const RemapBorder &border = RemapBorder());
 
-// remap using nearest neighbor interpolation
+// remap using nearest neighbor interpolation, `stride` pixels at a time.
 void remapNearest(OpBuilder &builder, Location loc, Value input, Value output,
                   Value mapInt, Value yStart, Value xStart, Value rows,
-                  Value cols);
-
-// remap using bilinear interpolation
-void remapBilinear(OpBuilder &builder, Location loc, Value input, Value output,
-                   Value mapInt, Value mapFrac);
-
-// remap using bicubic interpolation
-void remapBicubic(OpBuilder &builder, Location loc, Value input, Value output,
-                  Value mapInt, Value mapFrac);
+                  Value cols, int64_t stride,
+                  const RemapBorder &border = RemapBorder());
 
-// remap using lancoz interpolation
-void remapLancoz(OpBuilder &builder, Location loc, Value input, Value output,
-                 Value mapInt, Value mapFrac);
+// remap using a separable interpolation filter of `taps` taps per axis
+// (bilinear, bicubic or lanczos), `stride` pixels at a time. The tap weights
+// are looked up in `weights` by the fractional parts in mapFrac.
+void remapSeparable(OpBuilder &builder, Location loc, Value input,
+                    Value output, Value mapInt, Value mapFrac, Value weights,
+                    int64_t taps, Value yStart, Value xStart, Value rows,
+                    Value cols, int64_t stride, const int &RSV_BITS,
+                    const RemapBorder &border = RemapBorder());
 } // namespace buddy
 
 #endif // BUDDY_MLIR_AFFINETRANSFORMUTILS_H
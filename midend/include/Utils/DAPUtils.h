@@ -0,0 +1,59 @@
+//====- DAPUtils.h --------------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines DAP dialect specific utility functions for the buddy
+// compiler ecosystem.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_UTILS_DAPUTILS_H
+#define INCLUDE_UTILS_DAPUTILS_H
+
+#include "Utils/Utils.h"
+
+using namespace mlir;
+
+namespace buddy {
+namespace dap {
+
+// Fill `table` (1-D memref of index, length n) with the bit reversed position
+// of every index of a length n transform. n must be a power of two.
+void buildBitReverseTable(OpBuilder &builder, Location loc, Value table,
+                          Value n);
+
+// Fill `cosTable` and `sinTable` (1-D memrefs of length n / 2) with the
+// twiddle factors exp(-2 * pi * i * k / n) of a length n forward transform.
+void buildTwiddleTables(OpBuilder &builder, Location loc, Value cosTable,
+                        Value sinTable, Value n, FloatType elemTy);
+
+// Radix-2 decimation in time FFT of vecType.getNumElements() independent
+// signals at once. `memRefReal2D` and `memRefImag2D` are [n, lanes] buffers
+// whose column j holds signal j in bit reversed order; the spectra are written
+// back in place in natural order. Every butterfly works on whole rows, so the
+// transform is vectorised across signals rather than along them.
+void fftAcrossLanes(OpBuilder &builder, Location loc, Value memRefReal2D,
+                    Value memRefImag2D, Value cosTable, Value sinTable,
+                    Value n, VectorType vecType);
+
+// Dot product of row `row` of the 2-D memref `lhs` with the 1-D memref `rhs`,
+// both `length` elements long, using masked vectors of `stride` lanes.
+Value maskedRowDot(OpBuilder &builder, Location loc, Value lhs, Value row,
+                   Value rhs, Value length, int64_t stride, FloatType elemTy);
+
+} // namespace dap
+} // namespace buddy
+
+#endif // INCLUDE_UTILS_DAPUTILS_H
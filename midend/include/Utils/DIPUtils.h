@@ -23,6 +23,7 @@
 #define INCLUDE_UTILS_DIPUTILS_H
 
 #include "Utils/Utils.h"
+#include "Utils/AffineTransformUtils.h"
 #include <stdarg.h>
 
 using namespace mlir;
@@ -38,6 +39,17 @@ enum class DIP_OP { CORRELATION_2D, EROSION_2D, DILATION_2D };
 // from lowering passes with appropriate messages.
 enum class DIP_ERROR { INCONSISTENT_TYPES, UNSUPPORTED_TYPE, NO_ERROR };
 
+// Builds the same loop nest as affine::buildAffineLoopNest. When `rowGrain`
+// is positive, the outermost (row) loop is split into bands of `rowGrain`
+// rows that run as the iterations of an affine.parallel, which -lower-affine
+// turns into an scf.parallel for the async or OpenMP runtime. The body may
+// read any row, e.g. the halo of a kernel window, but must only write the
+// rows it is handed, so that bands never race.
+void buildRowBandLoopNest(
+    OpBuilder &builder, Location loc, ValueRange lbs, ValueRange ubs,
+    ArrayRef<int64_t> steps, int64_t rowGrain,
+    function_ref<void(OpBuilder &, Location, ValueRange)> bodyBuilder);
+
 // Inserts a constant op with value 0 into a location `loc` based on type
 // `type`. Supported types are : f32, f64, integer types.
 Value insertZeroConstantOp(MLIRContext *ctx, OpBuilder &builder, Location loc,
@@ -116,11 +128,24 @@ SmallVector<Value, 6> getRotationMatrix(OpBuilder &builder, Location loc,
                                         Value centerX, Value centerY,
                                         Value angle, Value scale);
 
-// Controls affine transform application.
+// Controls affine transform application. affineMatrix maps input to output
+// coordinates. interpType is a dip::InterpolationType.
 void affineTransformController(OpBuilder &builder, Location loc,
                                MLIRContext *ctx, Value input, Value output,
                                SmallVector<Value, 6> affineMatrix,
-                               int64_t stride);
+                               int64_t stride, int interpType,
+                               int64_t rowGrain,
+                               const RemapBorder &border = RemapBorder());
+
+// Controls perspective transform application. perspectiveMatrix (row major,
+// f32) maps input to output coordinates. interpType is a
+// dip::InterpolationType.
+void perspectiveTransformController(OpBuilder &builder, Location loc,
+                                    Value input, Value output,
+                                    SmallVector<Value, 9> perspectiveMatrix,
+                                    int64_t stride, int interpType,
+                                    int64_t rowGrain,
+                                    const RemapBorder &border = RemapBorder());
 
 // Controls shear transform application.
 void shearTransformController(
@@ -164,7 +189,7 @@ void NearestNeighbourInterpolationResizing(
     Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
     Value outputRowLastElemF32, Value outputColLastElemF32,
     Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32);
+    int64_t stride, Value c0, Value c0F32, int64_t rowGrain);
 
 // Helper function for resizing an image using bilinear interpolation mechanism.
 void BilinearInterpolationResizing(
@@ -174,7 +199,30 @@ void BilinearInterpolationResizing(
     Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
     Value outputRowLastElemF32, Value outputColLastElemF32,
     Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32, Value c1F32);
+    int64_t stride, Value c0, Value c0F32, Value c1F32, int64_t rowGrain);
+
+// Helper function for resizing an image with the area, bicubic or Lanczos
+// filter as separable vertical and horizontal passes over per-row and
+// per-column coefficient tables. The filters are widened when downscaling.
+// interpType is a dip::InterpolationType.
+void SeparableFilterResizing(OpBuilder &builder, Location loc, Value input,
+                             Value output, Value horizontalScalingFactor,
+                             Value verticalScalingFactor,
+                             int interpType, int64_t stride,
+                             int64_t rowGrain);
+
+// Blurs `input` with the 5x5 binomial kernel and writes every second row and
+// column of the result to `output`, evaluating the blur at those points only.
+void pyramidDown(OpBuilder &builder, Location loc, Value input, Value output,
+                 buddy::dip::BoundaryOption boundaryOptionAttr,
+                 int64_t stride, int64_t rowGrain);
+
+// Writes `fine` minus `coarse` upsampled to the size of `output` with the
+// kernel of pyramidDown. `output` may alias `fine`.
+void pyramidUpSubtract(OpBuilder &builder, Location loc, Value coarse,
+                       Value fine, Value output,
+                       buddy::dip::BoundaryOption boundaryOptionAttr,
+                       int64_t stride, int64_t rowGrain);
 
 // Util function for morphological transformations ; compares two vectors and
 // returns a mask
@@ -200,7 +248,174 @@ void traverseImagewBoundaryExtrapolation(
     OpBuilder &rewriter, Location loc, MLIRContext *ctx, Value input,
     Value kernel, Value output, Value centerX, Value centerY,
     Value constantValue, Value strideVal, Type elemTy,
-    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op);
+    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op,
+    int64_t rowGrain);
+
+// Correlates `input` with the separable kernel kernelY[i] * kernelX[j] in a
+// horizontal and a vertical pass and accumulates the result into `output`.
+// The boundary extrapolation matches traverseImagewBoundaryExtrapolation with
+// the full kernel.
+void separableCorrelation2D(OpBuilder &builder, Location loc, Value input,
+                            Value kernelX, Value kernelY, Value output,
+                            Value centerX, Value centerY, Value constantValue,
+                            Type elemTy,
+                            buddy::dip::BoundaryOption boundaryOptionAttr,
+                            int64_t stride, int64_t rowGrain);
+
+// Bounding box of the non-zero entries of a structuring element, with the
+// anchor relative to its top left corner. `isRectangle` holds when every entry
+// of the box is non-zero, i.e. the element is a flat rectangle or line.
+struct StructuringRectangle {
+  Value isRectangle;
+  Value width;
+  Value height;
+  Value anchorX;
+  Value anchorY;
+};
+
+// Inspects `kernel` at runtime and returns its bounding rectangle.
+StructuringRectangle detectStructuringRectangle(OpBuilder &builder,
+                                                Location loc, Value kernel,
+                                                Value centerX, Value centerY,
+                                                Type elemTy);
+
+// Erosion / dilation with a flat rectangular structuring element in two
+// van Herk/Gil-Werman passes, whose cost does not depend on the element size.
+// `input` is only read before the first result is handed to `store`, so it may
+// alias the memref that `store` writes to. `rows` and `cols` are its extents,
+// which bound affine loops and must therefore be valid affine symbols even when
+// `input` is picked at runtime.
+void rectangularMorphology(
+    OpBuilder &builder, Location loc, Value input, Value rows, Value cols,
+    const StructuringRectangle &rect, Value constantValue, Type elemTy,
+    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op,
+    int64_t rowGrain,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value)> store);
+
+// How the last stage of a morphology chain writes its result.
+enum class MORPH_EPILOGUE {
+  // output = chain(input)
+  STORE,
+  // output = input - chain(input), e.g. the top-hat.
+  SUBTRACT_FROM_INPUT,
+  // output = chain(input) - input, e.g. the bottom-hat.
+  SUBTRACT_INPUT,
+  // output = chain(input) - output, where output holds the previous chain.
+  SUBTRACT_OUTPUT,
+};
+
+// Erosions and dilations applied in order, each of them `iterations` times,
+// to the input of a morphological operation.
+struct MorphologyChain {
+  SmallVector<DIP_OP, 2> stages;
+  MORPH_EPILOGUE epilogue;
+};
+
+// Lowers a morphological operation made of one or more chains, which run one
+// after another on the same input. Flat rectangular structuring elements take
+// rectangularMorphology. Other elements are processed in bands of output rows:
+// every stage of a chain reads the previous one from a small padded band
+// buffer, which is recomputed with a halo instead of being written to a full
+// image, and only the epilogue of the last stage touches `output`.
+void morphologyPipeline(OpBuilder &builder, Location loc, Value input,
+                        Value kernel, Value output, Value centerX,
+                        Value centerY, Value iterations, Value constantValue,
+                        Type elemTy,
+                        buddy::dip::BoundaryOption boundaryOptionAttr,
+                        int64_t stride, int64_t rowGrain,
+                        ArrayRef<MorphologyChain> chains);
+
+// Correlates the real padded `input` with a kernel given by its spectrum, as
+// computed by rfft2D with the same twiddle tables, and writes every
+// strideY-th row and strideX-th column of the result to `output`. Strides
+// dividing the padded sizes fold the product spectrum, so that only the
+// inverse transform of the decimated grid is computed.
+void correlationFFT2D(OpBuilder &builder, Location loc, Value input,
+                      Value kernelSpectrumReal, Value kernelSpectrumImag,
+                      Value rowTwiddles, Value colTwiddles, Value output,
+                      Value strideX, Value strideY, int64_t stride);
+
+// Writes the summed-area tables of `input` and, unless null, of its squared
+// pixels to the (rows + 1) x (cols + 1) memrefs `sum` and `squareSum`.
+void integralImage(OpBuilder &builder, Location loc, Value input, Value sum,
+                   Value squareSum, int64_t stride);
+
+// Writes the mean of the kernelWidth x kernelHeight window anchored at
+// (centerX, centerY) around every pixel of `input` to `output`, reading the
+// window sums from summed-area tables of the padded input.
+void boxFilter(OpBuilder &builder, Location loc, Value input, Value output,
+               Value kernelWidth, Value kernelHeight, Value centerX,
+               Value centerY, Value constantValue,
+               buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+               int64_t rowGrain);
+
+// Writes the median of the kernelSize x kernelSize window centered on every
+// pixel of `input` to `output`, computed with min/max sorting networks.
+void medianBlur(OpBuilder &builder, Location loc, Value input, Value output,
+                Value constantValue, int64_t kernelSize,
+                buddy::dip::BoundaryOption boundaryOption, int64_t stride,
+                int64_t rowGrain);
+
+// Writes the gradient magnitude of `input` and, unless null, its derivatives
+// `gx`, `gy` and quantized `direction` in a single pass over the input.
+void gradient2D(OpBuilder &builder, Location loc, Value input, Value magnitude,
+                Value gx, Value gy, Value direction, Value constantValue,
+                buddy::dip::GradientOperator gradientOperator,
+                buddy::dip::GradientNorm norm,
+                buddy::dip::BoundaryOption boundaryOption, int64_t stride,
+                int64_t rowGrain);
+
+// dip.corr_2d with the `kernel` coefficients known at compile time: the taps
+// are unrolled, zero coefficients skipped and +-1 coefficients folded. The
+// output is accumulated into, as by traverseImagewBoundaryExtrapolation.
+void constantCorrelation2D(OpBuilder &builder, Location loc, Value input,
+                           DenseElementsAttr kernel, Value output,
+                           Value centerX, Value centerY, Value constantValue,
+                           buddy::dip::BoundaryOption boundaryOption,
+                           int64_t stride, int64_t rowGrain);
+
+// Counts the pixels of `input` in each bin of `hist`, whose bins split
+// [low, high) evenly. Every vector lane counts into its own histogram.
+void histogram2D(OpBuilder &builder, Location loc, Value input, Value hist,
+                 Value low, Value high, int64_t stride, int64_t rowGrain);
+
+// Writes lut[int(input(y, x))] to output(y, x), with the index clamped to the
+// size of the 1-D memref `lut`.
+void lookupTable2D(OpBuilder &builder, Location loc, Value input, Value lut,
+                   Value output, int64_t stride, int64_t rowGrain);
+
+// Equalizes the histogram of an image with values in [0, 256) as
+// cv::equalizeHist.
+void equalizeHistogram2D(OpBuilder &builder, Location loc, Value input,
+                         Value output, int64_t stride, int64_t rowGrain);
+
+// Equalizes the histograms of tilesX x tilesY tiles of an image with values
+// in [0, 256), clipped at clipLimit times the mean bin count, and
+// interpolates between the tiles as cv::CLAHE.
+void clahe2D(OpBuilder &builder, Location loc, Value input, Value output,
+             Value tilesX, Value tilesY, Value clipLimit, int64_t stride,
+             int64_t rowGrain);
+
+// Converts `input` to another color space as cv::cvtColor on float images,
+// after multiplying its pixels by `scale`. Color images are NHWC or NCHW
+// memrefs with three channels, gray images and YUV 4:2:0 frames 2-D ones.
+void convertColor(OpBuilder &builder, Location loc, Value input, Value output,
+                  Value scale, buddy::dip::ColorConversion conversion,
+                  int64_t stride, int64_t rowGrain);
+
+// Resizes an RGB image bilinearly to the size of the NCHW `output`,
+// normalizes its channels to (pixel * scale - mean[c]) / std[c] and stores it
+// to image `batchIndex` of `output` in one pass.
+void resizeNormalize2D(OpBuilder &builder, Location loc, Value input,
+                       Value output, Value batchIndex, Value scale, Value mean,
+                       Value stdDev, int64_t stride, int64_t rowGrain);
+
+// Maps `index`, which may lie outside of [0, size), to the index of the pixel
+// that the boundary option extrapolates there. `index` may be an index or a
+// vector of indices. Constant padding reads no pixel outside of the image, its
+// indices are clamped as with replicate padding.
+Value extrapolateIndex(OpBuilder &builder, Location loc, Value index,
+                       Value size, buddy::dip::BoundaryOption boundaryOption);
 
 // Function for applying type check mechanisms for all DIP dialect operations.
 template <typename DIPOP>
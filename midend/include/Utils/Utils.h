@@ -129,6 +129,41 @@ void dft2D(OpBuilder &builder, Location loc, Value container2DReal,
            Value intermediateReal, Value intermediateImag, Value c0, Value c1,
            Value strideVal, VectorType vecType);
 
+// Function for filling a twiddle factor table of the FFT utilities:
+// twiddles[0][t] = cos(2 * pi * t / length) and
+// twiddles[1][t] = -sin(2 * pi * t / length).
+void fftTwiddles(OpBuilder &builder, Location loc, Value twiddles,
+                 Value length, Value c0, Value c1);
+
+// Function for calculating the discrete Fourier transform of a 1D complex
+// MemRef with the self-sorting (Stockham) mixed-radix algorithm. Returns the
+// pair of the input and scratch MemRefs holding the result. Separate MemRefs
+// for real and imaginary parts are expected.
+std::pair<Value, Value>
+fft1DStockham(OpBuilder &builder, Location loc, Value memRefReal,
+              Value memRefImag, Value scratchReal, Value scratchImag,
+              Value twiddles, Value length, bool inverse, Value c0, Value c1);
+
+// Function for calculating the discrete Fourier transform of a real 2D MemRef.
+// Only the cols / 2 + 1 non-negative frequencies of every row are stored.
+// Separate MemRefs for real and imaginary parts of the spectrum are expected.
+void rfft2D(OpBuilder &builder, Location loc, Value input, Value spectrumReal,
+            Value spectrumImag, Value rowTwiddles, Value colTwiddles,
+            Value rows, Value cols, Value c0, Value c1);
+
+// Function for calculating the real inverse discrete Fourier transform of a 2D
+// spectrum stored as by rfft2D. The spectrum is clobbered.
+void irfft2D(OpBuilder &builder, Location loc, Value spectrumReal,
+             Value spectrumImag, Value output, Value rowTwiddles,
+             Value colTwiddles, Value rows, Value cols, Value c0, Value c1);
+
+// Function for folding a 2D spectrum stored as by rfft2D onto a grid which is
+// smaller by an integer factor in each dimension.
+void halfSpectrum2DFold(OpBuilder &builder, Location loc, Value srcReal,
+                        Value srcImag, Value srcRows, Value srcCols,
+                        Value dstReal, Value dstImag, Value dstRows,
+                        Value dstCols, Value c0, Value c1);
+
 } // namespace buddy
 
 #endif // INCLUDE_UTILS_UTILS_H
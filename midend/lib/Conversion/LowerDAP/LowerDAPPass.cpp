@@ -22,13 +22,17 @@
 #include "mlir/Dialect/Bufferization/Transforms/Bufferize.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/Math/IR/Math.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 
+#include <numeric>
+
 #include "DAP/DAPDialect.h"
 #include "DAP/DAPOps.h"
+#include "Utils/DAPUtils.h"
 
 using namespace mlir;
 using namespace buddy;
@@ -42,6 +46,166 @@ using namespace mlir::linalg;
 
 namespace {
 
+// Returns the memref type of `input` if it holds a [channels, samples]
+// multichannel signal, and a null type otherwise.
+MemRefType getChannelBlockedType(Value input) {
+  MemRefType inputTy = input.getType().dyn_cast<MemRefType>();
+  if (!inputTy || inputTy.getRank() != 2)
+    return MemRefType();
+  return inputTy;
+}
+
+// Apply one biquad section to `lanes` channels starting at `channel`, with one
+// vector lane per channel. The recursion runs sample by sample, so the state
+// (x[n-1], x[n-2], y[n-1], y[n-2]) of every channel is carried in registers
+// and each sample is gathered/scattered across the channel rows. `src` and
+// `dst` are [channels, samples] memrefs and are allowed to alias.
+void buildChannelBiquad(OpBuilder &builder, Location loc, Value src, Value dst,
+                        Value b0, Value b1, Value b2, Value a1, Value a2,
+                        Value channel, Value offsetVec, Value mask,
+                        VectorType vectorTy, Value N) {
+  Value c0 = builder.create<ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<ConstantIndexOp>(loc, 1);
+  Type elemTy = vectorTy.getElementType();
+
+  Value Vecb0 = builder.create<vector::BroadcastOp>(loc, vectorTy, b0);
+  Value Vecb1 = builder.create<vector::BroadcastOp>(loc, vectorTy, b1);
+  Value Vecb2 = builder.create<vector::BroadcastOp>(loc, vectorTy, b2);
+  Value Veca1 = builder.create<vector::BroadcastOp>(loc, vectorTy, a1);
+  Value Veca2 = builder.create<vector::BroadcastOp>(loc, vectorTy, a2);
+
+  Value zr = builder.create<ConstantOp>(loc, builder.getZeroAttr(elemTy));
+  Value zeroVec = builder.create<vector::BroadcastOp>(loc, vectorTy, zr);
+
+  // y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2];
+  builder.create<scf::ForOp>(
+      loc, c0, N, c1, ValueRange{zeroVec, zeroVec, zeroVec, zeroVec},
+      [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+        Value x = builder.create<GatherOp>(loc, vectorTy, src,
+                                           ValueRange{channel, iv}, offsetVec,
+                                           mask, zeroVec);
+        Value acc = builder.create<MulFOp>(loc, x, Vecb0);
+        acc = builder.create<FMAOp>(loc, iargs[0], Vecb1, acc);
+        acc = builder.create<FMAOp>(loc, iargs[1], Vecb2, acc);
+        Value fb = builder.create<MulFOp>(loc, iargs[2], Veca1);
+        fb = builder.create<FMAOp>(loc, iargs[3], Veca2, fb);
+        Value y = builder.create<SubFOp>(loc, acc, fb);
+        builder.create<ScatterOp>(loc, dst, ValueRange{channel, iv}, offsetVec,
+                                  mask, y);
+        builder.create<scf::YieldOp>(
+            loc, std::vector<Value>{x, iargs[0], y, iargs[2]});
+      });
+}
+
+// Build the per-lane element offsets [0, 1, ..., lanes - 1] * rowStride used
+// to gather one sample of consecutive channels.
+Value buildChannelOffsets(OpBuilder &builder, Location loc, int64_t lanes,
+                          Value rowStride) {
+  VectorType offsetTy = VectorType::get({lanes}, builder.getI64Type());
+  std::vector<int64_t> iota(lanes);
+  std::iota(iota.begin(), iota.end(), 0);
+  Value laneIdx = builder.create<ConstantOp>(
+      loc, DenseIntElementsAttr::get(offsetTy, ArrayRef<int64_t>(iota)));
+  Value stride =
+      builder.create<IndexCastOp>(loc, builder.getI64Type(), rowStride);
+  Value strideVec = builder.create<vector::BroadcastOp>(loc, offsetTy, stride);
+  return builder.create<MulIOp>(loc, laneIdx, strideVec);
+}
+
+// Fixed-point formats used for i16 operands. Samples and FIR taps are Q15;
+// biquad/IIR coefficients are Q14 so that feedback terms up to |a1| < 2 are
+// representable.
+const int64_t Q15_FRAC_BITS = 15;
+const int64_t BIQUAD_COEFF_FRAC_BITS = 14;
+
+// Check that input, kernel and output share an element type the biquad and IIR
+// lowerings support: any floating point type, or i16 as Q15 fixed point.
+// Scalar operands (e.g. the STFT hop size) are not checked.
+LogicalResult getDAPElementType(Operation *op, Type &elemTy) {
+  elemTy = op->getOperand(0).getType().cast<BaseMemRefType>().getElementType();
+  for (Value operand : op->getOperands()) {
+    BaseMemRefType operandTy = operand.getType().dyn_cast<BaseMemRefType>();
+    if (operandTy && operandTy.getElementType() != elemTy)
+      return op->emitOpError()
+             << "input, kernel and output must have the same element type";
+  }
+  if (!elemTy.isa<FloatType>() && !elemTy.isInteger(16))
+    return op->emitOpError()
+           << "supports only floating point and i16 (Q15) types. " << elemTy
+           << " is passed";
+  return success();
+}
+
+// Build an integer constant of type `ty`, splatted if `ty` is a vector type.
+Value createIntConstant(OpBuilder &builder, Location loc, Type ty,
+                        int64_t value) {
+  if (VectorType vecTy = ty.dyn_cast<VectorType>())
+    return builder.create<ConstantOp>(
+        loc, DenseElementsAttr::get(
+                 vecTy, builder.getIntegerAttr(vecTy.getElementType(), value)));
+  return builder.create<ConstantOp>(loc, builder.getIntegerAttr(ty, value));
+}
+
+// Round a wide fixed-point accumulator (scalar or vector of i64) with
+// `fracBits` fractional bits to the nearest Q15 value, saturate it to the i16
+// range and return it still in i64.
+Value roundAndSaturateQ15(OpBuilder &builder, Location loc, Value acc,
+                          int64_t fracBits) {
+  Type accTy = acc.getType();
+  Value half =
+      createIntConstant(builder, loc, accTy, int64_t(1) << (fracBits - 1));
+  Value shift = createIntConstant(builder, loc, accTy, fracBits);
+  Value minVal = createIntConstant(builder, loc, accTy, INT16_MIN);
+  Value maxVal = createIntConstant(builder, loc, accTy, INT16_MAX);
+  Value rounded = builder.create<AddIOp>(loc, acc, half);
+  rounded = builder.create<ShRSIOp>(loc, rounded, shift);
+  rounded = builder.create<MaxSIOp>(loc, rounded, minVal);
+  return builder.create<MinSIOp>(loc, rounded, maxVal);
+}
+
+// Apply one Q15 biquad section to the mono signal `src`, writing `dst`. The
+// coefficients are Q14 i16 values and the products are accumulated in i64, so
+// only the final result is rounded and saturated. The stored (saturated)
+// output is fed back, matching the behaviour of fixed-point DSP libraries.
+void buildFixedPointBiquad(OpBuilder &builder, Location loc, Value src,
+                           Value dst, Value b0, Value b1, Value b2, Value a1,
+                           Value a2, Value N) {
+  Value c0 = builder.create<ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<ConstantIndexOp>(loc, 1);
+  IntegerType i16 = builder.getI16Type();
+  IntegerType i64 = builder.getI64Type();
+
+  Value B0 = builder.create<ExtSIOp>(loc, i64, b0);
+  Value B1 = builder.create<ExtSIOp>(loc, i64, b1);
+  Value B2 = builder.create<ExtSIOp>(loc, i64, b2);
+  Value A1 = builder.create<ExtSIOp>(loc, i64, a1);
+  Value A2 = builder.create<ExtSIOp>(loc, i64, a2);
+  Value zr = createIntConstant(builder, loc, i64, 0);
+
+  // y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2];
+  builder.create<scf::ForOp>(
+      loc, c0, N, c1, ValueRange{zr, zr, zr, zr},
+      [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+        Value x16 = builder.create<memref::LoadOp>(loc, src, ValueRange{iv});
+        Value x = builder.create<ExtSIOp>(loc, i64, x16);
+        Value acc = builder.create<MulIOp>(loc, x, B0);
+        acc = builder.create<AddIOp>(
+            loc, acc, builder.create<MulIOp>(loc, iargs[0], B1));
+        acc = builder.create<AddIOp>(
+            loc, acc, builder.create<MulIOp>(loc, iargs[1], B2));
+        acc = builder.create<SubIOp>(
+            loc, acc, builder.create<MulIOp>(loc, iargs[2], A1));
+        acc = builder.create<SubIOp>(
+            loc, acc, builder.create<MulIOp>(loc, iargs[3], A2));
+        Value y =
+            roundAndSaturateQ15(builder, loc, acc, BIQUAD_COEFF_FRAC_BITS);
+        Value y16 = builder.create<TruncIOp>(loc, i16, y);
+        builder.create<memref::StoreOp>(loc, y16, dst, ValueRange{iv});
+        builder.create<scf::YieldOp>(
+            loc, std::vector<Value>{x, iargs[0], y, iargs[2]});
+      });
+}
+
 class DAPFirLowering : public OpRewritePattern<dap::FirOp> {
 public:
   using OpRewritePattern<dap::FirOp>::OpRewritePattern;
@@ -56,6 +220,12 @@ public:
     Value kernel = op->getOperand(1);
     Value output = op->getOperand(2);
 
+    // i16 is Q15 fixed point and needs a wide accumulator, see
+    // DAPFirFixedPointLowering.
+    Type elemTy = input.getType().cast<BaseMemRefType>().getElementType();
+    if (elemTy.isInteger(16))
+      return failure();
+
     rewriter.create<linalg::Conv1DOp>(loc, ValueRange{input, kernel},
                                       ValueRange{output});
 
@@ -64,6 +234,96 @@ public:
   }
 };
 
+// Q15 FIR: output[i] = sat(round(sum_k input[i + k] * kernel[k])), with both
+// the samples and the taps in Q15. Every lane accumulates in i64 and samples
+// past the end of the input read as zero.
+class DAPFirFixedPointLowering : public OpRewritePattern<dap::FirOp> {
+public:
+  using OpRewritePattern<dap::FirOp>::OpRewritePattern;
+
+  explicit DAPFirFixedPointLowering(MLIRContext *context, int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dap::FirOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    Type elemTy = input.getType().cast<BaseMemRefType>().getElementType();
+    if (!elemTy.isInteger(16))
+      return failure();
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+
+    Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
+    Value strideVal = rewriter.create<ConstantIndexOp>(loc, stride);
+
+    Value inputSize = rewriter.create<memref::DimOp>(loc, input, c0);
+    Value kernelSize = rewriter.create<memref::DimOp>(loc, kernel, c0);
+    Value outputSize = rewriter.create<memref::DimOp>(loc, output, c0);
+
+    VectorType vectorTy16 = VectorType::get({stride}, elemTy);
+    VectorType vectorTy64 = VectorType::get({stride}, rewriter.getI64Type());
+    VectorType vectorMaskTy = VectorType::get({stride}, rewriter.getI1Type());
+
+    Value zeroPadding = createIntConstant(rewriter, loc, vectorTy16, 0);
+    Value zeroAcc = createIntConstant(rewriter, loc, vectorTy64, 0);
+
+    rewriter.create<scf::ForOp>(
+        loc, c0, outputSize, strideVal, ValueRange{std::nullopt},
+        [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+          Value outputTail = builder.create<SubIOp>(loc, outputSize, iv);
+          Value outputMask =
+              builder.create<CreateMaskOp>(loc, vectorMaskTy, outputTail);
+
+          auto accLoop = builder.create<scf::ForOp>(
+              loc, c0, kernelSize, c1, ValueRange{zeroAcc},
+              [&](OpBuilder &builder, Location loc, Value k,
+                  ValueRange itrargs) {
+                Value tap =
+                    builder.create<memref::LoadOp>(loc, kernel, ValueRange{k});
+                Value tap64 =
+                    builder.create<ExtSIOp>(loc, builder.getI64Type(), tap);
+                Value tapVec =
+                    builder.create<BroadcastOp>(loc, vectorTy64, tap64);
+
+                Value idx = builder.create<AddIOp>(loc, iv, k);
+                Value inputTail = builder.create<SubIOp>(loc, inputSize, idx);
+                Value inputMask =
+                    builder.create<CreateMaskOp>(loc, vectorMaskTy, inputTail);
+                Value inputVec = builder.create<MaskedLoadOp>(
+                    loc, vectorTy16, input, ValueRange{idx}, inputMask,
+                    zeroPadding);
+                Value inputVec64 =
+                    builder.create<ExtSIOp>(loc, vectorTy64, inputVec);
+
+                Value prod = builder.create<MulIOp>(loc, inputVec64, tapVec);
+                Value acc = builder.create<AddIOp>(loc, itrargs[0], prod);
+                builder.create<scf::YieldOp>(loc, acc);
+              });
+
+          Value res = roundAndSaturateQ15(builder, loc, accLoop.getResult(0),
+                                          Q15_FRAC_BITS);
+          Value res16 = builder.create<TruncIOp>(loc, vectorTy16, res);
+          builder.create<MaskedStoreOp>(loc, output, ValueRange{iv},
+                                        outputMask, res16);
+          builder.create<scf::YieldOp>(loc, std::nullopt);
+        });
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
 class DAPBiquadLowering : public OpRewritePattern<dap::BiquadOp> {
 public:
   using OpRewritePattern<dap::BiquadOp>::OpRewritePattern;
@@ -76,12 +336,19 @@ public:
   LogicalResult matchAndRewrite(dap::BiquadOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto ctx = op->getContext();
 
     Value input = op->getOperand(0);
     Value kernel = op->getOperand(1);
     Value output = op->getOperand(2);
 
+    // Multichannel inputs are handled by DAPBiquadChannelLowering.
+    if (getChannelBlockedType(input))
+      return failure();
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+
     Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
     Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
     Value c2 = rewriter.create<ConstantIndexOp>(loc, 2);
@@ -97,14 +364,22 @@ public:
 
     Value N = rewriter.create<memref::DimOp>(loc, input, c0);
 
+    if (elemTy.isInteger(16)) {
+      buildFixedPointBiquad(rewriter, loc, input, output, b0, b1, b2, a1, a2,
+                            N);
+      rewriter.eraseOp(op);
+      return success();
+    }
+
     Value strideVal = rewriter.create<ConstantIndexOp>(loc, stride);
 
-    FloatType f32 = FloatType::getF32(ctx);
+    FloatType floatTy = elemTy.cast<FloatType>();
+    APFloat zero = APFloat::getZero(floatTy.getFloatSemantics());
 
-    Value z1 = rewriter.create<ConstantFloatOp>(loc, APFloat(float(0)), f32);
-    Value z2 = rewriter.create<ConstantFloatOp>(loc, APFloat(float(0)), f32);
+    Value z1 = rewriter.create<ConstantFloatOp>(loc, zero, floatTy);
+    Value z2 = rewriter.create<ConstantFloatOp>(loc, zero, floatTy);
 
-    VectorType vectorTy32 = VectorType::get({stride}, f32);
+    VectorType vectorTy = VectorType::get({stride}, floatTy);
 
     Value x0 = rewriter.create<memref::LoadOp>(loc, input, ValueRange{c0});
     Value x = rewriter.create<MulFOp>(loc, b0, x0);
@@ -116,9 +391,9 @@ public:
     Value x4 = rewriter.create<AddFOp>(loc, x2, x3);
     rewriter.create<memref::StoreOp>(loc, x4, output, ValueRange{c1});
 
-    Value Vecb0 = rewriter.create<vector::BroadcastOp>(loc, vectorTy32, b0);
-    Value Vecb1 = rewriter.create<vector::BroadcastOp>(loc, vectorTy32, b1);
-    Value Vecb2 = rewriter.create<vector::BroadcastOp>(loc, vectorTy32, b2);
+    Value Vecb0 = rewriter.create<vector::BroadcastOp>(loc, vectorTy, b0);
+    Value Vecb1 = rewriter.create<vector::BroadcastOp>(loc, vectorTy, b1);
+    Value Vecb2 = rewriter.create<vector::BroadcastOp>(loc, vectorTy, b2);
 
     // A biquad filter expression:
     // y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2];
@@ -131,14 +406,14 @@ public:
           Value idx2 = builder.create<SubIOp>(loc, idx0, c2);
 
           Value inputVec0 =
-              builder.create<LoadOp>(loc, vectorTy32, input, ValueRange{idx0});
+              builder.create<LoadOp>(loc, vectorTy, input, ValueRange{idx0});
           Value inputVec1 =
-              builder.create<LoadOp>(loc, vectorTy32, input, ValueRange{idx1});
+              builder.create<LoadOp>(loc, vectorTy, input, ValueRange{idx1});
           Value inputVec2 =
-              builder.create<LoadOp>(loc, vectorTy32, input, ValueRange{idx2});
+              builder.create<LoadOp>(loc, vectorTy, input, ValueRange{idx2});
 
           Value outputVec =
-              builder.create<LoadOp>(loc, vectorTy32, output, ValueRange{idx0});
+              builder.create<vector::BroadcastOp>(loc, vectorTy, z1);
           Value resVec0 =
               builder.create<FMAOp>(loc, inputVec0, Vecb0, outputVec);
           Value resVec1 = builder.create<FMAOp>(loc, inputVec1, Vecb1, resVec0);
@@ -183,12 +458,19 @@ public:
   LogicalResult matchAndRewrite(dap::IirOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto ctx = op->getContext();
 
     Value input = op->getOperand(0);
     Value kernel = op->getOperand(1);
     Value output = op->getOperand(2);
 
+    // Multichannel inputs are handled by DAPIirChannelLowering.
+    if (getChannelBlockedType(input))
+      return failure();
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+
     Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
     Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
     Value c2 = rewriter.create<ConstantIndexOp>(loc, 2);
@@ -199,11 +481,38 @@ public:
     Value filterSize = rewriter.create<memref::DimOp>(loc, kernel, c0);
     Value strideVal = rewriter.create<ConstantIndexOp>(loc, stride);
 
-    FloatType f32 = FloatType::getF32(ctx);
-
-    VectorType vectorTy32 = VectorType::get({stride}, f32);
-
-    Value zr = rewriter.create<ConstantFloatOp>(loc, APFloat(float(0)), f32);
+    if (elemTy.isInteger(16)) {
+      // loop over every row in SOS matrix, each section rounds and saturates
+      // its output to Q15 before feeding the next one.
+      rewriter.create<scf::ForOp>(
+          loc, c0, filterSize, c1, ValueRange{std::nullopt},
+          [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+            Value b0 =
+                builder.create<memref::LoadOp>(loc, kernel, ValueRange{iv, c0});
+            Value b1 =
+                builder.create<memref::LoadOp>(loc, kernel, ValueRange{iv, c1});
+            Value b2 =
+                builder.create<memref::LoadOp>(loc, kernel, ValueRange{iv, c2});
+            // Value a0 of kernel is not used
+            Value a1 =
+                builder.create<memref::LoadOp>(loc, kernel, ValueRange{iv, c4});
+            Value a2 =
+                builder.create<memref::LoadOp>(loc, kernel, ValueRange{iv, c5});
+            buildFixedPointBiquad(builder, loc, input, output, b0, b1, b2, a1,
+                                  a2, N);
+            builder.create<memref::CopyOp>(loc, output, input);
+            builder.create<scf::YieldOp>(loc, std::nullopt);
+          });
+      rewriter.eraseOp(op);
+      return success();
+    }
+
+    FloatType floatTy = elemTy.cast<FloatType>();
+    APFloat zero = APFloat::getZero(floatTy.getFloatSemantics());
+
+    VectorType vectorTy = VectorType::get({stride}, floatTy);
+
+    Value zr = rewriter.create<ConstantFloatOp>(loc, zero, floatTy);
 
     // loop over every row in SOS matrix
     rewriter.create<scf::ForOp>(
@@ -222,10 +531,8 @@ public:
           Value a2 = builder.create<memref::LoadOp>(loc, kernel,
                                                     ValueRange{ivs[0], c5});
 
-          Value z1 =
-              builder.create<ConstantFloatOp>(loc, APFloat(float(0)), f32);
-          Value z2 =
-              builder.create<ConstantFloatOp>(loc, APFloat(float(0)), f32);
+          Value z1 = builder.create<ConstantFloatOp>(loc, zero, floatTy);
+          Value z2 = builder.create<ConstantFloatOp>(loc, zero, floatTy);
 
           Value x0 = builder.create<memref::LoadOp>(loc, input, ValueRange{c0});
           Value temp = builder.create<MulFOp>(loc, b0, x0);
@@ -238,11 +545,11 @@ public:
           builder.create<memref::StoreOp>(loc, temp2, output, ValueRange{c1});
 
           Value Vecb0 =
-              builder.create<vector::BroadcastOp>(loc, vectorTy32, b0);
+              builder.create<vector::BroadcastOp>(loc, vectorTy, b0);
           Value Vecb1 =
-              builder.create<vector::BroadcastOp>(loc, vectorTy32, b1);
+              builder.create<vector::BroadcastOp>(loc, vectorTy, b1);
           Value Vecb2 =
-              builder.create<vector::BroadcastOp>(loc, vectorTy32, b2);
+              builder.create<vector::BroadcastOp>(loc, vectorTy, b2);
 
           // A biquad filter expression:
           // y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2];
@@ -255,15 +562,15 @@ public:
                 Value idx1 = builder.create<SubIOp>(loc, idx0, c1);
                 Value idx2 = builder.create<SubIOp>(loc, idx0, c2);
 
-                Value inputVec0 = builder.create<LoadOp>(loc, vectorTy32, input,
+                Value inputVec0 = builder.create<LoadOp>(loc, vectorTy, input,
                                                          ValueRange{idx0});
-                Value inputVec1 = builder.create<LoadOp>(loc, vectorTy32, input,
+                Value inputVec1 = builder.create<LoadOp>(loc, vectorTy, input,
                                                          ValueRange{idx1});
-                Value inputVec2 = builder.create<LoadOp>(loc, vectorTy32, input,
+                Value inputVec2 = builder.create<LoadOp>(loc, vectorTy, input,
                                                          ValueRange{idx2});
 
                 Value outputVec =
-                    rewriter.create<vector::BroadcastOp>(loc, vectorTy32, zr);
+                    rewriter.create<vector::BroadcastOp>(loc, vectorTy, zr);
                 Value resVec0 =
                     builder.create<FMAOp>(loc, inputVec0, Vecb0, outputVec);
                 Value resVec1 =
@@ -304,13 +611,627 @@ private:
   int64_t stride;
 };
 
+class DAPBiquadChannelLowering : public OpRewritePattern<dap::BiquadOp> {
+public:
+  using OpRewritePattern<dap::BiquadOp>::OpRewritePattern;
+
+  explicit DAPBiquadChannelLowering(MLIRContext *context, int64_t lanesParam)
+      : OpRewritePattern(context) {
+    lanes = lanesParam;
+  }
+
+  LogicalResult matchAndRewrite(dap::BiquadOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    if (!getChannelBlockedType(input))
+      return failure();
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+    if (!elemTy.isa<FloatType>())
+      return op->emitOpError()
+             << "multichannel filtering supports only floating point types. "
+             << elemTy << " is passed";
+
+    Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
+    Value c2 = rewriter.create<ConstantIndexOp>(loc, 2);
+    Value c4 = rewriter.create<ConstantIndexOp>(loc, 4);
+    Value c5 = rewriter.create<ConstantIndexOp>(loc, 5);
+
+    Value b0 = rewriter.create<memref::LoadOp>(loc, kernel, ValueRange{c0});
+    Value b1 = rewriter.create<memref::LoadOp>(loc, kernel, ValueRange{c1});
+    Value b2 = rewriter.create<memref::LoadOp>(loc, kernel, ValueRange{c2});
+    // Value a0 of kernel is not used
+    Value a1 = rewriter.create<memref::LoadOp>(loc, kernel, ValueRange{c4});
+    Value a2 = rewriter.create<memref::LoadOp>(loc, kernel, ValueRange{c5});
+
+    Value channels = rewriter.create<memref::DimOp>(loc, input, c0);
+    Value N = rewriter.create<memref::DimOp>(loc, input, c1);
+    Value lanesVal = rewriter.create<ConstantIndexOp>(loc, lanes);
+
+    VectorType vectorTy = VectorType::get({lanes}, elemTy);
+    VectorType maskTy = VectorType::get({lanes}, rewriter.getI1Type());
+    Value offsetVec = buildChannelOffsets(rewriter, loc, lanes, N);
+
+    // Loop over blocks of `lanes` channels, the last block is masked.
+    rewriter.create<scf::ForOp>(
+        loc, c0, channels, lanesVal, ValueRange{std::nullopt},
+        [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+          Value remaining = builder.create<SubIOp>(loc, channels, iv);
+          Value mask = builder.create<CreateMaskOp>(loc, maskTy, remaining);
+          buildChannelBiquad(builder, loc, input, output, b0, b1, b2, a1, a2,
+                             iv, offsetVec, mask, vectorTy, N);
+          builder.create<scf::YieldOp>(loc, std::nullopt);
+        });
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t lanes;
+};
+
+class DAPIirChannelLowering : public OpRewritePattern<dap::IirOp> {
+public:
+  using OpRewritePattern<dap::IirOp>::OpRewritePattern;
+
+  explicit DAPIirChannelLowering(MLIRContext *context, int64_t lanesParam)
+      : OpRewritePattern(context) {
+    lanes = lanesParam;
+  }
+
+  LogicalResult matchAndRewrite(dap::IirOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    if (!getChannelBlockedType(input))
+      return failure();
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+    if (!elemTy.isa<FloatType>())
+      return op->emitOpError()
+             << "multichannel filtering supports only floating point types. "
+             << elemTy << " is passed";
+
+    Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
+    Value c2 = rewriter.create<ConstantIndexOp>(loc, 2);
+    Value c4 = rewriter.create<ConstantIndexOp>(loc, 4);
+    Value c5 = rewriter.create<ConstantIndexOp>(loc, 5);
+
+    Value channels = rewriter.create<memref::DimOp>(loc, input, c0);
+    Value N = rewriter.create<memref::DimOp>(loc, input, c1);
+    Value filterSize = rewriter.create<memref::DimOp>(loc, kernel, c0);
+    Value lanesVal = rewriter.create<ConstantIndexOp>(loc, lanes);
+
+    VectorType vectorTy = VectorType::get({lanes}, elemTy);
+    VectorType maskTy = VectorType::get({lanes}, rewriter.getI1Type());
+    Value offsetVec = buildChannelOffsets(rewriter, loc, lanes, N);
+
+    // Unlike the mono lowering, the input is left untouched: the sections are
+    // applied in place on the output buffer.
+    rewriter.create<memref::CopyOp>(loc, input, output);
+
+    // Loop over blocks of `lanes` channels, the last block is masked.
+    rewriter.create<scf::ForOp>(
+        loc, c0, channels, lanesVal, ValueRange{std::nullopt},
+        [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+          Value remaining = builder.create<SubIOp>(loc, channels, iv);
+          Value mask = builder.create<CreateMaskOp>(loc, maskTy, remaining);
+
+          // loop over every row in SOS matrix
+          builder.create<scf::ForOp>(
+              loc, c0, filterSize, c1, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value sec,
+                  ValueRange itrargs) {
+                Value b0 = builder.create<memref::LoadOp>(loc, kernel,
+                                                          ValueRange{sec, c0});
+                Value b1 = builder.create<memref::LoadOp>(loc, kernel,
+                                                          ValueRange{sec, c1});
+                Value b2 = builder.create<memref::LoadOp>(loc, kernel,
+                                                          ValueRange{sec, c2});
+                // Value a0 of kernel is not used
+                Value a1 = builder.create<memref::LoadOp>(loc, kernel,
+                                                          ValueRange{sec, c4});
+                Value a2 = builder.create<memref::LoadOp>(loc, kernel,
+                                                          ValueRange{sec, c5});
+                buildChannelBiquad(builder, loc, output, output, b0, b1, b2,
+                                   a1, a2, iv, offsetVec, mask, vectorTy, N);
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+          builder.create<scf::YieldOp>(loc, std::nullopt);
+        });
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t lanes;
+};
+
+class DAPStftLowering : public OpRewritePattern<dap::StftOp> {
+public:
+  using OpRewritePattern<dap::StftOp>::OpRewritePattern;
+
+  explicit DAPStftLowering(MLIRContext *context, int64_t lanesParam)
+      : OpRewritePattern(context) {
+    lanes = lanesParam;
+  }
+
+  LogicalResult matchAndRewrite(dap::StftOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    Value input = op->getOperand(0);
+    Value window = op->getOperand(1);
+    Value hop = op->getOperand(2);
+    Value outReal = op->getOperand(3);
+    Value outImag = op->getOperand(4);
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+    if (!elemTy.isa<FloatType>())
+      return op->emitOpError()
+             << "spectral analysis supports only floating point types. "
+             << elemTy << " is passed";
+    FloatType floatTy = elemTy.cast<FloatType>();
+
+    Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
+    Value c2 = rewriter.create<ConstantIndexOp>(loc, 2);
+    Value lanesVal = rewriter.create<ConstantIndexOp>(loc, lanes);
+
+    Value N = rewriter.create<memref::DimOp>(loc, input, c0);
+    Value nfft = rewriter.create<memref::DimOp>(loc, window, c0);
+    Value frames = rewriter.create<memref::DimOp>(loc, outReal, c0);
+    Value bins = rewriter.create<memref::DimOp>(loc, outReal, c1);
+    // Bins past nfft do not exist, leave them untouched.
+    Value usedBins = rewriter.create<MinUIOp>(loc, bins, nfft);
+    Value halfN = rewriter.create<DivUIOp>(loc, nfft, c2);
+
+    VectorType vectorTy = VectorType::get({lanes}, elemTy);
+    VectorType maskTy = VectorType::get({lanes}, rewriter.getI1Type());
+    VectorType offsetTy = VectorType::get({lanes}, rewriter.getI64Type());
+
+    // Tables shared by all frames, and a [nfft, lanes] work buffer holding
+    // `lanes` frames side by side so that every FFT butterfly is one vector
+    // operation over consecutive frames.
+    Value bitReverse = rewriter.create<memref::AllocOp>(
+        loc, MemRefType::get({ShapedType::kDynamic}, rewriter.getIndexType()),
+        ValueRange{nfft});
+    MemRefType tableTy = MemRefType::get({ShapedType::kDynamic}, elemTy);
+    Value cosTable =
+        rewriter.create<memref::AllocOp>(loc, tableTy, ValueRange{halfN});
+    Value sinTable =
+        rewriter.create<memref::AllocOp>(loc, tableTy, ValueRange{halfN});
+    MemRefType workTy = MemRefType::get({ShapedType::kDynamic, lanes}, elemTy);
+    Value workReal =
+        rewriter.create<memref::AllocOp>(loc, workTy, ValueRange{nfft});
+    Value workImag =
+        rewriter.create<memref::AllocOp>(loc, workTy, ValueRange{nfft});
+    dap::buildBitReverseTable(rewriter, loc, bitReverse, nfft);
+    dap::buildTwiddleTables(rewriter, loc, cosTable, sinTable, nfft, floatTy);
+
+    // Lane j reads frame f0 + j, i.e. input samples j * hop apart, and writes
+    // output row f0 + j, i.e. j * bins elements apart.
+    Value hopOffsets = buildChannelOffsets(rewriter, loc, lanes, hop);
+    Value binOffsets = buildChannelOffsets(rewriter, loc, lanes, bins);
+    Value N64 = rewriter.create<IndexCastOp>(loc, rewriter.getI64Type(), N);
+    Value NVec = rewriter.create<vector::BroadcastOp>(loc, offsetTy, N64);
+    Value zr = rewriter.create<ConstantOp>(loc, rewriter.getZeroAttr(elemTy));
+    Value zeroVec = rewriter.create<vector::BroadcastOp>(loc, vectorTy, zr);
+
+    // Loop over blocks of `lanes` frames, the last block is masked.
+    rewriter.create<scf::ForOp>(
+        loc, c0, frames, lanesVal, ValueRange{std::nullopt},
+        [&](OpBuilder &builder, Location loc, Value f0, ValueRange iargs) {
+          Value remaining = builder.create<SubIOp>(loc, frames, f0);
+          Value frameMask =
+              builder.create<CreateMaskOp>(loc, maskTy, remaining);
+          Value start = builder.create<MulIOp>(loc, f0, hop);
+
+          // Window the frames and store them in bit reversed order.
+          builder.create<scf::ForOp>(
+              loc, c0, nfft, c1, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value m,
+                  ValueRange itrargs) {
+                Value pos = builder.create<AddIOp>(loc, start, m);
+                Value pos64 =
+                    builder.create<IndexCastOp>(loc, builder.getI64Type(), pos);
+                Value posVec =
+                    builder.create<vector::BroadcastOp>(loc, offsetTy, pos64);
+                posVec = builder.create<AddIOp>(loc, posVec, hopOffsets);
+                Value inRange = builder.create<CmpIOp>(
+                    loc, CmpIPredicate::slt, posVec, NVec);
+                Value mask = builder.create<AndIOp>(loc, inRange, frameMask);
+                Value x = builder.create<GatherOp>(loc, vectorTy, input,
+                                                   ValueRange{pos}, hopOffsets,
+                                                   mask, zeroVec);
+                Value w =
+                    builder.create<memref::LoadOp>(loc, window, ValueRange{m});
+                Value wVec = builder.create<vector::BroadcastOp>(loc, vectorTy,
+                                                                 w);
+                Value xw = builder.create<MulFOp>(loc, x, wVec);
+                Value r = builder.create<memref::LoadOp>(loc, bitReverse,
+                                                         ValueRange{m});
+                builder.create<StoreOp>(loc, xw, workReal, ValueRange{r, c0});
+                builder.create<StoreOp>(loc, zeroVec, workImag,
+                                        ValueRange{r, c0});
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+
+          dap::fftAcrossLanes(builder, loc, workReal, workImag, cosTable,
+                              sinTable, nfft, vectorTy);
+
+          // Scatter every bin back to the rows of its frame.
+          builder.create<scf::ForOp>(
+              loc, c0, usedBins, c1, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value k,
+                  ValueRange itrargs) {
+                Value re = builder.create<LoadOp>(loc, vectorTy, workReal,
+                                                  ValueRange{k, c0});
+                Value im = builder.create<LoadOp>(loc, vectorTy, workImag,
+                                                  ValueRange{k, c0});
+                builder.create<ScatterOp>(loc, outReal, ValueRange{f0, k},
+                                          binOffsets, frameMask, re);
+                builder.create<ScatterOp>(loc, outImag, ValueRange{f0, k},
+                                          binOffsets, frameMask, im);
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+          builder.create<scf::YieldOp>(loc, std::nullopt);
+        });
+
+    rewriter.create<memref::DeallocOp>(loc, bitReverse);
+    rewriter.create<memref::DeallocOp>(loc, cosTable);
+    rewriter.create<memref::DeallocOp>(loc, sinTable);
+    rewriter.create<memref::DeallocOp>(loc, workReal);
+    rewriter.create<memref::DeallocOp>(loc, workImag);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t lanes;
+};
+
+class DAPMelFilterbankLowering
+    : public OpRewritePattern<dap::MelFilterbankOp> {
+public:
+  using OpRewritePattern<dap::MelFilterbankOp>::OpRewritePattern;
+
+  explicit DAPMelFilterbankLowering(MLIRContext *context, int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dap::MelFilterbankOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    Value real = op->getOperand(0);
+    Value imag = op->getOperand(1);
+    Value filterbank = op->getOperand(2);
+    Value output = op->getOperand(3);
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+    if (!elemTy.isa<FloatType>())
+      return op->emitOpError()
+             << "spectral analysis supports only floating point types. "
+             << elemTy << " is passed";
+    FloatType floatTy = elemTy.cast<FloatType>();
+
+    Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
+    Value strideVal = rewriter.create<ConstantIndexOp>(loc, stride);
+
+    Value frames = rewriter.create<memref::DimOp>(loc, real, c0);
+    Value bins = rewriter.create<memref::DimOp>(loc, real, c1);
+    Value mels = rewriter.create<memref::DimOp>(loc, filterbank, c0);
+
+    VectorType vectorTy = VectorType::get({stride}, elemTy);
+    VectorType maskTy = VectorType::get({stride}, rewriter.getI1Type());
+    Value zr = rewriter.create<ConstantOp>(loc, rewriter.getZeroAttr(elemTy));
+    Value zeroVec = rewriter.create<vector::BroadcastOp>(loc, vectorTy, zr);
+
+    // Power spectrum of the current frame, reused by every mel band.
+    Value power = rewriter.create<memref::AllocOp>(
+        loc, MemRefType::get({ShapedType::kDynamic}, elemTy), ValueRange{bins});
+
+    rewriter.create<scf::ForOp>(
+        loc, c0, frames, c1, ValueRange{std::nullopt},
+        [&](OpBuilder &builder, Location loc, Value f, ValueRange iargs) {
+          builder.create<scf::ForOp>(
+              loc, c0, bins, strideVal, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value k,
+                  ValueRange itrargs) {
+                Value remaining = builder.create<SubIOp>(loc, bins, k);
+                Value mask =
+                    builder.create<CreateMaskOp>(loc, maskTy, remaining);
+                Value re = builder.create<MaskedLoadOp>(
+                    loc, vectorTy, real, ValueRange{f, k}, mask, zeroVec);
+                Value im = builder.create<MaskedLoadOp>(
+                    loc, vectorTy, imag, ValueRange{f, k}, mask, zeroVec);
+                Value p = builder.create<MulFOp>(loc, re, re);
+                p = builder.create<FMAOp>(loc, im, im, p);
+                builder.create<MaskedStoreOp>(loc, power, ValueRange{k}, mask,
+                                              p);
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+
+          builder.create<scf::ForOp>(
+              loc, c0, mels, c1, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value m,
+                  ValueRange itrargs) {
+                Value energy = dap::maskedRowDot(builder, loc, filterbank, m,
+                                                 power, bins, stride, floatTy);
+                builder.create<memref::StoreOp>(loc, energy, output,
+                                                ValueRange{f, m});
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+          builder.create<scf::YieldOp>(loc, std::nullopt);
+        });
+
+    rewriter.create<memref::DeallocOp>(loc, power);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
+class DAPMfccLowering : public OpRewritePattern<dap::MfccOp> {
+public:
+  using OpRewritePattern<dap::MfccOp>::OpRewritePattern;
+
+  explicit DAPMfccLowering(MLIRContext *context, int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dap::MfccOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    Value mel = op->getOperand(0);
+    Value dct = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+    if (!elemTy.isa<FloatType>())
+      return op->emitOpError()
+             << "spectral analysis supports only floating point types. "
+             << elemTy << " is passed";
+    FloatType floatTy = elemTy.cast<FloatType>();
+
+    Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
+    Value strideVal = rewriter.create<ConstantIndexOp>(loc, stride);
+
+    Value frames = rewriter.create<memref::DimOp>(loc, mel, c0);
+    Value mels = rewriter.create<memref::DimOp>(loc, mel, c1);
+    Value coeffs = rewriter.create<memref::DimOp>(loc, dct, c0);
+
+    VectorType vectorTy = VectorType::get({stride}, elemTy);
+    VectorType maskTy = VectorType::get({stride}, rewriter.getI1Type());
+    // Energies are floored before the logarithm so that silent bands stay
+    // finite.
+    Value floor =
+        rewriter.create<ConstantOp>(loc, rewriter.getFloatAttr(elemTy, 1e-10));
+    Value floorVec = rewriter.create<vector::BroadcastOp>(loc, vectorTy, floor);
+
+    // Log mel energies of the current frame, reused by every coefficient.
+    Value logMel = rewriter.create<memref::AllocOp>(
+        loc, MemRefType::get({ShapedType::kDynamic}, elemTy), ValueRange{mels});
+
+    rewriter.create<scf::ForOp>(
+        loc, c0, frames, c1, ValueRange{std::nullopt},
+        [&](OpBuilder &builder, Location loc, Value f, ValueRange iargs) {
+          builder.create<scf::ForOp>(
+              loc, c0, mels, strideVal, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value m,
+                  ValueRange itrargs) {
+                Value remaining = builder.create<SubIOp>(loc, mels, m);
+                Value mask =
+                    builder.create<CreateMaskOp>(loc, maskTy, remaining);
+                Value energy = builder.create<MaskedLoadOp>(
+                    loc, vectorTy, mel, ValueRange{f, m}, mask, floorVec);
+                energy = builder.create<MaxFOp>(loc, energy, floorVec);
+                Value logEnergy = builder.create<math::LogOp>(loc, energy);
+                builder.create<MaskedStoreOp>(loc, logMel, ValueRange{m}, mask,
+                                              logEnergy);
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+
+          builder.create<scf::ForOp>(
+              loc, c0, coeffs, c1, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value c,
+                  ValueRange itrargs) {
+                Value coeff = dap::maskedRowDot(builder, loc, dct, c, logMel,
+                                                mels, stride, floatTy);
+                builder.create<memref::StoreOp>(loc, coeff, output,
+                                                ValueRange{f, c});
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+          builder.create<scf::YieldOp>(loc, std::nullopt);
+        });
+
+    rewriter.create<memref::DeallocOp>(loc, logMel);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
+class DAPResampleLowering : public OpRewritePattern<dap::ResampleOp> {
+public:
+  using OpRewritePattern<dap::ResampleOp>::OpRewritePattern;
+
+  explicit DAPResampleLowering(MLIRContext *context, int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dap::ResampleOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value down = op->getOperand(3);
+    Value start = op->getOperand(4);
+
+    Type elemTy;
+    if (failed(getDAPElementType(op, elemTy)))
+      return failure();
+    if (!elemTy.isa<FloatType>())
+      return op->emitOpError()
+             << "resampling supports only floating point types. " << elemTy
+             << " is passed";
+
+    Value c0 = rewriter.create<ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<ConstantIndexOp>(loc, 1);
+    Value strideVal = rewriter.create<ConstantIndexOp>(loc, stride);
+
+    Value N = rewriter.create<memref::DimOp>(loc, input, c0);
+    Value up = rewriter.create<memref::DimOp>(loc, kernel, c0);
+    Value taps = rewriter.create<memref::DimOp>(loc, kernel, c1);
+    Value outputSize = rewriter.create<memref::DimOp>(loc, output, c0);
+    Value phases = rewriter.create<MinUIOp>(loc, up, outputSize);
+
+    VectorType vectorTy = VectorType::get({stride}, elemTy);
+    VectorType maskTy = VectorType::get({stride}, rewriter.getI1Type());
+    VectorType offsetTy = VectorType::get({stride}, rewriter.getI64Type());
+    Value zr = rewriter.create<ConstantOp>(loc, rewriter.getZeroAttr(elemTy));
+    Value zeroVec = rewriter.create<vector::BroadcastOp>(loc, vectorTy, zr);
+    Value zeroOffsets = rewriter.create<ConstantOp>(
+        loc, DenseElementsAttr::get(offsetTy, rewriter.getI64IntegerAttr(0)));
+    Value N64 = rewriter.create<IndexCastOp>(loc, rewriter.getI64Type(), N);
+    Value NVec = rewriter.create<vector::BroadcastOp>(loc, offsetTy, N64);
+
+    // Outputs n and n + up use the same phase and inputs `down` samples apart,
+    // so the outputs are split into `up` interleaved streams. Each stream is
+    // vectorised with its taps broadcast, its inputs gathered `down` apart and
+    // its outputs scattered `up` apart.
+    Value inputOffsets = buildChannelOffsets(rewriter, loc, stride, down);
+    Value outputOffsets = buildChannelOffsets(rewriter, loc, stride, up);
+
+    rewriter.create<scf::ForOp>(
+        loc, c0, phases, c1, ValueRange{std::nullopt},
+        [&](OpBuilder &builder, Location loc, Value r, ValueRange iargs) {
+          Value rDown = builder.create<MulIOp>(loc, r, down);
+          Value t = builder.create<AddIOp>(loc, start, rDown);
+          Value firstInput = builder.create<DivUIOp>(loc, t, up);
+          Value phase = builder.create<RemUIOp>(loc, t, up);
+          // ceil((outputSize - r) / up) outputs belong to this stream.
+          Value upMinusOne = builder.create<SubIOp>(loc, up, c1);
+          Value count = builder.create<SubIOp>(loc, outputSize, r);
+          count = builder.create<AddIOp>(loc, count, upMinusOne);
+          count = builder.create<DivUIOp>(loc, count, up);
+
+          builder.create<scf::ForOp>(
+              loc, c0, count, strideVal, ValueRange{std::nullopt},
+              [&](OpBuilder &builder, Location loc, Value v,
+                  ValueRange itrargs) {
+                Value remaining = builder.create<SubIOp>(loc, count, v);
+                Value laneMask =
+                    builder.create<CreateMaskOp>(loc, maskTy, remaining);
+                Value vDown = builder.create<MulIOp>(loc, v, down);
+                Value base = builder.create<AddIOp>(loc, firstInput, vDown);
+                Value base64 = builder.create<IndexCastOp>(
+                    loc, builder.getI64Type(), base);
+                Value baseVec =
+                    builder.create<vector::BroadcastOp>(loc, offsetTy, base64);
+                baseVec = builder.create<AddIOp>(loc, baseVec, inputOffsets);
+
+                auto acc = builder.create<scf::ForOp>(
+                    loc, c0, taps, c1, ValueRange{zeroVec},
+                    [&](OpBuilder &builder, Location loc, Value j,
+                        ValueRange accArgs) {
+                      Value j64 = builder.create<IndexCastOp>(
+                          loc, builder.getI64Type(), j);
+                      Value jVec = builder.create<vector::BroadcastOp>(
+                          loc, offsetTy, j64);
+                      Value idx = builder.create<SubIOp>(loc, baseVec, jVec);
+                      // Samples before the start or past the end are zero.
+                      Value aboveZero = builder.create<CmpIOp>(
+                          loc, CmpIPredicate::sge, idx, zeroOffsets);
+                      Value belowN = builder.create<CmpIOp>(
+                          loc, CmpIPredicate::slt, idx, NVec);
+                      Value mask =
+                          builder.create<AndIOp>(loc, aboveZero, belowN);
+                      mask = builder.create<AndIOp>(loc, mask, laneMask);
+                      Value x = builder.create<GatherOp>(
+                          loc, vectorTy, input, ValueRange{c0}, idx, mask,
+                          zeroVec);
+                      Value tap = builder.create<memref::LoadOp>(
+                          loc, kernel, ValueRange{phase, j});
+                      Value tapVec =
+                          builder.create<vector::BroadcastOp>(loc, vectorTy,
+                                                              tap);
+                      Value res =
+                          builder.create<FMAOp>(loc, tapVec, x, accArgs[0]);
+                      builder.create<scf::YieldOp>(loc, res);
+                    });
+
+                Value vUp = builder.create<MulIOp>(loc, v, up);
+                Value firstOutput = builder.create<AddIOp>(loc, r, vUp);
+                builder.create<ScatterOp>(loc, output, ValueRange{firstOutput},
+                                          outputOffsets, laneMask,
+                                          acc.getResult(0));
+                builder.create<scf::YieldOp>(loc, std::nullopt);
+              });
+          builder.create<scf::YieldOp>(loc, std::nullopt);
+        });
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
 } // end anonymous namespace
 
 void populateLowerDAPConversionPatterns(RewritePatternSet &patterns,
-                                        int64_t stride) {
+                                        int64_t stride, int64_t lanes) {
   patterns.add<DAPFirLowering>(patterns.getContext());
+  patterns.add<DAPFirFixedPointLowering>(patterns.getContext(), stride);
   patterns.add<DAPBiquadLowering>(patterns.getContext(), stride);
   patterns.add<DAPIirLowering>(patterns.getContext(), stride);
+  patterns.add<DAPBiquadChannelLowering>(patterns.getContext(), lanes);
+  patterns.add<DAPIirChannelLowering>(patterns.getContext(), lanes);
+  patterns.add<DAPStftLowering>(patterns.getContext(), lanes);
+  patterns.add<DAPMelFilterbankLowering>(patterns.getContext(), stride);
+  patterns.add<DAPMfccLowering>(patterns.getContext(), stride);
+  patterns.add<DAPResampleLowering>(patterns.getContext(), stride);
 }
 
 //===----------------------------------------------------------------------===//
@@ -333,11 +1254,18 @@ public:
   void getDependentDialects(DialectRegistry &registry) const override {
     registry.insert<buddy::dap::DAPDialect, func::FuncDialect,
                     memref::MemRefDialect, scf::SCFDialect, VectorDialect,
-                    affine::AffineDialect, arith::ArithDialect,linalg::LinalgDialect>();
+                    affine::AffineDialect, arith::ArithDialect,linalg::LinalgDialect,
+                    math::MathDialect>();
   }
   Option<int64_t> stride{*this, "DAP-vector-splitting",
                          llvm::cl::desc("Vector splitting size."),
                          llvm::cl::init(32)};
+  Option<int64_t> lanes{
+      *this, "DAP-channel-lanes",
+      llvm::cl::desc("Number of channels filtered per vector for multichannel "
+                     "(channels x samples) inputs, and of frames transformed "
+                     "per vector by the STFT."),
+      llvm::cl::init(8)};
 };
 } // end anonymous namespace.
 
@@ -349,11 +1277,11 @@ void LowerDAPPass::runOnOperation() {
   target.addLegalDialect<affine::AffineDialect, scf::SCFDialect,
                          func::FuncDialect, memref::MemRefDialect,
                          VectorDialect, arith::ArithDialect,
-                         linalg::LinalgDialect>();
+                         linalg::LinalgDialect, math::MathDialect>();
   target.addLegalOp<ModuleOp, func::FuncOp, func::ReturnOp>();
 
   RewritePatternSet patterns(context);
-  populateLowerDAPConversionPatterns(patterns, stride);
+  populateLowerDAPConversionPatterns(patterns, stride, lanes);
 
   if (failed(applyPartialConversion(module, target, std::move(patterns))))
     signalPassFailure();
@@ -28,6 +28,7 @@
 #include <mlir/IR/Builders.h>
 #include <mlir/IR/Location.h>
 #include <mlir/IR/MLIRContext.h>
+#include <mlir/IR/SymbolTable.h>
 #include <mlir/IR/ValueRange.h>
 #include <mlir/Pass/Pass.h>
 #include <vector>
@@ -46,13 +47,45 @@ using namespace buddy;
 
 namespace {
 
+// Reflect and wrap padding are implemented by dip.corr_2d and the morphology
+// operations. The other operations extrapolate from the image edge only.
+template <typename DIPOP>
+static LogicalResult checkEdgeBoundaryOption(DIPOP op) {
+  dip::BoundaryOption option = op.getBoundaryOption();
+  if (option == dip::BoundaryOption::ConstantPadding ||
+      option == dip::BoundaryOption::ReplicatePadding)
+    return success();
+  return op->emitOpError() << "supports only constant and replicate padding";
+}
+
+// Returns the coefficients of `kernel` when it is a constant 2-D
+// memref.global, possibly behind memref.cast, and null otherwise.
+static DenseElementsAttr getConstantKernel(Operation *op, Value kernel) {
+  while (auto castOp = kernel.getDefiningOp<memref::CastOp>())
+    kernel = castOp.getSource();
+  auto getGlobalOp = kernel.getDefiningOp<memref::GetGlobalOp>();
+  if (!getGlobalOp)
+    return {};
+  auto globalOp = SymbolTable::lookupNearestSymbolFrom<memref::GlobalOp>(
+      op, getGlobalOp.getNameAttr());
+  if (!globalOp || !globalOp.getConstant())
+    return {};
+  auto kernelAttr =
+      globalOp.getConstantInitValue().dyn_cast_or_null<DenseElementsAttr>();
+  if (!kernelAttr || kernelAttr.getType().getRank() != 2)
+    return {};
+  return kernelAttr;
+}
+
 class DIPCorr2DOpLowering : public OpRewritePattern<dip::Corr2DOp> {
 public:
   using OpRewritePattern<dip::Corr2DOp>::OpRewritePattern;
 
-  explicit DIPCorr2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPCorr2DOpLowering(MLIRContext *context, int64_t strideParam,
+                               int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
   LogicalResult matchAndRewrite(dip::Corr2DOp op,
@@ -82,10 +115,20 @@ public:
                                << inElemTy << "is passed";
     }
 
-    traverseImagewBoundaryExtrapolation(rewriter, loc, ctx, input, kernel,
-                                        output, centerX, centerY, constantValue,
-                                        strideVal, inElemTy, boundaryOptionAttr,
-                                        stride, dip::DIP_OP::CORRELATION_2D);
+    // Kernels known at compile time get an unrolled tap sequence instead of
+    // loads and zero checks of every coefficient.
+    if (DenseElementsAttr kernelAttr = getConstantKernel(op, kernel)) {
+      dip::constantCorrelation2D(rewriter, loc, input, kernelAttr, output,
+                                 centerX, centerY, constantValue,
+                                 boundaryOptionAttr, stride, rowGrain);
+      rewriter.eraseOp(op);
+      return success();
+    }
+
+    traverseImagewBoundaryExtrapolation(
+        rewriter, loc, ctx, input, kernel, output, centerX, centerY,
+        constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
+        dip::DIP_OP::CORRELATION_2D, rowGrain);
     // Remove the origin convolution operation.
     rewriter.eraseOp(op);
     return success();
@@ -93,6 +136,59 @@ public:
 
 private:
   int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPSepCorr2DOpLowering : public OpRewritePattern<dip::SepCorr2DOp> {
+public:
+  using OpRewritePattern<dip::SepCorr2DOp>::OpRewritePattern;
+
+  explicit DIPSepCorr2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::SepCorr2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernelX = op->getOperand(1);
+    Value kernelY = op->getOperand(2);
+    Value output = op->getOperand(3);
+    Value centerX = op->getOperand(4);
+    Value centerY = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::SepCorr2DOp>(
+        op, {input, kernelX, kernelY, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError() << "input, kernels, output and constant must "
+                                  "have the same element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
+    }
+    if (failed(checkEdgeBoundaryOption(op)))
+      return failure();
+
+    dip::separableCorrelation2D(rewriter, loc, input, kernelX, kernelY, output,
+                                centerX, centerY, constantValue, inElemTy,
+                                boundaryOptionAttr, stride, rowGrain);
+    // Remove the origin separable correlation operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
 };
 
 class DIPCorrFFT2DOpLowering : public OpRewritePattern<dip::CorrFFT2DOp> {
@@ -113,56 +209,134 @@ public:
     // Create constant indices.
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
     Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    Value c2 = rewriter.create<arith::ConstantIndexOp>(loc, 2);
 
     // Register operand values.
-    Value inputReal = op->getOperand(0);
-    Value inputImag = op->getOperand(1);
-    Value kernelReal = op->getOperand(2);
-    Value kernelImag = op->getOperand(3);
-    Value intermediateReal = op->getOperand(4);
-    Value intermediateImag = op->getOperand(5);
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value strideX = op->getOperand(3);
+    Value strideY = op->getOperand(4);
 
     // Create DimOp for padded input image.
-    Value inputRow = rewriter.create<memref::DimOp>(loc, inputReal, c0);
-    Value inputCol = rewriter.create<memref::DimOp>(loc, inputReal, c1);
-
-    // Create DimOp for padded original kernel.
-    Value kernelRow = rewriter.create<memref::DimOp>(loc, kernelReal, c0);
-    Value kernelCol = rewriter.create<memref::DimOp>(loc, kernelReal, c1);
+    Value inputRow = rewriter.create<memref::DimOp>(loc, input, c0);
+    Value inputCol = rewriter.create<memref::DimOp>(loc, input, c1);
 
     FloatType f32 = FloatType::getF32(ctx);
-    VectorType vectorTy32 = VectorType::get({stride}, f32);
+    MemRefType containerTy =
+        MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, f32);
+
+    // Compute the twiddle tables and the kernel spectrum, which
+    // dip.corrfft_2d_planned takes precomputed.
+    Value rowTwiddles = rewriter.create<memref::AllocOp>(
+        loc, containerTy, ValueRange{c2, inputCol});
+    Value colTwiddles = rewriter.create<memref::AllocOp>(
+        loc, containerTy, ValueRange{c2, inputRow});
+    fftTwiddles(rewriter, loc, rowTwiddles, inputCol, c0, c1);
+    fftTwiddles(rewriter, loc, colTwiddles, inputRow, c0, c1);
+
+    Value spectrumCol = rewriter.create<arith::AddIOp>(
+        loc, rewriter.create<arith::DivUIOp>(loc, inputCol, c2), c1);
+    Value kernelReal = rewriter.create<memref::AllocOp>(
+        loc, containerTy, ValueRange{inputRow, spectrumCol});
+    Value kernelImag = rewriter.create<memref::AllocOp>(
+        loc, containerTy, ValueRange{inputRow, spectrumCol});
+    rfft2D(rewriter, loc, kernel, kernelReal, kernelImag, rowTwiddles,
+           colTwiddles, inputRow, inputCol, c0, c1);
+
+    dip::correlationFFT2D(rewriter, loc, input, kernelReal, kernelImag,
+                          rowTwiddles, colTwiddles, output, strideX, strideY,
+                          stride);
+
+    for (Value buffer : {rowTwiddles, colTwiddles, kernelReal, kernelImag})
+      rewriter.create<memref::DeallocOp>(loc, buffer);
 
-    dft2D(rewriter, loc, inputReal, inputImag, inputRow, inputCol,
-          intermediateReal, intermediateImag, c0, c1, strideVal, vectorTy32);
+    // Remove the origin convolution operation involving FFT.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
 
-    dft2D(rewriter, loc, kernelReal, kernelImag, kernelRow, kernelCol,
-          intermediateReal, intermediateImag, c0, c1, strideVal, vectorTy32);
+class DIPRFFT2DOpLowering : public OpRewritePattern<dip::RFFT2DOp> {
+public:
+  using OpRewritePattern<dip::RFFT2DOp>::OpRewritePattern;
 
-    vector2DMemRefMultiply(rewriter, loc, inputReal, inputImag, kernelReal,
-                           kernelImag, inputReal, inputImag, inputRow, inputCol,
-                           c0, vectorTy32);
+  explicit DIPRFFT2DOpLowering(MLIRContext *context)
+      : OpRewritePattern(context) {}
 
-    idft2D(rewriter, loc, inputReal, inputImag, inputRow, inputCol,
-           intermediateReal, intermediateImag, c0, c1, strideVal, vectorTy32);
+  LogicalResult matchAndRewrite(dip::RFFT2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
 
-    // Remove the origin convolution operation involving FFT.
+    // Create constant indices.
+    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value spectrumReal = op->getOperand(1);
+    Value spectrumImag = op->getOperand(2);
+    Value rowTwiddles = op->getOperand(3);
+    Value colTwiddles = op->getOperand(4);
+
+    Value inputRow = rewriter.create<memref::DimOp>(loc, input, c0);
+    Value inputCol = rewriter.create<memref::DimOp>(loc, input, c1);
+
+    rfft2D(rewriter, loc, input, spectrumReal, spectrumImag, rowTwiddles,
+           colTwiddles, inputRow, inputCol, c0, c1);
+
+    // Remove the origin FFT operation.
     rewriter.eraseOp(op);
     return success();
   }
+};
 
-private:
-  int64_t stride;
+class DIPCorrFFT2DPlannedOpLowering
+    : public OpRewritePattern<dip::CorrFFT2DPlannedOp> {
+public:
+  using OpRewritePattern<dip::CorrFFT2DPlannedOp>::OpRewritePattern;
+
+  explicit DIPCorrFFT2DPlannedOpLowering(MLIRContext *context)
+      : OpRewritePattern(context) {}
+
+  LogicalResult matchAndRewrite(dip::CorrFFT2DPlannedOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernelReal = op->getOperand(1);
+    Value kernelImag = op->getOperand(2);
+    Value rowTwiddles = op->getOperand(3);
+    Value colTwiddles = op->getOperand(4);
+    Value output = op->getOperand(5);
+    Value strideX = op->getOperand(6);
+    Value strideY = op->getOperand(7);
+
+    // The spectrum product steps one column at a time with unmasked vector
+    // loads, so wider vectors would read past the half spectrum.
+    dip::correlationFFT2D(rewriter, loc, input, kernelReal, kernelImag,
+                          rowTwiddles, colTwiddles, output, strideX, strideY,
+                          /*stride=*/1);
+
+    // Remove the origin convolution operation involving FFT.
+    rewriter.eraseOp(op);
+    return success();
+  }
 };
 
 class DIPRotate2DOpLowering : public OpRewritePattern<dip::Rotate2DOp> {
 public:
   using OpRewritePattern<dip::Rotate2DOp>::OpRewritePattern;
 
-  explicit DIPRotate2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPRotate2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
   LogicalResult matchAndRewrite(dip::Rotate2DOp op,
@@ -174,6 +348,7 @@ public:
     Value input = op->getOperand(0);
     Value angleVal = op->getOperand(1);
     Value output = op->getOperand(2);
+    auto interpolationAttr = op.getInterpolationType();
 
     auto inElemTy = input.getType().cast<MemRefType>().getElementType();
     dip::DIP_ERROR error =
@@ -186,6 +361,16 @@ public:
       return op->emitOpError() << "supports only f32, f64 and integer types. "
                                << inElemTy << "is passed";
     }
+    if (interpolationAttr !=
+            dip::InterpolationType::NearestNeighbourInterpolation &&
+        !inElemTy.isa<FloatType>()) {
+      return op->emitOpError()
+             << "supports only f32 and f64 types with interpolating remaps. "
+             << inElemTy << "is passed";
+    }
+    if (interpolationAttr == dip::InterpolationType::AreaInterpolation) {
+      return op->emitOpError() << "does not support area interpolation";
+    }
 
     // Create constant indices.
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
@@ -226,7 +411,9 @@ public:
         rewriter.create<arith::AddFOp>(loc, affineMatrix[5], deltaYFDiv2);
 
     dip::affineTransformController(rewriter, loc, ctx, input, output,
-                                   affineMatrix, stride);
+                                   affineMatrix, stride,
+                                   static_cast<int>(interpolationAttr),
+                                   rowGrain);
 
     // Remove the origin rotation operation.
     rewriter.eraseOp(op);
@@ -234,15 +421,18 @@ public:
   }
 
   int64_t stride;
+  int64_t rowGrain;
 };
 
 class DIPResize2DOpLowering : public OpRewritePattern<dip::Resize2DOp> {
 public:
   using OpRewritePattern<dip::Resize2DOp>::OpRewritePattern;
 
-  explicit DIPResize2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPResize2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
   LogicalResult matchAndRewrite(dip::Resize2DOp op,
@@ -269,6 +459,24 @@ public:
       return op->emitOpError() << "supports only f32, f64 and integer types. "
                                << inElemTy << "is passed";
     }
+    if (interpolationAttr !=
+            dip::InterpolationType::NearestNeighbourInterpolation &&
+        interpolationAttr != dip::InterpolationType::BilinearInterpolation) {
+      // Bicubic, Lanczos and area interpolation filter the input.
+      if (!inElemTy.isa<FloatType>()) {
+        return op->emitOpError()
+               << "supports only f32 and f64 types with bicubic, Lanczos and "
+                  "area interpolation. "
+               << inElemTy << "is passed";
+      }
+      dip::SeparableFilterResizing(rewriter, loc, input, output,
+                                   horizontalScalingFactor,
+                                   verticalScalingFactor,
+                                   static_cast<int>(interpolationAttr), stride,
+                                   rowGrain);
+      rewriter.eraseOp(op);
+      return success();
+    }
 
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
     Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
@@ -327,13 +535,13 @@ public:
           rewriter, loc, ctx, lowerBounds1, upperBounds1, steps, strideVal,
           input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
           outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32);
+          inputColLastElemF32, vectorTy32, stride, c0, c0F32, rowGrain);
 
       dip::NearestNeighbourInterpolationResizing(
           rewriter, loc, ctx, lowerBounds2, upperBounds2, steps, strideTailVal,
           input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
           outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32);
+          inputColLastElemF32, vectorTy32, stride, c0, c0F32, rowGrain);
     } else if (interpolationAttr ==
                dip::InterpolationType::BilinearInterpolation) {
       Value c1F32 = indexToF32(rewriter, loc, c1);
@@ -342,13 +550,15 @@ public:
           rewriter, loc, ctx, lowerBounds1, upperBounds1, steps, strideVal,
           input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
           outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32, c1F32);
+          inputColLastElemF32, vectorTy32, stride, c0, c0F32, c1F32,
+          rowGrain);
 
       dip::BilinearInterpolationResizing(
           rewriter, loc, ctx, lowerBounds2, upperBounds2, steps, strideTailVal,
           input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
           outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32, c1F32);
+          inputColLastElemF32, vectorTy32, stride, c0, c0F32, c1F32,
+          rowGrain);
     }
 
     // Remove the original resize operation.
@@ -358,239 +568,290 @@ public:
 
 private:
   int64_t stride;
+  int64_t rowGrain;
 };
 
-class DIPErosion2DOpLowering : public OpRewritePattern<dip::Erosion2DOp> {
+// Check the operands of dip.warp_affine_2d and dip.warp_perspective_2d, load
+// the rows x 3 entries of their matrix and derive the border handling of the
+// remap.
+template <typename DIPOP>
+static LogicalResult prepareWarp2D(DIPOP op, PatternRewriter &rewriter,
+                                   int64_t rows,
+                                   SmallVector<Value, 9> &matrixEntries,
+                                   RemapBorder &border) {
+  auto loc = op->getLoc();
+  Value input = op->getOperand(0);
+  Value matrix = op->getOperand(1);
+  Value output = op->getOperand(2);
+  Value constantValue = op->getOperand(3);
+
+  auto inElemTy = input.getType().template cast<MemRefType>().getElementType();
+  dip::DIP_ERROR error =
+      dip::checkDIPCommonTypes<DIPOP>(op, {input, output, constantValue});
+
+  if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+    return op->emitOpError() << "input, output and constant must have the "
+                                "same element type";
+  } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+    return op->emitOpError() << "supports only f32, f64 and integer types. "
+                             << inElemTy << "is passed";
+  }
+  if (op.getInterpolationType() !=
+          dip::InterpolationType::NearestNeighbourInterpolation &&
+      !inElemTy.isa<FloatType>()) {
+    return op->emitOpError()
+           << "supports only f32 and f64 types with interpolating remaps. "
+           << inElemTy << "is passed";
+  }
+  if (op.getInterpolationType() == dip::InterpolationType::AreaInterpolation) {
+    return op->emitOpError() << "does not support area interpolation";
+  }
+  auto matrixTy = matrix.getType().template dyn_cast<MemRefType>();
+  if (!matrixTy || matrixTy.getRank() != 2 ||
+      !matrixTy.getElementType().isF32() ||
+      (matrixTy.hasStaticShape() &&
+       (matrixTy.getDimSize(0) != rows || matrixTy.getDimSize(1) != 3))) {
+    return op->emitOpError() << "expects a " << rows << "x3 f32 matrix";
+  }
+  if (failed(checkEdgeBoundaryOption(op)))
+    return failure();
+
+  for (int64_t i = 0; i < rows; ++i)
+    for (int64_t j = 0; j < 3; ++j)
+      matrixEntries.push_back(rewriter.create<memref::LoadOp>(
+          loc, matrix,
+          ValueRange{rewriter.create<arith::ConstantIndexOp>(loc, i),
+                     rewriter.create<arith::ConstantIndexOp>(loc, j)}));
+
+  if (op.getBoundaryOption() == dip::BoundaryOption::ReplicatePadding)
+    border.replicate = true;
+  else
+    border.value = constantValue;
+  return success();
+}
+
+class DIPWarpAffine2DOpLowering
+    : public OpRewritePattern<dip::WarpAffine2DOp> {
 public:
-  using OpRewritePattern<dip::Erosion2DOp>::OpRewritePattern;
+  using OpRewritePattern<dip::WarpAffine2DOp>::OpRewritePattern;
 
-  explicit DIPErosion2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPWarpAffine2DOpLowering(MLIRContext *context,
+                                     int64_t strideParam,
+                                     int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
-  LogicalResult matchAndRewrite(dip::Erosion2DOp op,
+  LogicalResult matchAndRewrite(dip::WarpAffine2DOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto *ctx = op->getContext();
+    auto ctx = op->getContext();
 
-    // Register operand values.
-    Value input = op->getOperand(0);
-    Value kernel = op->getOperand(1);
-    Value output = op->getOperand(2);
-    Value copymemref = op->getOperand(3);
-    Value centerX = op->getOperand(4);
-    Value centerY = op->getOperand(5);
-    Value iterations = op->getOperand(6);
-    Value constantValue = op->getOperand(7);
-    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+    SmallVector<Value, 9> matrixEntries;
+    RemapBorder border;
+    if (failed(prepareWarp2D(op, rewriter, 2, matrixEntries, border)))
+      return failure();
 
-    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
-    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Erosion2DOp>(
-        op, {input, kernel, output, copymemref, constantValue});
+    dip::affineTransformController(
+        rewriter, loc, ctx, op->getOperand(0), op->getOperand(2),
+        SmallVector<Value, 6>(matrixEntries.begin(), matrixEntries.end()),
+        stride, static_cast<int>(op.getInterpolationType()), rowGrain,
+        border);
 
-    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
-      return op->emitOpError()
-             << "input, kernel, output, copymemref and constant must "
-                "have the same element type";
-    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
-      return op->emitOpError() << "supports only f32, f64 and integer types. "
-                               << inElemTy << "is passed";
-    }
+    // Remove the origin affine warp operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
 
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPWarpPerspective2DOpLowering
+    : public OpRewritePattern<dip::WarpPerspective2DOp> {
+public:
+  using OpRewritePattern<dip::WarpPerspective2DOp>::OpRewritePattern;
+
+  explicit DIPWarpPerspective2DOpLowering(MLIRContext *context,
+                                          int64_t strideParam,
+                                          int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
 
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output, input);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref, output);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input, kernel, output, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
+  LogicalResult matchAndRewrite(dip::WarpPerspective2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
 
-    // Remove the origin erosion operation.
+    SmallVector<Value, 9> matrixEntries;
+    RemapBorder border;
+    if (failed(prepareWarp2D(op, rewriter, 3, matrixEntries, border)))
+      return failure();
+
+    dip::perspectiveTransformController(
+        rewriter, loc, op->getOperand(0), op->getOperand(2), matrixEntries,
+        stride, static_cast<int>(op.getInterpolationType()), rowGrain,
+        border);
+
+    // Remove the origin perspective warp operation.
     rewriter.eraseOp(op);
     return success();
   }
 
 private:
   int64_t stride;
+  int64_t rowGrain;
 };
 
-class DIPDilation2DOpLowering : public OpRewritePattern<dip::Dilation2DOp> {
+// Checks the element types of the pyramid operations, whose input and levels
+// must share a float type, and that at least `minLevels` levels are given.
+template <typename DIPOP>
+static LogicalResult preparePyramid2D(DIPOP op, size_t minLevels) {
+  Value input = op->getOperand(0);
+  auto inElemTy = input.getType().template cast<MemRefType>().getElementType();
+  std::vector<Value> args(op->getOperands().begin(), op->getOperands().end());
+  dip::DIP_ERROR error = dip::checkDIPCommonTypes<DIPOP>(op, args);
+
+  if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+    return op->emitOpError() << "input and levels must have the same element "
+                                "type";
+  } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE ||
+             !inElemTy.isa<FloatType>()) {
+    return op->emitOpError() << "supports only f32 and f64 types. " << inElemTy
+                             << "is passed";
+  }
+  if (op.getLevels().size() < minLevels) {
+    return op->emitOpError() << "expects at least " << minLevels
+                             << " level memrefs";
+  }
+  return checkEdgeBoundaryOption(op);
+}
 
+class DIPGaussianPyramid2DOpLowering
+    : public OpRewritePattern<dip::GaussianPyramid2DOp> {
 public:
-  using OpRewritePattern<dip::Dilation2DOp>::OpRewritePattern;
+  using OpRewritePattern<dip::GaussianPyramid2DOp>::OpRewritePattern;
 
-  explicit DIPDilation2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPGaussianPyramid2DOpLowering(MLIRContext *context,
+                                          int64_t strideParam,
+                                          int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
-  LogicalResult matchAndRewrite(dip::Dilation2DOp op,
+  LogicalResult matchAndRewrite(dip::GaussianPyramid2DOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto *ctx = op->getContext();
+    if (failed(preparePyramid2D(op, 1)))
+      return failure();
+
+    // Every level is reduced from the previous one.
+    Value source = op->getOperand(0);
+    for (Value level : op.getLevels()) {
+      dip::pyramidDown(rewriter, loc, source, level, op.getBoundaryOption(),
+                       stride, rowGrain);
+      source = level;
+    }
 
-    // Register operand values.
-    Value input = op->getOperand(0);
-    Value kernel = op->getOperand(1);
-    Value output = op->getOperand(2);
-    Value copymemref = op->getOperand(3);
-    Value centerX = op->getOperand(4);
-    Value centerY = op->getOperand(5);
-    Value iterations = op->getOperand(6);
-    Value constantValue = op->getOperand(7);
-    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+    // Remove the origin Gaussian pyramid operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
 
-    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
-    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Dilation2DOp>(
-        op, {input, kernel, output, copymemref, constantValue});
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
 
-    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
-      return op->emitOpError()
-             << "input, kernel, output, copymemref and constant must "
-                "have the same element type";
-    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
-      return op->emitOpError() << "supports only f32, f64 and integer types. "
-                               << inElemTy << "is passed";
+class DIPLaplacianPyramid2DOpLowering
+    : public OpRewritePattern<dip::LaplacianPyramid2DOp> {
+public:
+  using OpRewritePattern<dip::LaplacianPyramid2DOp>::OpRewritePattern;
+
+  explicit DIPLaplacianPyramid2DOpLowering(MLIRContext *context,
+                                           int64_t strideParam,
+                                           int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::LaplacianPyramid2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    if (failed(preparePyramid2D(op, 2)))
+      return failure();
+
+    // The Gaussian levels G1 ... GN are built in the memrefs following L0,
+    // each with the size of its Gaussian level.
+    ValueRange levels = op.getLevels();
+    Value source = op->getOperand(0);
+    for (Value level : levels.drop_front()) {
+      dip::pyramidDown(rewriter, loc, source, level, op.getBoundaryOption(),
+                       stride, rowGrain);
+      source = level;
     }
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
 
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output, input);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref, output);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input, kernel, output, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
+    // Li = Gi - up(G(i+1)) overwrites Gi, which later levels no longer read,
+    // and GN stays in the last memref as the residual.
+    for (size_t i = 0; i + 1 < levels.size(); ++i) {
+      Value fine = i == 0 ? op->getOperand(0) : levels[i];
+      dip::pyramidUpSubtract(rewriter, loc, levels[i + 1], fine, levels[i],
+                             op.getBoundaryOption(), stride, rowGrain);
+    }
 
-    // Remove the origin dilation operation.
+    // Remove the origin Laplacian pyramid operation.
     rewriter.eraseOp(op);
     return success();
   }
 
 private:
   int64_t stride;
+  int64_t rowGrain;
 };
 
-class DIPOpening2DOpLowering : public OpRewritePattern<dip::Opening2DOp> {
+class DIPIntegralImage2DOpLowering
+    : public OpRewritePattern<dip::IntegralImage2DOp> {
 public:
-  using OpRewritePattern<dip::Opening2DOp>::OpRewritePattern;
+  using OpRewritePattern<dip::IntegralImage2DOp>::OpRewritePattern;
 
-  explicit DIPOpening2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPIntegralImage2DOpLowering(MLIRContext *context,
+                                        int64_t strideParam)
       : OpRewritePattern(context) {
     stride = strideParam;
   }
 
-  LogicalResult matchAndRewrite(dip::Opening2DOp op,
+  LogicalResult matchAndRewrite(dip::IntegralImage2DOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto *ctx = op->getContext();
 
     // Register operand values.
     Value input = op->getOperand(0);
-    Value kernel = op->getOperand(1);
-    Value output = op->getOperand(2);
-    Value output1 = op->getOperand(3);
-    Value copymemref = op->getOperand(4);
-    Value copymemref1 = op->getOperand(5);
-    Value centerX = op->getOperand(6);
-    Value centerY = op->getOperand(7);
-    Value iterations = op->getOperand(8);
-    Value constantValue = op->getOperand(9);
-    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+    Value sum = op->getOperand(1);
+    Value squareSum = op.getMemrefSq();
 
     auto inElemTy = input.getType().cast<MemRefType>().getElementType();
-    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Opening2DOp>(
-        op, {input, kernel, output, output1, copymemref, copymemref1,
-             constantValue});
+    std::vector<Value> args{input, sum};
+    if (squareSum)
+      args.push_back(squareSum);
+    dip::DIP_ERROR error =
+        dip::checkDIPCommonTypes<dip::IntegralImage2DOp>(op, args);
 
     if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
-      return op->emitOpError() << "input, kernel, output, output1, copymemref, "
-                                  "copymemref1 and constant must "
-                                  "have the same element type";
+      return op->emitOpError() << "sums must have a float type at least as "
+                                  "wide as the input";
     } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
-      return op->emitOpError() << "supports only f32, f64 and integer types. "
+      return op->emitOpError() << "supports only f32 and f64 types. "
                                << inElemTy << "is passed";
     }
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
 
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output1, input);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input, kernel, output1, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
-
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output, output1);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref1, output);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, output1, kernel, output, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
+    dip::integralImage(rewriter, loc, input, sum, squareSum, stride);
 
-    // Remove the origin opening operation.
+    // Remove the origin integral image operation.
     rewriter.eraseOp(op);
     return success();
   }
@@ -599,725 +860,924 @@ private:
   int64_t stride;
 };
 
-class DIPClosing2DOpLowering : public OpRewritePattern<dip::Closing2DOp> {
+class DIPBoxFilter2DOpLowering : public OpRewritePattern<dip::BoxFilter2DOp> {
 public:
-  using OpRewritePattern<dip::Closing2DOp>::OpRewritePattern;
+  using OpRewritePattern<dip::BoxFilter2DOp>::OpRewritePattern;
 
-  explicit DIPClosing2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPBoxFilter2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                    int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
-  LogicalResult matchAndRewrite(dip::Closing2DOp op,
+  LogicalResult matchAndRewrite(dip::BoxFilter2DOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto *ctx = op->getContext();
 
     // Register operand values.
     Value input = op->getOperand(0);
-    Value kernel = op->getOperand(1);
-    Value output = op->getOperand(2);
-    Value output1 = op->getOperand(3);
-    Value copymemref = op->getOperand(4);
-    Value copymemref1 = op->getOperand(5);
-    Value centerX = op->getOperand(6);
-    Value centerY = op->getOperand(7);
-    Value iterations = op->getOperand(8);
-    Value constantValue = op->getOperand(9);
+    Value output = op->getOperand(1);
+    Value kernelWidth = op->getOperand(2);
+    Value kernelHeight = op->getOperand(3);
+    Value centerX = op->getOperand(4);
+    Value centerY = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
     dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
 
     auto inElemTy = input.getType().cast<MemRefType>().getElementType();
-    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Closing2DOp>(
-        op, {input, kernel, output, output1, copymemref, copymemref1,
-             constantValue});
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::BoxFilter2DOp>(
+        op, {input, output, constantValue});
 
     if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
-      return op->emitOpError() << "input, kernel, output, output1, copymemref, "
-                                  "copymemref1 and constant must "
-                                  "have the same element type";
+      return op->emitOpError() << "input, output and constant must have the "
+                                  "same element type";
     } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
-      return op->emitOpError() << "supports only f32, f64 and integer types. "
+      return op->emitOpError() << "supports only f32 and f64 types. "
                                << inElemTy << "is passed";
     }
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    if (failed(checkEdgeBoundaryOption(op)))
+      return failure();
 
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output1, input);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input, kernel, output1, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
-
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output, output1);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref1, output);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, output1, kernel, output, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
+    dip::boxFilter(rewriter, loc, input, output, kernelWidth, kernelHeight,
+                   centerX, centerY, constantValue, boundaryOptionAttr, stride,
+                   rowGrain);
 
-    // Remove the origin closing operation.
+    // Remove the origin box filter operation.
     rewriter.eraseOp(op);
     return success();
   }
 
 private:
   int64_t stride;
+  int64_t rowGrain;
 };
 
-class DIPTopHat2DOpLowering : public OpRewritePattern<dip::TopHat2DOp> {
+class DIPMedianBlur2DOpLowering
+    : public OpRewritePattern<dip::MedianBlur2DOp> {
 public:
-  using OpRewritePattern<dip::TopHat2DOp>::OpRewritePattern;
+  using OpRewritePattern<dip::MedianBlur2DOp>::OpRewritePattern;
 
-  explicit DIPTopHat2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPMedianBlur2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                     int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
-  LogicalResult matchAndRewrite(dip::TopHat2DOp op,
+  LogicalResult matchAndRewrite(dip::MedianBlur2DOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto *ctx = op->getContext();
-
-    // Create constant indices.
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
 
     // Register operand values.
     Value input = op->getOperand(0);
-    Value kernel = op->getOperand(1);
-    Value output = op->getOperand(2);
-    Value output1 = op->getOperand(3);
-    Value output2 = op->getOperand(4);
-    Value input1 = op->getOperand(5);
-    Value copymemref = op->getOperand(6);
-    Value copymemref1 = op->getOperand(7);
-    Value centerX = op->getOperand(8);
-    Value centerY = op->getOperand(9);
-    Value iterations = op->getOperand(10);
-    Value constantValue = op->getOperand(11);
+    Value output = op->getOperand(1);
+    Value constantValue = op->getOperand(2);
+    int64_t kernelSize = op.getKernelSize();
     dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
 
     auto inElemTy = input.getType().cast<MemRefType>().getElementType();
-    auto bitWidth = inElemTy.getIntOrFloatBitWidth();
-    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::TopHat2DOp>(
-        op, {input, kernel, output, output1, output2, input1, copymemref,
-             copymemref1, constantValue});
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::MedianBlur2DOp>(
+        op, {input, output, constantValue});
 
     if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
-      return op->emitOpError()
-             << "input, kernel, output, output1, output2, input1, copymemref, "
-                "copymemref1 and constant must "
-                "have the same element type";
+      return op->emitOpError() << "input, output and constant must have the "
+                                  "same element type";
     } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
       return op->emitOpError() << "supports only f32, f64 and integer types. "
                                << inElemTy << "is passed";
     }
-    rewriter.create<memref::CopyOp>(loc, input, input1);
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output1, input1);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input1, kernel, output1, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
-
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output2, output1);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref1, output2);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, output1, kernel, output2, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
-
-    Value outputRow = rewriter.create<memref::DimOp>(loc, output, c0);
-    Value outputCol = rewriter.create<memref::DimOp>(loc, output, c1);
-
-    SmallVector<Value, 8> lowerbounds4(2, c0);
-    SmallVector<Value, 8> upperbounds4{outputRow, outputCol};
-    SmallVector<int64_t, 8> steps4{1, stride};
-    VectorType vectorTy32 = VectorType::get({stride}, inElemTy);
-    IntegerType i1 = IntegerType::get(ctx, 1);
-    VectorType vectorMaskTy = VectorType::get({stride}, i1);
-    Value zeroPaddingElem =
-        dip::insertZeroConstantOp(ctx, rewriter, loc, inElemTy);
-    Value zeroPaddingVec =
-        rewriter.create<vector::BroadcastOp>(loc, vectorTy32, zeroPaddingElem);
-
-    if (inElemTy.isF32() || inElemTy.isF64()) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
-          [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
-            Value pseudoCol =
-                builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
-            Value pseudoCol1 =
-                builder.create<arith::SubIOp>(loc, pseudoCol, c1);
-            Value cond = builder.create<arith::CmpIOp>(
-                loc, arith::CmpIPredicate::sgt, pseudoCol1, outputCol);
-            builder.create<scf::IfOp>(
-                loc, cond,
-                [&](OpBuilder &builder, Location loc) {
-                  Value res =
-                      builder.create<arith::SubIOp>(loc, pseudoCol1, outputCol);
-                  Value maskVal =
-                      builder.create<arith::SubIOp>(loc, strideVal, res);
-                  Value maskVec = builder.create<vector::CreateMaskOp>(
-                      loc, vectorMaskTy, maskVal);
-                  Value ou1 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value ou2 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, input, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou2, ou1);
-                  builder.create<vector::MaskedStoreOp>(
-                      loc, output, ValueRange{ivs4[0], ivs4[1]}, maskVec,
-                      resVec);
-                  builder.create<scf::YieldOp>(loc);
-                },
-                [&](OpBuilder &builder, Location loc) {
-                  Value ou1 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]});
-                  Value ou2 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, input, ValueRange{ivs4[0], ivs4[1]});
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou2, ou1);
-                  builder.create<vector::StoreOp>(loc, resVec, output,
-                                                  ValueRange{ivs4[0], ivs4[1]});
-                  builder.create<scf::YieldOp>(loc);
-                });
-          }
-
-      );
-    } else if (inElemTy.isInteger(bitWidth)) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
-          [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
-            Value pseudoCol =
-                builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
-            Value pseudoCol1 =
-                builder.create<arith::SubIOp>(loc, pseudoCol, c1);
-            Value cond = builder.create<arith::CmpIOp>(
-                loc, arith::CmpIPredicate::sgt, pseudoCol1, outputCol);
-            builder.create<scf::IfOp>(
-                loc, cond,
-                [&](OpBuilder &builder, Location loc) {
-                  Value res =
-                      builder.create<arith::SubIOp>(loc, pseudoCol1, outputCol);
-                  Value maskVal =
-                      builder.create<arith::SubIOp>(loc, strideVal, res);
-                  Value maskVec = builder.create<vector::CreateMaskOp>(
-                      loc, vectorMaskTy, maskVal);
-                  Value ou1 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output1, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value ou2 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value resVec = builder.create<arith::SubIOp>(loc, ou1, ou2);
-                  builder.create<vector::MaskedStoreOp>(
-                      loc, output, ValueRange{ivs4[0], ivs4[1]}, maskVec,
-                      resVec);
-                  builder.create<scf::YieldOp>(loc);
-                },
-                [&](OpBuilder &builder, Location loc) {
-                  Value ou1 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output1, ValueRange{ivs4[0], ivs4[1]});
-                  Value ou2 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]});
-                  Value resVec = builder.create<arith::SubIOp>(loc, ou1, ou2);
-                  builder.create<vector::StoreOp>(loc, resVec, output,
-                                                  ValueRange{ivs4[0], ivs4[1]});
-                  builder.create<scf::YieldOp>(loc);
-                });
-          }
-
-      );
+    // The sorting networks are unrolled, so their size is bounded.
+    if (kernelSize != 3 && kernelSize != 5 && kernelSize != 7) {
+      return op->emitOpError() << "supports kernel sizes 3, 5 and 7. "
+                               << kernelSize << " is passed";
     }
 
-    // Remove the origin tophat operation.
+    dip::medianBlur(rewriter, loc, input, output, constantValue, kernelSize,
+                    boundaryOptionAttr, stride, rowGrain);
+
+    // Remove the origin median blur operation.
     rewriter.eraseOp(op);
     return success();
   }
 
 private:
   int64_t stride;
+  int64_t rowGrain;
 };
 
-class DIPBottomHat2DOpLowering : public OpRewritePattern<dip::BottomHat2DOp> {
+class DIPGradient2DOpLowering : public OpRewritePattern<dip::Gradient2DOp> {
 public:
-  using OpRewritePattern<dip::BottomHat2DOp>::OpRewritePattern;
+  using OpRewritePattern<dip::Gradient2DOp>::OpRewritePattern;
 
-  explicit DIPBottomHat2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPGradient2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                   int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
-  LogicalResult matchAndRewrite(dip::BottomHat2DOp op,
+  LogicalResult matchAndRewrite(dip::Gradient2DOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto *ctx = op->getContext();
-
-    // Create constant indices.
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
 
     // Register operand values.
-    Value input = op->getOperand(0);
-    Value kernel = op->getOperand(1);
-    Value output = op->getOperand(2);
-    Value output1 = op->getOperand(3);
-    Value output2 = op->getOperand(4);
-    Value input1 = op->getOperand(5);
-    Value copymemref = op->getOperand(6);
-    Value copymemref1 = op->getOperand(7);
-    Value centerX = op->getOperand(8);
-    Value centerY = op->getOperand(9);
-    Value iterations = op->getOperand(10);
-    Value constantValue = op->getOperand(11);
+    Value input = op.getMemrefI();
+    Value magnitude = op.getMemrefM();
+    Value constantValue = op.getConstantValue();
+    Value gx = op.getMemrefGx();
+    Value gy = op.getMemrefGy();
+    Value direction = op.getMemrefD();
+    dip::GradientOperator gradientOperator = op.getGradientOperator();
+    dip::GradientNorm norm = op.getNorm();
     dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
 
     auto inElemTy = input.getType().cast<MemRefType>().getElementType();
-    auto bitWidth = inElemTy.getIntOrFloatBitWidth();
-    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::BottomHat2DOp>(
-        op, {input, kernel, output, output1, output2, input1, copymemref,
-             copymemref1, constantValue});
+    std::vector<Value> args{input, magnitude, constantValue};
+    if (gx)
+      args.push_back(gx);
+    if (gy)
+      args.push_back(gy);
+    dip::DIP_ERROR error =
+        dip::checkDIPCommonTypes<dip::Gradient2DOp>(op, args);
 
     if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
-      return op->emitOpError()
-             << "input, kernel, output, output1, output2, input1, copymemref, "
-                "copymemref1 and constant must "
-                "have the same element type";
+      return op->emitOpError() << "input, outputs and constant must have the "
+                                  "same element type";
     } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
-      return op->emitOpError() << "supports only f32, f64 and integer types. "
+      return op->emitOpError() << "supports only f32 and f64 types. "
                                << inElemTy << "is passed";
     }
-    rewriter.create<memref::CopyOp>(loc, input, input1);
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output1, input1);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input1, kernel, output1, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
-
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output2, output1);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref1, output2);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, output1, kernel, output2, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
+    if (direction && !direction.getType()
+                           .cast<MemRefType>()
+                           .getElementType()
+                           .isIntOrFloat()) {
+      return op->emitOpError()
+             << "direction must have an integer or float element type";
+    }
 
-    Value outputRow = rewriter.create<memref::DimOp>(loc, output, c0);
-    Value outputCol = rewriter.create<memref::DimOp>(loc, output, c1);
+    dip::gradient2D(rewriter, loc, input, magnitude, gx, gy, direction,
+                    constantValue, gradientOperator, norm, boundaryOptionAttr,
+                    stride, rowGrain);
 
-    SmallVector<Value, 8> lowerbounds4(2, c0);
-    SmallVector<Value, 8> upperbounds4{outputRow, outputCol};
-    SmallVector<int64_t, 8> steps4{1, stride};
-
-    VectorType vectorTy32 = VectorType::get({stride}, inElemTy);
-    IntegerType i1 = IntegerType::get(ctx, 1);
-    VectorType vectorMaskTy = VectorType::get({stride}, i1);
-    Value zeroPaddingElem =
-        dip::insertZeroConstantOp(ctx, rewriter, loc, inElemTy);
-    Value zeroPaddingVec =
-        rewriter.create<vector::BroadcastOp>(loc, vectorTy32, zeroPaddingElem);
-
-    if (inElemTy.isF32() || inElemTy.isF64()) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
-          [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
-            Value pseudoCol =
-                builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
-            Value pseudoCol1 =
-                builder.create<arith::SubIOp>(loc, pseudoCol, c1);
-            Value cond = builder.create<arith::CmpIOp>(
-                loc, arith::CmpIPredicate::sgt, pseudoCol1, outputCol);
-            builder.create<scf::IfOp>(
-                loc, cond,
-                [&](OpBuilder &builder, Location loc) {
-                  Value res =
-                      builder.create<arith::SubIOp>(loc, pseudoCol1, outputCol);
-                  Value maskVal =
-                      builder.create<arith::SubIOp>(loc, strideVal, res);
-                  Value maskVec = builder.create<vector::CreateMaskOp>(
-                      loc, vectorMaskTy, maskVal);
-                  Value ou = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value in = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, input, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou, in);
-                  builder.create<vector::MaskedStoreOp>(
-                      loc, output, ValueRange{ivs4[0], ivs4[1]}, maskVec,
-                      resVec);
-                  builder.create<scf::YieldOp>(loc);
-                },
-                [&](OpBuilder &builder, Location loc) {
-                  Value ou = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]});
-                  Value in = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, input, ValueRange{ivs4[0], ivs4[1]});
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou, in);
-                  builder.create<vector::StoreOp>(loc, resVec, output,
-                                                  ValueRange{ivs4[0], ivs4[1]});
-                  builder.create<scf::YieldOp>(loc);
-                });
-          }
-
-      );
-    } else if (inElemTy.isInteger(bitWidth)) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
-          [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
-            Value pseudoCol =
-                builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
-            Value pseudoCol1 =
-                builder.create<arith::SubIOp>(loc, pseudoCol, c1);
-            Value cond = builder.create<arith::CmpIOp>(
-                loc, arith::CmpIPredicate::sgt, pseudoCol1, outputCol);
-            builder.create<scf::IfOp>(
-                loc, cond,
-                [&](OpBuilder &builder, Location loc) {
-                  Value res =
-                      builder.create<arith::SubIOp>(loc, pseudoCol1, outputCol);
-                  Value maskVal =
-                      builder.create<arith::SubIOp>(loc, strideVal, res);
-                  Value maskVec = builder.create<vector::CreateMaskOp>(
-                      loc, vectorMaskTy, maskVal);
-                  Value ou = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value in = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, input, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value resVec = builder.create<arith::SubIOp>(loc, ou, in);
-                  builder.create<vector::MaskedStoreOp>(
-                      loc, output, ValueRange{ivs4[0], ivs4[1]}, maskVec,
-                      resVec);
-                  builder.create<scf::YieldOp>(loc);
-                },
-                [&](OpBuilder &builder, Location loc) {
-                  Value ou = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]});
-                  Value in = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, input, ValueRange{ivs4[0], ivs4[1]});
-                  Value resVec = builder.create<arith::SubIOp>(loc, ou, in);
-                  builder.create<vector::StoreOp>(loc, resVec, output,
-                                                  ValueRange{ivs4[0], ivs4[1]});
-                  builder.create<scf::YieldOp>(loc);
-                });
-          });
-    }
-    // Remove the origin bottomhat operation.
+    // Remove the origin gradient operation.
     rewriter.eraseOp(op);
     return success();
   }
 
 private:
   int64_t stride;
+  int64_t rowGrain;
 };
 
-class DIPMorphGrad2DOpLowering : public OpRewritePattern<dip::MorphGrad2DOp> {
+class DIPHistogram2DOpLowering : public OpRewritePattern<dip::Histogram2DOp> {
 public:
-  using OpRewritePattern<dip::MorphGrad2DOp>::OpRewritePattern;
+  using OpRewritePattern<dip::Histogram2DOp>::OpRewritePattern;
 
-  explicit DIPMorphGrad2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPHistogram2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                    int64_t rowGrainParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    rowGrain = rowGrainParam;
   }
 
-  LogicalResult matchAndRewrite(dip::MorphGrad2DOp op,
+  LogicalResult matchAndRewrite(dip::Histogram2DOp op,
                                 PatternRewriter &rewriter) const override {
     auto loc = op->getLoc();
-    auto *ctx = op->getContext();
 
     // Register operand values.
     Value input = op->getOperand(0);
-    Value kernel = op->getOperand(1);
-    Value output = op->getOperand(2);
-    Value output1 = op->getOperand(3);
-    Value output2 = op->getOperand(4);
-    Value input1 = op->getOperand(5);
-    Value copymemref = op->getOperand(6);
-    Value copymemref1 = op->getOperand(7);
-    Value centerX = op->getOperand(8);
-    Value centerY = op->getOperand(9);
-    Value iterations = op->getOperand(10);
-    Value constantValue = op->getOperand(11);
+    Value hist = op->getOperand(1);
+    Value low = op->getOperand(2);
+    Value high = op->getOperand(3);
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Histogram2DOp>(
+        op, {input, hist, low, high});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError() << "histogram must have i32 elements, low and "
+                                  "high the element type of the input";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32 and f64 types. "
+                               << inElemTy << "is passed";
+    }
+
+    dip::histogram2D(rewriter, loc, input, hist, low, high, stride, rowGrain);
+
+    // Remove the origin histogram operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPEqualizeHist2DOpLowering
+    : public OpRewritePattern<dip::EqualizeHist2DOp> {
+public:
+  using OpRewritePattern<dip::EqualizeHist2DOp>::OpRewritePattern;
+
+  explicit DIPEqualizeHist2DOpLowering(MLIRContext *context,
+                                       int64_t strideParam,
+                                       int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::EqualizeHist2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error =
+        dip::checkDIPCommonTypes<dip::EqualizeHist2DOp>(op, {input, output});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError() << "input and output must have the same element "
+                                  "type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32 and f64 types. "
+                               << inElemTy << "is passed";
+    }
+
+    dip::equalizeHistogram2D(rewriter, loc, input, output, stride, rowGrain);
+
+    // Remove the origin histogram equalization operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPCLAHE2DOpLowering : public OpRewritePattern<dip::CLAHE2DOp> {
+public:
+  using OpRewritePattern<dip::CLAHE2DOp>::OpRewritePattern;
+
+  explicit DIPCLAHE2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::CLAHE2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value tilesX = op->getOperand(2);
+    Value tilesY = op->getOperand(3);
+    Value clipLimit = op->getOperand(4);
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::CLAHE2DOp>(
+        op, {input, output, clipLimit});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError() << "input, output and clip limit must have the "
+                                  "same element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32 and f64 types. "
+                               << inElemTy << "is passed";
+    }
+
+    dip::clahe2D(rewriter, loc, input, output, tilesX, tilesY, clipLimit,
+                 stride, rowGrain);
+
+    // Remove the origin CLAHE operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPLUT2DOpLowering : public OpRewritePattern<dip::LUT2DOp> {
+public:
+  using OpRewritePattern<dip::LUT2DOp>::OpRewritePattern;
+
+  explicit DIPLUT2DOpLowering(MLIRContext *context, int64_t strideParam,
+                              int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::LUT2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value lut = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error =
+        dip::checkDIPCommonTypes<dip::LUT2DOp>(op, {input, lut, output});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError() << "lookup table and output must have the same "
+                                  "element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32 and f64 types. "
+                               << inElemTy << "is passed";
+    }
+
+    dip::lookupTable2D(rewriter, loc, input, lut, output, stride, rowGrain);
+
+    // Remove the origin lookup table operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPCvtColorOpLowering : public OpRewritePattern<dip::CvtColorOp> {
+public:
+  using OpRewritePattern<dip::CvtColorOp>::OpRewritePattern;
+
+  explicit DIPCvtColorOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::CvtColorOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value scale = op->getOperand(2);
+    dip::ColorConversion conversion = op.getConversion();
+
+    auto outElemTy = output.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error =
+        dip::checkDIPCommonTypes<dip::CvtColorOp>(op, {input, output, scale});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError() << "output and scale must have the same "
+                                  "element type, and input that one or i8";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32 and f64 outputs. "
+                               << outElemTy << "is passed";
+    }
+
+    // Color images are NHWC or NCHW with a static channel dimension.
+    auto isColorImage = [](Value image) {
+      auto type = image.getType().dyn_cast<MemRefType>();
+      return type && type.getRank() == 4 &&
+             (type.getShape()[3] == 3 || type.getShape()[1] == 3);
+    };
+    auto isPlane = [](Value image) {
+      auto type = image.getType().dyn_cast<MemRefType>();
+      return type && type.getRank() == 2;
+    };
+    bool validInput = isColorImage(input);
+    bool validOutput = isColorImage(output);
+    if (conversion == dip::ColorConversion::RGB2Gray)
+      validOutput = isPlane(output);
+    if (conversion == dip::ColorConversion::YUV2RGBNV12 ||
+        conversion == dip::ColorConversion::YUV2RGBI420)
+      validInput = isPlane(input);
+    if (!validInput || !validOutput) {
+      return op->emitOpError()
+             << "color images must be NHWC or NCHW memrefs with 3 channels, "
+                "gray images and YUV 4:2:0 frames 2-D memrefs";
+    }
+
+    dip::convertColor(rewriter, loc, input, output, scale, conversion, stride,
+                      rowGrain);
+
+    // Remove the origin color conversion operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPResizeNormalize2DOpLowering
+    : public OpRewritePattern<dip::ResizeNormalize2DOp> {
+public:
+  using OpRewritePattern<dip::ResizeNormalize2DOp>::OpRewritePattern;
+
+  explicit DIPResizeNormalize2DOpLowering(MLIRContext *context,
+                                          int64_t strideParam,
+                                          int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::ResizeNormalize2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value batchIndex = op->getOperand(2);
+    Value scale = op->getOperand(3);
+    Value mean = op->getOperand(4);
+    Value stdDev = op->getOperand(5);
+
+    auto outElemTy = output.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::ResizeNormalize2DOp>(
+        op, {input, output, scale, mean, stdDev});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError()
+             << "output, scale, mean and std must have the same element type, "
+                "and input that one or i8";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32 and f64 outputs. "
+                               << outElemTy << "is passed";
+    }
+
+    auto inputTy = input.getType().dyn_cast<MemRefType>();
+    auto outputTy = output.getType().dyn_cast<MemRefType>();
+    if (!inputTy || inputTy.getRank() != 4 ||
+        (inputTy.getShape()[3] != 3 && inputTy.getShape()[1] != 3) ||
+        !outputTy || outputTy.getRank() != 4 || outputTy.getShape()[1] != 3) {
+      return op->emitOpError()
+             << "input must be an NHWC or NCHW memref and output an NCHW "
+                "memref with 3 channels";
+    }
+
+    dip::resizeNormalize2D(rewriter, loc, input, output, batchIndex, scale,
+                           mean, stdDev, stride, rowGrain);
+
+    // Remove the origin resize and normalization operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPErosion2DOpLowering : public OpRewritePattern<dip::Erosion2DOp> {
+public:
+  using OpRewritePattern<dip::Erosion2DOp>::OpRewritePattern;
+
+  explicit DIPErosion2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::Erosion2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value centerX = op->getOperand(3);
+    Value centerY = op->getOperand(4);
+    Value iterations = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
     dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
 
     auto inElemTy = input.getType().cast<MemRefType>().getElementType();
-    auto bitWidth = inElemTy.getIntOrFloatBitWidth();
-    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::MorphGrad2DOp>(
-        op, {input, kernel, output, output1, output2, input1, copymemref,
-             copymemref1, constantValue});
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Erosion2DOp>(
+        op, {input, kernel, output, constantValue});
 
     if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
       return op->emitOpError()
-             << "input, kernel, output, output1, output2, input1, copymemref, "
-                "copymemref1 and constant must "
-                "have the same element type";
+             << "input, kernel, output and constant must have the same "
+                "element type";
     } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
       return op->emitOpError() << "supports only f32, f64 and integer types. "
                                << inElemTy << "is passed";
     }
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
-    rewriter.create<memref::CopyOp>(loc, input, input1);
-
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output1, input);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input, kernel, output1, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
-
-    rewriter.create<affine::AffineForOp>(
-        loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
-        ValueRange{iterations}, rewriter.getDimIdentityMap(), /*Step=*/1,
-        std::nullopt,
-        [&](OpBuilder &builder, Location nestedLoc, Value iv,
-            ValueRange itrArgs) {
-          Value cond = builder.create<arith::CmpIOp>(
-              loc, arith::CmpIPredicate::sge, iv, c1);
-          builder.create<scf::IfOp>(
-              loc, cond, [&](OpBuilder &builder, Location loc) {
-                builder.create<memref::CopyOp>(loc, output2, input1);
-                builder.create<scf::YieldOp>(loc);
-              });
-          builder.create<memref::CopyOp>(loc, copymemref1, output2);
-          traverseImagewBoundaryExtrapolation(
-              rewriter, loc, ctx, input1, kernel, output2, centerX, centerY,
-              constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
-          builder.create<affine::AffineYieldOp>(loc);
-        });
 
-    Value outputRow = rewriter.create<memref::DimOp>(loc, output, c0);
-    Value outputCol = rewriter.create<memref::DimOp>(loc, output, c1);
+    // A single chain of erosions.
+    SmallVector<dip::MorphologyChain, 2> chains{
+        {{dip::DIP_OP::EROSION_2D}, dip::MORPH_EPILOGUE::STORE}};
+    dip::morphologyPipeline(rewriter, loc, input, kernel, output, centerX,
+                            centerY, iterations, constantValue, inElemTy,
+                            boundaryOptionAttr, stride, rowGrain, chains);
+
+    // Remove the origin erosion operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPDilation2DOpLowering : public OpRewritePattern<dip::Dilation2DOp> {
+public:
+  using OpRewritePattern<dip::Dilation2DOp>::OpRewritePattern;
+
+  explicit DIPDilation2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                   int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::Dilation2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value centerX = op->getOperand(3);
+    Value centerY = op->getOperand(4);
+    Value iterations = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
 
-    SmallVector<Value, 8> lowerbounds4(2, c0);
-    SmallVector<Value, 8> upperbounds4{outputRow, outputCol};
-    SmallVector<int64_t, 8> steps4{1, stride};
-
-    VectorType vectorTy32 = VectorType::get({stride}, inElemTy);
-    IntegerType i1 = IntegerType::get(ctx, 1);
-    VectorType vectorMaskTy = VectorType::get({stride}, i1);
-    Value zeroPaddingElem =
-        dip::insertZeroConstantOp(ctx, rewriter, loc, inElemTy);
-    Value zeroPaddingVec =
-        rewriter.create<vector::BroadcastOp>(loc, vectorTy32, zeroPaddingElem);
-
-    if (inElemTy.isF32() || inElemTy.isF64()) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
-          [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
-            Value pseudoCol =
-                builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
-            Value pseudoCol1 =
-                builder.create<arith::SubIOp>(loc, pseudoCol, c1);
-            Value cond = builder.create<arith::CmpIOp>(
-                loc, arith::CmpIPredicate::sgt, pseudoCol1, outputCol);
-            builder.create<scf::IfOp>(
-                loc, cond,
-                [&](OpBuilder &builder, Location loc) {
-                  Value res =
-                      builder.create<arith::SubIOp>(loc, pseudoCol1, outputCol);
-                  Value maskVal =
-                      builder.create<arith::SubIOp>(loc, strideVal, res);
-                  Value maskVec = builder.create<vector::CreateMaskOp>(
-                      loc, vectorMaskTy, maskVal);
-                  Value ou1 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output1, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value ou2 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou1, ou2);
-                  builder.create<vector::MaskedStoreOp>(
-                      loc, output, ValueRange{ivs4[0], ivs4[1]}, maskVec,
-                      resVec);
-                  builder.create<scf::YieldOp>(loc);
-                },
-                [&](OpBuilder &builder, Location loc) {
-                  Value ou1 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output1, ValueRange{ivs4[0], ivs4[1]});
-                  Value ou2 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]});
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou1, ou2);
-                  builder.create<vector::StoreOp>(loc, resVec, output,
-                                                  ValueRange{ivs4[0], ivs4[1]});
-                  builder.create<scf::YieldOp>(loc);
-                });
-          }
-
-      );
-    } else if (inElemTy.isInteger(bitWidth)) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
-          [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
-            Value pseudoCol =
-                builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
-            Value pseudoCol1 =
-                builder.create<arith::SubIOp>(loc, pseudoCol, c1);
-            Value cond = builder.create<arith::CmpIOp>(
-                loc, arith::CmpIPredicate::sgt, pseudoCol1, outputCol);
-            builder.create<scf::IfOp>(
-                loc, cond,
-                [&](OpBuilder &builder, Location loc) {
-                  Value res =
-                      builder.create<arith::SubIOp>(loc, pseudoCol1, outputCol);
-                  Value maskVal =
-                      builder.create<arith::SubIOp>(loc, strideVal, res);
-                  Value maskVec = builder.create<vector::CreateMaskOp>(
-                      loc, vectorMaskTy, maskVal);
-                  Value ou1 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output1, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value ou2 = builder.create<vector::MaskedLoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]},
-                      maskVec, zeroPaddingVec);
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou1, ou2);
-                  builder.create<vector::MaskedStoreOp>(
-                      loc, output, ValueRange{ivs4[0], ivs4[1]}, maskVec,
-                      resVec);
-                },
-                [&](OpBuilder &builder, Location loc) {
-                  Value ou1 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output1, ValueRange{ivs4[0], ivs4[1]});
-                  Value ou2 = builder.create<vector::LoadOp>(
-                      loc, vectorTy32, output2, ValueRange{ivs4[0], ivs4[1]});
-                  Value resVec = builder.create<arith::SubFOp>(loc, ou1, ou2);
-                  builder.create<vector::StoreOp>(loc, resVec, output,
-                                                  ValueRange{ivs4[0], ivs4[1]});
-                });
-          });
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Dilation2DOp>(
+        op, {input, kernel, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError()
+             << "input, kernel, output and constant must have the same "
+                "element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
     }
 
-    // Remove the origin morphological gradient operation.
+    // A single chain of dilations.
+    SmallVector<dip::MorphologyChain, 2> chains{
+        {{dip::DIP_OP::DILATION_2D}, dip::MORPH_EPILOGUE::STORE}};
+    dip::morphologyPipeline(rewriter, loc, input, kernel, output, centerX,
+                            centerY, iterations, constantValue, inElemTy,
+                            boundaryOptionAttr, stride, rowGrain, chains);
+
+    // Remove the origin dilation operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPOpening2DOpLowering : public OpRewritePattern<dip::Opening2DOp> {
+public:
+  using OpRewritePattern<dip::Opening2DOp>::OpRewritePattern;
+
+  explicit DIPOpening2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::Opening2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value centerX = op->getOperand(3);
+    Value centerY = op->getOperand(4);
+    Value iterations = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Opening2DOp>(
+        op, {input, kernel, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError()
+             << "input, kernel, output and constant must have the same "
+                "element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
+    }
+
+    // Opening: dilation of the erosion.
+    SmallVector<dip::MorphologyChain, 2> chains{
+        {{dip::DIP_OP::EROSION_2D, dip::DIP_OP::DILATION_2D},
+         dip::MORPH_EPILOGUE::STORE}};
+    dip::morphologyPipeline(rewriter, loc, input, kernel, output, centerX,
+                            centerY, iterations, constantValue, inElemTy,
+                            boundaryOptionAttr, stride, rowGrain, chains);
+
+    // Remove the origin opening operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPClosing2DOpLowering : public OpRewritePattern<dip::Closing2DOp> {
+public:
+  using OpRewritePattern<dip::Closing2DOp>::OpRewritePattern;
+
+  explicit DIPClosing2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::Closing2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value centerX = op->getOperand(3);
+    Value centerY = op->getOperand(4);
+    Value iterations = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Closing2DOp>(
+        op, {input, kernel, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError()
+             << "input, kernel, output and constant must have the same "
+                "element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
+    }
+
+    // Closing: erosion of the dilation.
+    SmallVector<dip::MorphologyChain, 2> chains{
+        {{dip::DIP_OP::DILATION_2D, dip::DIP_OP::EROSION_2D},
+         dip::MORPH_EPILOGUE::STORE}};
+    dip::morphologyPipeline(rewriter, loc, input, kernel, output, centerX,
+                            centerY, iterations, constantValue, inElemTy,
+                            boundaryOptionAttr, stride, rowGrain, chains);
+
+    // Remove the origin closing operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPTopHat2DOpLowering : public OpRewritePattern<dip::TopHat2DOp> {
+public:
+  using OpRewritePattern<dip::TopHat2DOp>::OpRewritePattern;
+
+  explicit DIPTopHat2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::TopHat2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value centerX = op->getOperand(3);
+    Value centerY = op->getOperand(4);
+    Value iterations = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::TopHat2DOp>(
+        op, {input, kernel, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError()
+             << "input, kernel, output and constant must have the same "
+                "element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
+    }
+
+    // Top-hat: input - opening.
+    SmallVector<dip::MorphologyChain, 2> chains{
+        {{dip::DIP_OP::EROSION_2D, dip::DIP_OP::DILATION_2D},
+         dip::MORPH_EPILOGUE::SUBTRACT_FROM_INPUT}};
+    dip::morphologyPipeline(rewriter, loc, input, kernel, output, centerX,
+                            centerY, iterations, constantValue, inElemTy,
+                            boundaryOptionAttr, stride, rowGrain, chains);
+
+    // Remove the origin tophat operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPBottomHat2DOpLowering : public OpRewritePattern<dip::BottomHat2DOp> {
+public:
+  using OpRewritePattern<dip::BottomHat2DOp>::OpRewritePattern;
+
+  explicit DIPBottomHat2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                    int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::BottomHat2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value centerX = op->getOperand(3);
+    Value centerY = op->getOperand(4);
+    Value iterations = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::BottomHat2DOp>(
+        op, {input, kernel, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError()
+             << "input, kernel, output and constant must have the same "
+                "element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
+    }
+
+    // Bottom-hat: closing - input.
+    SmallVector<dip::MorphologyChain, 2> chains{
+        {{dip::DIP_OP::DILATION_2D, dip::DIP_OP::EROSION_2D},
+         dip::MORPH_EPILOGUE::SUBTRACT_INPUT}};
+    dip::morphologyPipeline(rewriter, loc, input, kernel, output, centerX,
+                            centerY, iterations, constantValue, inElemTy,
+                            boundaryOptionAttr, stride, rowGrain, chains);
+
+    // Remove the origin bottomhat operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t rowGrain;
+};
+
+class DIPMorphGrad2DOpLowering : public OpRewritePattern<dip::MorphGrad2DOp> {
+public:
+  using OpRewritePattern<dip::MorphGrad2DOp>::OpRewritePattern;
+
+  explicit DIPMorphGrad2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                    int64_t rowGrainParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    rowGrain = rowGrainParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::MorphGrad2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value centerX = op->getOperand(3);
+    Value centerY = op->getOperand(4);
+    Value iterations = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::MorphGrad2DOp>(
+        op, {input, kernel, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError()
+             << "input, kernel, output and constant must have the same "
+                "element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
+    }
+
+    // Morphological gradient: dilation - erosion. The erosion is
+    // written to the output first and subtracted by the dilation chain.
+    SmallVector<dip::MorphologyChain, 2> chains{
+        {{dip::DIP_OP::EROSION_2D}, dip::MORPH_EPILOGUE::STORE},
+        {{dip::DIP_OP::DILATION_2D}, dip::MORPH_EPILOGUE::SUBTRACT_OUTPUT}};
+    dip::morphologyPipeline(rewriter, loc, input, kernel, output, centerX,
+                            centerY, iterations, constantValue, inElemTy,
+                            boundaryOptionAttr, stride, rowGrain, chains);
+
+    // Remove the origin morphgrad operation.
     rewriter.eraseOp(op);
     return success();
   }
 
 private:
   int64_t stride;
+  int64_t rowGrain;
 };
 
 } // end anonymous namespace
 
 void populateLowerDIPConversionPatterns(RewritePatternSet &patterns,
-                                        int64_t stride) {
-  patterns.add<DIPCorr2DOpLowering>(patterns.getContext(), stride);
+                                        int64_t stride, int64_t rowGrain) {
+  patterns.add<DIPCorr2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPSepCorr2DOpLowering>(patterns.getContext(), stride,
+                                       rowGrain);
   patterns.add<DIPCorrFFT2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPRotate2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPResize2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPErosion2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPDilation2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPOpening2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPClosing2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPTopHat2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPBottomHat2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPMorphGrad2DOpLowering>(patterns.getContext(), stride);
+  patterns.add<DIPRFFT2DOpLowering>(patterns.getContext());
+  patterns.add<DIPCorrFFT2DPlannedOpLowering>(patterns.getContext());
+  patterns.add<DIPRotate2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPResize2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPWarpAffine2DOpLowering>(patterns.getContext(), stride,
+                                          rowGrain);
+  patterns.add<DIPWarpPerspective2DOpLowering>(patterns.getContext(), stride,
+                                               rowGrain);
+  patterns.add<DIPGaussianPyramid2DOpLowering>(patterns.getContext(), stride,
+                                               rowGrain);
+  patterns.add<DIPLaplacianPyramid2DOpLowering>(patterns.getContext(), stride,
+                                                rowGrain);
+  patterns.add<DIPIntegralImage2DOpLowering>(patterns.getContext(), stride);
+  patterns.add<DIPBoxFilter2DOpLowering>(patterns.getContext(), stride,
+                                         rowGrain);
+  patterns.add<DIPMedianBlur2DOpLowering>(patterns.getContext(), stride,
+                                          rowGrain);
+  patterns.add<DIPGradient2DOpLowering>(patterns.getContext(), stride,
+                                        rowGrain);
+  patterns.add<DIPHistogram2DOpLowering>(patterns.getContext(), stride,
+                                         rowGrain);
+  patterns.add<DIPEqualizeHist2DOpLowering>(patterns.getContext(), stride,
+                                            rowGrain);
+  patterns.add<DIPCLAHE2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPLUT2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPCvtColorOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPResizeNormalize2DOpLowering>(patterns.getContext(), stride,
+                                               rowGrain);
+  patterns.add<DIPErosion2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPDilation2DOpLowering>(patterns.getContext(), stride,
+                                        rowGrain);
+  patterns.add<DIPOpening2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPClosing2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPTopHat2DOpLowering>(patterns.getContext(), stride, rowGrain);
+  patterns.add<DIPBottomHat2DOpLowering>(patterns.getContext(), stride,
+                                         rowGrain);
+  patterns.add<DIPMorphGrad2DOpLowering>(patterns.getContext(), stride,
+                                         rowGrain);
 }
 
 //===----------------------------------------------------------------------===//
@@ -1347,6 +1807,10 @@ public:
   Option<int64_t> stride{*this, "DIP-strip-mining",
                          llvm::cl::desc("Strip mining size."),
                          llvm::cl::init(32)};
+  Option<int64_t> rowGrain{
+      *this, "DIP-row-grain",
+      llvm::cl::desc("Rows per parallel band, 0 keeps the row loops serial."),
+      llvm::cl::init(0)};
 };
 } // end anonymous namespace.
 
@@ -1362,7 +1826,7 @@ void LowerDIPPass::runOnOperation() {
   target.addLegalOp<ModuleOp, func::FuncOp, func::ReturnOp>();
 
   RewritePatternSet patterns(context);
-  populateLowerDIPConversionPatterns(patterns, stride);
+  populateLowerDIPConversionPatterns(patterns, stride, rowGrain);
 
   if (failed(applyPartialConversion(module, target, std::move(patterns))))
     signalPassFailure();
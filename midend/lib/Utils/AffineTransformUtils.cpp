@@ -29,7 +29,11 @@
 
 #include <mlir/IR/MLIRContext.h>
 #include <mlir/IR/Value.h>
+#include <cmath>
+#include <vector>
 
+#include "DIP/DIPDialect.h"
+#include "DIP/DIPOps.h"
 #include "Utils/AffineTransformUtils.h"
 #include "Utils/Utils.h"
 
@@ -109,24 +113,240 @@ void affineTransformCoreTiled(OpBuilder &builder, Location loc,
       });
 }
 
-// Given x*m0+m2(and x*m3+m5) and m1(and m4), compute new x and y, then remap
-// origin pixels to new pixels
-void affineTransformCore(OpBuilder &builder, Location loc, Value input,
-                         Value output, Value yStart, Value yEnd, Value xStart,
-                         Value xEnd, Value m1, Value m4, Value xAddr1,
-                         Value xAddr2, int64_t stride, const int &RSV_BITS,
-                         int interp_type) {
+// Clamp the i32 lanes of `vec` to [low, high].
+static Value clampVec(OpBuilder &builder, Location loc, Value vec, Value low,
+                      Value high) {
+  return builder.create<arith::MinSIOp>(
+      loc, builder.create<arith::MaxSIOp>(loc, vec, low), high);
+}
+
+// Walk the rows of a remap block in chunks of `stride` pixels. `body` gets the
+// block coordinates of the chunk, its output coordinates and the mask of the
+// lanes inside the block.
+static void remapChunks(
+    OpBuilder &builder, Location loc, Value yStart, Value xStart, Value rows,
+    Value cols, int64_t stride,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value, Value, Value)>
+        body) {
   Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
   Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
-  Value c_rsv = builder.create<arith::ConstantOp>(
-      loc, builder.getF32FloatAttr((float)(1 << RSV_BITS)));
-  Value rsvVal = builder.create<arith::ConstantOp>(
-      loc, builder.getI32IntegerAttr(RSV_BITS));
   Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
-  VectorType vectorTyI32 =
-      VectorType::get({stride}, IntegerType::get(builder.getContext(), 32));
-  Value rsvValVec = builder.create<vector::SplatOp>(loc, vectorTyI32, rsvVal);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  builder.create<scf::ForOp>(
+      loc, c0, rows, c1, std::nullopt,
+      [&](OpBuilder &yBuilder, Location yLoc, Value yiv, ValueRange) {
+        Value dstY = yBuilder.create<arith::AddIOp>(yLoc, yiv, yStart);
+        yBuilder.create<scf::ForOp>(
+            yLoc, c0, cols, strideVal, std::nullopt,
+            [&](OpBuilder &xBuilder, Location xLoc, Value xiv, ValueRange) {
+              Value dstX = xBuilder.create<arith::AddIOp>(xLoc, xiv, xStart);
+              Value rest = xBuilder.create<arith::SubIOp>(xLoc, cols, xiv);
+              Value mask = xBuilder.create<vector::CreateMaskOp>(
+                  xLoc, maskTy, ValueRange{rest});
+              body(xBuilder, xLoc, yiv, xiv, dstY, dstX, mask);
+              xBuilder.create<scf::YieldOp>(xLoc);
+            });
+        yBuilder.create<scf::YieldOp>(yLoc);
+      });
+}
+
+// Load a chunk of the x (plane 0) or y (plane 1) part of a remap buffer as
+// i32 lanes.
+static Value loadMapChunk(OpBuilder &builder, Location loc, Value map,
+                          Value plane, Value y, Value x, Value mask,
+                          int64_t stride) {
+  Type elemTy = map.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  Value zero = builder.create<arith::ConstantOp>(
+      loc, vecTy, builder.getZeroAttr(vecTy));
+  Value chunk = builder.create<vector::MaskedLoadOp>(
+      loc, vecTy, map, ValueRange{plane, y, x}, mask, zero);
+  return builder.create<arith::ExtSIOp>(
+      loc, VectorType::get({stride}, builder.getI32Type()), chunk);
+}
+
+// Build the [taps, 2^RSV_BITS] table of the tap weights for every fractional
+// part. Tap i sits i - (taps / 2 - 1) pixels right of / below the pixel left
+// of / above the sample.
+static Value interpolationWeights(OpBuilder &builder, Location loc,
+                                  dip::InterpolationType type, Type elemTy,
+                                  const int &RSV_BITS, int64_t &taps) {
+  const int64_t steps = 1 << RSV_BITS;
+  std::vector<double> table;
+  if (type == dip::InterpolationType::BilinearInterpolation)
+    taps = 2;
+  else if (type == dip::InterpolationType::BicubicInterpolation)
+    taps = 4;
+  else
+    taps = 8;
+  table.resize(taps * steps);
+
+  for (int64_t f = 0; f < steps; ++f) {
+    double t = double(f) / steps;
+    if (type == dip::InterpolationType::BilinearInterpolation) {
+      table[f] = 1 - t;
+      table[steps + f] = t;
+    } else if (type == dip::InterpolationType::BicubicInterpolation) {
+      // Keys' cubic convolution with a = -0.75, as used by OpenCV.
+      const double a = -0.75;
+      double w0 = ((a * (t + 1) - 5 * a) * (t + 1) + 8 * a) * (t + 1) - 4 * a;
+      double w1 = ((a + 2) * t - (a + 3)) * t * t + 1;
+      double w2 = ((a + 2) * (1 - t) - (a + 3)) * (1 - t) * (1 - t) + 1;
+      table[f] = w0;
+      table[steps + f] = w1;
+      table[2 * steps + f] = w2;
+      table[3 * steps + f] = 1 - w0 - w1 - w2;
+    } else {
+      // Lanczos window with a = 4, normalized to a unit sum.
+      double sum = 0;
+      for (int64_t i = 0; i < taps; ++i) {
+        double d = t - (i - (taps / 2 - 1));
+        double weight = 1;
+        if (d != 0)
+          weight = taps / 2 * std::sin(M_PI * d) *
+                   std::sin(M_PI * d / (taps / 2)) / (M_PI * M_PI * d * d);
+        table[i * steps + f] = weight;
+        sum += weight;
+      }
+      for (int64_t i = 0; i < taps; ++i)
+        table[i * steps + f] /= sum;
+    }
+  }
+
+  Value weights = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({taps, steps}, elemTy));
+  for (int64_t i = 0; i < taps; ++i)
+    for (int64_t f = 0; f < steps; ++f) {
+      Value weight = builder.create<arith::ConstantOp>(
+          loc, builder.getFloatAttr(elemTy, table[i * steps + f]));
+      builder.create<memref::StoreOp>(
+          loc, weight, weights,
+          ValueRange{builder.create<arith::ConstantIndexOp>(loc, i),
+                     builder.create<arith::ConstantIndexOp>(loc, f)});
+    }
+  return weights;
+}
+
+// Compute the perspective map of a block. The inverse matrix m takes the
+// output pixel (x, y) to the source pixel (X / W, Y / W), with
+// X = m0 * x + m1 * y + m2, Y = m3 * x + m4 * y + m5 and
+// W = m6 * x + m7 * y + m8. The results use the fixed point format of
+// affineTransformCoreTiled.
+static void perspectiveTransformCoreTiled(OpBuilder &builder, Location loc,
+                                          Value resIntPart, Value resFracPart,
+                                          Value yStart, Value yEnd,
+                                          Value xStart, Value xEnd,
+                                          ArrayRef<Value> m, int64_t stride,
+                                          const int &RSV_BITS) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  VectorType vectorTyF32 = VectorType::get({stride}, builder.getF32Type());
+  VectorType vectorTyI32 = VectorType::get({stride}, builder.getI32Type());
+  VectorType vectorTyI16 = VectorType::get({stride}, builder.getI16Type());
+  VectorType vectorTyI8 = VectorType::get({stride}, builder.getI8Type());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  auto splatF32 = [&](float val) -> Value {
+    return builder.create<arith::ConstantOp>(
+        loc, DenseElementsAttr::get(vectorTyF32, builder.getF32FloatAttr(val)));
+  };
+  SmallVector<Value, 3> xCoeffs;
+  for (int i : {0, 3, 6})
+    xCoeffs.push_back(builder.create<vector::SplatOp>(loc, vectorTyF32, m[i]));
+  Value xVecInitial = iotaVec0F32(builder, loc, stride);
+  Value zeroF32Vec = splatF32(0);
+  Value oneF32Vec = splatF32(1);
+  Value rsvF32Vec = splatF32(1 << RSV_BITS);
+  // Keep the source coordinates far outside of the input within the range of
+  // the i16 integer parts.
+  Value lowVec = splatF32(-(1 << 14));
+  Value highVec = splatF32(1 << 14);
+  Value rsvValVec = builder.create<arith::ConstantOp>(
+      loc,
+      DenseElementsAttr::get(vectorTyI32, builder.getI32IntegerAttr(RSV_BITS)));
+  Value rsvDeltaVec = builder.create<arith::ConstantOp>(
+      loc, DenseElementsAttr::get(
+               vectorTyI32, builder.getI32IntegerAttr(1 << (RSV_BITS - 1))));
+
+  builder.create<scf::ForOp>(
+      loc, yStart, yEnd, c1, std::nullopt,
+      [&](OpBuilder &yBuilder, Location yLoc, Value yiv, ValueRange) {
+        Value yOffset = yBuilder.create<arith::SubIOp>(yLoc, yiv, yStart);
+        Value yF32 = indexToF32(yBuilder, yLoc, yiv);
+        // m1 * y + m2, m4 * y + m5 and m7 * y + m8.
+        SmallVector<Value, 3> rowTerms;
+        for (int i : {1, 4, 7})
+          rowTerms.push_back(yBuilder.create<vector::SplatOp>(
+              yLoc, vectorTyF32,
+              yBuilder.create<arith::AddFOp>(
+                  yLoc, yBuilder.create<arith::MulFOp>(yLoc, yF32, m[i]),
+                  m[i + 1])));
+
+        yBuilder.create<scf::ForOp>(
+            yLoc, xStart, xEnd, strideVal, std::nullopt,
+            [&](OpBuilder &xBuilder, Location xLoc, Value xiv, ValueRange) {
+              Value xOffset = xBuilder.create<arith::SubIOp>(xLoc, xiv, xStart);
+              Value rest = xBuilder.create<arith::SubIOp>(xLoc, xEnd, xiv);
+              Value mask = xBuilder.create<vector::CreateMaskOp>(
+                  xLoc, maskTy, ValueRange{rest});
+              Value xVec = xBuilder.create<arith::AddFOp>(
+                  xLoc, xVecInitial,
+                  xBuilder.create<vector::SplatOp>(
+                      xLoc, vectorTyF32, indexToF32(xBuilder, xLoc, xiv)));
+              Value terms[3];
+              for (int i = 0; i < 3; ++i)
+                terms[i] = xBuilder.create<vector::FMAOp>(
+                    xLoc, xVec, xCoeffs[i], rowTerms[i]);
+              // Points on the horizon line (W = 0) map to the origin.
+              Value wIsZero = xBuilder.create<arith::CmpFOp>(
+                  xLoc, arith::CmpFPredicate::OEQ, terms[2], zeroF32Vec);
+              Value invW = xBuilder.create<arith::SelectOp>(
+                  xLoc, wIsZero, zeroF32Vec,
+                  xBuilder.create<arith::DivFOp>(xLoc, oneF32Vec, terms[2]));
 
+              for (int plane = 0; plane < 2; ++plane) {
+                Value planeVal = plane == 0 ? c0 : c1;
+                Value src = xBuilder.create<arith::MulFOp>(xLoc, terms[plane],
+                                                           invW);
+                src = xBuilder.create<arith::MaxFOp>(xLoc, src, lowVec);
+                src = xBuilder.create<arith::MinFOp>(xLoc, src, highVec);
+                Value fixed = xBuilder.create<arith::AddIOp>(
+                    xLoc,
+                    xBuilder.create<arith::FPToSIOp>(
+                        xLoc, vectorTyI32,
+                        xBuilder.create<arith::MulFOp>(xLoc, src, rsvF32Vec)),
+                    rsvDeltaVec);
+                xBuilder.create<vector::MaskedStoreOp>(
+                    xLoc, resFracPart, ValueRange{planeVal, yOffset, xOffset},
+                    mask,
+                    xBuilder.create<arith::TruncIOp>(xLoc, vectorTyI8, fixed));
+                xBuilder.create<vector::MaskedStoreOp>(
+                    xLoc, resIntPart, ValueRange{planeVal, yOffset, xOffset},
+                    mask,
+                    xBuilder.create<arith::TruncIOp>(
+                        xLoc, vectorTyI16,
+                        xBuilder.create<arith::ShRSIOp>(xLoc, fixed,
+                                                        rsvValVec)));
+              }
+
+              xBuilder.create<scf::YieldOp>(xLoc);
+            });
+
+        yBuilder.create<scf::YieldOp>(yLoc);
+      });
+}
+
+// Remap the output rectangle [yStart, yEnd) x [xStart, xEnd) block by block.
+// `computeMap` fills the scratch buffers resIntPart and resFracPart with the
+// source coordinates of a block, given as its output bounds.
+static void remapBlocks(
+    OpBuilder &builder, Location loc, Value input, Value output, Value yStart,
+    Value yEnd, Value xStart, Value xEnd, int64_t stride, const int &RSV_BITS,
+    int interp_type, int64_t rowGrain, const RemapBorder &border,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value, Value, Value,
+                      Value)>
+        computeMap) {
   // create memref to store compute result for remap use
   // TODO: auto config BLOCK_SZ by input type. float->32, uchar->64
 #define BLOCK_SZ 32
@@ -136,85 +356,311 @@ void affineTransformCore(OpBuilder &builder, Location loc, Value input,
   MemRefType resFracPartType =
       MemRefType::get({2, BLOCK_SZ / 2, BLOCK_SZ * 2},
                       IntegerType::get(builder.getContext(), 8));
-  Value resIntPart = builder.create<memref::AllocOp>(loc, resIntPartType);
-  Value resFracPart = builder.create<memref::AllocOp>(loc, resFracPartType);
 
   Value rowStride = builder.create<arith::ConstantIndexOp>(loc, BLOCK_SZ / 2);
   Value colStride = builder.create<arith::ConstantIndexOp>(loc, BLOCK_SZ * 2);
 #undef BLOCK_SZ
 
+  // The interpolating remaps look their tap weights up by the fractional
+  // parts of the source coordinates.
+  auto interpType = static_cast<dip::InterpolationType>(interp_type);
+  Value weights;
+  int64_t taps = 1;
+  if (interpType != dip::InterpolationType::NearestNeighbourInterpolation) {
+    Type elemTy = input.getType().cast<MemRefType>().getElementType();
+    weights = interpolationWeights(builder, loc, interpType, elemTy, RSV_BITS,
+                                   taps);
+  }
+
+  // Compute and remap the block rows starting at yiv through the scratch
+  // buffers resIntPart and resFracPart.
+  auto blockRow = [&](OpBuilder &yBuilder, Location yLoc, Value yiv,
+                      Value resIntPart, Value resFracPart) {
+    Value realYEnd = yBuilder.create<arith::MinUIOp>(
+        yLoc, yEnd, yBuilder.create<arith::AddIOp>(yLoc, yiv, rowStride));
+    Value rows = yBuilder.create<arith::SubIOp>(yLoc, realYEnd, yiv);
+    yBuilder.create<scf::ForOp>(
+        yLoc, xStart, xEnd, colStride, std::nullopt,
+        [&](OpBuilder &xBuilder, Location xLoc, Value xiv, ValueRange) {
+          Value realXEnd = xBuilder.create<arith::MinUIOp>(
+              xLoc, xEnd, xBuilder.create<arith::AddIOp>(xLoc, xiv, colStride));
+          Value cols = xBuilder.create<arith::SubIOp>(xLoc, realXEnd, xiv);
+          computeMap(xBuilder, xLoc, resIntPart, resFracPart, yiv, realYEnd,
+                     xiv, realXEnd);
+
+          // remap
+          if (!weights)
+            remapNearest(xBuilder, xLoc, input, output, resIntPart, yiv, xiv,
+                         rows, cols, stride, border);
+          else
+            remapSeparable(xBuilder, xLoc, input, output, resIntPart,
+                           resFracPart, weights, taps, yiv, xiv, rows, cols,
+                           stride, RSV_BITS, border);
+
+          xBuilder.create<scf::YieldOp>(xLoc);
+        });
+  };
+
+  if (rowGrain > 0) {
+    // Block rows run in parallel, every one with its own scratch buffers.
+    builder.create<scf::ParallelOp>(
+        loc, ValueRange{yStart}, ValueRange{yEnd}, ValueRange{rowStride},
+        [&](OpBuilder &yBuilder, Location yLoc, ValueRange yivs) {
+          Value resIntPart =
+              yBuilder.create<memref::AllocOp>(yLoc, resIntPartType);
+          Value resFracPart =
+              yBuilder.create<memref::AllocOp>(yLoc, resFracPartType);
+          blockRow(yBuilder, yLoc, yivs[0], resIntPart, resFracPart);
+          yBuilder.create<memref::DeallocOp>(yLoc, resIntPart);
+          yBuilder.create<memref::DeallocOp>(yLoc, resFracPart);
+        });
+    if (weights)
+      builder.create<memref::DeallocOp>(loc, weights);
+    return;
+  }
+
+  Value resIntPart = builder.create<memref::AllocOp>(loc, resIntPartType);
+  Value resFracPart = builder.create<memref::AllocOp>(loc, resFracPartType);
   builder.create<scf::ForOp>(
       loc, yStart, yEnd, rowStride, std::nullopt,
       [&](OpBuilder &yBuilder, Location yLoc, Value yiv, ValueRange) {
-        Value realYEnd = yBuilder.create<arith::MinUIOp>(
-            yLoc, yEnd, yBuilder.create<arith::AddIOp>(yLoc, yiv, rowStride));
-        Value rows = yBuilder.create<arith::SubIOp>(yLoc, realYEnd, yiv);
-        yBuilder.create<scf::ForOp>(
-            yLoc, xStart, xEnd, colStride, std::nullopt,
-            [&](OpBuilder &xBuilder, Location xLoc, Value xiv, ValueRange) {
-              Value realXEnd = xBuilder.create<arith::MinUIOp>(
-                  xLoc, xEnd,
-                  xBuilder.create<arith::AddIOp>(xLoc, xiv, colStride));
-              Value cols = xBuilder.create<arith::SubIOp>(xLoc, realXEnd, xiv);
-              affineTransformCoreTiled(xBuilder, xLoc, resIntPart, resFracPart,
-                                       yiv, realYEnd, xiv, realXEnd, m1, m4,
-                                       xAddr1, xAddr2, rsvValVec, strideVal, c0,
-                                       c1, c_rsv, stride);
-
-              // remap
-              remapNearest(xBuilder, xLoc, input, output, resIntPart, yiv, xiv,
-                           rows, cols);
-
-              xBuilder.create<scf::YieldOp>(xLoc);
-            });
+        blockRow(yBuilder, yLoc, yiv, resIntPart, resFracPart);
         yBuilder.create<scf::YieldOp>(yLoc);
       });
 
   builder.create<memref::DeallocOp>(loc, resIntPart);
   builder.create<memref::DeallocOp>(loc, resFracPart);
+  if (weights)
+    builder.create<memref::DeallocOp>(loc, weights);
+}
+
+// Given x*m0+m2(and x*m3+m5) and m1(and m4), compute new x and y, then remap
+// origin pixels to new pixels
+void affineTransformCore(OpBuilder &builder, Location loc, Value input,
+                         Value output, Value yStart, Value yEnd, Value xStart,
+                         Value xEnd, Value m1, Value m4, Value xAddr1,
+                         Value xAddr2, int64_t stride, const int &RSV_BITS,
+                         int interp_type, int64_t rowGrain,
+                         const RemapBorder &border) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c_rsv = builder.create<arith::ConstantOp>(
+      loc, builder.getF32FloatAttr((float)(1 << RSV_BITS)));
+  Value rsvVal = builder.create<arith::ConstantOp>(
+      loc, builder.getI32IntegerAttr(RSV_BITS));
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  VectorType vectorTyI32 =
+      VectorType::get({stride}, IntegerType::get(builder.getContext(), 32));
+  Value rsvValVec = builder.create<vector::SplatOp>(loc, vectorTyI32, rsvVal);
+
+  remapBlocks(builder, loc, input, output, yStart, yEnd, xStart, xEnd, stride,
+              RSV_BITS, interp_type, rowGrain, border,
+              [&](OpBuilder &builder, Location loc, Value resIntPart,
+                  Value resFracPart, Value y0, Value y1, Value x0, Value x1) {
+                affineTransformCoreTiled(builder, loc, resIntPart, resFracPart,
+                                         y0, y1, x0, x1, m1, m4, xAddr1,
+                                         xAddr2, rsvValVec, strideVal, c0, c1,
+                                         c_rsv, stride);
+              });
+}
+
+void perspectiveTransformCore(OpBuilder &builder, Location loc, Value input,
+                              Value output, Value yStart, Value yEnd,
+                              Value xStart, Value xEnd, ArrayRef<Value> m,
+                              int64_t stride, const int &RSV_BITS,
+                              int interp_type, int64_t rowGrain,
+                              const RemapBorder &border) {
+  remapBlocks(builder, loc, input, output, yStart, yEnd, xStart, xEnd, stride,
+              RSV_BITS, interp_type, rowGrain, border,
+              [&](OpBuilder &builder, Location loc, Value resIntPart,
+                  Value resFracPart, Value y0, Value y1, Value x0, Value x1) {
+                perspectiveTransformCoreTiled(builder, loc, resIntPart,
+                                              resFracPart, y0, y1, x0, x1, m,
+                                              stride, RSV_BITS);
+              });
 }
 
 void remapNearest(OpBuilder &builder, Location loc, Value input, Value output,
                   Value mapInt, Value yStart, Value xStart, Value rows,
-                  Value cols) {
+                  Value cols, int64_t stride, const RemapBorder &border) {
   Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
   Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
-  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
-  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
-  builder.create<scf::ForOp>(
-      loc, c0, rows, c1, std::nullopt,
-      [&](OpBuilder &yBuilder, Location yLoc, Value yiv, ValueRange) {
-        Value dstY = yBuilder.create<arith::AddIOp>(yLoc, yiv, yStart);
-        yBuilder.create<scf::ForOp>(
-            yLoc, c0, cols, c1, std::nullopt,
-            [&](OpBuilder &xBuilder, Location xLoc, Value xiv, ValueRange) {
-              Value dstX = xBuilder.create<arith::AddIOp>(xLoc, xiv, xStart);
-              Value srcXI16 = xBuilder.create<memref::LoadOp>(
-                  xLoc, mapInt, ValueRange{c0, yiv, xiv});
-              Value srcYI16 = xBuilder.create<memref::LoadOp>(
-                  xLoc, mapInt, ValueRange{c1, yiv, xiv});
-              Value srcX = xBuilder.create<arith::IndexCastOp>(
-                  xLoc, IndexType::get(xBuilder.getContext()), srcXI16);
-              Value srcY = xBuilder.create<arith::IndexCastOp>(
-                  xLoc, IndexType::get(xBuilder.getContext()), srcYI16);
-              Value xInBound = inBound(xBuilder, xLoc, srcX, c0, inputCol);
-              Value yInBound = inBound(xBuilder, xLoc, srcY, c0, inputRow);
-              Value pixelInBound =
-                  xBuilder.create<arith::AndIOp>(xLoc, xInBound, yInBound);
-              xBuilder.create<scf::IfOp>(
-                  xLoc, pixelInBound,
-                  [&](OpBuilder &ifBuilder, Location ifLoc) {
-                    Value pixel = ifBuilder.create<memref::LoadOp>(
-                        ifLoc, input, ValueRange{srcY, srcX});
-                    ifBuilder.create<memref::StoreOp>(ifLoc, pixel, output,
-                                                      ValueRange{dstY, dstX});
-                    ifBuilder.create<scf::YieldOp>(ifLoc);
-                  });
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType i32VecTy = VectorType::get({stride}, builder.getI32Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
 
-              xBuilder.create<scf::YieldOp>(xLoc);
-            });
+  Value inputRow = builder.create<arith::IndexCastOp>(
+      loc, builder.getI32Type(),
+      builder.create<memref::DimOp>(loc, input, c0));
+  Value inputCol = builder.create<arith::IndexCastOp>(
+      loc, builder.getI32Type(),
+      builder.create<memref::DimOp>(loc, input, c1));
+  Value inputRowVec = builder.create<vector::SplatOp>(loc, i32VecTy, inputRow);
+  Value inputColVec = builder.create<vector::SplatOp>(loc, i32VecTy, inputCol);
+  Value zeroI32Vec = builder.create<arith::ConstantOp>(
+      loc, i32VecTy, builder.getZeroAttr(i32VecTy));
+  Value oneI32Vec = builder.create<arith::ConstantOp>(
+      loc, DenseElementsAttr::get(i32VecTy, builder.getI32IntegerAttr(1)));
+  Value passThru =
+      border.value
+          ? builder.create<vector::SplatOp>(loc, vecTy, border.value)
+                .getResult()
+          : builder.create<arith::ConstantOp>(loc, vecTy,
+                                              builder.getZeroAttr(vecTy))
+                .getResult();
+  Value lastRowVec = builder.create<arith::SubIOp>(loc, inputRowVec, oneI32Vec);
+  Value lastColVec = builder.create<arith::SubIOp>(loc, inputColVec, oneI32Vec);
 
-        yBuilder.create<scf::YieldOp>(yLoc);
+  remapChunks(
+      builder, loc, yStart, xStart, rows, cols, stride,
+      [&](OpBuilder &builder, Location loc, Value y, Value x, Value dstY,
+          Value dstX, Value mask) {
+        Value srcX =
+            loadMapChunk(builder, loc, mapInt, c0, y, x, mask, stride);
+        Value srcY =
+            loadMapChunk(builder, loc, mapInt, c1, y, x, mask, stride);
+        if (border.replicate) {
+          srcX = clampVec(builder, loc, srcX, zeroI32Vec, lastColVec);
+          srcY = clampVec(builder, loc, srcY, zeroI32Vec, lastRowVec);
+        }
+        Value inImage = builder.create<arith::AndIOp>(
+            loc, mask,
+            builder.create<arith::AndIOp>(
+                loc, inBound(builder, loc, srcX, zeroI32Vec, inputColVec),
+                inBound(builder, loc, srcY, zeroI32Vec, inputRowVec)));
+        Value offsets = builder.create<arith::AddIOp>(
+            loc, builder.create<arith::MulIOp>(loc, srcY, inputColVec), srcX);
+        Value pixels = builder.create<vector::GatherOp>(
+            loc, vecTy, input, ValueRange{c0, c0},
+            builder.create<arith::IndexCastOp>(loc, indexVecTy, offsets),
+            inImage, passThru);
+        // Without a border value, pixels mapped outside of the input keep
+        // their output value.
+        builder.create<vector::MaskedStoreOp>(
+            loc, output, ValueRange{dstY, dstX},
+            border.value ? mask : inImage, pixels);
+      });
+}
+
+void remapSeparable(OpBuilder &builder, Location loc, Value input,
+                    Value output, Value mapInt, Value mapFrac, Value weights,
+                    int64_t taps, Value yStart, Value xStart, Value rows,
+                    Value cols, int64_t stride, const int &RSV_BITS,
+                    const RemapBorder &border) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType i32VecTy = VectorType::get({stride}, builder.getI32Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  auto splatI32 = [&](int64_t val) -> Value {
+    return builder.create<arith::ConstantOp>(
+        loc, DenseElementsAttr::get(i32VecTy, builder.getI32IntegerAttr(val)));
+  };
+  Value inputRow = builder.create<arith::IndexCastOp>(
+      loc, builder.getI32Type(),
+      builder.create<memref::DimOp>(loc, input, c0));
+  Value inputCol = builder.create<arith::IndexCastOp>(
+      loc, builder.getI32Type(),
+      builder.create<memref::DimOp>(loc, input, c1));
+  Value inputRowVec = builder.create<vector::SplatOp>(loc, i32VecTy, inputRow);
+  Value inputColVec = builder.create<vector::SplatOp>(loc, i32VecTy, inputCol);
+  Value zeroI32Vec = splatI32(0);
+  Value fracMaskVec = splatI32((1 << RSV_BITS) - 1);
+  Value halfVec = splatI32(1 << (RSV_BITS - 1));
+  Value firstTapVec = splatI32(taps / 2 - 1);
+  Value zeroVec = builder.create<arith::ConstantOp>(
+      loc, vecTy, builder.getZeroAttr(vecTy));
+  Value allLanes = builder.create<arith::ConstantOp>(
+      loc, DenseElementsAttr::get(maskTy, true));
+  Value outsideVec =
+      border.value ? builder.create<vector::SplatOp>(loc, vecTy, border.value)
+                         .getResult()
+                   : zeroVec;
+  Value lastRowVec =
+      builder.create<arith::SubIOp>(loc, inputRowVec, splatI32(1));
+  Value lastColVec =
+      builder.create<arith::SubIOp>(loc, inputColVec, splatI32(1));
+
+  remapChunks(
+      builder, loc, yStart, xStart, rows, cols, stride,
+      [&](OpBuilder &builder, Location loc, Value y, Value x, Value dstY,
+          Value dstX, Value mask) {
+        // The integer parts are rounded to the nearest pixel. Move them to the
+        // first tap, counted from the pixel left of / above the sample, and
+        // the fractional parts to the distance from that pixel.
+        auto axis = [&](Value plane, Value &first, Value &fracIndex) {
+          Value pixel =
+              loadMapChunk(builder, loc, mapInt, plane, y, x, mask, stride);
+          Value frac = builder.create<arith::AndIOp>(
+              loc,
+              loadMapChunk(builder, loc, mapFrac, plane, y, x, mask, stride),
+              fracMaskVec);
+          Value roundedUp = builder.create<arith::CmpIOp>(
+              loc, arith::CmpIPredicate::slt, frac, halfVec);
+          Value floor = builder.create<arith::SubIOp>(
+              loc, pixel,
+              builder.create<arith::ExtUIOp>(loc, i32VecTy, roundedUp));
+          first = builder.create<arith::SubIOp>(loc, floor, firstTapVec);
+          fracIndex = builder.create<arith::IndexCastOp>(
+              loc, indexVecTy,
+              builder.create<arith::AndIOp>(
+                  loc, builder.create<arith::AddIOp>(loc, frac, halfVec),
+                  fracMaskVec));
+        };
+        Value firstX, fracX, firstY, fracY;
+        axis(c0, firstX, fracX);
+        axis(c1, firstY, fracY);
+
+        SmallVector<Value, 8> weightsX, weightsY;
+        for (int64_t i = 0; i < taps; ++i) {
+          Value tap = builder.create<arith::ConstantIndexOp>(loc, i);
+          weightsX.push_back(builder.create<vector::GatherOp>(
+              loc, vecTy, weights, ValueRange{tap, c0}, fracX, allLanes,
+              zeroVec));
+          weightsY.push_back(builder.create<vector::GatherOp>(
+              loc, vecTy, weights, ValueRange{tap, c0}, fracY, allLanes,
+              zeroVec));
+        }
+
+        // Taps outside of the input read the border value (0 by default),
+        // unless the border replicates the edge pixels.
+        Value acc = zeroVec;
+        for (int64_t i = 0; i < taps; ++i) {
+          Value srcY =
+              builder.create<arith::AddIOp>(loc, firstY, splatI32(i));
+          if (border.replicate)
+            srcY = clampVec(builder, loc, srcY, zeroI32Vec, lastRowVec);
+          Value rowMask = builder.create<arith::AndIOp>(
+              loc, mask, inBound(builder, loc, srcY, zeroI32Vec, inputRowVec));
+          Value rowOffset =
+              builder.create<arith::MulIOp>(loc, srcY, inputColVec);
+          Value rowAcc = zeroVec;
+          for (int64_t j = 0; j < taps; ++j) {
+            Value srcX =
+                builder.create<arith::AddIOp>(loc, firstX, splatI32(j));
+            if (border.replicate)
+              srcX = clampVec(builder, loc, srcX, zeroI32Vec, lastColVec);
+            Value tapMask = builder.create<arith::AndIOp>(
+                loc, rowMask,
+                inBound(builder, loc, srcX, zeroI32Vec, inputColVec));
+            Value offsets = builder.create<arith::IndexCastOp>(
+                loc, indexVecTy,
+                builder.create<arith::AddIOp>(loc, rowOffset, srcX));
+            Value pixels = builder.create<vector::GatherOp>(
+                loc, vecTy, input, ValueRange{c0, c0}, offsets, tapMask,
+                outsideVec);
+            rowAcc = builder.create<vector::FMAOp>(loc, pixels, weightsX[j],
+                                                   rowAcc);
+          }
+          acc = builder.create<vector::FMAOp>(loc, rowAcc, weightsY[i], acc);
+        }
+        builder.create<vector::MaskedStoreOp>(loc, output,
+                                              ValueRange{dstY, dstX}, mask,
+                                              acc);
       });
 }
 } // namespace buddy
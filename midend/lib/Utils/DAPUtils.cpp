@@ -0,0 +1,215 @@
+//====- DAPUtils.cpp ------------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements DAP dialect specific utility functions for the buddy
+// compiler ecosystem.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef UTILS_DAPUTILS_DEF
+#define UTILS_DAPUTILS_DEF
+
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Math/IR/Math.h>
+#include <mlir/Dialect/MemRef/IR/MemRef.h>
+#include <mlir/Dialect/SCF/IR/SCF.h>
+#include <mlir/Dialect/Vector/IR/VectorOps.h>
+#include <mlir/IR/MLIRContext.h>
+#include <mlir/IR/Value.h>
+#include <cmath>
+#include <vector>
+
+#include "Utils/DAPUtils.h"
+#include "Utils/Utils.h"
+
+using namespace mlir;
+
+namespace buddy {
+namespace dap {
+
+// Fill `table` with the bit reversed position of every index of a length n
+// transform. n must be a power of two.
+void buildBitReverseTable(OpBuilder &builder, Location loc, Value table,
+                          Value n) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  // log2(n) is the number of trailing zeros of n.
+  Value n64 = builder.create<arith::IndexCastOp>(loc, builder.getI64Type(), n);
+  Value log2N64 = builder.create<math::CountTrailingZerosOp>(loc, n64);
+  Value log2N = builder.create<arith::IndexCastOp>(
+      loc, builder.getIndexType(), log2N64);
+
+  builder.create<scf::ForOp>(
+      loc, c0, n, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value iv, ValueRange) {
+        auto bits = builder.create<scf::ForOp>(
+            loc, c0, log2N, c1, ValueRange{c0, iv},
+            [&](OpBuilder &builder, Location loc, Value, ValueRange iargs) {
+              Value shifted = builder.create<arith::ShLIOp>(loc, iargs[0], c1);
+              Value bit = builder.create<arith::AndIOp>(loc, iargs[1], c1);
+              Value reversed = builder.create<arith::OrIOp>(loc, shifted, bit);
+              Value rest = builder.create<arith::ShRUIOp>(loc, iargs[1], c1);
+              builder.create<scf::YieldOp>(loc, ValueRange{reversed, rest});
+            });
+        builder.create<memref::StoreOp>(loc, bits.getResult(0), table,
+                                        ValueRange{iv});
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Fill `cosTable` and `sinTable` with the twiddle factors of a length n
+// forward transform.
+void buildTwiddleTables(OpBuilder &builder, Location loc, Value cosTable,
+                        Value sinTable, Value n, FloatType elemTy) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value half = builder.create<arith::DivUIOp>(loc, n, c2);
+
+  Value n64 = builder.create<arith::IndexCastOp>(loc, builder.getI64Type(), n);
+  Value nF = builder.create<arith::SIToFPOp>(loc, elemTy, n64);
+  Value minusTwoPi = builder.create<arith::ConstantOp>(
+      loc, builder.getFloatAttr(elemTy, -2 * M_PI));
+  Value step = builder.create<arith::DivFOp>(loc, minusTwoPi, nF);
+
+  builder.create<scf::ForOp>(
+      loc, c0, half, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value iv, ValueRange) {
+        Value k64 =
+            builder.create<arith::IndexCastOp>(loc, builder.getI64Type(), iv);
+        Value kF = builder.create<arith::SIToFPOp>(loc, elemTy, k64);
+        Value angle = builder.create<arith::MulFOp>(loc, kF, step);
+        Value cosVal = builder.create<math::CosOp>(loc, angle);
+        Value sinVal = builder.create<math::SinOp>(loc, angle);
+        builder.create<memref::StoreOp>(loc, cosVal, cosTable, ValueRange{iv});
+        builder.create<memref::StoreOp>(loc, sinVal, sinTable, ValueRange{iv});
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Radix-2 decimation in time FFT of vecType.getNumElements() independent
+// signals stored column wise in [n, lanes] buffers.
+void fftAcrossLanes(OpBuilder &builder, Location loc, Value memRefReal2D,
+                    Value memRefImag2D, Value cosTable, Value sinTable,
+                    Value n, VectorType vecType) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+
+  // Every stage doubles the butterfly span; the loop runs while span < n.
+  Value n64 = builder.create<arith::IndexCastOp>(loc, builder.getI64Type(), n);
+  Value log2N64 = builder.create<math::CountTrailingZerosOp>(loc, n64);
+  Value log2N = builder.create<arith::IndexCastOp>(
+      loc, builder.getIndexType(), log2N64);
+
+  builder.create<scf::ForOp>(
+      loc, c0, log2N, c1, ValueRange{c1},
+      [&](OpBuilder &builder, Location loc, Value, ValueRange stageArgs) {
+        Value halfSpan = stageArgs[0];
+        Value span = builder.create<arith::ShLIOp>(loc, halfSpan, c1);
+        // Twiddle k of this stage is entry k * (n / span) of the full table.
+        Value twiddleStep = builder.create<arith::DivUIOp>(loc, n, span);
+
+        builder.create<scf::ForOp>(
+            loc, c0, n, span, std::nullopt,
+            [&](OpBuilder &builder, Location loc, Value start, ValueRange) {
+              builder.create<scf::ForOp>(
+                  loc, c0, halfSpan, c1, std::nullopt,
+                  [&](OpBuilder &builder, Location loc, Value k, ValueRange) {
+                    Value twiddleIdx =
+                        builder.create<arith::MulIOp>(loc, k, twiddleStep);
+                    Value wReal = builder.create<memref::LoadOp>(
+                        loc, cosTable, ValueRange{twiddleIdx});
+                    Value wImag = builder.create<memref::LoadOp>(
+                        loc, sinTable, ValueRange{twiddleIdx});
+                    Value wRealVec =
+                        builder.create<vector::BroadcastOp>(loc, vecType, wReal);
+                    Value wImagVec =
+                        builder.create<vector::BroadcastOp>(loc, vecType, wImag);
+
+                    Value top = builder.create<arith::AddIOp>(loc, start, k);
+                    Value bottom =
+                        builder.create<arith::AddIOp>(loc, top, halfSpan);
+                    Value topReal = builder.create<vector::LoadOp>(
+                        loc, vecType, memRefReal2D, ValueRange{top, c0});
+                    Value topImag = builder.create<vector::LoadOp>(
+                        loc, vecType, memRefImag2D, ValueRange{top, c0});
+                    Value bottomReal = builder.create<vector::LoadOp>(
+                        loc, vecType, memRefReal2D, ValueRange{bottom, c0});
+                    Value bottomImag = builder.create<vector::LoadOp>(
+                        loc, vecType, memRefImag2D, ValueRange{bottom, c0});
+
+                    std::vector<Value> product =
+                        complexVecMulI(builder, loc, bottomReal, bottomImag,
+                                       wRealVec, wImagVec);
+
+                    Value sumReal =
+                        builder.create<arith::AddFOp>(loc, topReal, product[0]);
+                    Value sumImag =
+                        builder.create<arith::AddFOp>(loc, topImag, product[1]);
+                    Value diffReal =
+                        builder.create<arith::SubFOp>(loc, topReal, product[0]);
+                    Value diffImag =
+                        builder.create<arith::SubFOp>(loc, topImag, product[1]);
+
+                    builder.create<vector::StoreOp>(loc, sumReal, memRefReal2D,
+                                                    ValueRange{top, c0});
+                    builder.create<vector::StoreOp>(loc, sumImag, memRefImag2D,
+                                                    ValueRange{top, c0});
+                    builder.create<vector::StoreOp>(
+                        loc, diffReal, memRefReal2D, ValueRange{bottom, c0});
+                    builder.create<vector::StoreOp>(
+                        loc, diffImag, memRefImag2D, ValueRange{bottom, c0});
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc, span);
+      });
+}
+
+// Dot product of a row of `lhs` with `rhs` using masked vectors.
+Value maskedRowDot(OpBuilder &builder, Location loc, Value lhs, Value row,
+                   Value rhs, Value length, int64_t stride, FloatType elemTy) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  VectorType vecType = VectorType::get({stride}, elemTy);
+  VectorType maskType = VectorType::get({stride}, builder.getI1Type());
+  Value zero = builder.create<arith::ConstantFloatOp>(
+      loc, APFloat::getZero(elemTy.getFloatSemantics()), elemTy);
+  Value zeroVec = builder.create<vector::BroadcastOp>(loc, vecType, zero);
+
+  auto loop = builder.create<scf::ForOp>(
+      loc, c0, length, strideVal, ValueRange{zeroVec},
+      [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+        Value remaining = builder.create<arith::SubIOp>(loc, length, iv);
+        Value mask = builder.create<vector::CreateMaskOp>(
+            loc, maskType, ValueRange{remaining});
+        Value lhsVec = builder.create<vector::MaskedLoadOp>(
+            loc, vecType, lhs, ValueRange{row, iv}, mask, zeroVec);
+        Value rhsVec = builder.create<vector::MaskedLoadOp>(
+            loc, vecType, rhs, ValueRange{iv}, mask, zeroVec);
+        Value acc =
+            builder.create<vector::FMAOp>(loc, lhsVec, rhsVec, iargs[0]);
+        builder.create<scf::YieldOp>(loc, acc);
+      });
+  return builder.create<vector::ReductionOp>(loc, vector::CombiningKind::ADD,
+                                             loop.getResult(0));
+}
+
+} // namespace dap
+} // namespace buddy
+
+#endif // UTILS_DAPUTILS_DEF
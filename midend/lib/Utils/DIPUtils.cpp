@@ -30,6 +30,7 @@
 #include <mlir/Dialect/SCF/IR/SCF.h>
 #include <mlir/Dialect/Vector/IR/VectorOps.h>
 #include <mlir/IR/MLIRContext.h>
+#include <cfloat>
 #include <mlir/IR/Value.h>
 #include <numeric>
 #include <vector>
@@ -48,12 +49,56 @@ template DIP_ERROR
 checkDIPCommonTypes<dip::Corr2DOp>(dip::Corr2DOp,
                                    const std::vector<Value> &args);
 template DIP_ERROR
+checkDIPCommonTypes<dip::SepCorr2DOp>(dip::SepCorr2DOp,
+                                      const std::vector<Value> &args);
+template DIP_ERROR
 checkDIPCommonTypes<dip::Rotate2DOp>(dip::Rotate2DOp,
                                      const std::vector<Value> &args);
 template DIP_ERROR
 checkDIPCommonTypes<dip::Resize2DOp>(dip::Resize2DOp,
                                      const std::vector<Value> &args);
 template DIP_ERROR
+checkDIPCommonTypes<dip::WarpAffine2DOp>(dip::WarpAffine2DOp,
+                                         const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::WarpPerspective2DOp>(dip::WarpPerspective2DOp,
+                                              const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::GaussianPyramid2DOp>(dip::GaussianPyramid2DOp,
+                                              const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::LaplacianPyramid2DOp>(dip::LaplacianPyramid2DOp,
+                                               const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::IntegralImage2DOp>(dip::IntegralImage2DOp,
+                                            const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::BoxFilter2DOp>(dip::BoxFilter2DOp,
+                                        const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::MedianBlur2DOp>(dip::MedianBlur2DOp,
+                                         const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::Gradient2DOp>(dip::Gradient2DOp,
+                                       const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::Histogram2DOp>(dip::Histogram2DOp,
+                                        const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::EqualizeHist2DOp>(dip::EqualizeHist2DOp,
+                                           const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::CLAHE2DOp>(dip::CLAHE2DOp,
+                                    const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::LUT2DOp>(dip::LUT2DOp,
+                                  const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::CvtColorOp>(dip::CvtColorOp,
+                                     const std::vector<Value> &args);
+template DIP_ERROR checkDIPCommonTypes<dip::ResizeNormalize2DOp>(
+    dip::ResizeNormalize2DOp, const std::vector<Value> &args);
+template DIP_ERROR
 checkDIPCommonTypes<dip::Erosion2DOp>(dip::Erosion2DOp,
                                       const std::vector<Value> &args);
 template DIP_ERROR
@@ -103,6 +148,21 @@ DIP_ERROR checkDIPCommonTypes(DIPOP op, const std::vector<Value> &args) {
       return DIP_ERROR::INCONSISTENT_TYPES;
     }
 
+    if (notSameElementTypeForMemrefs(inElemTy)) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "sep_corr_2d") {
+    auto inElemTy = getElementType(0);
+    auto kXElemTy = getElementType(1);
+    auto kYElemTy = getElementType(2);
+    auto outElemTy = getElementType(3);
+    auto constElemTy = getType(4);
+
+    if (inElemTy != kXElemTy || kXElemTy != kYElemTy ||
+        kYElemTy != outElemTy || outElemTy != constElemTy) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
     if (notSameElementTypeForMemrefs(inElemTy)) {
       return DIP_ERROR::UNSUPPORTED_TYPE;
     }
@@ -120,59 +180,172 @@ DIP_ERROR checkDIPCommonTypes(DIPOP op, const std::vector<Value> &args) {
     if (notSameElementTypeForMemrefs(inElemTy)) {
       return DIP_ERROR::UNSUPPORTED_TYPE;
     }
-  } else if (op->getName().stripDialect() == "erosion_2d" ||
-             op->getName().stripDialect() == "dilation_2d") {
+  } else if (op->getName().stripDialect() == "warp_affine_2d" ||
+             op->getName().stripDialect() == "warp_perspective_2d") {
+    auto inElemTy = getElementType(0);
+    auto outElemTy = getElementType(1);
+    auto constElemTy = getType(2);
+
+    if (inElemTy != outElemTy || outElemTy != constElemTy) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
 
+    if (notSameElementTypeForMemrefs(inElemTy)) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "gaussian_pyramid_2d" ||
+             op->getName().stripDialect() == "laplacian_pyramid_2d") {
+    // The input and every level of the pyramid.
     auto inElemTy = getElementType(0);
-    auto kElemTy = getElementType(1);
-    auto outElemTy = getElementType(2);
-    auto copyElemTy = getElementType(3);
-    auto constElemTy = getType(4);
+    for (size_t i = 1; i < args.size(); ++i) {
+      if (getElementType(i) != inElemTy) {
+        return DIP_ERROR::INCONSISTENT_TYPES;
+      }
+    }
 
-    if (inElemTy != kElemTy || kElemTy != outElemTy ||
-        outElemTy != copyElemTy || copyElemTy != constElemTy) {
+    if (notSameElementTypeForMemrefs(inElemTy)) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "integral_image_2d") {
+    // The sums may be wider than the input, but not narrower.
+    auto inElemTy = getElementType(0);
+    for (size_t i = 1; i < args.size(); ++i) {
+      auto sumElemTy = getElementType(i);
+      if (!sumElemTy.isa<FloatType>() ||
+          sumElemTy.getIntOrFloatBitWidth() <
+              inElemTy.getIntOrFloatBitWidth()) {
+        return DIP_ERROR::INCONSISTENT_TYPES;
+      }
+    }
+
+    if (!inElemTy.isa<FloatType>()) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "box_filter_2d") {
+    auto inElemTy = getElementType(0);
+    auto outElemTy = getElementType(1);
+    auto constElemTy = getType(2);
+
+    if (inElemTy != outElemTy || outElemTy != constElemTy) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
+    if (!inElemTy.isa<FloatType>()) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "median_blur_2d") {
+    auto inElemTy = getElementType(0);
+    auto outElemTy = getElementType(1);
+    auto constElemTy = getType(2);
+
+    if (inElemTy != outElemTy || outElemTy != constElemTy) {
       return DIP_ERROR::INCONSISTENT_TYPES;
     }
 
     if (notSameElementTypeForMemrefs(inElemTy)) {
       return DIP_ERROR::UNSUPPORTED_TYPE;
     }
-  } else if (op->getName().stripDialect() == "opening_2d" ||
-             op->getName().stripDialect() == "closing_2d") {
+  } else if (op->getName().stripDialect() == "gradient_2d") {
+    // The input, the magnitude, the constant and the derivatives, if any.
     auto inElemTy = getElementType(0);
-    auto kElemTy = getElementType(1);
+    auto constElemTy = getType(2);
+
+    if (constElemTy != inElemTy) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+    for (size_t i = 1; i < args.size(); ++i) {
+      if (i != 2 && getElementType(i) != inElemTy) {
+        return DIP_ERROR::INCONSISTENT_TYPES;
+      }
+    }
+
+    if (!inElemTy.isa<FloatType>()) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "histogram_2d") {
+    auto inElemTy = getElementType(0);
+    auto histElemTy = getElementType(1);
+    auto lowElemTy = getType(2);
+    auto highElemTy = getType(3);
+
+    if (inElemTy != lowElemTy || lowElemTy != highElemTy ||
+        !histElemTy.isInteger(32)) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
+    if (!inElemTy.isa<FloatType>()) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "equalize_hist_2d" ||
+             op->getName().stripDialect() == "clahe_2d") {
+    // The input, the output and, for CLAHE, the clip limit.
+    auto inElemTy = getElementType(0);
+    if (getElementType(1) != inElemTy ||
+        (args.size() > 2 && getType(2) != inElemTy)) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
+    if (!inElemTy.isa<FloatType>()) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "lut_2d") {
+    // The table may have another type than the input it is indexed with.
+    auto inElemTy = getElementType(0);
+    auto lutElemTy = getElementType(1);
     auto outElemTy = getElementType(2);
-    auto outElemTy1 = getElementType(3);
-    auto copyElemTy = getElementType(4);
-    auto copyElemTy1 = getElementType(5);
-    auto constElemTy = getType(6);
 
-    if (inElemTy != kElemTy || kElemTy != outElemTy ||
-        outElemTy != outElemTy1 || outElemTy1 != copyElemTy ||
-        copyElemTy != copyElemTy1 || copyElemTy1 != constElemTy) {
+    if (lutElemTy != outElemTy) {
       return DIP_ERROR::INCONSISTENT_TYPES;
     }
 
-    if (notSameElementTypeForMemrefs(inElemTy)) {
+    if (!inElemTy.isa<FloatType>()) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "cvt_color") {
+    // u8 inputs in i8 memrefs are converted to the output type.
+    auto inElemTy = getElementType(0);
+    auto outElemTy = getElementType(1);
+    auto scaleElemTy = getType(2);
+
+    if (outElemTy != scaleElemTy ||
+        (inElemTy != outElemTy && !inElemTy.isInteger(8))) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
+    if (!outElemTy.isa<FloatType>()) {
       return DIP_ERROR::UNSUPPORTED_TYPE;
     }
-  } else if (op->getName().stripDialect() == "tophat_2d" ||
+  } else if (op->getName().stripDialect() == "resize_normalize_2d") {
+    // u8 inputs in i8 memrefs are converted to the output type.
+    auto inElemTy = getElementType(0);
+    auto outElemTy = getElementType(1);
+    auto scaleElemTy = getType(2);
+    auto meanElemTy = getElementType(3);
+    auto stdElemTy = getElementType(4);
+
+    if (outElemTy != scaleElemTy || outElemTy != meanElemTy ||
+        outElemTy != stdElemTy ||
+        (inElemTy != outElemTy && !inElemTy.isInteger(8))) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
+    if (!outElemTy.isa<FloatType>()) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "erosion_2d" ||
+             op->getName().stripDialect() == "dilation_2d" ||
+             op->getName().stripDialect() == "opening_2d" ||
+             op->getName().stripDialect() == "closing_2d" ||
+             op->getName().stripDialect() == "tophat_2d" ||
              op->getName().stripDialect() == "bottomhat_2d" ||
              op->getName().stripDialect() == "morphgrad_2d") {
     auto inElemTy = getElementType(0);
     auto kElemTy = getElementType(1);
     auto outElemTy = getElementType(2);
-    auto outElemTy1 = getElementType(3);
-    auto outElemTy2 = getElementType(4);
-    auto inElemTy1 = getElementType(5);
-    auto copyElemTy = getElementType(6);
-    auto copyElemTy1 = getElementType(7);
-    auto constElemTy = getType(8);
+    auto constElemTy = getType(3);
 
     if (inElemTy != kElemTy || kElemTy != outElemTy ||
-        outElemTy != outElemTy1 || outElemTy1 != outElemTy2 ||
-        outElemTy2 != inElemTy1 || inElemTy1 != copyElemTy ||
-        copyElemTy != copyElemTy1 || copyElemTy1 != constElemTy) {
+        outElemTy != constElemTy) {
       return DIP_ERROR::INCONSISTENT_TYPES;
     }
 
@@ -184,6 +357,50 @@ DIP_ERROR checkDIPCommonTypes(DIPOP op, const std::vector<Value> &args) {
   return DIP_ERROR::NO_ERROR;
 }
 
+// Build the loop nest of affine::buildAffineLoopNest, optionally running the
+// outermost (row) loop in parallel bands of `rowGrain` rows.
+void buildRowBandLoopNest(
+    OpBuilder &builder, Location loc, ValueRange lbs, ValueRange ubs,
+    ArrayRef<int64_t> steps, int64_t rowGrain,
+    function_ref<void(OpBuilder &, Location, ValueRange)> bodyBuilder) {
+  if (rowGrain <= 0) {
+    affine::buildAffineLoopNest(builder, loc, lbs, ubs, steps, bodyBuilder);
+    return;
+  }
+
+  MLIRContext *ctx = builder.getContext();
+  int64_t bandStep = rowGrain * steps[0];
+  AffineMap identity = builder.getDimIdentityMap();
+  auto bands = builder.create<affine::AffineParallelOp>(
+      loc, TypeRange{}, ArrayRef<arith::AtomicRMWKind>{},
+      ArrayRef<AffineMap>{identity}, ValueRange{lbs[0]},
+      ArrayRef<AffineMap>{identity}, ValueRange{ubs[0]},
+      ArrayRef<int64_t>{bandStep});
+
+  OpBuilder::InsertionGuard guard(builder);
+  builder.setInsertionPointToStart(bands.getBody());
+  Value bandStart = bands.getIVs()[0];
+
+  // Rows of this band: [bandStart, min(bandStart + bandStep, ub)).
+  AffineExpr d0, d1;
+  bindDims(ctx, d0, d1);
+  AffineMap bandEnd = AffineMap::get(2, 0, {d0 + bandStep, d1}, ctx);
+  builder.create<affine::AffineForOp>(
+      loc, ValueRange{bandStart}, identity, ValueRange{bandStart, ubs[0]},
+      bandEnd, steps[0], std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value row, ValueRange) {
+        affine::buildAffineLoopNest(
+            builder, loc, lbs.drop_front(), ubs.drop_front(),
+            steps.drop_front(),
+            [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+              SmallVector<Value, 4> allIvs{row};
+              allIvs.append(ivs.begin(), ivs.end());
+              bodyBuilder(builder, loc, allIvs);
+            });
+        builder.create<affine::AffineYieldOp>(loc);
+      });
+}
+
 // Inserts a constant op with value 0 into a location `loc` based on type
 // `type`. Supported types are : f32, f64, integer types.
 Value insertZeroConstantOp(MLIRContext *ctx, OpBuilder &builder, Location loc,
@@ -497,7 +714,8 @@ inline void inverseAffineMatrix(OpBuilder &builder, Location loc,
 void affineTransformController(OpBuilder &builder, Location loc,
                                MLIRContext *ctx, Value input, Value output,
                                SmallVector<Value, 6> affineMatrix,
-                               int64_t stride) {
+                               int64_t stride, int interpType,
+                               int64_t rowGrain, const RemapBorder &border) {
   VectorType vectorTyF32 = VectorType::get({stride}, FloatType::getF32(ctx));
   VectorType vectorTyI32 = VectorType::get({stride}, IntegerType::get(ctx, 32));
 
@@ -584,12 +802,76 @@ void affineTransformController(OpBuilder &builder, Location loc,
 
   affineTransformCore(builder, loc, input, output, c0Index, outputRow, c0Index,
                       outputCol, affineMatrix[1], affineMatrix[4], xMm0, xMm3,
-                      stride, RSV_BITS, 0);
+                      stride, RSV_BITS, interpType, rowGrain, border);
 
   builder.create<memref::DeallocOp>(loc, xMm0);
   builder.create<memref::DeallocOp>(loc, xMm3);
 }
 
+// Compute the inverse of the 3x3 perspective matrix as its adjugate divided
+// by the determinant. A singular matrix yields the zero matrix, which maps
+// every output pixel to the origin.
+inline void inversePerspectiveMatrix(OpBuilder &builder, Location loc,
+                                     SmallVector<Value, 9> &m) {
+  Value c0F32 = builder.create<arith::ConstantOp>(
+      loc, builder.getF32FloatAttr((float).0));
+  // m[a] * m[b] - m[c] * m[d]
+  auto cross = [&](int a, int b, int c, int d) -> Value {
+    return builder.create<arith::SubFOp>(
+        loc, builder.create<arith::MulFOp>(loc, m[a], m[b]),
+        builder.create<arith::MulFOp>(loc, m[c], m[d]));
+  };
+  SmallVector<Value, 9> adj{cross(4, 8, 5, 7), cross(2, 7, 1, 8),
+                            cross(1, 5, 2, 4), cross(5, 6, 3, 8),
+                            cross(0, 8, 2, 6), cross(2, 3, 0, 5),
+                            cross(3, 7, 4, 6), cross(1, 6, 0, 7),
+                            cross(0, 4, 1, 3)};
+  Value D = builder.create<arith::AddFOp>(
+      loc,
+      builder.create<arith::AddFOp>(
+          loc, builder.create<arith::MulFOp>(loc, m[0], adj[0]),
+          builder.create<arith::MulFOp>(loc, m[1], adj[3])),
+      builder.create<arith::MulFOp>(loc, m[2], adj[6]));
+  Value dEq0 =
+      builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ, D, c0F32);
+  auto scfRes = builder.create<scf::IfOp>(
+      loc, dEq0,
+      [&](OpBuilder &thenBuilder, Location thenLoc) {
+        thenBuilder.create<scf::YieldOp>(thenLoc, ValueRange{c0F32});
+      },
+      [&](OpBuilder &elseBuilder, Location elseLoc) {
+        Value c1F32 = elseBuilder.create<arith::ConstantOp>(
+            elseLoc, builder.getF32FloatAttr((float)1.));
+        Value res = elseBuilder.create<arith::DivFOp>(elseLoc, c1F32, D);
+        elseBuilder.create<scf::YieldOp>(elseLoc, ValueRange{res});
+      });
+  D = scfRes.getResult(0);
+  for (int i = 0; i < 9; ++i)
+    m[i] = builder.create<arith::MulFOp>(loc, adj[i], D);
+}
+
+// Controls perspective transform application.
+void perspectiveTransformController(OpBuilder &builder, Location loc,
+                                    Value input, Value output,
+                                    SmallVector<Value, 9> perspectiveMatrix,
+                                    int64_t stride, int interpType,
+                                    int64_t rowGrain,
+                                    const RemapBorder &border) {
+  Value c0Index = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1Index = builder.create<arith::ConstantIndexOp>(loc, 1);
+
+  inversePerspectiveMatrix(builder, loc, perspectiveMatrix);
+
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0Index);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1Index);
+
+  // Reserve as many fraction bits as affineTransformController.
+  const int RSV_BITS = 5;
+  perspectiveTransformCore(builder, loc, input, output, c0Index, outputRow,
+                           c0Index, outputCol, perspectiveMatrix, stride,
+                           RSV_BITS, interpType, rowGrain, border);
+}
+
 // Controls shear transform application.
 void shearTransformController(
     OpBuilder &builder, Location loc, MLIRContext *ctx,
@@ -729,101 +1011,2999 @@ void fillPixelsBilinearInterpolate(
         Value weightVal4 = builder.create<arith::MulFOp>(loc, indexWeights[0],
                                                          indexWeights[1]);
 
-        Value interm1 =
-            builder.create<arith::MulFOp>(loc, pixelVal_a, weightVal1);
-        Value interm2 =
-            builder.create<arith::MulFOp>(loc, pixelVal_b, weightVal2);
-        Value interm3 =
-            builder.create<arith::MulFOp>(loc, pixelVal_c, weightVal3);
-        Value interm4 =
-            builder.create<arith::MulFOp>(loc, pixelVal_d, weightVal4);
+        Value interm1 =
+            builder.create<arith::MulFOp>(loc, pixelVal_a, weightVal1);
+        Value interm2 =
+            builder.create<arith::MulFOp>(loc, pixelVal_b, weightVal2);
+        Value interm3 =
+            builder.create<arith::MulFOp>(loc, pixelVal_c, weightVal3);
+        Value interm4 =
+            builder.create<arith::MulFOp>(loc, pixelVal_d, weightVal4);
+
+        Value pixel_interm1 =
+            builder.create<arith::AddFOp>(loc, interm1, interm2);
+        Value pixel_interm2 =
+            builder.create<arith::AddFOp>(loc, interm3, interm4);
+        Value pixel_interm3 =
+            builder.create<arith::AddFOp>(loc, pixel_interm1, pixel_interm2);
+
+        Value pixelVal = roundOff(builder, loc, pixel_interm3);
+
+        builder.create<memref::StoreOp>(
+            loc, pixelVal, output, ValueRange{resIndices[1], resIndices[0]});
+
+        builder.create<affine::AffineYieldOp>(loc);
+      });
+}
+
+// Helper function for resizing an image using nearest neighbour interpolation
+// mechanism.
+void NearestNeighbourInterpolationResizing(
+    OpBuilder &builder, Location loc, MLIRContext *ctx,
+    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
+    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
+    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
+    Value outputRowLastElemF32, Value outputColLastElemF32,
+    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
+    int64_t stride, Value c0, Value c0F32, int64_t rowGrain) {
+  buildRowBandLoopNest(
+      builder, loc, lowerBounds, upperBounds, steps, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value ivs0F32 = indexToF32(builder, loc, ivs[0]);
+        Value yVec = builder.create<vector::SplatOp>(loc, vectorTy32, ivs0F32);
+        Value xVec = iotaVec(builder, loc, ctx, ivs[1], strideVal, vectorTy32,
+                             c0, stride);
+
+        Value resXVecInterm = builder.create<arith::MulFOp>(
+            loc, xVec, horizontalScalingFactorVec);
+        Value resYVecInterm =
+            builder.create<arith::MulFOp>(loc, yVec, verticalScalingFactorVec);
+
+        Value resXVec = roundOff(builder, loc, resXVecInterm);
+        Value resYVec = roundOff(builder, loc, resYVecInterm);
+
+        fillPixels(builder, loc, xVec, yVec, resXVec, resYVec, input, output,
+                   c0, strideVal, outputRowLastElemF32, outputColLastElemF32,
+                   inputRowLastElemF32, inputColLastElemF32, c0F32);
+      });
+}
+
+// Helper function for resizing an image using bilinear interpolation mechanism.
+void BilinearInterpolationResizing(
+    OpBuilder &builder, Location loc, MLIRContext *ctx,
+    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
+    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
+    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
+    Value outputRowLastElemF32, Value outputColLastElemF32,
+    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
+    int64_t stride, Value c0, Value c0F32, Value c1F32, int64_t rowGrain) {
+  buildRowBandLoopNest(
+      builder, loc, lowerBounds, upperBounds, steps, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value ivs0F32 = indexToF32(builder, loc, ivs[0]);
+        Value yVec = builder.create<vector::SplatOp>(loc, vectorTy32, ivs0F32);
+        Value xVec = iotaVec(builder, loc, ctx, ivs[1], strideVal, vectorTy32,
+                             c0, stride);
+
+        Value xVecInterm = builder.create<arith::MulFOp>(
+            loc, xVec, horizontalScalingFactorVec);
+        Value yVecInterm =
+            builder.create<arith::MulFOp>(loc, yVec, verticalScalingFactorVec);
+
+        Value xVecInterm_L = builder.create<math::FloorOp>(loc, xVecInterm);
+        Value xVecInterm_H = builder.create<math::CeilOp>(loc, xVecInterm);
+
+        Value yVecInterm_L = builder.create<math::FloorOp>(loc, yVecInterm);
+        Value yVecInterm_H = builder.create<math::CeilOp>(loc, yVecInterm);
+
+        Value xVecWeight =
+            builder.create<arith::SubFOp>(loc, xVecInterm, xVecInterm_L);
+        Value yVecWeight =
+            builder.create<arith::SubFOp>(loc, yVecInterm, yVecInterm_L);
+
+        fillPixelsBilinearInterpolate(
+            builder, loc, xVec, yVec, xVecInterm_L, yVecInterm_L, xVecInterm_H,
+            yVecInterm_H, input, output, c0, strideVal, xVecWeight, yVecWeight,
+            outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
+            inputColLastElemF32, c0F32, c1F32);
+      });
+}
+
+// Support radius of the separable resizing filters, in input pixels when
+// not downscaling.
+static double resizeFilterRadius(InterpolationType type) {
+  if (type == InterpolationType::AreaInterpolation)
+    return 0.5;
+  if (type == InterpolationType::BicubicInterpolation)
+    return 2;
+  return 4;
+}
+
+// Weight of the bicubic (Keys, a = -0.75) or Lanczos (a = 4) filter at the
+// distance `d` >= 0 (f32).
+static Value resizeFilterWeight(OpBuilder &builder, Location loc,
+                                InterpolationType type, Value d) {
+  auto f32 = [&](double val) -> Value {
+    return builder.create<arith::ConstantOp>(loc,
+                                             builder.getF32FloatAttr(val));
+  };
+  auto mul = [&](Value a, Value b) -> Value {
+    return builder.create<arith::MulFOp>(loc, a, b);
+  };
+  auto add = [&](Value a, Value b) -> Value {
+    return builder.create<arith::AddFOp>(loc, a, b);
+  };
+  auto less = [&](Value a, double b) -> Value {
+    return builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OLT, a,
+                                         f32(b));
+  };
+
+  if (type == InterpolationType::BicubicInterpolation) {
+    const double a = -0.75;
+    // ((a + 2) * d - (a + 3)) * d * d + 1 for d < 1 and
+    // ((a * d - 5 * a) * d + 8 * a) * d - 4 * a for d < 2.
+    Value inner =
+        add(mul(add(mul(f32(a + 2), d), f32(-(a + 3))), mul(d, d)), f32(1));
+    Value outer = add(
+        mul(add(mul(add(mul(f32(a), d), f32(-5 * a)), d), f32(8 * a)), d),
+        f32(-4 * a));
+    return builder.create<arith::SelectOp>(
+        loc, less(d, 1), inner,
+        builder.create<arith::SelectOp>(loc, less(d, 2), outer, f32(0)));
+  }
+
+  const double radius = resizeFilterRadius(type);
+  Value pd = mul(f32(M_PI), d);
+  Value sinc = builder.create<arith::DivFOp>(
+      loc,
+      mul(f32(radius), mul(builder.create<math::SinOp>(loc, pd),
+                           builder.create<math::SinOp>(
+                               loc, mul(pd, f32(1 / radius))))),
+      mul(pd, pd));
+  Value isZero = builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ,
+                                               d, f32(0));
+  return builder.create<arith::SelectOp>(
+      loc, isZero, f32(1),
+      builder.create<arith::SelectOp>(loc, less(d, radius), sinc, f32(0)));
+}
+
+// Build the coefficient table of one axis of a separable resize. Output
+// index i covers the input interval [i * scale, (i + 1) * scale). Tap k of i
+// reads the input index indices[k, i] with the weight weights[k, i] (of the
+// element type `elemTy`). When downscaling, the filter is stretched by the
+// scale to average the input instead of aliasing. Indices outside of the
+// input are clamped, so bicubic and Lanczos taps there replicate the border
+// as cv::resize does, while area taps there get the weight 0. The weights of
+// every output index sum to 1.
+static void resizeCoefficients(OpBuilder &builder, Location loc,
+                               InterpolationType type, Type elemTy,
+                               Value inSize, Value outSize, Value scale,
+                               Value &taps, Value &indices, Value &weights) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  auto f32 = [&](double val) -> Value {
+    return builder.create<arith::ConstantOp>(loc,
+                                             builder.getF32FloatAttr(val));
+  };
+  const double radius = resizeFilterRadius(type);
+  bool area = type == InterpolationType::AreaInterpolation;
+
+  // The filter covers 2 * radius * max(scale, 1) input pixels, so it touches
+  // at most one pixel more.
+  Value filterScale = builder.create<arith::MaxFOp>(loc, scale, f32(1));
+  Value support = builder.create<arith::MulFOp>(loc, filterScale, f32(radius));
+  Value span = builder.create<math::CeilOp>(
+      loc, builder.create<arith::MulFOp>(loc, support, f32(2)));
+  taps = builder.create<arith::AddIOp>(
+      loc,
+      builder.create<arith::IndexCastOp>(
+          loc, builder.getIndexType(),
+          builder.create<arith::FPToSIOp>(loc, builder.getI32Type(), span)),
+      c1);
+
+  MemRefType indicesTy = MemRefType::get(
+      {ShapedType::kDynamic, ShapedType::kDynamic}, builder.getI32Type());
+  MemRefType weightsTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  indices = builder.create<memref::AllocOp>(loc, indicesTy,
+                                            ValueRange{taps, outSize});
+  weights = builder.create<memref::AllocOp>(loc, weightsTy,
+                                            ValueRange{taps, outSize});
+
+  Value lastIndex = builder.create<arith::IndexCastOp>(
+      loc, builder.getI32Type(),
+      builder.create<arith::SubIOp>(loc, inSize, c1));
+  Value inSizeI32 =
+      builder.create<arith::IndexCastOp>(loc, builder.getI32Type(), inSize);
+  Value zeroI32 =
+      builder.create<arith::ConstantOp>(loc, builder.getI32IntegerAttr(0));
+
+  builder.create<scf::ForOp>(
+      loc, c0, outSize, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value i, ValueRange) {
+        Value iF32 = indexToF32(builder, loc, i);
+        Value low = builder.create<arith::MulFOp>(loc, iF32, scale);
+        Value center = builder.create<arith::MulFOp>(
+            loc, builder.create<arith::AddFOp>(loc, iF32, f32(0.5)), scale);
+        // The area filter starts at the pixel holding the start of the
+        // interval, the others at the first pixel center within support.
+        Value firstF32 = builder.create<math::FloorOp>(
+            loc, area ? low
+                      : builder.create<arith::AddFOp>(
+                            loc,
+                            builder.create<arith::SubFOp>(loc, center,
+                                                          support),
+                            f32(0.5)));
+        Value first = builder.create<arith::FPToSIOp>(
+            loc, builder.getI32Type(), firstF32);
+
+        // Tap k reads the input index first + k with an unnormalized weight.
+        auto tap = [&](OpBuilder &builder, Location loc, Value k, Value &index,
+                       Value &weight) {
+          index = builder.create<arith::AddIOp>(
+              loc, first,
+              builder.create<arith::IndexCastOp>(loc, builder.getI32Type(),
+                                                 k));
+          Value indexF32 = builder.create<arith::SIToFPOp>(
+              loc, builder.getF32Type(), index);
+          if (area) {
+            // Overlap of [index, index + 1) with [low, low + scale).
+            Value start = builder.create<arith::MaxFOp>(loc, indexF32, low);
+            Value end = builder.create<arith::MinFOp>(
+                loc, builder.create<arith::AddFOp>(loc, indexF32, f32(1)),
+                builder.create<arith::AddFOp>(loc, low, scale));
+            weight = builder.create<arith::MaxFOp>(
+                loc, builder.create<arith::SubFOp>(loc, end, start), f32(0));
+            Value inside = builder.create<arith::AndIOp>(
+                loc,
+                builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::sge,
+                                              index, zeroI32),
+                builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt,
+                                              index, inSizeI32));
+            weight =
+                builder.create<arith::SelectOp>(loc, inside, weight, f32(0));
+          } else {
+            Value d = builder.create<math::AbsFOp>(
+                loc, builder.create<arith::SubFOp>(
+                         loc,
+                         builder.create<arith::AddFOp>(loc, indexF32,
+                                                       f32(0.5)),
+                         center));
+            weight = resizeFilterWeight(
+                builder, loc, type,
+                builder.create<arith::DivFOp>(loc, d, filterScale));
+          }
+        };
+
+        auto sumLoop = builder.create<scf::ForOp>(
+            loc, c0, taps, c1, ValueRange{f32(0)},
+            [&](OpBuilder &builder, Location loc, Value k, ValueRange sum) {
+              Value index, weight;
+              tap(builder, loc, k, index, weight);
+              builder.create<scf::YieldOp>(
+                  loc, ValueRange{builder.create<arith::AddFOp>(loc, sum[0],
+                                                                weight)});
+            });
+        Value sum = sumLoop.getResult(0);
+
+        builder.create<scf::ForOp>(
+            loc, c0, taps, c1, std::nullopt,
+            [&](OpBuilder &builder, Location loc, Value k, ValueRange) {
+              Value index, weight;
+              tap(builder, loc, k, index, weight);
+              weight = builder.create<arith::DivFOp>(loc, weight, sum);
+              if (!elemTy.isF32())
+                weight = builder.create<arith::ExtFOp>(loc, elemTy, weight);
+              index = builder.create<arith::MinSIOp>(
+                  loc, builder.create<arith::MaxSIOp>(loc, index, zeroI32),
+                  lastIndex);
+              builder.create<memref::StoreOp>(loc, index, indices,
+                                              ValueRange{k, i});
+              builder.create<memref::StoreOp>(loc, weight, weights,
+                                              ValueRange{k, i});
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Helper function for resizing an image with the area, bicubic or Lanczos
+// filter. A vertical pass filters the columns of the input into a buffer of
+// output rows and input columns, and a horizontal pass filters the rows of
+// that buffer into the output.
+void SeparableFilterResizing(OpBuilder &builder, Location loc, Value input,
+                             Value output, Value horizontalScalingFactor,
+                             Value verticalScalingFactor,
+                             int interpType, int64_t stride,
+                             int64_t rowGrain) {
+  auto type = static_cast<InterpolationType>(interpType);
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType i32VecTy = VectorType::get({stride}, builder.getI32Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+
+  Value rowTaps, rowIndices, rowWeights;
+  resizeCoefficients(builder, loc, type, elemTy, inputRow, outputRow,
+                     verticalScalingFactor, rowTaps, rowIndices, rowWeights);
+  Value colTaps, colIndices, colWeights;
+  resizeCoefficients(builder, loc, type, elemTy, inputCol, outputCol,
+                     horizontalScalingFactor, colTaps, colIndices, colWeights);
+
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  Value zeroI32Vec = builder.create<arith::ConstantOp>(
+      loc, i32VecTy, builder.getZeroAttr(i32VecTy));
+  Value buffer = builder.create<memref::AllocOp>(
+      loc,
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy),
+      ValueRange{outputRow, inputCol});
+
+  // Vertical pass: the taps of an output row are whole input rows.
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {outputRow, inputCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rest = builder.create<arith::SubIOp>(loc, inputCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        auto taps = builder.create<scf::ForOp>(
+            loc, c0, rowTaps, c1, ValueRange{zeroVec},
+            [&](OpBuilder &builder, Location loc, Value k, ValueRange acc) {
+              Value srcRow = builder.create<arith::IndexCastOp>(
+                  loc, builder.getIndexType(),
+                  builder.create<memref::LoadOp>(loc, rowIndices,
+                                                 ValueRange{k, ivs[0]}));
+              Value weight = builder.create<vector::SplatOp>(
+                  loc, vecTy,
+                  builder.create<memref::LoadOp>(loc, rowWeights,
+                                                 ValueRange{k, ivs[0]}));
+              Value pixels = builder.create<vector::MaskedLoadOp>(
+                  loc, vecTy, input, ValueRange{srcRow, ivs[1]}, mask,
+                  zeroVec);
+              builder.create<scf::YieldOp>(
+                  loc, ValueRange{builder.create<vector::FMAOp>(
+                           loc, pixels, weight, acc[0])});
+            });
+        builder.create<vector::MaskedStoreOp>(
+            loc, buffer, ValueRange{ivs[0], ivs[1]}, mask, taps.getResult(0));
+      });
+
+  // Horizontal pass: the taps of a chunk of output columns are gathered.
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {outputRow, outputCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rest = builder.create<arith::SubIOp>(loc, outputCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        auto taps = builder.create<scf::ForOp>(
+            loc, c0, colTaps, c1, ValueRange{zeroVec},
+            [&](OpBuilder &builder, Location loc, Value k, ValueRange acc) {
+              Value srcCols = builder.create<vector::MaskedLoadOp>(
+                  loc, i32VecTy, colIndices, ValueRange{k, ivs[1]}, mask,
+                  zeroI32Vec);
+              Value weights = builder.create<vector::MaskedLoadOp>(
+                  loc, vecTy, colWeights, ValueRange{k, ivs[1]}, mask,
+                  zeroVec);
+              Value pixels = builder.create<vector::GatherOp>(
+                  loc, vecTy, buffer, ValueRange{ivs[0], c0},
+                  builder.create<arith::IndexCastOp>(loc, indexVecTy,
+                                                     srcCols),
+                  mask, zeroVec);
+              builder.create<scf::YieldOp>(
+                  loc, ValueRange{builder.create<vector::FMAOp>(
+                           loc, pixels, weights, acc[0])});
+            });
+        builder.create<vector::MaskedStoreOp>(
+            loc, output, ValueRange{ivs[0], ivs[1]}, mask, taps.getResult(0));
+      });
+
+  builder.create<memref::DeallocOp>(loc, buffer);
+  builder.create<memref::DeallocOp>(loc, rowIndices);
+  builder.create<memref::DeallocOp>(loc, rowWeights);
+  builder.create<memref::DeallocOp>(loc, colIndices);
+  builder.create<memref::DeallocOp>(loc, colWeights);
+}
+
+// Clamps the row or column `index` of a pyramid level to [zero, last], for
+// scalar indices as well as index vectors. `inside` holds where no clamping
+// was needed, i.e. where a constant padded tap reads the image.
+static Value clampPyramidIndex(OpBuilder &builder, Location loc, Value index,
+                               Value zero, Value last, Value &inside) {
+  Value clamped = builder.create<arith::MaxSIOp>(
+      loc, builder.create<arith::MinSIOp>(loc, index, last), zero);
+  inside = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, index,
+                                         clamped);
+  return clamped;
+}
+
+// Helper function for one level of a Gaussian pyramid. `output` receives the
+// input blurred with the 5x5 binomial kernel [1 4 6 4 1]^T [1 4 6 4 1] / 256
+// at every second row and column, so the blur is only evaluated where it is
+// kept: a vertical pass filters the even input rows into a buffer of output
+// rows and input columns, and a horizontal pass gathers the even columns of
+// that buffer. Constant padding reads zero outside of the input.
+void pyramidDown(OpBuilder &builder, Location loc, Value input, Value output,
+                 buddy::dip::BoundaryOption boundaryOptionAttr,
+                 int64_t stride, int64_t rowGrain) {
+  static const double taps[5] = {1.0 / 16, 4.0 / 16, 6.0 / 16, 4.0 / 16,
+                                 1.0 / 16};
+  bool replicate = boundaryOptionAttr == BoundaryOption::ReplicatePadding;
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+  Value lastRow = builder.create<arith::SubIOp>(loc, inputRow, c1);
+  Value lastCol = builder.create<arith::SubIOp>(loc, inputCol, c1);
+
+  Value zeroElem = insertZeroConstantOp(builder.getContext(), builder, loc,
+                                        elemTy);
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  SmallVector<Value, 5> weights;
+  for (double tap : taps)
+    weights.push_back(builder.create<arith::ConstantOp>(
+        loc, builder.getFloatAttr(elemTy, tap)));
+
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  Value laneOffsets = builder.create<arith::ConstantOp>(
+      loc, indexVecTy, builder.getIndexVectorAttr(lanes));
+  Value zeroIndexVec = builder.create<vector::BroadcastOp>(loc, indexVecTy, c0);
+  Value twoIndexVec = builder.create<vector::BroadcastOp>(loc, indexVecTy, c2);
+  Value lastColVec =
+      builder.create<vector::BroadcastOp>(loc, indexVecTy, lastCol);
+
+  Value buffer = builder.create<memref::AllocOp>(
+      loc,
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy),
+      ValueRange{outputRow, inputCol});
+
+  // Vertical pass: output row y filters input rows 2y - 2 to 2y + 2.
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {outputRow, inputCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rest = builder.create<arith::SubIOp>(loc, inputCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        Value center = builder.create<arith::MulIOp>(loc, ivs[0], c2);
+        Value acc = zeroVec;
+        for (int64_t k = 0; k < 5; ++k) {
+          Value inside;
+          Value row = clampPyramidIndex(
+              builder, loc,
+              builder.create<arith::AddIOp>(
+                  loc, center,
+                  builder.create<arith::ConstantIndexOp>(loc, k - 2)),
+              c0, lastRow, inside);
+          Value weight = weights[k];
+          if (!replicate)
+            weight = builder.create<arith::SelectOp>(loc, inside, weight,
+                                                     zeroElem);
+          Value pixels = builder.create<vector::MaskedLoadOp>(
+              loc, vecTy, input, ValueRange{row, ivs[1]}, mask, zeroVec);
+          acc = builder.create<vector::FMAOp>(
+              loc, pixels, builder.create<vector::SplatOp>(loc, vecTy, weight),
+              acc);
+        }
+        builder.create<vector::MaskedStoreOp>(
+            loc, buffer, ValueRange{ivs[0], ivs[1]}, mask, acc);
+      });
+
+  // Horizontal pass: output column x gathers buffer columns 2x - 2 to 2x + 2.
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {outputRow, outputCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rest = builder.create<arith::SubIOp>(loc, outputCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        Value center = builder.create<arith::MulIOp>(
+            loc,
+            builder.create<arith::AddIOp>(
+                loc, builder.create<vector::BroadcastOp>(loc, indexVecTy,
+                                                         ivs[1]),
+                laneOffsets),
+            twoIndexVec);
+        Value acc = zeroVec;
+        for (int64_t k = 0; k < 5; ++k) {
+          Value inside;
+          Value cols = clampPyramidIndex(
+              builder, loc,
+              builder.create<arith::AddIOp>(
+                  loc, center,
+                  builder.create<vector::BroadcastOp>(
+                      loc, indexVecTy,
+                      builder.create<arith::ConstantIndexOp>(loc, k - 2))),
+              zeroIndexVec, lastColVec, inside);
+          Value tapMask =
+              replicate ? mask
+                        : builder.create<arith::AndIOp>(loc, mask, inside);
+          Value pixels = builder.create<vector::GatherOp>(
+              loc, vecTy, buffer, ValueRange{ivs[0], c0}, cols, tapMask,
+              zeroVec);
+          acc = builder.create<vector::FMAOp>(
+              loc, pixels,
+              builder.create<vector::SplatOp>(loc, vecTy, weights[k]), acc);
+        }
+        builder.create<vector::MaskedStoreOp>(
+            loc, output, ValueRange{ivs[0], ivs[1]}, mask, acc);
+      });
+
+  builder.create<memref::DeallocOp>(loc, buffer);
+}
+
+// Helper function for one level of a Laplacian pyramid. `output` receives
+// `fine` minus `coarse` upsampled to its size with the kernel of pyramidDown
+// scaled by 4, whose taps reduce to (1 6 1) / 8 at even and (4 4) / 8 at odd
+// rows and columns. `output` may alias `fine`, which is read at the pixel
+// that is written.
+void pyramidUpSubtract(OpBuilder &builder, Location loc, Value coarse,
+                       Value fine, Value output,
+                       buddy::dip::BoundaryOption boundaryOptionAttr,
+                       int64_t stride, int64_t rowGrain) {
+  // Weights of the coarse rows or columns c - 1, c and c + 1 around the
+  // destination 2c (even) and 2c + 1 (odd).
+  static const double evenTaps[3] = {1.0 / 8, 6.0 / 8, 1.0 / 8};
+  static const double oddTaps[3] = {0, 4.0 / 8, 4.0 / 8};
+  bool replicate = boundaryOptionAttr == BoundaryOption::ReplicatePadding;
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Type elemTy = coarse.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  Value coarseRow = builder.create<memref::DimOp>(loc, coarse, c0);
+  Value coarseCol = builder.create<memref::DimOp>(loc, coarse, c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+  Value lastRow = builder.create<arith::SubIOp>(loc, coarseRow, c1);
+  Value lastCol = builder.create<arith::SubIOp>(loc, coarseCol, c1);
+
+  Value zeroElem = insertZeroConstantOp(builder.getContext(), builder, loc,
+                                        elemTy);
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  SmallVector<Value, 3> evenWeights, oddWeights, evenWeightVecs, oddWeightVecs;
+  for (int64_t k = 0; k < 3; ++k) {
+    evenWeights.push_back(builder.create<arith::ConstantOp>(
+        loc, builder.getFloatAttr(elemTy, evenTaps[k])));
+    oddWeights.push_back(builder.create<arith::ConstantOp>(
+        loc, builder.getFloatAttr(elemTy, oddTaps[k])));
+    evenWeightVecs.push_back(
+        builder.create<vector::SplatOp>(loc, vecTy, evenWeights[k]));
+    oddWeightVecs.push_back(
+        builder.create<vector::SplatOp>(loc, vecTy, oddWeights[k]));
+  }
+
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  Value laneOffsets = builder.create<arith::ConstantOp>(
+      loc, indexVecTy, builder.getIndexVectorAttr(lanes));
+  Value zeroIndexVec = builder.create<vector::BroadcastOp>(loc, indexVecTy, c0);
+  Value oneIndexVec = builder.create<vector::BroadcastOp>(loc, indexVecTy, c1);
+  Value lastColVec =
+      builder.create<vector::BroadcastOp>(loc, indexVecTy, lastCol);
+
+  Value buffer = builder.create<memref::AllocOp>(
+      loc,
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy),
+      ValueRange{outputRow, coarseCol});
+
+  // Vertical pass: output row y filters coarse rows y / 2 - 1 to y / 2 + 1.
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {outputRow, coarseCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rest = builder.create<arith::SubIOp>(loc, coarseCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        Value center = builder.create<arith::ShRUIOp>(loc, ivs[0], c1);
+        Value odd = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ne,
+            builder.create<arith::AndIOp>(loc, ivs[0], c1), c0);
+        Value acc = zeroVec;
+        for (int64_t k = 0; k < 3; ++k) {
+          Value inside;
+          Value row = clampPyramidIndex(
+              builder, loc,
+              builder.create<arith::AddIOp>(
+                  loc, center,
+                  builder.create<arith::ConstantIndexOp>(loc, k - 1)),
+              c0, lastRow, inside);
+          Value weight = builder.create<arith::SelectOp>(
+              loc, odd, oddWeights[k], evenWeights[k]);
+          if (!replicate)
+            weight = builder.create<arith::SelectOp>(loc, inside, weight,
+                                                     zeroElem);
+          Value pixels = builder.create<vector::MaskedLoadOp>(
+              loc, vecTy, coarse, ValueRange{row, ivs[1]}, mask, zeroVec);
+          acc = builder.create<vector::FMAOp>(
+              loc, pixels, builder.create<vector::SplatOp>(loc, vecTy, weight),
+              acc);
+        }
+        builder.create<vector::MaskedStoreOp>(
+            loc, buffer, ValueRange{ivs[0], ivs[1]}, mask, acc);
+      });
+
+  // Horizontal pass: output column x gathers buffer columns x / 2 - 1 to
+  // x / 2 + 1 and is subtracted from `fine`.
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {outputRow, outputCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rest = builder.create<arith::SubIOp>(loc, outputCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        Value cols = builder.create<arith::AddIOp>(
+            loc, builder.create<vector::BroadcastOp>(loc, indexVecTy, ivs[1]),
+            laneOffsets);
+        Value center = builder.create<arith::ShRUIOp>(loc, cols, oneIndexVec);
+        Value odd = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ne,
+            builder.create<arith::AndIOp>(loc, cols, oneIndexVec),
+            zeroIndexVec);
+        Value acc = zeroVec;
+        for (int64_t k = 0; k < 3; ++k) {
+          Value inside;
+          Value tapCols = clampPyramidIndex(
+              builder, loc,
+              builder.create<arith::AddIOp>(
+                  loc, center,
+                  builder.create<vector::BroadcastOp>(
+                      loc, indexVecTy,
+                      builder.create<arith::ConstantIndexOp>(loc, k - 1))),
+              zeroIndexVec, lastColVec, inside);
+          Value tapMask =
+              replicate ? mask
+                        : builder.create<arith::AndIOp>(loc, mask, inside);
+          Value pixels = builder.create<vector::GatherOp>(
+              loc, vecTy, buffer, ValueRange{ivs[0], c0}, tapCols, tapMask,
+              zeroVec);
+          Value weights = builder.create<arith::SelectOp>(
+              loc, odd, oddWeightVecs[k], evenWeightVecs[k]);
+          acc = builder.create<vector::FMAOp>(loc, pixels, weights, acc);
+        }
+        Value finePixels = builder.create<vector::MaskedLoadOp>(
+            loc, vecTy, fine, ValueRange{ivs[0], ivs[1]}, mask, zeroVec);
+        builder.create<vector::MaskedStoreOp>(
+            loc, output, ValueRange{ivs[0], ivs[1]}, mask,
+            builder.create<arith::SubFOp>(loc, finePixels, acc));
+      });
+
+  builder.create<memref::DeallocOp>(loc, buffer);
+}
+
+// Inclusive prefix sums of the lanes of `vec`, computed in log2(stride) steps
+// that add the vector shifted up by 1, 2, 4, ... lanes to itself.
+static Value prefixSumLanes(OpBuilder &builder, Location loc, Value vec,
+                            Value zeroVec, int64_t stride) {
+  for (int64_t shift = 1; shift < stride; shift *= 2) {
+    // Lanes below `shift` take zeros, the others lane i - shift of `vec`.
+    SmallVector<int64_t, 16> lanes;
+    for (int64_t i = 0; i < stride; ++i)
+      lanes.push_back(i < shift ? i : stride + i - shift);
+    Value shifted =
+        builder.create<vector::ShuffleOp>(loc, zeroVec, vec, lanes);
+    vec = builder.create<arith::AddFOp>(loc, vec, shifted);
+  }
+  return vec;
+}
+
+// Stores zeros to columns [0, count) of row `row` of `integral`.
+static void zeroIntegralRow(OpBuilder &builder, Location loc, Value integral,
+                            Value row, Value count, int64_t stride) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Type accTy = integral.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, accTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  builder.create<scf::ForOp>(
+      loc, c0, count, builder.create<arith::ConstantIndexOp>(loc, stride),
+      std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+        Value rest = builder.create<arith::SubIOp>(loc, count, x);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        builder.create<vector::MaskedStoreOp>(loc, integral,
+                                              ValueRange{row, x}, mask,
+                                              zeroVec);
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Computes row `row` of the summed-area table `integral` from row `row - 1`:
+// column 0 is zero and column x + 1 adds the sum of the first x + 1 of the
+// `count` elements returned by `load` for a column and a lane mask. Each
+// chunk is scanned in registers and offset by the total of the chunks before
+// it.
+static void integralRow(
+    OpBuilder &builder, Location loc, Value integral, Value row, Value count,
+    int64_t stride,
+    function_ref<Value(OpBuilder &, Location, Value, Value)> load) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Type accTy = integral.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, accTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroAcc = builder.create<arith::ConstantOp>(
+      loc, accTy, builder.getZeroAttr(accTy));
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  Value prevRow = builder.create<arith::SubIOp>(loc, row, c1);
+
+  builder.create<memref::StoreOp>(loc, zeroAcc, integral, ValueRange{row, c0});
+  builder.create<scf::ForOp>(
+      loc, c0, count, builder.create<arith::ConstantIndexOp>(loc, stride),
+      ValueRange{zeroAcc},
+      [&](OpBuilder &builder, Location loc, Value x, ValueRange carry) {
+        Value rest = builder.create<arith::SubIOp>(loc, count, x);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        Value scan = builder.create<arith::AddFOp>(
+            loc,
+            prefixSumLanes(builder, loc, load(builder, loc, x, mask), zeroVec,
+                           stride),
+            builder.create<vector::SplatOp>(loc, vecTy, carry[0]));
+        Value col = builder.create<arith::AddIOp>(loc, x, c1);
+        Value above = builder.create<vector::MaskedLoadOp>(
+            loc, vecTy, integral, ValueRange{prevRow, col}, mask, zeroVec);
+        builder.create<vector::MaskedStoreOp>(
+            loc, integral, ValueRange{row, col}, mask,
+            builder.create<arith::AddFOp>(loc, scan, above));
+        // Masked lanes load zero, so the last lane holds the running total.
+        builder.create<scf::YieldOp>(
+            loc, ValueRange{builder.create<vector::ExtractOp>(
+                     loc, scan, ArrayRef<int64_t>{stride - 1})});
+      });
+}
+
+// Widens a vector of `elemTy` to the accumulator vector type `accVecTy`.
+static Value extendToAccumulator(OpBuilder &builder, Location loc, Value vec,
+                                 VectorType accVecTy) {
+  if (vec.getType() == accVecTy)
+    return vec;
+  return builder.create<arith::ExtFOp>(loc, accVecTy, vec);
+}
+
+// Helper function for the integral image: `sum` and, if given, `squareSum`
+// of size (rows + 1) x (cols + 1) receive the sums of the input pixels and
+// of their squares above and left of each position. The rows are computed
+// one after another since each one adds to the previous one.
+void integralImage(OpBuilder &builder, Location loc, Value input, Value sum,
+                   Value squareSum, int64_t stride) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value sumCol = builder.create<arith::AddIOp>(loc, inputCol, c1);
+
+  SmallVector<Value, 2> tables{sum};
+  if (squareSum)
+    tables.push_back(squareSum);
+  for (Value table : tables)
+    zeroIntegralRow(builder, loc, table, c0, sumCol, stride);
+
+  builder.create<scf::ForOp>(
+      loc, c0, inputRow, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value y, ValueRange) {
+        Value row = builder.create<arith::AddIOp>(loc, y, c1);
+        for (size_t t = 0; t < tables.size(); ++t) {
+          auto accTy = tables[t].getType().cast<MemRefType>().getElementType();
+          VectorType accVecTy = VectorType::get({stride}, accTy);
+          integralRow(
+              builder, loc, tables[t], row, inputCol, stride,
+              [&](OpBuilder &builder, Location loc, Value x,
+                  Value mask) -> Value {
+                Value pixels = extendToAccumulator(
+                    builder, loc,
+                    builder.create<vector::MaskedLoadOp>(
+                        loc, vecTy, input, ValueRange{y, x}, mask, zeroVec),
+                    accVecTy);
+                if (t == 0)
+                  return pixels;
+                return builder.create<arith::MulFOp>(loc, pixels, pixels);
+              });
+        }
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Helper function for the box filter: every output pixel is the mean of the
+// kernelWidth x kernelHeight window of the padded input whose anchor
+// (centerX, centerY) lies on it. Bands of output rows build an f64 summed-area
+// table of the padded input rows they read, so every window sum takes four
+// contiguous loads whatever the size of the window. Padded rows are written
+// to a row buffer first, with the boundary extrapolation of
+// traverseImagewBoundaryExtrapolation.
+void boxFilter(OpBuilder &builder, Location loc, Value input, Value output,
+               Value kernelWidth, Value kernelHeight, Value centerX,
+               Value centerY, Value constantValue,
+               buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+               int64_t rowGrain) {
+  bool replicate = boundaryOptionAttr == BoundaryOption::ReplicatePadding;
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  Type accTy = builder.getF64Type();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  Value zeroAccVec = builder.create<arith::ConstantOp>(
+      loc, accVecTy, builder.getZeroAttr(accVecTy));
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value lastRow = builder.create<arith::SubIOp>(loc, inputRow, c1);
+  Value lastCol = builder.create<arith::SubIOp>(loc, inputCol, c1);
+  // Padded row: centerX columns on the left, then the input row, then
+  // kernelWidth - 1 - centerX columns on the right.
+  Value padCol = builder.create<arith::SubIOp>(
+      loc, builder.create<arith::AddIOp>(loc, inputCol, kernelWidth), c1);
+  Value rightStart = builder.create<arith::AddIOp>(loc, centerX, inputCol);
+
+  Value area = builder.create<arith::MulIOp>(loc, kernelWidth, kernelHeight);
+  Value invArea = builder.create<vector::SplatOp>(
+      loc, accVecTy,
+      builder.create<arith::DivFOp>(
+          loc,
+          builder.create<arith::ConstantOp>(loc, builder.getF64FloatAttr(1)),
+          builder.create<arith::SIToFPOp>(
+              loc, accTy,
+              builder.create<arith::IndexCastOp>(loc, builder.getI64Type(),
+                                                 area))));
+
+  // Stores `value` to columns [from, to) of the row buffer.
+  auto fillRow = [&](OpBuilder &builder, Location loc, Value rowBuffer,
+                     Value from, Value to, Value value) {
+    Value valueVec = builder.create<vector::SplatOp>(loc, vecTy, value);
+    builder.create<scf::ForOp>(
+        loc, from, to, strideVal, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+          Value rest = builder.create<arith::SubIOp>(loc, to, x);
+          Value mask = builder.create<vector::CreateMaskOp>(loc, maskTy,
+                                                            ValueRange{rest});
+          builder.create<vector::MaskedStoreOp>(loc, rowBuffer, ValueRange{x},
+                                                mask, valueVec);
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+
+  // Writes the padded input row `srcRow`, which may lie outside of the input.
+  auto padRow = [&](OpBuilder &builder, Location loc, Value rowBuffer,
+                    Value srcRow) {
+    auto copyRow = [&](OpBuilder &builder, Location loc, Value row) {
+      builder.create<scf::ForOp>(
+          loc, c0, inputCol, strideVal, std::nullopt,
+          [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+            Value rest = builder.create<arith::SubIOp>(loc, inputCol, x);
+            Value mask = builder.create<vector::CreateMaskOp>(
+                loc, maskTy, ValueRange{rest});
+            Value pixels = builder.create<vector::MaskedLoadOp>(
+                loc, vecTy, input, ValueRange{row, x}, mask, zeroVec);
+            builder.create<vector::MaskedStoreOp>(
+                loc, rowBuffer,
+                ValueRange{builder.create<arith::AddIOp>(loc, x, centerX)},
+                mask, pixels);
+            builder.create<scf::YieldOp>(loc);
+          });
+      Value left = constantValue, right = constantValue;
+      if (replicate) {
+        left = builder.create<memref::LoadOp>(loc, input, ValueRange{row, c0});
+        right = builder.create<memref::LoadOp>(loc, input,
+                                               ValueRange{row, lastCol});
+      }
+      fillRow(builder, loc, rowBuffer, c0, centerX, left);
+      fillRow(builder, loc, rowBuffer, rightStart, padCol, right);
+    };
+
+    if (replicate) {
+      Value row = builder.create<arith::MaxSIOp>(
+          loc, builder.create<arith::MinSIOp>(loc, srcRow, lastRow), c0);
+      copyRow(builder, loc, row);
+      return;
+    }
+    Value inside = builder.create<arith::AndIOp>(
+        loc,
+        builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::sge, srcRow,
+                                      c0),
+        builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt, srcRow,
+                                      inputRow));
+    builder.create<scf::IfOp>(
+        loc, inside,
+        [&](OpBuilder &builder, Location loc) {
+          copyRow(builder, loc, srcRow);
+          builder.create<scf::YieldOp>(loc);
+        },
+        [&](OpBuilder &builder, Location loc) {
+          fillRow(builder, loc, rowBuffer, c0, padCol, constantValue);
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+
+  // Filters output rows [rowStart, rowEnd).
+  auto band = [&](OpBuilder &builder, Location loc, Value rowStart,
+                  Value rowEnd) {
+    // The band reads rowEnd - rowStart + kernelHeight - 1 padded rows.
+    Value bandRows = builder.create<arith::SubIOp>(loc, rowEnd, rowStart);
+    Value padRows = builder.create<arith::SubIOp>(
+        loc, builder.create<arith::AddIOp>(loc, bandRows, kernelHeight), c1);
+    Value integral = builder.create<memref::AllocOp>(
+        loc,
+        MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, accTy),
+        ValueRange{builder.create<arith::AddIOp>(loc, padRows, c1),
+                   builder.create<arith::AddIOp>(loc, padCol, c1)});
+    Value rowBuffer = builder.create<memref::AllocOp>(
+        loc, MemRefType::get({ShapedType::kDynamic}, elemTy),
+        ValueRange{padCol});
+
+    zeroIntegralRow(builder, loc, integral, c0,
+                    builder.create<arith::AddIOp>(loc, padCol, c1), stride);
+    builder.create<scf::ForOp>(
+        loc, c0, padRows, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value py, ValueRange) {
+          Value srcRow = builder.create<arith::SubIOp>(
+              loc, builder.create<arith::AddIOp>(loc, rowStart, py), centerY);
+          padRow(builder, loc, rowBuffer, srcRow);
+          integralRow(
+              builder, loc, integral,
+              builder.create<arith::AddIOp>(loc, py, c1), padCol, stride,
+              [&](OpBuilder &builder, Location loc, Value x,
+                  Value mask) -> Value {
+                return extendToAccumulator(
+                    builder, loc,
+                    builder.create<vector::MaskedLoadOp>(
+                        loc, vecTy, rowBuffer, ValueRange{x}, mask, zeroVec),
+                    accVecTy);
+              });
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    // The window of output column x spans padded columns [x, x + width).
+    builder.create<scf::ForOp>(
+        loc, rowStart, rowEnd, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value y, ValueRange) {
+          Value top = builder.create<arith::SubIOp>(loc, y, rowStart);
+          Value bottom = builder.create<arith::AddIOp>(loc, top, kernelHeight);
+          builder.create<scf::ForOp>(
+              loc, c0, inputCol, strideVal, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+                Value rest = builder.create<arith::SubIOp>(loc, inputCol, x);
+                Value mask = builder.create<vector::CreateMaskOp>(
+                    loc, maskTy, ValueRange{rest});
+                Value right =
+                    builder.create<arith::AddIOp>(loc, x, kernelWidth);
+                auto corner = [&](Value row, Value col) -> Value {
+                  return builder.create<vector::MaskedLoadOp>(
+                      loc, accVecTy, integral, ValueRange{row, col}, mask,
+                      zeroAccVec);
+                };
+                Value rightSum = builder.create<arith::SubFOp>(
+                    loc, corner(bottom, right), corner(top, right));
+                Value leftSum = builder.create<arith::SubFOp>(
+                    loc, corner(bottom, x), corner(top, x));
+                Value windowSum =
+                    builder.create<arith::SubFOp>(loc, rightSum, leftSum);
+                Value mean =
+                    builder.create<arith::MulFOp>(loc, windowSum, invArea);
+                if (vecTy != accVecTy)
+                  mean = builder.create<arith::TruncFOp>(loc, vecTy, mean);
+                builder.create<vector::MaskedStoreOp>(
+                    loc, output, ValueRange{y, x}, mask, mean);
+                builder.create<scf::YieldOp>(loc);
+              });
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    builder.create<memref::DeallocOp>(loc, integral);
+    builder.create<memref::DeallocOp>(loc, rowBuffer);
+  };
+
+  if (rowGrain <= 0) {
+    band(builder, loc, c0, inputRow);
+    return;
+  }
+
+  // Every band recomputes kernelHeight - 1 padded rows of its neighbours, so
+  // bands are at least four kernels high.
+  Value bandStep = builder.create<arith::MaxSIOp>(
+      loc, builder.create<arith::ConstantIndexOp>(loc, rowGrain),
+      builder.create<arith::MulIOp>(
+          loc, kernelHeight, builder.create<arith::ConstantIndexOp>(loc, 4)));
+  builder.create<scf::ParallelOp>(
+      loc, ValueRange{c0}, ValueRange{inputRow}, ValueRange{bandStep},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rowEnd = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, ivs[0], bandStep),
+            inputRow);
+        band(builder, loc, ivs[0], rowEnd);
+      });
+}
+
+// Adds the pixels of rows [rowStart, rowEnd) and columns [colStart, colEnd)
+// of `input` to the lane private histogram `counts`, which holds stride x
+// bins i32 counters flattened so that lane l counts bin b at l * bins + b.
+// A pixel v falls into bin floor((v - low) * scale) when that is in
+// [0, bins). Every lane increments its own counters, so the scatter of a
+// chunk never writes one counter twice.
+static void accumulateLaneHistogram(OpBuilder &builder, Location loc,
+                                    Value input, Value rowStart, Value rowEnd,
+                                    Value colStart, Value colEnd, Value low,
+                                    Value scale, Value bins, Value counts,
+                                    int64_t stride) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType i32VecTy = VectorType::get({stride}, builder.getI32Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  Value zeroI32Vec = builder.create<arith::ConstantOp>(
+      loc, i32VecTy, builder.getZeroAttr(i32VecTy));
+  Value oneI32Vec = builder.create<arith::ConstantOp>(
+      loc, DenseElementsAttr::get(i32VecTy, builder.getI32IntegerAttr(1)));
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  Value laneBase = builder.create<arith::MulIOp>(
+      loc,
+      builder.create<arith::ConstantOp>(loc, indexVecTy,
+                                        builder.getIndexVectorAttr(lanes)),
+      builder.create<vector::BroadcastOp>(loc, indexVecTy, bins));
+  Value lowVec = builder.create<vector::SplatOp>(loc, vecTy, low);
+  Value scaleVec = builder.create<vector::SplatOp>(loc, vecTy, scale);
+  Value binsVec = builder.create<vector::SplatOp>(
+      loc, vecTy,
+      builder.create<arith::SIToFPOp>(
+          loc, elemTy,
+          builder.create<arith::IndexCastOp>(loc, builder.getI32Type(),
+                                             bins)));
+
+  builder.create<scf::ForOp>(
+      loc, rowStart, rowEnd, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value y, ValueRange) {
+        builder.create<scf::ForOp>(
+            loc, colStart, colEnd, strideVal, std::nullopt,
+            [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+              Value rest = builder.create<arith::SubIOp>(loc, colEnd, x);
+              Value tail = builder.create<vector::CreateMaskOp>(
+                  loc, maskTy, ValueRange{rest});
+              Value pixels = builder.create<vector::MaskedLoadOp>(
+                  loc, vecTy, input, ValueRange{y, x}, tail, zeroVec);
+              Value position = builder.create<arith::MulFOp>(
+                  loc, builder.create<arith::SubFOp>(loc, pixels, lowVec),
+                  scaleVec);
+              // Ordered compares also drop NaNs.
+              Value inRange = builder.create<arith::AndIOp>(
+                  loc,
+                  builder.create<arith::CmpFOp>(
+                      loc, arith::CmpFPredicate::OGE, position, zeroVec),
+                  builder.create<arith::CmpFOp>(
+                      loc, arith::CmpFPredicate::OLT, position, binsVec));
+              Value mask = builder.create<arith::AndIOp>(loc, tail, inRange);
+              Value bin = builder.create<arith::SelectOp>(
+                  loc, mask,
+                  builder.create<arith::FPToSIOp>(loc, i32VecTy, position),
+                  zeroI32Vec);
+              Value index = builder.create<arith::AddIOp>(
+                  loc, laneBase,
+                  builder.create<arith::IndexCastOp>(loc, indexVecTy, bin));
+              Value old = builder.create<vector::GatherOp>(
+                  loc, i32VecTy, counts, ValueRange{c0}, index, mask,
+                  zeroI32Vec);
+              builder.create<vector::ScatterOp>(
+                  loc, counts, ValueRange{c0}, index, mask,
+                  builder.create<arith::AddIOp>(loc, old, oneI32Vec));
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Builds a lane private histogram of a part of `input` (see
+// accumulateLaneHistogram) and hands the total of every bin to `store`.
+static void laneHistogram(
+    OpBuilder &builder, Location loc, Value input, Value rowStart,
+    Value rowEnd, Value colStart, Value colEnd, Value low, Value scale,
+    Value bins, int64_t stride,
+    function_ref<void(OpBuilder &, Location, Value, Value)> store) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Type i32Ty = builder.getI32Type();
+  Value zeroI32 =
+      builder.create<arith::ConstantOp>(loc, i32Ty, builder.getZeroAttr(i32Ty));
+
+  Value size = builder.create<arith::MulIOp>(loc, bins, strideVal);
+  Value counts = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({ShapedType::kDynamic}, i32Ty), ValueRange{size});
+  builder.create<scf::ForOp>(
+      loc, c0, size, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value i, ValueRange) {
+        builder.create<memref::StoreOp>(loc, zeroI32, counts, ValueRange{i});
+        builder.create<scf::YieldOp>(loc);
+      });
+  accumulateLaneHistogram(builder, loc, input, rowStart, rowEnd, colStart,
+                          colEnd, low, scale, bins, counts, stride);
+  builder.create<scf::ForOp>(
+      loc, c0, bins, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value b, ValueRange) {
+        auto total = builder.create<scf::ForOp>(
+            loc, c0, size, bins, ValueRange{zeroI32},
+            [&](OpBuilder &builder, Location loc, Value laneBase,
+                ValueRange acc) {
+              Value count = builder.create<memref::LoadOp>(
+                  loc, counts,
+                  ValueRange{builder.create<arith::AddIOp>(loc, laneBase, b)});
+              builder.create<scf::YieldOp>(
+                  loc, ValueRange{
+                           builder.create<arith::AddIOp>(loc, acc[0], count)});
+            });
+        store(builder, loc, b, total.getResult(0));
+        builder.create<scf::YieldOp>(loc);
+      });
+  builder.create<memref::DeallocOp>(loc, counts);
+}
+
+// Helper function for histograms: `hist` receives the number of pixels of
+// `input` in each of its bins, which split [low, high) evenly. Bands of rows
+// count into private histograms and add them to `hist` atomically.
+void histogram2D(OpBuilder &builder, Location loc, Value input, Value hist,
+                 Value low, Value high, int64_t stride, int64_t rowGrain) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  Type i32Ty = builder.getI32Type();
+  Value zeroI32 =
+      builder.create<arith::ConstantOp>(loc, i32Ty, builder.getZeroAttr(i32Ty));
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value bins = builder.create<memref::DimOp>(loc, hist, c0);
+  Value scale = builder.create<arith::DivFOp>(
+      loc,
+      builder.create<arith::SIToFPOp>(
+          loc, elemTy, builder.create<arith::IndexCastOp>(loc, i32Ty, bins)),
+      builder.create<arith::SubFOp>(loc, high, low));
+
+  builder.create<scf::ForOp>(
+      loc, c0, bins, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value b, ValueRange) {
+        builder.create<memref::StoreOp>(loc, zeroI32, hist, ValueRange{b});
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  if (rowGrain <= 0) {
+    laneHistogram(builder, loc, input, c0, inputRow, c0, inputCol, low, scale,
+                  bins, stride,
+                  [&](OpBuilder &builder, Location loc, Value b, Value total) {
+                    builder.create<memref::StoreOp>(loc, total, hist,
+                                                    ValueRange{b});
+                  });
+    return;
+  }
+
+  Value grain = builder.create<arith::ConstantIndexOp>(loc, rowGrain);
+  builder.create<scf::ParallelOp>(
+      loc, ValueRange{c0}, ValueRange{inputRow}, ValueRange{grain},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rowEnd = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, ivs[0], grain), inputRow);
+        laneHistogram(
+            builder, loc, input, ivs[0], rowEnd, c0, inputCol, low, scale,
+            bins, stride,
+            [&](OpBuilder &builder, Location loc, Value b, Value total) {
+              builder.create<memref::AtomicRMWOp>(
+                  loc, arith::AtomicRMWKind::addi, total, hist, ValueRange{b});
+            });
+      });
+}
+
+// Rounds the non-negative `value` to the nearest integer, ties to even, and
+// clamps it to 255, as the saturating cast to 8 bits of OpenCV. `value` may
+// be a scalar or a vector, and `half`, `one` and `max` have its type.
+static Value roundToByte(OpBuilder &builder, Location loc, Value value,
+                         Value half, Value one, Value max) {
+  Value rounded = builder.create<math::FloorOp>(
+      loc, builder.create<arith::AddFOp>(loc, value, half));
+  Value tie = builder.create<arith::CmpFOp>(
+      loc, arith::CmpFPredicate::OEQ,
+      builder.create<arith::SubFOp>(loc, rounded, value), half);
+  Value halfRounded = builder.create<arith::MulFOp>(loc, rounded, half);
+  Value odd = builder.create<arith::CmpFOp>(
+      loc, arith::CmpFPredicate::UNE,
+      builder.create<math::FloorOp>(loc, halfRounded), halfRounded);
+  rounded = builder.create<arith::SelectOp>(
+      loc, builder.create<arith::AndIOp>(loc, tie, odd),
+      builder.create<arith::SubFOp>(loc, rounded, one), rounded);
+  return builder.create<arith::MinFOp>(loc, rounded, max);
+}
+
+// Helper function for applying a lookup table: output(y, x) receives
+// lut[int(input(y, x))], with the index clamped to the table. The entries
+// are gathered a vector at a time.
+void lookupTable2D(OpBuilder &builder, Location loc, Value input, Value lut,
+                   Value output, int64_t stride, int64_t rowGrain) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  Type lutTy = lut.getType().cast<MemRefType>().getElementType();
+  Type i32Ty = builder.getI32Type();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType lutVecTy = VectorType::get({stride}, lutTy);
+  VectorType i32VecTy = VectorType::get({stride}, i32Ty);
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value lastEntry = builder.create<arith::IndexCastOp>(
+      loc, i32Ty,
+      builder.create<arith::SubIOp>(
+          loc, builder.create<memref::DimOp>(loc, lut, c0), c1));
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  Value zeroLutVec = builder.create<arith::ConstantOp>(
+      loc, lutVecTy, builder.getZeroAttr(lutVecTy));
+  Value zeroI32Vec = builder.create<arith::ConstantOp>(
+      loc, i32VecTy, builder.getZeroAttr(i32VecTy));
+  Value lastEntryVec =
+      builder.create<vector::SplatOp>(loc, i32VecTy, lastEntry);
+
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {inputRow, inputCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rest = builder.create<arith::SubIOp>(loc, inputCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        Value pixels = builder.create<vector::MaskedLoadOp>(
+            loc, vecTy, input, ValueRange{ivs[0], ivs[1]}, mask, zeroVec);
+        Value entry = builder.create<arith::MaxSIOp>(
+            loc,
+            builder.create<arith::MinSIOp>(
+                loc, builder.create<arith::FPToSIOp>(loc, i32VecTy, pixels),
+                lastEntryVec),
+            zeroI32Vec);
+        Value values = builder.create<vector::GatherOp>(
+            loc, lutVecTy, lut, ValueRange{c0},
+            builder.create<arith::IndexCastOp>(loc, indexVecTy, entry), mask,
+            zeroLutVec);
+        builder.create<vector::MaskedStoreOp>(
+            loc, output, ValueRange{ivs[0], ivs[1]}, mask, values);
+      });
+}
+
+// Helper function for global histogram equalization of an image with values
+// in [0, 256), as cv::equalizeHist: the 256 bin histogram is turned into the
+// lookup table of its normalized cumulative sum, which is then applied.
+void equalizeHistogram2D(OpBuilder &builder, Location loc, Value input,
+                         Value output, int64_t stride, int64_t rowGrain) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c255 = builder.create<arith::ConstantIndexOp>(loc, 255);
+  Value c256 = builder.create<arith::ConstantIndexOp>(loc, 256);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  Type i32Ty = builder.getI32Type();
+  Value zeroI32 =
+      builder.create<arith::ConstantOp>(loc, i32Ty, builder.getZeroAttr(i32Ty));
+  Value zeroElem = builder.create<arith::ConstantOp>(
+      loc, builder.getFloatAttr(elemTy, 0));
+  Value half =
+      builder.create<arith::ConstantOp>(loc, builder.getFloatAttr(elemTy, 0.5));
+  Value one =
+      builder.create<arith::ConstantOp>(loc, builder.getFloatAttr(elemTy, 1));
+  Value maxByte = builder.create<arith::ConstantOp>(
+      loc, builder.getFloatAttr(elemTy, 255));
+
+  Value hist = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({256}, i32Ty));
+  Value lut = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({256}, elemTy));
+  histogram2D(builder, loc, input, hist, zeroElem,
+              builder.create<arith::ConstantOp>(
+                  loc, builder.getFloatAttr(elemTy, 256)),
+              stride, rowGrain);
+
+  Value total = builder.create<arith::IndexCastOp>(
+      loc, i32Ty,
+      builder.create<arith::MulIOp>(
+          loc, builder.create<memref::DimOp>(loc, input, c0),
+          builder.create<memref::DimOp>(loc, input, c1)));
+  // The first non-empty bin maps to 0.
+  auto firstBin = builder.create<scf::ForOp>(
+      loc, c0, c256, c1, ValueRange{c256},
+      [&](OpBuilder &builder, Location loc, Value i, ValueRange first) {
+        Value count = builder.create<memref::LoadOp>(loc, hist, ValueRange{i});
+        Value isFirst = builder.create<arith::AndIOp>(
+            loc,
+            builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
+                                          first[0], c256),
+            builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ne,
+                                          count, zeroI32));
+        builder.create<scf::YieldOp>(
+            loc, ValueRange{builder.create<arith::SelectOp>(loc, isFirst, i,
+                                                            first[0])});
+      });
+  Value first = firstBin.getResult(0);
+  Value firstCount = builder.create<memref::LoadOp>(
+      loc, hist,
+      ValueRange{builder.create<arith::MinUIOp>(loc, first, c255)});
+  // An image of a single value keeps it.
+  Value flat = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
+                                             firstCount, total);
+  Value flatValue = builder.create<arith::SIToFPOp>(
+      loc, elemTy, builder.create<arith::IndexCastOp>(loc, i32Ty, first));
+  Value rest = builder.create<arith::MaxSIOp>(
+      loc, builder.create<arith::SubIOp>(loc, total, firstCount),
+      builder.create<arith::ConstantOp>(loc, builder.getI32IntegerAttr(1)));
+  Value scale = builder.create<arith::DivFOp>(
+      loc, maxByte, builder.create<arith::SIToFPOp>(loc, elemTy, rest));
+
+  builder.create<scf::ForOp>(
+      loc, c0, c256, c1, ValueRange{zeroI32},
+      [&](OpBuilder &builder, Location loc, Value i, ValueRange sum) {
+        Value count = builder.create<memref::LoadOp>(loc, hist, ValueRange{i});
+        Value after = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ugt, i, first);
+        Value newSum = builder.create<arith::SelectOp>(
+            loc, after, builder.create<arith::AddIOp>(loc, sum[0], count),
+            zeroI32);
+        Value value = roundToByte(
+            builder, loc,
+            builder.create<arith::MulFOp>(
+                loc, builder.create<arith::SIToFPOp>(loc, elemTy, newSum),
+                scale),
+            half, one, maxByte);
+        builder.create<memref::StoreOp>(
+            loc, builder.create<arith::SelectOp>(loc, flat, flatValue, value),
+            lut, ValueRange{i});
+        builder.create<scf::YieldOp>(loc, ValueRange{newSum});
+      });
+
+  lookupTable2D(builder, loc, input, lut, output, stride, rowGrain);
+  builder.create<memref::DeallocOp>(loc, hist);
+  builder.create<memref::DeallocOp>(loc, lut);
+}
+
+// Helper function for contrast limited adaptive histogram equalization of an
+// image with values in [0, 256), after cv::CLAHE. Every tile of the
+// tilesX x tilesY grid equalizes its own histogram, whose bins are clipped to
+// clipLimit times the mean bin count with the excess spread over all bins.
+// The tiles are ceil(rows / tilesY) x ceil(cols / tilesX); OpenCV pads the
+// image to that size instead of leaving the last tiles smaller. Every pixel
+// then interpolates bilinearly between the lookup tables of the four
+// nearest tile centers.
+void clahe2D(OpBuilder &builder, Location loc, Value input, Value output,
+             Value tilesX, Value tilesY, Value clipLimit, int64_t stride,
+             int64_t rowGrain) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c256 = builder.create<arith::ConstantIndexOp>(loc, 256);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  Type i32Ty = builder.getI32Type();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType i32VecTy = VectorType::get({stride}, i32Ty);
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  auto elemConst = [&](double value) -> Value {
+    return builder.create<arith::ConstantOp>(
+        loc, builder.getFloatAttr(elemTy, value));
+  };
+  auto i32Const = [&](int32_t value) -> Value {
+    return builder.create<arith::ConstantOp>(
+        loc, builder.getI32IntegerAttr(value));
+  };
+  auto toElem = [&](OpBuilder &builder, Location loc, Value index) -> Value {
+    return builder.create<arith::SIToFPOp>(
+        loc, elemTy, builder.create<arith::IndexCastOp>(loc, i32Ty, index));
+  };
+  Value zeroElem = elemConst(0);
+  Value oneElem = elemConst(1);
+  Value half = elemConst(0.5);
+  Value maxByte = elemConst(255);
+  Value binsElem = elemConst(256);
+  Value zeroI32 = i32Const(0);
+  Value oneI32 = i32Const(1);
+  Value c256I32 = i32Const(256);
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value tileRow = builder.create<arith::CeilDivSIOp>(loc, inputRow, tilesY);
+  Value tileCol = builder.create<arith::CeilDivSIOp>(loc, inputCol, tilesX);
+  Value numTiles = builder.create<arith::MulIOp>(loc, tilesX, tilesY);
+  // The lookup table of tile t starts at entry 256 * t.
+  Value luts = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({ShapedType::kDynamic}, elemTy),
+      ValueRange{builder.create<arith::MulIOp>(loc, numTiles, c256)});
+
+  auto tileLut = [&](OpBuilder &builder, Location loc, Value tile) {
+    Value ty = builder.create<arith::DivUIOp>(loc, tile, tilesX);
+    Value tx = builder.create<arith::RemUIOp>(loc, tile, tilesX);
+    auto extent = [&](Value t, Value size, Value limit, Value &start,
+                      Value &end) {
+      start = builder.create<arith::MinUIOp>(
+          loc, builder.create<arith::MulIOp>(loc, t, size), limit);
+      end = builder.create<arith::MinUIOp>(
+          loc, builder.create<arith::AddIOp>(loc, start, size), limit);
+    };
+    Value rowStart, rowEnd, colStart, colEnd;
+    extent(ty, tileRow, inputRow, rowStart, rowEnd);
+    extent(tx, tileCol, inputCol, colStart, colEnd);
+    Value area = builder.create<arith::IndexCastOp>(
+        loc, i32Ty,
+        builder.create<arith::MulIOp>(
+            loc, builder.create<arith::SubIOp>(loc, rowEnd, rowStart),
+            builder.create<arith::SubIOp>(loc, colEnd, colStart)));
+
+    Value hist = builder.create<memref::AllocOp>(
+        loc, MemRefType::get({256}, i32Ty));
+    laneHistogram(builder, loc, input, rowStart, rowEnd, colStart, colEnd,
+                  zeroElem, oneElem, c256, stride,
+                  [&](OpBuilder &builder, Location loc, Value b, Value total) {
+                    builder.create<memref::StoreOp>(loc, total, hist,
+                                                    ValueRange{b});
+                  });
+
+    // A bin holds at most max(int(clipLimit * area / 256), 1) pixels, and no
+    // limit applies for a non-positive clipLimit.
+    Value limit = builder.create<arith::MaxSIOp>(
+        loc,
+        builder.create<arith::FPToSIOp>(
+            loc, i32Ty,
+            builder.create<arith::DivFOp>(
+                loc,
+                builder.create<arith::MulFOp>(
+                    loc, clipLimit,
+                    builder.create<arith::SIToFPOp>(loc, elemTy, area)),
+                binsElem)),
+        oneI32);
+    limit = builder.create<arith::SelectOp>(
+        loc,
+        builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OGT,
+                                      clipLimit, zeroElem),
+        limit, builder.create<arith::MaxSIOp>(loc, area, oneI32));
+    auto clipped = builder.create<scf::ForOp>(
+        loc, c0, c256, c1, ValueRange{zeroI32},
+        [&](OpBuilder &builder, Location loc, Value i, ValueRange acc) {
+          Value count =
+              builder.create<memref::LoadOp>(loc, hist, ValueRange{i});
+          Value excess = builder.create<arith::MaxSIOp>(
+              loc, builder.create<arith::SubIOp>(loc, count, limit), zeroI32);
+          builder.create<memref::StoreOp>(
+              loc, builder.create<arith::SubIOp>(loc, count, excess), hist,
+              ValueRange{i});
+          builder.create<scf::YieldOp>(
+              loc,
+              ValueRange{builder.create<arith::AddIOp>(loc, acc[0], excess)});
+        });
+    // Every bin gets excess / 256 pixels back, and the remaining `residual`
+    // ones go to every residualStep-th bin from bin 0 on.
+    Value excess = clipped.getResult(0);
+    Value batch = builder.create<arith::DivSIOp>(loc, excess, c256I32);
+    Value residual = builder.create<arith::SubIOp>(
+        loc, excess, builder.create<arith::MulIOp>(loc, batch, c256I32));
+    Value residualStep = builder.create<arith::MaxSIOp>(
+        loc,
+        builder.create<arith::DivSIOp>(
+            loc, c256I32,
+            builder.create<arith::MaxSIOp>(loc, residual, oneI32)),
+        oneI32);
+    Value lutScale = builder.create<arith::DivFOp>(
+        loc, maxByte,
+        builder.create<arith::SIToFPOp>(
+            loc, elemTy, builder.create<arith::MaxSIOp>(loc, area, oneI32)));
+    Value lutStart = builder.create<arith::MulIOp>(loc, tile, c256);
+
+    builder.create<scf::ForOp>(
+        loc, c0, c256, c1, ValueRange{zeroI32},
+        [&](OpBuilder &builder, Location loc, Value i, ValueRange sum) {
+          Value bin = builder.create<arith::IndexCastOp>(loc, i32Ty, i);
+          Value getsResidual = builder.create<arith::AndIOp>(
+              loc,
+              builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::eq,
+                  builder.create<arith::RemSIOp>(loc, bin, residualStep),
+                  zeroI32),
+              builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::slt,
+                  builder.create<arith::DivSIOp>(loc, bin, residualStep),
+                  residual));
+          Value count = builder.create<arith::AddIOp>(
+              loc,
+              builder.create<arith::AddIOp>(
+                  loc, builder.create<memref::LoadOp>(loc, hist, ValueRange{i}),
+                  batch),
+              builder.create<arith::ExtUIOp>(loc, i32Ty, getsResidual));
+          Value newSum = builder.create<arith::AddIOp>(loc, sum[0], count);
+          Value value = roundToByte(
+              builder, loc,
+              builder.create<arith::MulFOp>(
+                  loc, builder.create<arith::SIToFPOp>(loc, elemTy, newSum),
+                  lutScale),
+              half, oneElem, maxByte);
+          builder.create<memref::StoreOp>(
+              loc, value, luts,
+              ValueRange{builder.create<arith::AddIOp>(loc, lutStart, i)});
+          builder.create<scf::YieldOp>(loc, ValueRange{newSum});
+        });
+    builder.create<memref::DeallocOp>(loc, hist);
+  };
+
+  if (rowGrain > 0) {
+    builder.create<scf::ParallelOp>(
+        loc, ValueRange{c0}, ValueRange{numTiles}, ValueRange{c1},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          tileLut(builder, loc, ivs[0]);
+        });
+  } else {
+    builder.create<scf::ForOp>(
+        loc, c0, numTiles, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value tile, ValueRange) {
+          tileLut(builder, loc, tile);
+          builder.create<scf::YieldOp>(loc);
+        });
+  }
+
+  // Pixel (y, x) lies between the tile centers around
+  // (y / tileRow - 0.5, x / tileCol - 0.5) in tile coordinates.
+  Value invTileRow = builder.create<arith::DivFOp>(
+      loc, oneElem, toElem(builder, loc, tileRow));
+  Value invTileColVec = builder.create<vector::SplatOp>(
+      loc, vecTy,
+      builder.create<arith::DivFOp>(loc, oneElem,
+                                    toElem(builder, loc, tileCol)));
+  Value lastTileY = builder.create<arith::SubIOp>(
+      loc, builder.create<arith::IndexCastOp>(loc, i32Ty, tilesY), oneI32);
+  Value lastTileXVec = builder.create<vector::SplatOp>(
+      loc, i32VecTy,
+      builder.create<arith::SubIOp>(
+          loc, builder.create<arith::IndexCastOp>(loc, i32Ty, tilesX),
+          oneI32));
+  Value tilesXI32 = builder.create<arith::IndexCastOp>(loc, i32Ty, tilesX);
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  Value zeroI32Vec = builder.create<arith::ConstantOp>(
+      loc, i32VecTy, builder.getZeroAttr(i32VecTy));
+  Value oneVec = builder.create<vector::SplatOp>(loc, vecTy, oneElem);
+  Value halfVec = builder.create<vector::SplatOp>(loc, vecTy, half);
+  Value oneI32Vec = builder.create<vector::SplatOp>(loc, i32VecTy, oneI32);
+  Value maxByteVec = builder.create<vector::SplatOp>(loc, vecTy, maxByte);
+  Value c255I32Vec = builder.create<vector::SplatOp>(loc, i32VecTy,
+                                                     i32Const(255));
+  Value c256I32Vec = builder.create<vector::SplatOp>(loc, i32VecTy, c256I32);
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  Value laneOffsets = builder.create<arith::SIToFPOp>(
+      loc, vecTy,
+      builder.create<arith::IndexCastOp>(
+          loc, i32VecTy,
+          builder.create<arith::ConstantOp>(
+              loc, indexVecTy, builder.getIndexVectorAttr(lanes))));
+
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {inputRow, inputCol}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        // Tile rows above and below the pixel and the weight of the lower.
+        Value tyf = builder.create<arith::SubFOp>(
+            loc,
+            builder.create<arith::MulFOp>(loc, toElem(builder, loc, ivs[0]),
+                                          invTileRow),
+            half);
+        Value tyFloor = builder.create<math::FloorOp>(loc, tyf);
+        Value ya = builder.create<vector::SplatOp>(
+            loc, vecTy, builder.create<arith::SubFOp>(loc, tyf, tyFloor));
+        Value ty1 = builder.create<arith::FPToSIOp>(loc, i32Ty, tyFloor);
+        Value ty2 = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, ty1, oneI32), lastTileY);
+        ty1 = builder.create<arith::MaxSIOp>(loc, ty1, zeroI32);
+        Value row1 = builder.create<vector::SplatOp>(
+            loc, i32VecTy, builder.create<arith::MulIOp>(loc, ty1, tilesXI32));
+        Value row2 = builder.create<vector::SplatOp>(
+            loc, i32VecTy, builder.create<arith::MulIOp>(loc, ty2, tilesXI32));
+
+        Value rest = builder.create<arith::SubIOp>(loc, inputCol, ivs[1]);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+        Value xVec = builder.create<arith::AddFOp>(
+            loc,
+            builder.create<vector::SplatOp>(loc, vecTy,
+                                            toElem(builder, loc, ivs[1])),
+            laneOffsets);
+        Value txf = builder.create<arith::SubFOp>(
+            loc, builder.create<arith::MulFOp>(loc, xVec, invTileColVec),
+            halfVec);
+        Value txFloor = builder.create<math::FloorOp>(loc, txf);
+        Value xa = builder.create<arith::SubFOp>(loc, txf, txFloor);
+        Value tx1 = builder.create<arith::FPToSIOp>(loc, i32VecTy, txFloor);
+        Value tx2 = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, tx1, oneI32Vec),
+            lastTileXVec);
+        tx1 = builder.create<arith::MaxSIOp>(loc, tx1, zeroI32Vec);
+
+        Value pixels = builder.create<vector::MaskedLoadOp>(
+            loc, vecTy, input, ValueRange{ivs[0], ivs[1]}, mask, zeroVec);
+        Value bin = builder.create<arith::MaxSIOp>(
+            loc,
+            builder.create<arith::MinSIOp>(
+                loc, builder.create<arith::FPToSIOp>(loc, i32VecTy, pixels),
+                c255I32Vec),
+            zeroI32Vec);
+        auto lookup = [&](Value row, Value tx) -> Value {
+          Value entry = builder.create<arith::AddIOp>(
+              loc,
+              builder.create<arith::MulIOp>(
+                  loc, builder.create<arith::AddIOp>(loc, row, tx),
+                  c256I32Vec),
+              bin);
+          return builder.create<vector::GatherOp>(
+              loc, vecTy, luts, ValueRange{c0},
+              builder.create<arith::IndexCastOp>(loc, indexVecTy, entry),
+              mask, zeroVec);
+        };
+        // Weighted as OpenCV does, to round the same ties.
+        auto blend = [&](Value a, Value wa, Value b, Value wb) -> Value {
+          return builder.create<arith::AddFOp>(
+              loc, builder.create<arith::MulFOp>(loc, a, wa),
+              builder.create<arith::MulFOp>(loc, b, wb));
+        };
+        Value xa1 = builder.create<arith::SubFOp>(loc, oneVec, xa);
+        Value ya1 = builder.create<arith::SubFOp>(loc, oneVec, ya);
+        Value upper = blend(lookup(row1, tx1), xa1, lookup(row1, tx2), xa);
+        Value lower = blend(lookup(row2, tx1), xa1, lookup(row2, tx2), xa);
+        builder.create<vector::MaskedStoreOp>(
+            loc, output, ValueRange{ivs[0], ivs[1]}, mask,
+            roundToByte(builder, loc, blend(upper, ya1, lower, ya), halfVec,
+                        oneVec, maxByteVec));
+      });
+
+  builder.create<memref::DeallocOp>(loc, luts);
+}
+
+// Returns a vector of `vecTy` with every lane set to `value`.
+static Value splatFloat(OpBuilder &builder, Location loc, VectorType vecTy,
+                        double value) {
+  return builder.create<arith::ConstantOp>(
+      loc, DenseElementsAttr::get(
+               vecTy, builder.getFloatAttr(vecTy.getElementType(), value)));
+}
+
+// Converts loaded pixels to the floats of `vecTy` and multiplies them by
+// `scaleVec`. Integer pixels are read as unsigned, e.g. u8 images in i8.
+static Value scalePixels(OpBuilder &builder, Location loc, Value pixels,
+                         VectorType vecTy, Value scaleVec) {
+  if (pixels.getType().cast<VectorType>().getElementType().isa<IntegerType>())
+    pixels = builder.create<arith::UIToFPOp>(loc, vecTy, pixels);
+  return builder.create<arith::MulFOp>(loc, pixels, scaleVec);
+}
+
+// Loads the three channels of the pixels of row y of image n from column x
+// on, `rest` of which are left in the row. An NHWC image holds them
+// interleaved, so 3 * stride contiguous values are loaded at once and split
+// with shuffles; an NCHW image holds every channel in its own plane.
+static void loadColorPixels(OpBuilder &builder, Location loc, Value image,
+                            bool interleaved, Value n, Value y, Value x,
+                            Value rest, VectorType vecTy, Value scaleVec,
+                            Value channels[3]) {
+  int64_t stride = vecTy.getNumElements();
+  Type elemTy = image.getType().cast<MemRefType>().getElementType();
+  if (interleaved) {
+    VectorType pixelTy = VectorType::get({3 * stride}, elemTy);
+    Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+    Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+    Value mask = builder.create<vector::CreateMaskOp>(
+        loc, VectorType::get({3 * stride}, builder.getI1Type()),
+        ValueRange{builder.create<arith::MulIOp>(loc, rest, c3)});
+    Value pixels = builder.create<vector::MaskedLoadOp>(
+        loc, pixelTy, image, ValueRange{n, y, x, c0}, mask,
+        builder.create<arith::ConstantOp>(loc, pixelTy,
+                                          builder.getZeroAttr(pixelTy)));
+    for (int64_t c = 0; c < 3; ++c) {
+      SmallVector<int64_t, 16> lanes;
+      for (int64_t i = 0; i < stride; ++i)
+        lanes.push_back(3 * i + c);
+      channels[c] = scalePixels(
+          builder, loc,
+          builder.create<vector::ShuffleOp>(loc, pixels, pixels, lanes), vecTy,
+          scaleVec);
+    }
+    return;
+  }
+  VectorType pixelTy = VectorType::get({stride}, elemTy);
+  Value mask = builder.create<vector::CreateMaskOp>(
+      loc, VectorType::get({stride}, builder.getI1Type()), ValueRange{rest});
+  Value zero = builder.create<arith::ConstantOp>(loc, pixelTy,
+                                                 builder.getZeroAttr(pixelTy));
+  for (int64_t c = 0; c < 3; ++c) {
+    Value channel = builder.create<arith::ConstantIndexOp>(loc, c);
+    channels[c] = scalePixels(
+        builder, loc,
+        builder.create<vector::MaskedLoadOp>(
+            loc, pixelTy, image, ValueRange{n, channel, y, x}, mask, zero),
+        vecTy, scaleVec);
+  }
+}
+
+// Stores the three channels of pixels as loadColorPixels loads them,
+// interleaving them with shuffles for an NHWC image.
+static void storeColorPixels(OpBuilder &builder, Location loc, Value image,
+                             bool interleaved, Value n, Value y, Value x,
+                             Value rest, Value channels[3]) {
+  int64_t stride = channels[0].getType().cast<VectorType>().getNumElements();
+  if (interleaved) {
+    Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+    Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+    SmallVector<int64_t, 32> firstTwo(2 * stride);
+    std::iota(firstTwo.begin(), firstTwo.end(), 0);
+    Value pair = builder.create<vector::ShuffleOp>(loc, channels[0],
+                                                   channels[1], firstTwo);
+    // Lane i of channel c lands at 3 * i + c.
+    SmallVector<int64_t, 48> lanes;
+    for (int64_t i = 0; i < stride; ++i)
+      for (int64_t c = 0; c < 3; ++c)
+        lanes.push_back(c * stride + i);
+    Value pixels =
+        builder.create<vector::ShuffleOp>(loc, pair, channels[2], lanes);
+    Value mask = builder.create<vector::CreateMaskOp>(
+        loc, VectorType::get({3 * stride}, builder.getI1Type()),
+        ValueRange{builder.create<arith::MulIOp>(loc, rest, c3)});
+    builder.create<vector::MaskedStoreOp>(loc, image, ValueRange{n, y, x, c0},
+                                          mask, pixels);
+    return;
+  }
+  Value mask = builder.create<vector::CreateMaskOp>(
+      loc, VectorType::get({stride}, builder.getI1Type()), ValueRange{rest});
+  for (int64_t c = 0; c < 3; ++c) {
+    Value channel = builder.create<arith::ConstantIndexOp>(loc, c);
+    builder.create<vector::MaskedStoreOp>(
+        loc, image, ValueRange{n, channel, y, x}, mask, channels[c]);
+  }
+}
+
+// Computes the (H, S, V) channels of (R, G, B) ones as the float path of
+// cv::cvtColor: H in degrees in [0, 360), S in [0, 1] and V = max(R, G, B).
+static void rgbToHsv(OpBuilder &builder, Location loc, Value rgb[3],
+                     Value hsv[3]) {
+  VectorType vecTy = rgb[0].getType().cast<VectorType>();
+  Value epsilon = splatFloat(builder, loc, vecTy, FLT_EPSILON);
+  Value max = builder.create<arith::MaxFOp>(
+      loc, builder.create<arith::MaxFOp>(loc, rgb[0], rgb[1]), rgb[2]);
+  Value min = builder.create<arith::MinFOp>(
+      loc, builder.create<arith::MinFOp>(loc, rgb[0], rgb[1]), rgb[2]);
+  Value diff = builder.create<arith::SubFOp>(loc, max, min);
+  Value saturation = builder.create<arith::DivFOp>(
+      loc, diff,
+      builder.create<arith::AddFOp>(
+          loc, builder.create<math::AbsFOp>(loc, max), epsilon));
+  Value hueScale = builder.create<arith::DivFOp>(
+      loc, splatFloat(builder, loc, vecTy, 60),
+      builder.create<arith::AddFOp>(loc, diff, epsilon));
+  // The hue is measured from the largest channel.
+  auto hueFrom = [&](Value a, Value b, double offset) -> Value {
+    return builder.create<arith::AddFOp>(
+        loc,
+        builder.create<arith::MulFOp>(
+            loc, builder.create<arith::SubFOp>(loc, a, b), hueScale),
+        splatFloat(builder, loc, vecTy, offset));
+  };
+  Value hue = builder.create<arith::SelectOp>(
+      loc,
+      builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ, max,
+                                    rgb[0]),
+      hueFrom(rgb[1], rgb[2], 0),
+      builder.create<arith::SelectOp>(
+          loc,
+          builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ, max,
+                                        rgb[1]),
+          hueFrom(rgb[2], rgb[0], 120), hueFrom(rgb[0], rgb[1], 240)));
+  Value zero = splatFloat(builder, loc, vecTy, 0);
+  hsv[0] = builder.create<arith::SelectOp>(
+      loc,
+      builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OLT, hue, zero),
+      builder.create<arith::AddFOp>(loc, hue,
+                                    splatFloat(builder, loc, vecTy, 360)),
+      hue);
+  hsv[1] = saturation;
+  hsv[2] = max;
+}
+
+// Computes the (R, G, B) channels of (H, S, V) ones as the float path of
+// cv::cvtColor. The hue falls into one of six sectors, each of which takes
+// the three channels from v, v(1 - s), v(1 - sf) and v(1 - s(1 - f)) for
+// the fraction f of the hue in the sector.
+static void hsvToRgb(OpBuilder &builder, Location loc, Value hsv[3],
+                     Value rgb[3]) {
+  VectorType vecTy = hsv[0].getType().cast<VectorType>();
+  Value zero = splatFloat(builder, loc, vecTy, 0);
+  Value one = splatFloat(builder, loc, vecTy, 1);
+  Value six = splatFloat(builder, loc, vecTy, 6);
+  Value hue = builder.create<arith::MulFOp>(
+      loc, hsv[0], splatFloat(builder, loc, vecTy, 6.0f / 360.0f));
+  hue = builder.create<arith::SubFOp>(
+      loc, hue,
+      builder.create<arith::MulFOp>(
+          loc, six,
+          builder.create<math::FloorOp>(
+              loc, builder.create<arith::DivFOp>(loc, hue, six))));
+  Value sector = builder.create<math::FloorOp>(loc, hue);
+  Value fraction = builder.create<arith::SubFOp>(loc, hue, sector);
+  // Rounding may leave the hue at 6, which is sector 0.
+  Value wrapped = builder.create<arith::CmpFOp>(
+      loc, arith::CmpFPredicate::OGE, sector, six);
+  sector = builder.create<arith::SelectOp>(loc, wrapped, zero, sector);
+  fraction = builder.create<arith::SelectOp>(loc, wrapped, zero, fraction);
+
+  Value s = hsv[1];
+  Value v = hsv[2];
+  auto scaleValue = [&](Value factor) -> Value {
+    return builder.create<arith::MulFOp>(
+        loc, v, builder.create<arith::SubFOp>(loc, one, factor));
+  };
+  Value tab[4] = {
+      v, scaleValue(s),
+      scaleValue(builder.create<arith::MulFOp>(loc, s, fraction)),
+      scaleValue(builder.create<arith::MulFOp>(
+          loc, s, builder.create<arith::SubFOp>(loc, one, fraction)))};
+  Value inSector[6];
+  for (int64_t i = 1; i < 6; ++i)
+    inSector[i] = builder.create<arith::CmpFOp>(
+        loc, arith::CmpFPredicate::OEQ, sector,
+        splatFloat(builder, loc, vecTy, i));
+  // The entries of tab that make R, G and B in each sector.
+  const int sectorTab[3][6] = {
+      {0, 2, 1, 1, 3, 0}, {3, 0, 0, 2, 1, 1}, {1, 1, 3, 0, 0, 2}};
+  for (int64_t c = 0; c < 3; ++c) {
+    rgb[c] = tab[sectorTab[c][0]];
+    for (int64_t i = 1; i < 6; ++i)
+      rgb[c] = builder.create<arith::SelectOp>(loc, inSector[i],
+                                               tab[sectorTab[c][i]], rgb[c]);
+  }
+}
+
+// Helper function for color conversions, as cv::cvtColor on float images.
+// Color images are 4-D memrefs, NHWC when their last dimension is 3 and
+// NCHW otherwise, and every image of the batch is converted. Gray images
+// and YUV 4:2:0 frames are 2-D memrefs of a single image. The input pixels
+// are multiplied by `scale` when loaded, so that a u8 image in an i8 memref
+// with a scale of 1 / 255 is normalized to [0, 1] by the same pass; YUV
+// conversions expect channels in [0, 1] after scaling.
+void convertColor(OpBuilder &builder, Location loc, Value input, Value output,
+                  Value scale, ColorConversion conversion, int64_t stride,
+                  int64_t rowGrain) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+  Type elemTy = output.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  Value scaleVec = builder.create<vector::SplatOp>(loc, vecTy, scale);
+
+  auto isInterleaved = [](Value image) {
+    MemRefType type = image.getType().cast<MemRefType>();
+    return type.getRank() == 4 && type.getShape()[3] == 3;
+  };
+  bool inputInterleaved = isInterleaved(input);
+  bool outputInterleaved = isInterleaved(output);
+  bool yuv420 = conversion == ColorConversion::YUV2RGBNV12 ||
+                conversion == ColorConversion::YUV2RGBI420;
+
+  // Rows of all images of the batch are visited as one range of
+  // batch * imageRows rows.
+  Value batch, imageRows, imageCols;
+  if (yuv420) {
+    batch = c1;
+    imageRows = builder.create<arith::DivUIOp>(
+        loc,
+        builder.create<arith::MulIOp>(
+            loc, builder.create<memref::DimOp>(loc, input, c0), c2),
+        c3);
+    imageCols = builder.create<memref::DimOp>(loc, input, c1);
+  } else {
+    batch = conversion == ColorConversion::RGB2Gray
+                ? c1
+                : builder.create<memref::DimOp>(loc, input, c0).getResult();
+    imageRows =
+        builder.create<memref::DimOp>(loc, input, inputInterleaved ? c1 : c2);
+    imageCols =
+        builder.create<memref::DimOp>(loc, input, inputInterleaved ? c2 : c3);
+  }
+  Value rows = builder.create<arith::MulIOp>(loc, batch, imageRows);
+
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  Value laneOffsets = builder.create<arith::ConstantOp>(
+      loc, indexVecTy, builder.getIndexVectorAttr(lanes));
+
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {rows, imageCols}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value n = builder.create<arith::DivUIOp>(loc, ivs[0], imageRows);
+        Value y = builder.create<arith::RemUIOp>(loc, ivs[0], imageRows);
+        Value x = ivs[1];
+        Value rest = builder.create<arith::SubIOp>(loc, imageCols, x);
+        auto constant = [&](double value) {
+          return splatFloat(builder, loc, vecTy, value);
+        };
+        // Returns acc + a * weight.
+        auto addScaled = [&](Value acc, Value a, double weight) -> Value {
+          return builder.create<arith::AddFOp>(
+              loc, acc,
+              builder.create<arith::MulFOp>(loc, a, constant(weight)));
+        };
+        auto luma = [&](Value rgb[3]) -> Value {
+          Value sum = builder.create<arith::MulFOp>(loc, rgb[0],
+                                                    constant(0.299));
+          return addScaled(addScaled(sum, rgb[1], 0.587), rgb[2], 0.114);
+        };
+
+        Value in[3], out[3];
+        if (yuv420) {
+          // Y has one value per pixel, U and V one per 2x2 pixels behind
+          // it: interleaved in NV12, in two planes in I420.
+          Type inElemTy = input.getType().cast<MemRefType>().getElementType();
+          VectorType pixelTy = VectorType::get({stride}, inElemTy);
+          Value zero = builder.create<arith::ConstantOp>(
+              loc, pixelTy, builder.getZeroAttr(pixelTy));
+          Value mask = builder.create<vector::CreateMaskOp>(
+              loc, VectorType::get({stride}, builder.getI1Type()),
+              ValueRange{rest});
+          in[0] = scalePixels(builder, loc,
+                              builder.create<vector::MaskedLoadOp>(
+                                  loc, pixelTy, input, ValueRange{y, x},
+                                  mask, zero),
+                              vecTy, scaleVec);
+          Value chromaCol = builder.create<arith::DivUIOp>(
+              loc,
+              builder.create<arith::AddIOp>(
+                  loc, builder.create<vector::SplatOp>(loc, indexVecTy, x),
+                  laneOffsets),
+              builder.create<vector::SplatOp>(loc, indexVecTy, c2));
+          Value chromaRow = builder.create<arith::DivUIOp>(loc, y, c2);
+          Value base[2], offsets[2];
+          if (conversion == ColorConversion::YUV2RGBNV12) {
+            Value uvRow = builder.create<arith::AddIOp>(loc, imageRows,
+                                                        chromaRow);
+            Value u = builder.create<arith::MulIOp>(
+                loc, chromaCol,
+                builder.create<vector::SplatOp>(loc, indexVecTy, c2));
+            base[0] = base[1] = uvRow;
+            offsets[0] = u;
+            offsets[1] = builder.create<arith::AddIOp>(
+                loc, u, builder.create<vector::SplatOp>(loc, indexVecTy, c1));
+          } else {
+            // The planes are contiguous, so offsets from their first row
+            // may run past the end of a row.
+            Value chromaCols = builder.create<arith::DivUIOp>(loc, imageCols,
+                                                              c2);
+            Value planeSize = builder.create<arith::MulIOp>(
+                loc, builder.create<arith::DivUIOp>(loc, imageRows, c2),
+                chromaCols);
+            Value u = builder.create<arith::AddIOp>(
+                loc,
+                builder.create<vector::SplatOp>(
+                    loc, indexVecTy,
+                    builder.create<arith::MulIOp>(loc, chromaRow, chromaCols)),
+                chromaCol);
+            base[0] = base[1] = imageRows;
+            offsets[0] = u;
+            offsets[1] = builder.create<arith::AddIOp>(
+                loc, u,
+                builder.create<vector::SplatOp>(loc, indexVecTy, planeSize));
+          }
+          Value chroma[2];
+          for (int64_t c = 0; c < 2; ++c)
+            chroma[c] = scalePixels(
+                builder, loc,
+                builder.create<vector::GatherOp>(loc, pixelTy, input,
+                                                 ValueRange{base[c], c0},
+                                                 offsets[c], mask, zero),
+                vecTy, scaleVec);
+          // BT.601 with video range luma, as cv::cvtColor on u8 frames,
+          // clamped to [0, 1].
+          Value yScaled = builder.create<arith::MulFOp>(
+              loc,
+              builder.create<arith::MaxFOp>(
+                  loc,
+                  builder.create<arith::SubFOp>(loc, in[0],
+                                                constant(16.0 / 255.0)),
+                  constant(0)),
+              constant(1.164));
+          Value u = builder.create<arith::SubFOp>(loc, chroma[0],
+                                                  constant(128.0 / 255.0));
+          Value v = builder.create<arith::SubFOp>(loc, chroma[1],
+                                                  constant(128.0 / 255.0));
+          out[0] = addScaled(yScaled, v, 1.596);
+          out[1] = addScaled(addScaled(yScaled, v, -0.813), u, -0.391);
+          out[2] = addScaled(yScaled, u, 2.018);
+          for (int64_t c = 0; c < 3; ++c)
+            out[c] = builder.create<arith::MinFOp>(
+                loc, builder.create<arith::MaxFOp>(loc, out[c], constant(0)),
+                constant(1));
+          storeColorPixels(builder, loc, output, outputInterleaved, c0, y, x,
+                           rest, out);
+          return;
+        }
+
+        loadColorPixels(builder, loc, input, inputInterleaved, n, y, x, rest,
+                        vecTy, scaleVec, in);
+        switch (conversion) {
+        case ColorConversion::RGB2Gray: {
+          Value mask = builder.create<vector::CreateMaskOp>(
+              loc, VectorType::get({stride}, builder.getI1Type()),
+              ValueRange{rest});
+          builder.create<vector::MaskedStoreOp>(loc, output, ValueRange{y, x},
+                                                mask, luma(in));
+          return;
+        }
+        case ColorConversion::RGB2YUV: {
+          // Chroma is centered on 0.5.
+          Value half = constant(0.5);
+          out[0] = luma(in);
+          out[1] = addScaled(
+              half, builder.create<arith::SubFOp>(loc, in[2], out[0]), 0.492);
+          out[2] = addScaled(
+              half, builder.create<arith::SubFOp>(loc, in[0], out[0]), 0.877);
+          break;
+        }
+        case ColorConversion::YUV2RGB: {
+          Value half = constant(0.5);
+          Value u = builder.create<arith::SubFOp>(loc, in[1], half);
+          Value v = builder.create<arith::SubFOp>(loc, in[2], half);
+          out[0] = addScaled(in[0], v, 1.140);
+          out[1] = addScaled(addScaled(in[0], u, -0.395), v, -0.581);
+          out[2] = addScaled(in[0], u, 2.032);
+          break;
+        }
+        case ColorConversion::RGB2HSV:
+          rgbToHsv(builder, loc, in, out);
+          break;
+        case ColorConversion::HSV2RGB:
+          hsvToRgb(builder, loc, in, out);
+          break;
+        default:
+          llvm_unreachable("unexpected color conversion");
+        }
+        storeColorPixels(builder, loc, output, outputInterleaved, n, y, x,
+                         rest, out);
+      });
+}
+
+// Helper function for preparing an RGB image as the input of a model. Every
+// output pixel is interpolated bilinearly on half pixel centers, as
+// cv::resize with INTER_LINEAR, from the four input pixels around it, whose
+// channels are gathered from an NHWC or NCHW input. It is then normalized to
+// (pixel * scale - mean[c]) / std[c] with one multiply-add and stored to
+// image `batchIndex` of the NCHW output, so that the input is read and the
+// output written once.
+void resizeNormalize2D(OpBuilder &builder, Location loc, Value input,
+                       Value output, Value batchIndex, Value scale, Value mean,
+                       Value stdDev, int64_t stride, int64_t rowGrain) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+  MemRefType inputTy = input.getType().cast<MemRefType>();
+  Type inElemTy = inputTy.getElementType();
+  Type elemTy = output.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType pixelTy = VectorType::get({stride}, inElemTy);
+  VectorType i32VecTy = VectorType::get({stride}, builder.getI32Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  bool interleaved = inputTy.getShape()[3] == 3;
+
+  Value inputRows =
+      builder.create<memref::DimOp>(loc, input, interleaved ? c1 : c2);
+  Value inputCols =
+      builder.create<memref::DimOp>(loc, input, interleaved ? c2 : c3);
+  Value outputRows = builder.create<memref::DimOp>(loc, output, c2);
+  Value outputCols = builder.create<memref::DimOp>(loc, output, c3);
+  Value lastRow = builder.create<arith::SubIOp>(loc, inputRows, c1);
+  Value lastCol = builder.create<arith::SubIOp>(loc, inputCols, c1);
+
+  auto toFloat = [&](Value index) -> Value {
+    return builder.create<arith::SIToFPOp>(
+        loc, elemTy,
+        builder.create<arith::IndexCastOp>(loc, builder.getI32Type(), index));
+  };
+  auto constant = [&](double value) -> Value {
+    return builder.create<arith::ConstantOp>(
+        loc, builder.getFloatAttr(elemTy, value));
+  };
+  Value rowScale = builder.create<arith::DivFOp>(loc, toFloat(inputRows),
+                                                 toFloat(outputRows));
+  Value colScaleVec = builder.create<vector::SplatOp>(
+      loc, vecTy,
+      builder.create<arith::DivFOp>(loc, toFloat(inputCols),
+                                    toFloat(outputCols)));
+  Value half = constant(0.5);
+  Value halfVec = splatFloat(builder, loc, vecTy, 0.5);
+  Value zero = constant(0);
+  Value zeroVec = splatFloat(builder, loc, vecTy, 0);
+  Value oneVec = splatFloat(builder, loc, vecTy, 1);
+  Value zeroPixels = builder.create<arith::ConstantOp>(
+      loc, pixelTy, builder.getZeroAttr(pixelTy));
+
+  // (pixel * scale - mean[c]) / std[c] = pixel * gain[c] + offset[c].
+  Value gain[3], offset[3];
+  for (int64_t c = 0; c < 3; ++c) {
+    Value channel = builder.create<arith::ConstantIndexOp>(loc, c);
+    Value channelMean = builder.create<memref::LoadOp>(loc, mean, channel);
+    Value channelStd = builder.create<memref::LoadOp>(loc, stdDev, channel);
+    gain[c] = builder.create<vector::SplatOp>(
+        loc, vecTy, builder.create<arith::DivFOp>(loc, scale, channelStd));
+    offset[c] = builder.create<vector::SplatOp>(
+        loc, vecTy,
+        builder.create<arith::DivFOp>(
+            loc, builder.create<arith::NegFOp>(loc, channelMean),
+            channelStd));
+  }
+
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  Value laneOffsets = builder.create<arith::ConstantOp>(
+      loc, indexVecTy, builder.getIndexVectorAttr(lanes));
+  Value lastColVec = builder.create<vector::SplatOp>(loc, indexVecTy, lastCol);
+  Value oneIndexVec = builder.create<vector::SplatOp>(loc, indexVecTy, c1);
+  Value threeIndexVec = builder.create<vector::SplatOp>(loc, indexVecTy, c3);
+
+  buildRowBandLoopNest(
+      builder, loc, {c0, c0}, {outputRows, outputCols}, {1, stride}, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value y = ivs[0];
+        Value x = ivs[1];
+        Value rest = builder.create<arith::SubIOp>(loc, outputCols, x);
+        Value mask =
+            builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+
+        // Source coordinates are clamped to the first pixel at the top and
+        // left, and both neighbours to the last one at the bottom and right.
+        Value sy = builder.create<arith::MaxFOp>(
+            loc,
+            builder.create<arith::SubFOp>(
+                loc,
+                builder.create<arith::MulFOp>(
+                    loc,
+                    builder.create<arith::AddFOp>(
+                        loc,
+                        builder.create<arith::SIToFPOp>(
+                            loc, elemTy,
+                            builder.create<arith::IndexCastOp>(
+                                loc, builder.getI32Type(), y)),
+                        half),
+                    rowScale),
+                half),
+            zero);
+        Value syFloor = builder.create<math::FloorOp>(loc, sy);
+        Value fy = builder.create<vector::SplatOp>(
+            loc, vecTy, builder.create<arith::SubFOp>(loc, sy, syFloor));
+        Value y0 = builder.create<arith::IndexCastOp>(
+            loc, builder.getIndexType(),
+            builder.create<arith::FPToSIOp>(loc, builder.getI32Type(),
+                                            syFloor));
+        Value srcRows[2] = {
+            builder.create<arith::MinSIOp>(loc, y0, lastRow),
+            builder.create<arith::MinSIOp>(
+                loc, builder.create<arith::AddIOp>(loc, y0, c1), lastRow)};
+
+        Value xs = builder.create<arith::AddIOp>(
+            loc, builder.create<vector::SplatOp>(loc, indexVecTy, x),
+            laneOffsets);
+        Value sx = builder.create<arith::MaxFOp>(
+            loc,
+            builder.create<arith::SubFOp>(
+                loc,
+                builder.create<arith::MulFOp>(
+                    loc,
+                    builder.create<arith::AddFOp>(
+                        loc,
+                        builder.create<arith::SIToFPOp>(
+                            loc, vecTy,
+                            builder.create<arith::IndexCastOp>(loc, i32VecTy,
+                                                               xs)),
+                        halfVec),
+                    colScaleVec),
+                halfVec),
+            zeroVec);
+        Value sxFloor = builder.create<math::FloorOp>(loc, sx);
+        Value fx = builder.create<arith::SubFOp>(loc, sx, sxFloor);
+        Value x0 = builder.create<arith::IndexCastOp>(
+            loc, indexVecTy,
+            builder.create<arith::FPToSIOp>(loc, i32VecTy, sxFloor));
+        Value srcCols[2] = {
+            builder.create<arith::MinSIOp>(loc, x0, lastColVec),
+            builder.create<arith::MinSIOp>(
+                loc, builder.create<arith::AddIOp>(loc, x0, oneIndexVec),
+                lastColVec)};
+        Value wx = builder.create<arith::SubFOp>(loc, oneVec, fx);
+        Value wy = builder.create<arith::SubFOp>(loc, oneVec, fy);
+
+        for (int64_t c = 0; c < 3; ++c) {
+          Value channel = builder.create<arith::ConstantIndexOp>(loc, c);
+          // Interpolates a source row between the two source columns.
+          auto interpolateRow = [&](Value row) -> Value {
+            Value pixels[2];
+            for (int64_t i = 0; i < 2; ++i) {
+              SmallVector<Value, 4> base{c0, channel, row, c0};
+              Value offsets = srcCols[i];
+              if (interleaved) {
+                base = {c0, row, c0, c0};
+                offsets = builder.create<arith::AddIOp>(
+                    loc,
+                    builder.create<arith::MulIOp>(loc, srcCols[i],
+                                                  threeIndexVec),
+                    builder.create<vector::SplatOp>(loc, indexVecTy,
+                                                    channel));
+              }
+              pixels[i] = builder.create<vector::GatherOp>(
+                  loc, pixelTy, input, base, offsets, mask, zeroPixels);
+              if (inElemTy.isa<IntegerType>())
+                pixels[i] =
+                    builder.create<arith::UIToFPOp>(loc, vecTy, pixels[i]);
+            }
+            return builder.create<vector::FMAOp>(
+                loc, pixels[1], fx,
+                builder.create<arith::MulFOp>(loc, pixels[0], wx));
+          };
+          Value value = builder.create<vector::FMAOp>(
+              loc, interpolateRow(srcRows[1]), fy,
+              builder.create<arith::MulFOp>(loc, interpolateRow(srcRows[0]),
+                                            wy));
+          builder.create<vector::MaskedStoreOp>(
+              loc, output, ValueRange{batchIndex, channel, y, x}, mask,
+              builder.create<vector::FMAOp>(loc, value, gain[c], offset[c]));
+        }
+      });
+}
+
+Value extrapolateIndex(OpBuilder &builder, Location loc, Value index,
+                       Value size, buddy::dip::BoundaryOption boundaryOption) {
+  VectorType vecTy = index.getType().dyn_cast<VectorType>();
+  auto splat = [&](Value value) -> Value {
+    return vecTy ? builder.create<vector::SplatOp>(loc, vecTy, value) : value;
+  };
+  auto constant = [&](int64_t value) -> Value {
+    return splat(builder.create<arith::ConstantIndexOp>(loc, value));
+  };
+  Value n = splat(size);
+  // index mod period, in [0, period) for negative indices as well.
+  auto wrap = [&](Value period) -> Value {
+    Value rem = builder.create<arith::RemSIOp>(loc, index, period);
+    return builder.create<arith::RemSIOp>(
+        loc, builder.create<arith::AddIOp>(loc, rem, period), period);
+  };
+  // Mirrors the second half of a period back into the image.
+  auto mirror = [&](Value j, Value mirrored) -> Value {
+    Value inside =
+        builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt, j, n);
+    return builder.create<arith::SelectOp>(loc, inside, j, mirrored);
+  };
+
+  switch (boundaryOption) {
+  case BoundaryOption::ConstantPadding:
+  case BoundaryOption::ReplicatePadding: {
+    Value last = builder.create<arith::SubIOp>(loc, n, constant(1));
+    return builder.create<arith::MaxSIOp>(
+        loc, builder.create<arith::MinSIOp>(loc, index, last), constant(0));
+  }
+  case BoundaryOption::WrapPadding:
+    return wrap(n);
+  case BoundaryOption::ReflectPadding: {
+    // fedcba|abcdef|fedcba repeats with period 2 * size.
+    Value period = builder.create<arith::AddIOp>(loc, n, n);
+    Value j = wrap(period);
+    return mirror(j, builder.create<arith::SubIOp>(
+                         loc, builder.create<arith::SubIOp>(loc, period, j),
+                         constant(1)));
+  }
+  case BoundaryOption::Reflect101Padding: {
+    // fedcb|abcdef|edcba repeats with period 2 * size - 2, or 1 for images
+    // of a single pixel.
+    Value period = builder.create<arith::MaxSIOp>(
+        loc,
+        builder.create<arith::SubIOp>(
+            loc, builder.create<arith::AddIOp>(loc, n, n), constant(2)),
+        constant(1));
+    Value j = wrap(period);
+    return mirror(j, builder.create<arith::SubIOp>(loc, period, j));
+  }
+  }
+  llvm_unreachable("unknown boundary option");
+}
+
+// Comparators (i, j), i < j, of Batcher's odd-even merge sort of `wires`
+// wires, a power of two. Every comparator leaves the smaller value on wire i
+// and the larger one on wire j. The stages sorting blocks of fewer than
+// `sortedBlock` wires are left out, for inputs made of sorted blocks.
+static SmallVector<std::pair<int64_t, int64_t>>
+oddEvenMergeSortNetwork(int64_t wires, int64_t sortedBlock) {
+  SmallVector<std::pair<int64_t, int64_t>> network;
+  for (int64_t p = sortedBlock; p < wires; p *= 2)
+    for (int64_t k = p; k >= 1; k /= 2)
+      for (int64_t j = k % p; j + k < wires; j += 2 * k)
+        for (int64_t i = 0; i < std::min(k, wires - j - k); ++i)
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+            network.push_back({i + j, i + j + k});
+  return network;
+}
+
+// Flags, for every comparator of `network`, whether its minimum and its
+// maximum are needed to compute wire `target`, walking the network backwards
+// from it.
+static SmallVector<std::pair<bool, bool>>
+pruneSortingNetwork(ArrayRef<std::pair<int64_t, int64_t>> network,
+                    int64_t wires, int64_t target) {
+  SmallVector<bool> needed(wires, false);
+  needed[target] = true;
+  SmallVector<std::pair<bool, bool>> used(network.size());
+  for (int64_t c = network.size() - 1; c >= 0; --c) {
+    auto [i, j] = network[c];
+    used[c] = {needed[i], needed[j]};
+    if (needed[i] || needed[j])
+      needed[i] = needed[j] = true;
+  }
+  return used;
+}
+
+// Applies `network` to the vectors `wires` with element wise minima and
+// maxima. A null wire stands for a value larger than any other one, so the
+// comparators reading it are resolved here. With `used`, only the flagged
+// outputs of every comparator are computed.
+static void applySortingNetwork(OpBuilder &builder, Location loc,
+                                ArrayRef<std::pair<int64_t, int64_t>> network,
+                                ArrayRef<std::pair<bool, bool>> used,
+                                SmallVectorImpl<Value> &wires) {
+  Type elemTy = wires.front().getType().cast<VectorType>().getElementType();
+  bool isFloat = elemTy.isa<FloatType>();
+  for (size_t c = 0; c < network.size(); ++c) {
+    auto [i, j] = network[c];
+    bool useMin = used.empty() || used[c].first;
+    bool useMax = used.empty() || used[c].second;
+    if ((!useMin && !useMax) || !wires[j])
+      continue;
+    if (!wires[i]) {
+      std::swap(wires[i], wires[j]);
+      continue;
+    }
+    Value lhs = wires[i], rhs = wires[j];
+    if (useMin && isFloat)
+      wires[i] = builder.create<arith::MinFOp>(loc, lhs, rhs);
+    else if (useMin)
+      wires[i] = builder.create<arith::MinSIOp>(loc, lhs, rhs);
+    if (useMax && isFloat)
+      wires[j] = builder.create<arith::MaxFOp>(loc, lhs, rhs);
+    else if (useMax)
+      wires[j] = builder.create<arith::MaxSIOp>(loc, lhs, rhs);
+  }
+}
+
+// Rounds `value` up to a multiple of `stride`.
+static Value alignToStride(OpBuilder &builder, Location loc, Value value,
+                           int64_t stride) {
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value chunks = builder.create<arith::DivUIOp>(
+      loc,
+      builder.create<arith::AddIOp>(
+          loc, value, builder.create<arith::ConstantIndexOp>(loc, stride - 1)),
+      strideVal);
+  return builder.create<arith::MulIOp>(loc, chunks, strideVal);
+}
+
+// Writes input row `srcRow` to row `bufferRow` of `buffer`, shifted right by
+// `radius` columns. Rows and columns outside of the input, up to column
+// `bufferCol` of the buffer, read the constant or the pixel chosen by the
+// boundary option.
+static void padImageRow(OpBuilder &builder, Location loc, Value input,
+                        Value buffer, Value bufferRow, Value srcRow,
+                        Value radius, Value bufferCol, Value constantValue,
+                        buddy::dip::BoundaryOption boundaryOption,
+                        int64_t stride) {
+  bool constantPadding = boundaryOption == BoundaryOption::ConstantPadding;
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value rightStart = builder.create<arith::AddIOp>(loc, radius, inputCol);
+
+  auto copyRow = [&](OpBuilder &builder, Location loc, Value row) {
+    builder.create<scf::ForOp>(
+        loc, c0, inputCol, strideVal, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+          Value rest = builder.create<arith::SubIOp>(loc, inputCol, x);
+          Value mask = builder.create<vector::CreateMaskOp>(loc, maskTy,
+                                                            ValueRange{rest});
+          Value pixels = builder.create<vector::MaskedLoadOp>(
+              loc, vecTy, input, ValueRange{row, x}, mask, zeroVec);
+          builder.create<vector::MaskedStoreOp>(
+              loc, buffer,
+              ValueRange{bufferRow,
+                         builder.create<arith::AddIOp>(loc, x, radius)},
+              mask, pixels);
+          builder.create<scf::YieldOp>(loc);
+        });
+    // The border columns read the constant or an extrapolated input column.
+    auto border = [&](Value from, Value to) {
+      builder.create<scf::ForOp>(
+          loc, from, to, c1, std::nullopt,
+          [&](OpBuilder &builder, Location loc, Value col, ValueRange) {
+            Value pixel = constantValue;
+            if (!constantPadding) {
+              Value srcCol = extrapolateIndex(
+                  builder, loc, builder.create<arith::SubIOp>(loc, col, radius),
+                  inputCol, boundaryOption);
+              pixel = builder.create<memref::LoadOp>(loc, input,
+                                                     ValueRange{row, srcCol});
+            }
+            builder.create<memref::StoreOp>(loc, pixel, buffer,
+                                            ValueRange{bufferRow, col});
+            builder.create<scf::YieldOp>(loc);
+          });
+    };
+    border(c0, radius);
+    border(rightStart, bufferCol);
+  };
+
+  if (!constantPadding) {
+    copyRow(builder, loc,
+            extrapolateIndex(builder, loc, srcRow, inputRow, boundaryOption));
+    return;
+  }
+  Value inside = builder.create<arith::AndIOp>(
+      loc,
+      builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::sge, srcRow,
+                                    c0),
+      builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt, srcRow,
+                                    inputRow));
+  builder.create<scf::IfOp>(
+      loc, inside,
+      [&](OpBuilder &builder, Location loc) {
+        copyRow(builder, loc, srcRow);
+        builder.create<scf::YieldOp>(loc);
+      },
+      [&](OpBuilder &builder, Location loc) {
+        // Whole rows of constants are written a vector at a time.
+        Value constantVec =
+            builder.create<vector::SplatOp>(loc, vecTy, constantValue);
+        builder.create<scf::ForOp>(
+            loc, c0, bufferCol, strideVal, std::nullopt,
+            [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+              Value rest = builder.create<arith::SubIOp>(loc, bufferCol, x);
+              Value mask = builder.create<vector::CreateMaskOp>(
+                  loc, maskTy, ValueRange{rest});
+              builder.create<vector::MaskedStoreOp>(
+                  loc, buffer, ValueRange{bufferRow, x}, mask, constantVec);
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
 
-        Value pixel_interm1 =
-            builder.create<arith::AddFOp>(loc, interm1, interm2);
-        Value pixel_interm2 =
-            builder.create<arith::AddFOp>(loc, interm3, interm4);
-        Value pixel_interm3 =
-            builder.create<arith::AddFOp>(loc, pixel_interm1, pixel_interm2);
+// Helper function for the median filter. Bands of output rows pad the input
+// rows they read into a buffer, whose width is a whole number of vectors plus
+// the vectors read past the last output column, so that all loads are full
+// vectors. Each vector of neighbouring pixels x..x+stride-1 then needs the
+// sorted padded columns x..x+stride+kernelSize-2: they are sorted a vector at
+// a time, carried from one vector to the next and shifted into place with
+// shuffles, so every column is sorted once per output row. The kernelSize
+// shifted column vectors are merged with Batcher's odd-even merge, pruned to
+// the comparators that the median depends on.
+void medianBlur(OpBuilder &builder, Location loc, Value input, Value output,
+                Value constantValue, int64_t kernelSize,
+                buddy::dip::BoundaryOption boundaryOption, int64_t stride,
+                int64_t rowGrain) {
+  int64_t radius = kernelSize / 2;
+  // Sorted column vectors used by each output vector.
+  int64_t chunks = 1 + (kernelSize + stride - 2) / stride;
+
+  // The columns are padded to a power of two with wires larger than any
+  // value, so that the median is wire (kernelSize^2 - 1) / 2 of the sorted
+  // window.
+  int64_t columnWires = llvm::PowerOf2Ceil(kernelSize);
+  int64_t windowWires = columnWires * columnWires;
+  auto columnNetwork = oddEvenMergeSortNetwork(columnWires, 1);
+  auto mergeNetwork = oddEvenMergeSortNetwork(windowWires, columnWires);
+  int64_t median = (kernelSize * kernelSize - 1) / 2;
+  auto mergeUsed = pruneSortingNetwork(mergeNetwork, windowWires, median);
+
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value radiusVal = builder.create<arith::ConstantIndexOp>(loc, radius);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  // Buffer column c holds input column c - radius.
+  Value bufferCol = builder.create<arith::AddIOp>(
+      loc, alignToStride(builder, loc, inputCol, stride),
+      builder.create<arith::ConstantIndexOp>(loc, (chunks - 1) * stride));
+
+  // Appends the sorted kernelSize rows of buffer columns x..x+stride-1,
+  // starting at buffer row `top`, to `sorted`.
+  auto sortColumns = [&](OpBuilder &builder, Location loc, Value buffer,
+                         Value top, Value x, SmallVectorImpl<Value> &sorted) {
+    SmallVector<Value, 8> wires(columnWires, Value());
+    for (int64_t r = 0; r < kernelSize; ++r) {
+      Value row = builder.create<arith::AddIOp>(
+          loc, top, builder.create<arith::ConstantIndexOp>(loc, r));
+      wires[r] = builder.create<vector::LoadOp>(loc, vecTy, buffer,
+                                                ValueRange{row, x});
+    }
+    applySortingNetwork(builder, loc, columnNetwork, {}, wires);
+    sorted.append(wires.begin(), wires.begin() + kernelSize);
+  };
 
-        Value pixelVal = roundOff(builder, loc, pixel_interm3);
+  // Filters output rows [rowStart, rowEnd).
+  auto band = [&](OpBuilder &builder, Location loc, Value rowStart,
+                  Value rowEnd) {
+    Value bandRows = builder.create<arith::SubIOp>(loc, rowEnd, rowStart);
+    Value padRows = builder.create<arith::AddIOp>(
+        loc, bandRows,
+        builder.create<arith::ConstantIndexOp>(loc, kernelSize - 1));
+    Value buffer = builder.create<memref::AllocOp>(
+        loc,
+        MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy),
+        ValueRange{padRows, bufferCol});
+
+    builder.create<scf::ForOp>(
+        loc, c0, padRows, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value py, ValueRange) {
+          Value srcRow = builder.create<arith::SubIOp>(
+              loc, builder.create<arith::AddIOp>(loc, rowStart, py),
+              radiusVal);
+          padImageRow(builder, loc, input, buffer, py, srcRow, radiusVal,
+                      bufferCol, constantValue, boundaryOption, stride);
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    builder.create<scf::ForOp>(
+        loc, c0, bandRows, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value top, ValueRange) {
+          Value y = builder.create<arith::AddIOp>(loc, rowStart, top);
+          // The first chunks - 1 sorted column vectors of the row.
+          SmallVector<Value, 16> init;
+          for (int64_t chunk = 0; chunk < chunks - 1; ++chunk)
+            sortColumns(
+                builder, loc, buffer, top,
+                builder.create<arith::ConstantIndexOp>(loc, chunk * stride),
+                init);
+          builder.create<scf::ForOp>(
+              loc, c0, inputCol, strideVal, init,
+              [&](OpBuilder &builder, Location loc, Value x,
+                  ValueRange carried) {
+                SmallVector<Value, 24> sorted(carried.begin(), carried.end());
+                sortColumns(builder, loc, buffer, top,
+                            builder.create<arith::AddIOp>(
+                                loc, x,
+                                builder.create<arith::ConstantIndexOp>(
+                                    loc, (chunks - 1) * stride)),
+                            sorted);
+
+                // Window column dx of lane l is sorted column x + l + dx.
+                SmallVector<Value, 64> wires(windowWires, Value());
+                for (int64_t dx = 0; dx < kernelSize; ++dx) {
+                  int64_t chunk = dx / stride, shift = dx % stride;
+                  SmallVector<int64_t, 16> lanes;
+                  for (int64_t l = 0; l < stride; ++l)
+                    lanes.push_back(shift + l);
+                  for (int64_t r = 0; r < kernelSize; ++r) {
+                    Value column = sorted[chunk * kernelSize + r];
+                    if (shift)
+                      column = builder.create<vector::ShuffleOp>(
+                          loc, column, sorted[(chunk + 1) * kernelSize + r],
+                          lanes);
+                    wires[dx * columnWires + r] = column;
+                  }
+                }
+                applySortingNetwork(builder, loc, mergeNetwork, mergeUsed,
+                                    wires);
+
+                Value rest = builder.create<arith::SubIOp>(loc, inputCol, x);
+                Value mask = builder.create<vector::CreateMaskOp>(
+                    loc, maskTy, ValueRange{rest});
+                builder.create<vector::MaskedStoreOp>(
+                    loc, output, ValueRange{y, x}, mask, wires[median]);
+                builder.create<scf::YieldOp>(
+                    loc, ValueRange(sorted).drop_front(kernelSize));
+              });
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    builder.create<memref::DeallocOp>(loc, buffer);
+  };
 
-        builder.create<memref::StoreOp>(
-            loc, pixelVal, output, ValueRange{resIndices[1], resIndices[0]});
+  if (rowGrain <= 0) {
+    band(builder, loc, c0, inputRow);
+    return;
+  }
 
-        builder.create<affine::AffineYieldOp>(loc);
+  // Every band pads kernelSize - 1 rows of its neighbours, so bands are at
+  // least four kernels high.
+  Value bandStep = builder.create<arith::MaxSIOp>(
+      loc, builder.create<arith::ConstantIndexOp>(loc, rowGrain),
+      builder.create<arith::ConstantIndexOp>(loc, 4 * kernelSize));
+  builder.create<scf::ParallelOp>(
+      loc, ValueRange{c0}, ValueRange{inputRow}, ValueRange{bandStep},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rowEnd = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, ivs[0], bandStep),
+            inputRow);
+        band(builder, loc, ivs[0], rowEnd);
       });
 }
 
-// Helper function for resizing an image using nearest neighbour interpolation
-// mechanism.
-void NearestNeighbourInterpolationResizing(
-    OpBuilder &builder, Location loc, MLIRContext *ctx,
-    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
-    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
-    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32) {
-  affine::buildAffineLoopNest(
-      builder, loc, lowerBounds, upperBounds, steps,
-      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
-        Value ivs0F32 = indexToF32(builder, loc, ivs[0]);
-        Value yVec = builder.create<vector::SplatOp>(loc, vectorTy32, ivs0F32);
-        Value xVec = iotaVec(builder, loc, ctx, ivs[1], strideVal, vectorTy32,
-                             c0, stride);
+// Helper function for the gradient operation. Each band of output rows keeps
+// three padded input rows in a ring buffer: output row y reads the ring rows
+// of input rows y - 1, y and y + 1, after row y + 1 has been padded over the
+// one of row y - 2, so every input row is padded once. Each vector of pixels
+// takes three loads per ring row, and the separable 3x3 kernels, a central
+// difference across [outer center outer] weights, give gx and gy. All outputs
+// of a vector are computed and stored in the same iteration.
+void gradient2D(OpBuilder &builder, Location loc, Value input, Value magnitude,
+                Value gx, Value gy, Value direction, Value constantValue,
+                buddy::dip::GradientOperator gradientOperator,
+                buddy::dip::GradientNorm norm,
+                buddy::dip::BoundaryOption boundaryOption, int64_t stride,
+                int64_t rowGrain) {
+  bool sobel = gradientOperator == GradientOperator::Sobel;
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  auto splat = [&](double value) -> Value {
+    return builder.create<vector::SplatOp>(
+        loc, vecTy,
+        builder.create<arith::ConstantOp>(
+            loc, builder.getFloatAttr(elemTy, value)));
+  };
+  Value outerVec = splat(sobel ? 1 : 3);
+  Value centerVec = splat(sobel ? 2 : 10);
+  Value zeroVec = splat(0);
+  Value tan22Vec = splat(std::tan(M_PI / 8));
+  Value tan67Vec = splat(std::tan(3 * M_PI / 8));
+
+  // Direction codes 0 to 3 in the element type of the direction memref.
+  SmallVector<Value, 4> codes;
+  if (direction) {
+    Type codeTy = direction.getType().cast<MemRefType>().getElementType();
+    VectorType codeVecTy = VectorType::get({stride}, codeTy);
+    for (int64_t code = 0; code < 4; ++code) {
+      TypedAttr attr;
+      if (codeTy.isa<FloatType>())
+        attr = builder.getFloatAttr(codeTy, code);
+      else
+        attr = builder.getIntegerAttr(codeTy, code);
+      codes.push_back(builder.create<vector::SplatOp>(
+          loc, codeVecTy, builder.create<arith::ConstantOp>(loc, attr)));
+    }
+  }
 
-        Value resXVecInterm = builder.create<arith::MulFOp>(
-            loc, xVec, horizontalScalingFactorVec);
-        Value resYVecInterm =
-            builder.create<arith::MulFOp>(loc, yVec, verticalScalingFactorVec);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  // Ring column c holds input column c - 1; the loads of the last vector
+  // reach two columns past it.
+  Value bufferCol = builder.create<arith::AddIOp>(
+      loc, alignToStride(builder, loc, inputCol, stride), strideVal);
+
+  // Computes and stores the outputs of the pixels x..x+stride-1 of row y from
+  // the ring rows `top`, `mid` and `bottom`.
+  auto gradientVector = [&](OpBuilder &builder, Location loc, Value buffer,
+                            Value top, Value mid, Value bottom, Value y,
+                            Value x) {
+    auto load = [&](Value row, Value dx) -> Value {
+      return builder.create<vector::LoadOp>(
+          loc, vecTy, buffer,
+          ValueRange{row, builder.create<arith::AddIOp>(loc, x, dx)});
+    };
+    auto sub = [&](Value lhs, Value rhs) -> Value {
+      return builder.create<arith::SubFOp>(loc, lhs, rhs);
+    };
+    // outer * outerDiff + center * centerDiff.
+    auto weigh = [&](Value outerDiff, Value centerDiff) -> Value {
+      if (!sobel)
+        outerDiff = builder.create<arith::MulFOp>(loc, outerDiff, outerVec);
+      return builder.create<vector::FMAOp>(loc, centerDiff, centerVec,
+                                           outerDiff);
+    };
+    Value topLeft = load(top, c0), topRight = load(top, c2);
+    Value bottomLeft = load(bottom, c0), bottomRight = load(bottom, c2);
+    Value gxVec = weigh(
+        builder.create<arith::AddFOp>(loc, sub(topRight, topLeft),
+                                      sub(bottomRight, bottomLeft)),
+        sub(load(mid, c2), load(mid, c0)));
+    Value gyVec = weigh(
+        builder.create<arith::AddFOp>(loc, sub(bottomLeft, topLeft),
+                                      sub(bottomRight, topRight)),
+        sub(load(bottom, c1), load(top, c1)));
+
+    Value rest = builder.create<arith::SubIOp>(loc, inputCol, x);
+    Value mask =
+        builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{rest});
+    auto store = [&](Value memref, Value vec) {
+      builder.create<vector::MaskedStoreOp>(loc, memref, ValueRange{y, x},
+                                            mask, vec);
+    };
+    if (gx)
+      store(gx, gxVec);
+    if (gy)
+      store(gy, gyVec);
+
+    Value absGx = builder.create<math::AbsFOp>(loc, gxVec);
+    Value absGy = builder.create<math::AbsFOp>(loc, gyVec);
+    if (norm == GradientNorm::L1Norm) {
+      store(magnitude, builder.create<arith::AddFOp>(loc, absGx, absGy));
+    } else {
+      Value squares = builder.create<vector::FMAOp>(
+          loc, gxVec, gxVec, builder.create<arith::MulFOp>(loc, gyVec, gyVec));
+      store(magnitude, builder.create<math::SqrtOp>(loc, squares));
+    }
+    if (!direction)
+      return;
+
+    // |gy| <= tan(22.5) |gx| is horizontal, |gy| > tan(67.5) |gx| vertical,
+    // and the sign of gx * gy tells the two diagonals apart.
+    Value horizontal = builder.create<arith::CmpFOp>(
+        loc, arith::CmpFPredicate::OLE, absGy,
+        builder.create<arith::MulFOp>(loc, absGx, tan22Vec));
+    Value vertical = builder.create<arith::CmpFOp>(
+        loc, arith::CmpFPredicate::OGT, absGy,
+        builder.create<arith::MulFOp>(loc, absGx, tan67Vec));
+    Value sameSign = builder.create<arith::CmpFOp>(
+        loc, arith::CmpFPredicate::OGE,
+        builder.create<arith::MulFOp>(loc, gxVec, gyVec), zeroVec);
+    Value diagonal =
+        builder.create<arith::SelectOp>(loc, sameSign, codes[1], codes[3]);
+    Value code = builder.create<arith::SelectOp>(
+        loc, horizontal, codes[0],
+        builder.create<arith::SelectOp>(loc, vertical, codes[2], diagonal));
+    store(direction, code);
+  };
 
-        Value resXVec = roundOff(builder, loc, resXVecInterm);
-        Value resYVec = roundOff(builder, loc, resYVecInterm);
+  // Computes output rows [rowStart, rowEnd).
+  auto band = [&](OpBuilder &builder, Location loc, Value rowStart,
+                  Value rowEnd) {
+    Value buffer = builder.create<memref::AllocOp>(
+        loc, MemRefType::get({3, ShapedType::kDynamic}, elemTy),
+        ValueRange{bufferCol});
+    Value firstRow = builder.create<arith::SubIOp>(loc, rowStart, c1);
+    padImageRow(builder, loc, input, buffer, c0, firstRow, c1, bufferCol,
+                constantValue, boundaryOption, stride);
+    padImageRow(builder, loc, input, buffer, c1, rowStart, c1, bufferCol,
+                constantValue, boundaryOption, stride);
+
+    builder.create<scf::ForOp>(
+        loc, rowStart, rowEnd, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value y, ValueRange) {
+          Value t = builder.create<arith::SubIOp>(loc, y, rowStart);
+          auto ringRow = [&](Value offset) -> Value {
+            return builder.create<arith::RemUIOp>(
+                loc, builder.create<arith::AddIOp>(loc, t, offset), c3);
+          };
+          Value top = ringRow(c0), mid = ringRow(c1), bottom = ringRow(c2);
+          padImageRow(builder, loc, input, buffer, bottom,
+                      builder.create<arith::AddIOp>(loc, y, c1), c1,
+                      bufferCol, constantValue, boundaryOption, stride);
+          builder.create<scf::ForOp>(
+              loc, c0, inputCol, strideVal, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+                gradientVector(builder, loc, buffer, top, mid, bottom, y, x);
+                builder.create<scf::YieldOp>(loc);
+              });
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    builder.create<memref::DeallocOp>(loc, buffer);
+  };
 
-        fillPixels(builder, loc, xVec, yVec, resXVec, resYVec, input, output,
-                   c0, strideVal, outputRowLastElemF32, outputColLastElemF32,
-                   inputRowLastElemF32, inputColLastElemF32, c0F32);
+  if (rowGrain <= 0) {
+    band(builder, loc, c0, inputRow);
+    return;
+  }
+
+  // Every band pads two rows of its neighbours, so bands are at least twelve
+  // rows high.
+  Value bandStep = builder.create<arith::MaxSIOp>(
+      loc, builder.create<arith::ConstantIndexOp>(loc, rowGrain),
+      builder.create<arith::ConstantIndexOp>(loc, 12));
+  builder.create<scf::ParallelOp>(
+      loc, ValueRange{c0}, ValueRange{inputRow}, ValueRange{bandStep},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rowEnd = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, ivs[0], bandStep),
+            inputRow);
+        band(builder, loc, ivs[0], rowEnd);
       });
 }
 
-// Helper function for resizing an image using bilinear interpolation mechanism.
-void BilinearInterpolationResizing(
-    OpBuilder &builder, Location loc, MLIRContext *ctx,
-    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
-    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
-    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32, Value c1F32) {
-  affine::buildAffineLoopNest(
-      builder, loc, lowerBounds, upperBounds, steps,
-      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
-        Value ivs0F32 = indexToF32(builder, loc, ivs[0]);
-        Value yVec = builder.create<vector::SplatOp>(loc, vectorTy32, ivs0F32);
-        Value xVec = iotaVec(builder, loc, ctx, ivs[1], strideVal, vectorTy32,
-                             c0, stride);
+// Helper function for dip.corr_2d with a kernel known at compile time. Bands
+// of output rows keep the last kernelRows padded input rows in a ring, so
+// every input row is padded once per band, and every vector of output pixels
+// is accumulated by an unrolled sequence of taps: zero coefficients are
+// skipped, and coefficients of 1 and -1 become additions and subtractions.
+void constantCorrelation2D(OpBuilder &builder, Location loc, Value input,
+                           DenseElementsAttr kernel, Value output,
+                           Value centerX, Value centerY, Value constantValue,
+                           buddy::dip::BoundaryOption boundaryOption,
+                           int64_t stride, int64_t rowGrain) {
+  int64_t kernelRows = kernel.getType().getShape()[0];
+  int64_t kernelCols = kernel.getType().getShape()[1];
+  Type elemTy = input.getType().cast<MemRefType>().getElementType();
+  bool isFloat = elemTy.isa<FloatType>();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value kernelRowsVal = builder.create<arith::ConstantIndexOp>(loc, kernelRows);
 
-        Value xVecInterm = builder.create<arith::MulFOp>(
-            loc, xVec, horizontalScalingFactorVec);
-        Value yVecInterm =
-            builder.create<arith::MulFOp>(loc, yVec, verticalScalingFactorVec);
+  // The non-zero taps, with a splat of the coefficient unless it is 1 or -1.
+  struct Tap {
+    int64_t row, col, sign;
+    Value weightVec;
+  };
+  SmallVector<Tap> taps;
+  SmallVector<bool> rowUsed(kernelRows, false);
+  int64_t index = 0;
+  for (Attribute element : kernel.getValues<Attribute>()) {
+    int64_t row = index / kernelCols, col = index % kernelCols;
+    ++index;
+    auto weight = element.cast<TypedAttr>();
+    double value = isFloat
+                       ? weight.cast<FloatAttr>().getValueAsDouble()
+                       : weight.cast<IntegerAttr>().getValue().getSExtValue();
+    if (value == 0)
+      continue;
+    Tap tap{row, col, 0, {}};
+    if (value == 1 || value == -1) {
+      tap.sign = value > 0 ? 1 : -1;
+    } else {
+      tap.weightVec = builder.create<vector::SplatOp>(
+          loc, vecTy, builder.create<arith::ConstantOp>(loc, weight));
+    }
+    taps.push_back(tap);
+    rowUsed[row] = true;
+  }
 
-        Value xVecInterm_L = builder.create<math::FloorOp>(loc, xVecInterm);
-        Value xVecInterm_H = builder.create<math::CeilOp>(loc, xVecInterm);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  // Ring column c holds input column c - centerX; the loads of the last
+  // vector reach kernelCols - 1 columns past it.
+  Value bufferCol = builder.create<arith::AddIOp>(
+      loc, alignToStride(builder, loc, inputCol, stride),
+      builder.create<arith::ConstantIndexOp>(loc, kernelCols - 1));
+
+  // Computes output rows [rowStart, rowEnd). Ring row (t + k) % kernelRows
+  // holds input row rowStart + t + k - centerY while row rowStart + t is
+  // computed.
+  auto band = [&](OpBuilder &builder, Location loc, Value rowStart,
+                  Value rowEnd) {
+    Value buffer = builder.create<memref::AllocOp>(
+        loc, MemRefType::get({kernelRows, ShapedType::kDynamic}, elemTy),
+        ValueRange{bufferCol});
+    Value firstRow = builder.create<arith::SubIOp>(loc, rowStart, centerY);
+    for (int64_t k = 0; k < kernelRows - 1; ++k) {
+      Value kVal = builder.create<arith::ConstantIndexOp>(loc, k);
+      padImageRow(builder, loc, input, buffer, kVal,
+                  builder.create<arith::AddIOp>(loc, firstRow, kVal), centerX,
+                  bufferCol, constantValue, boundaryOption, stride);
+    }
 
-        Value yVecInterm_L = builder.create<math::FloorOp>(loc, yVecInterm);
-        Value yVecInterm_H = builder.create<math::CeilOp>(loc, yVecInterm);
+    builder.create<scf::ForOp>(
+        loc, rowStart, rowEnd, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value y, ValueRange) {
+          Value t = builder.create<arith::SubIOp>(loc, y, rowStart);
+          auto ringRow = [&](int64_t k) -> Value {
+            return builder.create<arith::RemUIOp>(
+                loc,
+                builder.create<arith::AddIOp>(
+                    loc, t, builder.create<arith::ConstantIndexOp>(loc, k)),
+                kernelRowsVal);
+          };
+          Value lastRow = builder.create<arith::AddIOp>(
+              loc, builder.create<arith::SubIOp>(loc, y, centerY),
+              builder.create<arith::ConstantIndexOp>(loc, kernelRows - 1));
+          padImageRow(builder, loc, input, buffer, ringRow(kernelRows - 1),
+                      lastRow, centerX, bufferCol, constantValue,
+                      boundaryOption, stride);
+          SmallVector<Value> ringRows(kernelRows);
+          for (int64_t k = 0; k < kernelRows; ++k)
+            if (rowUsed[k])
+              ringRows[k] = ringRow(k);
+
+          builder.create<scf::ForOp>(
+              loc, c0, inputCol, strideVal, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value x, ValueRange) {
+                Value rest = builder.create<arith::SubIOp>(loc, inputCol, x);
+                Value mask = builder.create<vector::CreateMaskOp>(
+                    loc, maskTy, ValueRange{rest});
+                Value acc = builder.create<vector::MaskedLoadOp>(
+                    loc, vecTy, output, ValueRange{y, x}, mask,
+                    builder.create<arith::ConstantOp>(
+                        loc, vecTy, builder.getZeroAttr(vecTy)));
+                for (const Tap &tap : taps) {
+                  Value col = builder.create<arith::AddIOp>(
+                      loc, x,
+                      builder.create<arith::ConstantIndexOp>(loc, tap.col));
+                  Value pixels = builder.create<vector::LoadOp>(
+                      loc, vecTy, buffer, ValueRange{ringRows[tap.row], col});
+                  if (tap.weightVec) {
+                    acc = insertFMAOp(builder, loc, vecTy, pixels,
+                                      tap.weightVec, acc);
+                  } else if (tap.sign > 0 && isFloat) {
+                    acc = builder.create<arith::AddFOp>(loc, acc, pixels);
+                  } else if (tap.sign > 0) {
+                    acc = builder.create<arith::AddIOp>(loc, acc, pixels);
+                  } else if (isFloat) {
+                    acc = builder.create<arith::SubFOp>(loc, acc, pixels);
+                  } else {
+                    acc = builder.create<arith::SubIOp>(loc, acc, pixels);
+                  }
+                }
+                builder.create<vector::MaskedStoreOp>(loc, output,
+                                                      ValueRange{y, x}, mask,
+                                                      acc);
+                builder.create<scf::YieldOp>(loc);
+              });
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    builder.create<memref::DeallocOp>(loc, buffer);
+  };
 
-        Value xVecWeight =
-            builder.create<arith::SubFOp>(loc, xVecInterm, xVecInterm_L);
-        Value yVecWeight =
-            builder.create<arith::SubFOp>(loc, yVecInterm, yVecInterm_L);
+  if (rowGrain <= 0) {
+    band(builder, loc, c0, inputRow);
+    return;
+  }
 
-        fillPixelsBilinearInterpolate(
-            builder, loc, xVec, yVec, xVecInterm_L, yVecInterm_L, xVecInterm_H,
-            yVecInterm_H, input, output, c0, strideVal, xVecWeight, yVecWeight,
-            outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-            inputColLastElemF32, c0F32, c1F32);
+  // Every band pads kernelRows - 1 rows of its neighbours, so bands are at
+  // least four times the kernel height.
+  Value bandStep = builder.create<arith::MaxSIOp>(
+      loc, builder.create<arith::ConstantIndexOp>(loc, rowGrain),
+      builder.create<arith::ConstantIndexOp>(loc, 4 * kernelRows));
+  builder.create<scf::ParallelOp>(
+      loc, ValueRange{c0}, ValueRange{inputRow}, ValueRange{bandStep},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value rowEnd = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, ivs[0], bandStep),
+            inputRow);
+        band(builder, loc, ivs[0], rowEnd);
       });
 }
 
@@ -952,11 +4132,38 @@ void calcAndStorewTailProcessingMorph(
       });
 }
 
+// Loads `vecTy` pixels of image row `row` from column `col` on, taking the
+// columns outside of the image from the image as the boundary option does.
+static Value loadExtrapolatedRow(OpBuilder &builder, Location loc, Value input,
+                                 Value row, Value col, Value inputCol,
+                                 VectorType vecTy,
+                                 buddy::dip::BoundaryOption boundaryOption) {
+  int64_t stride = vecTy.getNumElements();
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  Value cols = builder.create<arith::AddIOp>(
+      loc, builder.create<vector::SplatOp>(loc, indexVecTy, col),
+      builder.create<arith::ConstantOp>(loc, indexVecTy,
+                                        builder.getIndexVectorAttr(lanes)));
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value allLanes = builder.create<arith::ConstantOp>(
+      loc, DenseElementsAttr::get(maskTy, true));
+  Value zeroVec =
+      builder.create<arith::ConstantOp>(loc, vecTy, builder.getZeroAttr(vecTy));
+  return builder.create<vector::GatherOp>(
+      loc, vecTy, input, ValueRange{row, c0},
+      extrapolateIndex(builder, loc, cols, inputCol, boundaryOption), allLanes,
+      zeroVec);
+}
+
 void traverseImagewBoundaryExtrapolation(
     OpBuilder &rewriter, Location loc, MLIRContext *ctx, Value input,
     Value kernel, Value output, Value centerX, Value centerY,
     Value constantValue, Value strideVal, Type elemTy,
-    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op) {
+    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op,
+    int64_t rowGrain) {
   // Create constant indices.
   Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
   Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
@@ -992,8 +4199,8 @@ void traverseImagewBoundaryExtrapolation(
   Value pseudoCol = rewriter.create<affine::AffineApplyOp>(
       loc, calcHelper, ValueRange{inputCol, kernelCol, c1});
 
-  affine::buildAffineLoopNest(
-      rewriter, loc, lowerBounds, uperBounds, steps,
+  buildRowBandLoopNest(
+      rewriter, loc, lowerBounds, uperBounds, steps, rowGrain,
       [&](OpBuilder &builder, Location loc, ValueRange ivs) {
         // Indices of current pixel with respect to pseudo image containing
         // extrapolated boundaries.
@@ -1084,6 +4291,13 @@ void traverseImagewBoundaryExtrapolation(
                                   loc, vectorTy32, input,
                                   ValueRange{c0, leftPaddingOffset}, leftMask,
                                   padding);
+                            } else {
+                              Value srcRow = extrapolateIndex(
+                                  builder, loc, imRow, inputRow,
+                                  boundaryOptionAttr);
+                              inputVec = loadExtrapolatedRow(
+                                  builder, loc, input, srcRow, imCol, inputCol,
+                                  vectorTy32, boundaryOptionAttr);
                             }
 
                             if (op == DIP_OP::CORRELATION_2D) {
@@ -1123,6 +4337,13 @@ void traverseImagewBoundaryExtrapolation(
                                     inputVec = builder.create<vector::LoadOp>(
                                         loc, vectorTy32, input,
                                         ValueRange{c0, imCol});
+                                  } else {
+                                    Value srcRow = extrapolateIndex(
+                                        builder, loc, imRow, inputRow,
+                                        boundaryOptionAttr);
+                                    inputVec = builder.create<vector::LoadOp>(
+                                        loc, vectorTy32, input,
+                                        ValueRange{srcRow, imCol});
                                   }
 
                                   if (op == DIP_OP::CORRELATION_2D) {
@@ -1178,6 +4399,14 @@ void traverseImagewBoundaryExtrapolation(
                                             loc, vectorTy32, input,
                                             ValueRange{c0, imCol}, rightMask,
                                             padding);
+                                  } else {
+                                    Value srcRow = extrapolateIndex(
+                                        builder, loc, imRow, inputRow,
+                                        boundaryOptionAttr);
+                                    inputVec = loadExtrapolatedRow(
+                                        builder, loc, input, srcRow, imCol,
+                                        inputCol, vectorTy32,
+                                        boundaryOptionAttr);
                                   }
                                   Value tailCond = tailChecker(
                                       builder, loc, calcHelper, strideVal,
@@ -1269,6 +4498,10 @@ void traverseImagewBoundaryExtrapolation(
                                           loc, vectorTy32, input,
                                           ValueRange{imRow, leftPaddingOffset},
                                           leftMask, padding);
+                                } else {
+                                  inputVec = loadExtrapolatedRow(
+                                      builder, loc, input, imRow, imCol,
+                                      inputCol, vectorTy32, boundaryOptionAttr);
                                 }
 
                                 if (op == DIP_OP::CORRELATION_2D) {
@@ -1379,6 +4612,11 @@ void traverseImagewBoundaryExtrapolation(
                                                     loc, vectorTy32, input,
                                                     ValueRange{imRow, imCol},
                                                     rightMask, padding);
+                                      } else {
+                                        inputVec = loadExtrapolatedRow(
+                                            builder, loc, input, imRow, imCol,
+                                            inputCol, vectorTy32,
+                                            boundaryOptionAttr);
                                       }
                                       Value tailCond = tailChecker(
                                           builder, loc, calcHelper, strideVal,
@@ -1478,6 +4716,14 @@ void traverseImagewBoundaryExtrapolation(
                                             ValueRange{downRange,
                                                        leftPaddingOffset},
                                             leftMask, padding);
+                                  } else {
+                                    Value srcRow = extrapolateIndex(
+                                        builder, loc, imRow, inputRow,
+                                        boundaryOptionAttr);
+                                    inputVec = loadExtrapolatedRow(
+                                        builder, loc, input, srcRow, imCol,
+                                        inputCol, vectorTy32,
+                                        boundaryOptionAttr);
                                   }
 
                                   if (op == DIP_OP::CORRELATION_2D) {
@@ -1524,6 +4770,14 @@ void traverseImagewBoundaryExtrapolation(
                                               builder.create<vector::LoadOp>(
                                                   loc, vectorTy32, input,
                                                   ValueRange{downRange, imCol});
+                                        } else {
+                                          Value srcRow = extrapolateIndex(
+                                              builder, loc, imRow, inputRow,
+                                              boundaryOptionAttr);
+                                          inputVec =
+                                              builder.create<vector::LoadOp>(
+                                                  loc, vectorTy32, input,
+                                                  ValueRange{srcRow, imCol});
                                         }
 
                                         if (op == DIP_OP::CORRELATION_2D) {
@@ -1596,6 +4850,14 @@ void traverseImagewBoundaryExtrapolation(
                                                       ValueRange{downRange,
                                                                  imCol},
                                                       rightMask, padding);
+                                        } else {
+                                          Value srcRow = extrapolateIndex(
+                                              builder, loc, imRow, inputRow,
+                                              boundaryOptionAttr);
+                                          inputVec = loadExtrapolatedRow(
+                                              builder, loc, input, srcRow,
+                                              imCol, inputCol, vectorTy32,
+                                              boundaryOptionAttr);
                                         }
                                         Value tailCond = tailChecker(
                                             builder, loc, calcHelper, strideVal,
@@ -1642,6 +4904,1310 @@ void traverseImagewBoundaryExtrapolation(
       });
 }
 
+// Correlate `input` with the separable kernel kernelY[i] * kernelX[j] and
+// accumulate the result into `output`. The horizontal pass writes the rows of
+// `input` correlated with kernelX into a temporary buffer, the vertical pass
+// correlates the columns of that buffer with kernelY. Rows above and below the
+// image need no horizontal pass of their own: with replicate padding they are
+// copies of the first / last buffer row, with constant padding every element
+// of them is constantValue * sum(kernelX).
+void separableCorrelation2D(OpBuilder &builder, Location loc, Value input,
+                            Value kernelX, Value kernelY, Value output,
+                            Value centerX, Value centerY, Value constantValue,
+                            Type elemTy,
+                            buddy::dip::BoundaryOption boundaryOptionAttr,
+                            int64_t stride, int64_t rowGrain) {
+  MLIRContext *ctx = builder.getContext();
+  bool isFloat = elemTy.isF32() || elemTy.isF64();
+  bool constantPadding =
+      boundaryOptionAttr == buddy::dip::BoundaryOption::ConstantPadding;
+
+  // Create constant indices.
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+
+  // Create DimOp.
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value kernelXSize = builder.create<memref::DimOp>(loc, kernelX, c0);
+  Value kernelYSize = builder.create<memref::DimOp>(loc, kernelY, c0);
+  Value lastRow = builder.create<arith::SubIOp>(loc, inputRow, c1);
+  Value lastCol = builder.create<arith::SubIOp>(loc, inputCol, c1);
+
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getIndexType());
+
+  Value zeroElem = insertZeroConstantOp(ctx, builder, loc, elemTy);
+  Value zeroVec = builder.create<vector::BroadcastOp>(loc, vecTy, zeroElem);
+  Value constantVec =
+      builder.create<vector::BroadcastOp>(loc, vecTy, constantValue);
+  Value allLanes =
+      builder.create<vector::CreateMaskOp>(loc, maskTy, ValueRange{strideVal});
+
+  auto addElems = [&](OpBuilder &builder, Location loc, Value lhs,
+                      Value rhs) -> Value {
+    if (isFloat)
+      return builder.create<arith::AddFOp>(loc, lhs, rhs);
+    return builder.create<arith::AddIOp>(loc, lhs, rhs);
+  };
+
+  // Column offsets of the vector lanes, used to build gather indices.
+  SmallVector<int64_t, 16> lanes(stride);
+  std::iota(lanes.begin(), lanes.end(), 0);
+  Value laneOffsets = builder.create<arith::ConstantOp>(
+      loc, indexVecTy, builder.getIndexVectorAttr(lanes));
+  Value zeroIndexVec =
+      builder.create<vector::BroadcastOp>(loc, indexVecTy, c0);
+  Value inputColVec =
+      builder.create<vector::BroadcastOp>(loc, indexVecTy, inputCol);
+  Value lastColVec =
+      builder.create<vector::BroadcastOp>(loc, indexVecTy, lastCol);
+
+  // Value of every element of a padded row after the horizontal pass.
+  Value paddedRowVec = zeroVec;
+  if (constantPadding) {
+    auto kernelXSum = builder.create<scf::ForOp>(
+        loc, c0, kernelXSize, c1, ValueRange{zeroElem},
+        [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+          Value tap = builder.create<memref::LoadOp>(loc, kernelX, iv);
+          Value sum = addElems(builder, loc, iargs[0], tap);
+          builder.create<scf::YieldOp>(loc, sum);
+        });
+    Value sumVec = builder.create<vector::BroadcastOp>(
+        loc, vecTy, kernelXSum.getResult(0));
+    paddedRowVec = insertFMAOp(builder, loc, vecTy, constantVec, sumVec,
+                               zeroVec);
+  }
+
+  // The columns of the temporary buffer are rounded up to whole vectors, so
+  // both passes use unmasked loads and stores on it.
+  AffineExpr d0;
+  bindDims(ctx, d0);
+  AffineMap roundUp =
+      AffineMap::get(1, 0, {d0.ceilDiv(stride) * stride}, ctx);
+  Value bufferCol =
+      builder.create<affine::AffineApplyOp>(loc, roundUp, ValueRange{inputCol});
+  MemRefType bufferTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  Value buffer = builder.create<memref::AllocOp>(
+      loc, bufferTy, ValueRange{inputRow, bufferCol});
+
+  SmallVector<Value, 8> lowerBounds(2, c0);
+  SmallVector<Value, 8> upperBounds{inputRow, inputCol};
+  SmallVector<int64_t, 8> steps{1, stride};
+
+  // Horizontal pass. Blocks whose whole window lies inside the row use plain
+  // vector loads, the others gather every tap with out of range columns
+  // clamped (replicate padding) or masked off to the constant.
+  buildRowBandLoopNest(
+      builder, loc, lowerBounds, upperBounds, steps, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value row = ivs[0];
+        Value windowBegin = builder.create<arith::SubIOp>(loc, ivs[1], centerX);
+        Value windowEnd = builder.create<arith::AddIOp>(
+            loc, builder.create<arith::AddIOp>(loc, windowBegin, kernelXSize),
+            builder.create<arith::SubIOp>(loc, strideVal, c1));
+        Value leftInside = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::sge, windowBegin, c0);
+        Value rightInside = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::sle, windowEnd, inputCol);
+        Value inside =
+            builder.create<arith::AndIOp>(loc, leftInside, rightInside);
+
+        auto correlateRow = [&](OpBuilder &builder, Location loc,
+                                bool boundary) {
+          auto taps = builder.create<scf::ForOp>(
+              loc, c0, kernelXSize, c1, ValueRange{zeroVec},
+              [&](OpBuilder &builder, Location loc, Value iv,
+                  ValueRange iargs) {
+                Value tap = builder.create<memref::LoadOp>(loc, kernelX, iv);
+                Value tapVec =
+                    builder.create<vector::BroadcastOp>(loc, vecTy, tap);
+                Value col = builder.create<arith::AddIOp>(loc, windowBegin, iv);
+                Value inputVec;
+                if (!boundary) {
+                  inputVec = builder.create<vector::LoadOp>(
+                      loc, vecTy, input, ValueRange{row, col});
+                } else {
+                  Value colVec = builder.create<arith::AddIOp>(
+                      loc,
+                      builder.create<vector::BroadcastOp>(loc, indexVecTy,
+                                                          col),
+                      laneOffsets);
+                  if (constantPadding) {
+                    Value notLeft = builder.create<arith::CmpIOp>(
+                        loc, arith::CmpIPredicate::sge, colVec, zeroIndexVec);
+                    Value notRight = builder.create<arith::CmpIOp>(
+                        loc, arith::CmpIPredicate::slt, colVec, inputColVec);
+                    Value inImage =
+                        builder.create<arith::AndIOp>(loc, notLeft, notRight);
+                    inputVec = builder.create<vector::GatherOp>(
+                        loc, vecTy, input, ValueRange{row, c0}, colVec,
+                        inImage, constantVec);
+                  } else {
+                    Value clamped = builder.create<arith::MinSIOp>(
+                        loc,
+                        builder.create<arith::MaxSIOp>(loc, colVec,
+                                                       zeroIndexVec),
+                        lastColVec);
+                    inputVec = builder.create<vector::GatherOp>(
+                        loc, vecTy, input, ValueRange{row, c0}, clamped,
+                        allLanes, zeroVec);
+                  }
+                }
+                Value acc = insertFMAOp(builder, loc, vecTy, inputVec, tapVec,
+                                        iargs[0]);
+                builder.create<scf::YieldOp>(loc, acc);
+              });
+          builder.create<scf::YieldOp>(loc, taps.getResult(0));
+        };
+
+        auto rowVec = builder.create<scf::IfOp>(
+            loc, inside,
+            [&](OpBuilder &builder, Location loc) {
+              correlateRow(builder, loc, /*boundary=*/false);
+            },
+            [&](OpBuilder &builder, Location loc) {
+              correlateRow(builder, loc, /*boundary=*/true);
+            });
+        builder.create<vector::StoreOp>(loc, rowVec.getResult(0), buffer,
+                                        ValueRange{row, ivs[1]});
+      });
+
+  // Vertical pass. Rows above and below the image are read from the clamped
+  // buffer row, and replaced by the padded row value for constant padding.
+  buildRowBandLoopNest(
+      builder, loc, lowerBounds, upperBounds, steps, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value windowBegin = builder.create<arith::SubIOp>(loc, ivs[0], centerY);
+        auto taps = builder.create<scf::ForOp>(
+            loc, c0, kernelYSize, c1, ValueRange{zeroVec},
+            [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+              Value tap = builder.create<memref::LoadOp>(loc, kernelY, iv);
+              Value tapVec =
+                  builder.create<vector::BroadcastOp>(loc, vecTy, tap);
+              Value srcRow =
+                  builder.create<arith::AddIOp>(loc, windowBegin, iv);
+              Value clamped = builder.create<arith::MinSIOp>(
+                  loc, builder.create<arith::MaxSIOp>(loc, srcRow, c0),
+                  lastRow);
+              Value bufferVec = builder.create<vector::LoadOp>(
+                  loc, vecTy, buffer, ValueRange{clamped, ivs[1]});
+              if (constantPadding) {
+                Value inImage = builder.create<arith::CmpIOp>(
+                    loc, arith::CmpIPredicate::eq, srcRow, clamped);
+                bufferVec = builder.create<arith::SelectOp>(
+                    loc, inImage, bufferVec, paddedRowVec);
+              }
+              Value acc = insertFMAOp(builder, loc, vecTy, bufferVec, tapVec,
+                                      iargs[0]);
+              builder.create<scf::YieldOp>(loc, acc);
+            });
+        Value resVec = taps.getResult(0);
+
+        // Accumulate into the output, masking the last block of a row.
+        Value blockEnd = builder.create<arith::AddIOp>(loc, ivs[1], strideVal);
+        Value fullBlock = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::sle, blockEnd, inputCol);
+        builder.create<scf::IfOp>(
+            loc, fullBlock,
+            [&](OpBuilder &builder, Location loc) {
+              Value outputVec = builder.create<vector::LoadOp>(
+                  loc, vecTy, output, ValueRange{ivs[0], ivs[1]});
+              Value sum = addElems(builder, loc, outputVec, resVec);
+              builder.create<vector::StoreOp>(loc, sum, output,
+                                              ValueRange{ivs[0], ivs[1]});
+              builder.create<scf::YieldOp>(loc);
+            },
+            [&](OpBuilder &builder, Location loc) {
+              Value tailMask =
+                  tailMaskCreator(builder, loc, inputCol, ivs[1], maskTy);
+              Value outputVec = builder.create<vector::MaskedLoadOp>(
+                  loc, vecTy, output, ValueRange{ivs[0], ivs[1]}, tailMask,
+                  zeroVec);
+              Value sum = addElems(builder, loc, outputVec, resVec);
+              builder.create<vector::MaskedStoreOp>(
+                  loc, output, ValueRange{ivs[0], ivs[1]}, tailMask, sum);
+              builder.create<scf::YieldOp>(loc);
+            });
+      });
+
+  builder.create<memref::DeallocOp>(loc, buffer);
+}
+
+// Bounding box of the non-zero entries of `kernel`, and whether every entry
+// inside of it is non-zero.
+StructuringRectangle detectStructuringRectangle(OpBuilder &builder,
+                                                Location loc, Value kernel,
+                                                Value centerX, Value centerY,
+                                                Type elemTy) {
+  MLIRContext *ctx = builder.getContext();
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value cMinus1 = builder.create<arith::ConstantIndexOp>(loc, -1);
+  Value kernelRow = builder.create<memref::DimOp>(loc, kernel, c0);
+  Value kernelCol = builder.create<memref::DimOp>(loc, kernel, c1);
+  Value zeroElem = insertZeroConstantOp(ctx, builder, loc, elemTy);
+
+  // Iteration arguments: first row, last row, first column, last column and
+  // number of non-zero entries.
+  auto rows = builder.create<scf::ForOp>(
+      loc, c0, kernelRow, c1,
+      ValueRange{kernelRow, cMinus1, kernelCol, cMinus1, c0},
+      [&](OpBuilder &builder, Location loc, Value i, ValueRange rowArgs) {
+        auto cols = builder.create<scf::ForOp>(
+            loc, c0, kernelCol, c1, rowArgs,
+            [&](OpBuilder &builder, Location loc, Value j, ValueRange args) {
+              Value kernelValue =
+                  builder.create<memref::LoadOp>(loc, kernel, ValueRange{i, j});
+              Value nonZero =
+                  zeroCond(builder, loc, elemTy, kernelValue, zeroElem);
+              auto update = [&](Value current, Value candidate) -> Value {
+                return builder.create<arith::SelectOp>(loc, nonZero, candidate,
+                                                       current);
+              };
+              Value rowMin = update(
+                  args[0], builder.create<arith::MinSIOp>(loc, args[0], i));
+              Value rowMax = update(
+                  args[1], builder.create<arith::MaxSIOp>(loc, args[1], i));
+              Value colMin = update(
+                  args[2], builder.create<arith::MinSIOp>(loc, args[2], j));
+              Value colMax = update(
+                  args[3], builder.create<arith::MaxSIOp>(loc, args[3], j));
+              Value count = update(
+                  args[4], builder.create<arith::AddIOp>(loc, args[4], c1));
+              builder.create<scf::YieldOp>(
+                  loc, ValueRange{rowMin, rowMax, colMin, colMax, count});
+            });
+        builder.create<scf::YieldOp>(loc, cols.getResults());
+      });
+
+  StructuringRectangle rect;
+  rect.height = builder.create<arith::AddIOp>(
+      loc,
+      builder.create<arith::SubIOp>(loc, rows.getResult(1), rows.getResult(0)),
+      c1);
+  rect.width = builder.create<arith::AddIOp>(
+      loc,
+      builder.create<arith::SubIOp>(loc, rows.getResult(3), rows.getResult(2)),
+      c1);
+  rect.anchorX = builder.create<arith::SubIOp>(loc, centerX, rows.getResult(2));
+  rect.anchorY = builder.create<arith::SubIOp>(loc, centerY, rows.getResult(0));
+
+  Value area = builder.create<arith::MulIOp>(loc, rect.height, rect.width);
+  Value notEmpty = builder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::sgt, rows.getResult(4), c0);
+  Value full = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
+                                             rows.getResult(4), area);
+  rect.isRectangle = builder.create<arith::AndIOp>(loc, notEmpty, full);
+  return rect;
+}
+
+// Element wise minimum (erosion) or maximum (dilation) of two vectors.
+static Value combineMorph(OpBuilder &builder, Location loc, VectorType type,
+                          Value lhs, Value rhs, DIP_OP op) {
+  Value takeRhs = createCompVecMorph(builder, loc, type, lhs, rhs, op);
+  return builder.create<arith::SelectOp>(loc, takeRhs, rhs, lhs);
+}
+
+// dst[c][r] = src[r][c] for r < rows, c < cols.
+static void transpose2D(OpBuilder &builder, Location loc, Value src, Value dst,
+                        Value rows, Value cols, int64_t rowGrain) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  SmallVector<Value, 8> lowerBounds(2, c0);
+  SmallVector<Value, 8> upperBounds{rows, cols};
+  SmallVector<int64_t, 8> steps{1, 1};
+  buildRowBandLoopNest(
+      builder, loc, lowerBounds, upperBounds, steps, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value elem = builder.create<memref::LoadOp>(
+            loc, src, ValueRange{ivs[0], ivs[1]});
+        builder.create<memref::StoreOp>(loc, elem, dst,
+                                        ValueRange{ivs[1], ivs[0]});
+      });
+}
+
+// Erosion / dilation of the rows of `src` with a window of `window` rows
+// starting `anchor` rows above the output row, using the van Herk/Gil-Werman
+// algorithm: the extended rows are cut into blocks of `window`, and every
+// window is the combination of a suffix of one block and a prefix of the next
+// one. That takes three comparisons per element whatever the window size.
+// Columns are processed a vector at a time, so `src` needs `cols` rounded up
+// to whole vectors. Rows outside of `src` are read as `constantVec` (constant
+// padding) or extrapolated from the rows of `src` as the boundary option does.
+static void vanHerkGilWerman(
+    OpBuilder &builder, Location loc, Value src, Value srcRows, Value cols,
+    Value window, Value anchor, Value constantVec,
+    buddy::dip::BoundaryOption boundaryOption, VectorType vecTy, DIP_OP op,
+    int64_t stride, int64_t rowGrain,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value)> store) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value windowLast = builder.create<arith::SubIOp>(loc, window, c1);
+  Value extRows = builder.create<arith::AddIOp>(loc, srcRows, windowLast);
+  MemRefType suffixTy =
+      MemRefType::get({ShapedType::kDynamic, stride}, vecTy.getElementType());
+
+  SmallVector<Value, 8> lowerBounds{c0};
+  SmallVector<Value, 8> upperBounds{cols};
+  SmallVector<int64_t, 8> steps{stride};
+  buildRowBandLoopNest(
+      builder, loc, lowerBounds, upperBounds, steps, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value col = ivs[0];
+        // Row `t` of the source extended by the boundary rows.
+        auto loadExtended = [&](OpBuilder &builder, Location loc,
+                                Value t) -> Value {
+          Value srcRow = builder.create<arith::SubIOp>(loc, t, anchor);
+          Value extrapolated =
+              extrapolateIndex(builder, loc, srcRow, srcRows, boundaryOption);
+          Value rowVec = builder.create<vector::LoadOp>(
+              loc, vecTy, src, ValueRange{extrapolated, col});
+          if (boundaryOption == buddy::dip::BoundaryOption::ConstantPadding) {
+            Value inside = builder.create<arith::CmpIOp>(
+                loc, arith::CmpIPredicate::eq, srcRow, extrapolated);
+            rowVec = builder.create<arith::SelectOp>(loc, inside, rowVec,
+                                                     constantVec);
+          }
+          return rowVec;
+        };
+
+        Value suffix = builder.create<memref::AllocOp>(loc, suffixTy,
+                                                       ValueRange{extRows});
+
+        // Suffixes, restarting at the last row of every block.
+        builder.create<scf::ForOp>(
+            loc, c0, extRows, c1, ValueRange{constantVec},
+            [&](OpBuilder &builder, Location loc, Value iv, ValueRange iargs) {
+              Value t = builder.create<arith::SubIOp>(
+                  loc, builder.create<arith::SubIOp>(loc, extRows, c1), iv);
+              Value rowVec = loadExtended(builder, loc, t);
+              Value blockPos = builder.create<arith::RemUIOp>(
+                  loc, builder.create<arith::AddIOp>(loc, t, c1), window);
+              Value blockEnd = builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::eq, blockPos, c0);
+              Value lastExtRow = builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::eq, iv, c0);
+              Value restart =
+                  builder.create<arith::OrIOp>(loc, blockEnd, lastExtRow);
+              Value suffixVec = builder.create<arith::SelectOp>(
+                  loc, restart, rowVec,
+                  combineMorph(builder, loc, vecTy, iargs[0], rowVec, op));
+              builder.create<vector::StoreOp>(loc, suffixVec, suffix,
+                                              ValueRange{t, c0});
+              builder.create<scf::YieldOp>(loc, suffixVec);
+            });
+
+        // Prefixes, restarting at the first row of every block. The window of
+        // output row i ends at extended row i + window - 1.
+        builder.create<scf::ForOp>(
+            loc, c0, extRows, c1, ValueRange{constantVec},
+            [&](OpBuilder &builder, Location loc, Value t, ValueRange iargs) {
+              Value rowVec = loadExtended(builder, loc, t);
+              Value blockPos = builder.create<arith::RemUIOp>(loc, t, window);
+              Value blockStart = builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::eq, blockPos, c0);
+              Value prefixVec = builder.create<arith::SelectOp>(
+                  loc, blockStart, rowVec,
+                  combineMorph(builder, loc, vecTy, iargs[0], rowVec, op));
+
+              Value row = builder.create<arith::SubIOp>(loc, t, windowLast);
+              Value ready = builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::sge, row, c0);
+              builder.create<scf::IfOp>(
+                  loc, ready, [&](OpBuilder &builder, Location loc) {
+                    Value suffixVec = builder.create<vector::LoadOp>(
+                        loc, vecTy, suffix, ValueRange{row, c0});
+                    store(builder, loc, row, col,
+                          combineMorph(builder, loc, vecTy, suffixVec,
+                                       prefixVec, op));
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc, prefixVec);
+            });
+
+        builder.create<memref::DeallocOp>(loc, suffix);
+      });
+}
+
+// Erosion / dilation of `input` with the flat rectangle `rect`. The horizontal
+// pass runs on the transposed image, so both passes are vectorized across the
+// contiguous dimension. `store` receives the result a vector at a time.
+void rectangularMorphology(
+    OpBuilder &builder, Location loc, Value input, Value rows, Value cols,
+    const StructuringRectangle &rect, Value constantValue, Type elemTy,
+    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op,
+    int64_t rowGrain,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value)> store) {
+  MLIRContext *ctx = builder.getContext();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  Value constantVec =
+      builder.create<vector::BroadcastOp>(loc, vecTy, constantValue);
+
+  // Buffers are padded to whole vectors along their contiguous dimension.
+  AffineExpr d0;
+  bindDims(ctx, d0);
+  AffineMap roundUp =
+      AffineMap::get(1, 0, {d0.ceilDiv(stride) * stride}, ctx);
+  Value paddedRow =
+      builder.create<affine::AffineApplyOp>(loc, roundUp, ValueRange{rows});
+  Value paddedCol =
+      builder.create<affine::AffineApplyOp>(loc, roundUp, ValueRange{cols});
+  MemRefType bufferTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  Value transposed = builder.create<memref::AllocOp>(
+      loc, bufferTy, ValueRange{cols, paddedRow});
+  Value horizontal = builder.create<memref::AllocOp>(
+      loc, bufferTy, ValueRange{cols, paddedRow});
+  Value rowsDone = builder.create<memref::AllocOp>(
+      loc, bufferTy, ValueRange{rows, paddedCol});
+
+  // Horizontal pass: rows of the transposed image are image columns.
+  transpose2D(builder, loc, input, transposed, rows, cols, rowGrain);
+  vanHerkGilWerman(
+      builder, loc, transposed, cols, rows, rect.width, rect.anchorX,
+      constantVec, boundaryOptionAttr, vecTy, op, stride, rowGrain,
+      [&](OpBuilder &builder, Location loc, Value row, Value col, Value vec) {
+        builder.create<vector::StoreOp>(loc, vec, horizontal,
+                                        ValueRange{row, col});
+      });
+  transpose2D(builder, loc, horizontal, rowsDone, cols, rows, rowGrain);
+
+  // Vertical pass.
+  vanHerkGilWerman(builder, loc, rowsDone, rows, cols, rect.height,
+                   rect.anchorY, constantVec, boundaryOptionAttr, vecTy, op,
+                   stride, rowGrain, store);
+
+  builder.create<memref::DeallocOp>(loc, transposed);
+  builder.create<memref::DeallocOp>(loc, horizontal);
+  builder.create<memref::DeallocOp>(loc, rowsDone);
+}
+
+// Rows of output computed per band by the banded morphology, unless the halo
+// of the chains asks for more.
+static constexpr int64_t kMorphologyBandRows = 32;
+
+// The neutral element of erosion (the largest value of `elemTy`) or dilation
+// (the lowest one).
+static Value insertMorphIdentity(OpBuilder &builder, Location loc, Type elemTy,
+                                 DIP_OP op) {
+  MLIRContext *ctx = builder.getContext();
+  bool erosion = op == DIP_OP::EROSION_2D;
+  auto bitWidth = elemTy.getIntOrFloatBitWidth();
+  if (elemTy.isF32() || elemTy.isF64()) {
+    FloatType type =
+        elemTy.isF32() ? FloatType::getF32(ctx) : FloatType::getF64(ctx);
+    auto inf = APFloat::getInf(type.getFloatSemantics(), !erosion);
+    return builder.create<arith::ConstantFloatOp>(loc, inf, type);
+  }
+  APInt bound = erosion ? APInt::getSignedMaxValue(bitWidth)
+                        : APInt::getSignedMinValue(bitWidth);
+  return builder.create<arith::ConstantOp>(
+      loc, builder.getIntegerAttr(elemTy, bound));
+}
+
+static Value insertSubOp(OpBuilder &builder, Location loc, Type elemTy,
+                         Value lhs, Value rhs) {
+  if (elemTy.isF32() || elemTy.isF64())
+    return builder.create<arith::SubFOp>(loc, lhs, rhs);
+  return builder.create<arith::SubIOp>(loc, lhs, rhs);
+}
+
+// Writes `vec`, the result of a chain for columns [col, col + stride) of
+// output row `row`, to `output` as `epilogue` says. Lanes past `cols` are
+// masked off.
+static void storeMorphologyResult(OpBuilder &builder, Location loc, Value vec,
+                                  Value input, Value output, Value row,
+                                  Value col, Value cols, Type elemTy,
+                                  int64_t stride, MORPH_EPILOGUE epilogue) {
+  MLIRContext *ctx = builder.getContext();
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+
+  auto result = [&](OpBuilder &builder, Location loc,
+                    function_ref<Value(Value)> load) -> Value {
+    switch (epilogue) {
+    case MORPH_EPILOGUE::STORE:
+      return vec;
+    case MORPH_EPILOGUE::SUBTRACT_FROM_INPUT:
+      return insertSubOp(builder, loc, elemTy, load(input), vec);
+    case MORPH_EPILOGUE::SUBTRACT_INPUT:
+      return insertSubOp(builder, loc, elemTy, vec, load(input));
+    case MORPH_EPILOGUE::SUBTRACT_OUTPUT:
+      return insertSubOp(builder, loc, elemTy, vec, load(output));
+    }
+    llvm_unreachable("unknown morphology epilogue");
+  };
+
+  Value blockEnd = builder.create<arith::AddIOp>(loc, col, strideVal);
+  Value fullBlock = builder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::sle, blockEnd, cols);
+  builder.create<scf::IfOp>(
+      loc, fullBlock,
+      [&](OpBuilder &builder, Location loc) {
+        Value resVec = result(builder, loc, [&](Value memref) -> Value {
+          return builder.create<vector::LoadOp>(loc, vecTy, memref,
+                                                ValueRange{row, col});
+        });
+        builder.create<vector::StoreOp>(loc, resVec, output,
+                                        ValueRange{row, col});
+        builder.create<scf::YieldOp>(loc);
+      },
+      [&](OpBuilder &builder, Location loc) {
+        Value tailMask = tailMaskCreator(builder, loc, cols, col, maskTy);
+        Value zeroElem = insertZeroConstantOp(ctx, builder, loc, elemTy);
+        Value zeroVec =
+            builder.create<vector::BroadcastOp>(loc, vecTy, zeroElem);
+        Value resVec = result(builder, loc, [&](Value memref) -> Value {
+          return builder.create<vector::MaskedLoadOp>(
+              loc, vecTy, memref, ValueRange{row, col}, tailMask, zeroVec);
+        });
+        builder.create<vector::MaskedStoreOp>(
+            loc, output, ValueRange{row, col}, tailMask, resVec);
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Chains of morphologyPipeline for a rectangular structuring element. Every
+// application runs over the whole image, reading the previous one in place, so
+// a chain needs no buffer besides `output` unless its epilogue reads `output`.
+static void rectangularPipeline(OpBuilder &builder, Location loc, Value input,
+                                Value output, const StructuringRectangle &rect,
+                                Value iterations, Value constantValue,
+                                Type elemTy,
+                                buddy::dip::BoundaryOption boundaryOptionAttr,
+                                int64_t stride, int64_t rowGrain,
+                                ArrayRef<MorphologyChain> chains) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  MemRefType imageTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  Value source = builder.create<memref::CastOp>(loc, imageTy, input);
+
+  for (const MorphologyChain &chain : chains) {
+    bool ownBuffer = chain.epilogue == MORPH_EPILOGUE::SUBTRACT_OUTPUT;
+    Value work;
+    if (ownBuffer)
+      work = builder.create<memref::AllocOp>(loc, imageTy,
+                                             ValueRange{inputRow, inputCol});
+    else
+      work = builder.create<memref::CastOp>(loc, imageTy, output);
+    Value stageCount =
+        builder.create<arith::ConstantIndexOp>(loc, chain.stages.size());
+    Value lastApplication = builder.create<arith::SubIOp>(
+        loc, builder.create<arith::MulIOp>(loc, iterations, stageCount), c1);
+
+    for (size_t stageIdx = 0; stageIdx < chain.stages.size(); ++stageIdx) {
+      DIP_OP op = chain.stages[stageIdx];
+      Value stageBegin = builder.create<arith::MulIOp>(
+          loc, iterations,
+          builder.create<arith::ConstantIndexOp>(loc, stageIdx));
+      builder.create<scf::ForOp>(
+          loc, c0, iterations, c1, std::nullopt,
+          [&](OpBuilder &builder, Location loc, Value iv, ValueRange) {
+            Value application =
+                builder.create<arith::AddIOp>(loc, stageBegin, iv);
+            Value isFirst = builder.create<arith::CmpIOp>(
+                loc, arith::CmpIPredicate::eq, application, c0);
+            Value isLast = builder.create<arith::CmpIOp>(
+                loc, arith::CmpIPredicate::eq, application, lastApplication);
+            Value src =
+                builder.create<arith::SelectOp>(loc, isFirst, source, work);
+            rectangularMorphology(
+                builder, loc, src, inputRow, inputCol, rect, constantValue,
+                elemTy, boundaryOptionAttr, stride, op, rowGrain,
+                [&](OpBuilder &builder, Location loc, Value row, Value col,
+                    Value vec) {
+                  builder.create<scf::IfOp>(
+                      loc, isLast,
+                      [&](OpBuilder &builder, Location loc) {
+                        storeMorphologyResult(builder, loc, vec, input,
+                                              output, row, col, inputCol,
+                                              elemTy, stride, chain.epilogue);
+                        builder.create<scf::YieldOp>(loc);
+                      },
+                      [&](OpBuilder &builder, Location loc) {
+                        storeMorphologyResult(builder, loc, vec, input, work,
+                                              row, col, inputCol, elemTy,
+                                              stride, MORPH_EPILOGUE::STORE);
+                        builder.create<scf::YieldOp>(loc);
+                      });
+                });
+            builder.create<scf::YieldOp>(loc);
+          });
+    }
+
+    if (ownBuffer)
+      builder.create<memref::DeallocOp>(loc, work);
+  }
+}
+
+// Whether the boundary option extrapolates pixels from anywhere in the image
+// (reflect and wrap padding) rather than from its edge.
+static bool isPeriodicBoundary(buddy::dip::BoundaryOption boundaryOption) {
+  return boundaryOption != buddy::dip::BoundaryOption::ConstantPadding &&
+         boundaryOption != buddy::dip::BoundaryOption::ReplicatePadding;
+}
+
+// Extrapolates the rows and columns of a band buffer that lie outside of the
+// image. Row `base` + j of `buffer` holds image row `offset` + j for j <
+// `height`, and column i holds image column i - `centerX`; rows [validBegin,
+// validEnd) of the image are already filled in. With reflect and wrap padding
+// the rows above and below the image are read from `source` if given, and
+// otherwise from the filled rows, which then have to hold the whole image.
+static void padMorphologyBand(OpBuilder &builder, Location loc, Value buffer,
+                              Value source, Value base, Value offset,
+                              Value height, Value validBegin, Value validEnd,
+                              Value rows, Value cols, Value centerX,
+                              Value width, Value constantValue,
+                              buddy::dip::BoundaryOption boundaryOption) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value rightBegin = builder.create<arith::AddIOp>(loc, centerX, cols);
+  Value lastCol = builder.create<arith::SubIOp>(loc, rightBegin, c1);
+  Value firstValid = builder.create<arith::SubIOp>(loc, validBegin, offset);
+  Value endValid = builder.create<arith::SubIOp>(loc, validEnd, offset);
+  bool constantPadding =
+      boundaryOption == buddy::dip::BoundaryOption::ConstantPadding;
+
+  if (isPeriodicBoundary(boundaryOption)) {
+    // Image column of buffer column i.
+    auto imageCol = [&](OpBuilder &builder, Location loc, Value i) -> Value {
+      return extrapolateIndex(builder, loc,
+                              builder.create<arith::SubIOp>(loc, i, centerX),
+                              cols, boundaryOption);
+    };
+    auto copyCols = [&](OpBuilder &builder, Location loc, Value row,
+                        Value begin, Value end) {
+      builder.create<scf::ForOp>(
+          loc, begin, end, c1, std::nullopt,
+          [&](OpBuilder &builder, Location loc, Value i, ValueRange) {
+            Value srcCol = builder.create<arith::AddIOp>(
+                loc, centerX, imageCol(builder, loc, i));
+            Value elem = builder.create<memref::LoadOp>(
+                loc, buffer, ValueRange{row, srcCol});
+            builder.create<memref::StoreOp>(loc, elem, buffer,
+                                            ValueRange{row, i});
+            builder.create<scf::YieldOp>(loc);
+          });
+    };
+
+    // Columns left and right of the image.
+    builder.create<scf::ForOp>(
+        loc, firstValid, endValid, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value j, ValueRange) {
+          Value row = builder.create<arith::AddIOp>(loc, base, j);
+          copyCols(builder, loc, row, c0, centerX);
+          copyCols(builder, loc, row, rightBegin, width);
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    // Rows above and below the image.
+    auto mirrorRows = [&](Value begin, Value end) {
+      builder.create<scf::ForOp>(
+          loc, begin, end, c1, std::nullopt,
+          [&](OpBuilder &builder, Location loc, Value j, ValueRange) {
+            Value row = builder.create<arith::AddIOp>(loc, base, j);
+            Value imageRow = extrapolateIndex(
+                builder, loc, builder.create<arith::AddIOp>(loc, offset, j),
+                rows, boundaryOption);
+            Value srcRow = builder.create<arith::AddIOp>(
+                loc, base,
+                builder.create<arith::SubIOp>(loc, imageRow, offset));
+            builder.create<scf::ForOp>(
+                loc, c0, width, c1, std::nullopt,
+                [&](OpBuilder &builder, Location loc, Value i, ValueRange) {
+                  Value col = imageCol(builder, loc, i);
+                  Value elem;
+                  if (source)
+                    elem = builder.create<memref::LoadOp>(
+                        loc, source, ValueRange{imageRow, col});
+                  else
+                    elem = builder.create<memref::LoadOp>(
+                        loc, buffer,
+                        ValueRange{srcRow, builder.create<arith::AddIOp>(
+                                               loc, centerX, col)});
+                  builder.create<memref::StoreOp>(loc, elem, buffer,
+                                                  ValueRange{row, i});
+                  builder.create<scf::YieldOp>(loc);
+                });
+            builder.create<scf::YieldOp>(loc);
+          });
+    };
+    mirrorRows(c0, firstValid);
+    mirrorRows(endValid, height);
+    return;
+  }
+
+  auto fillRow = [&](OpBuilder &builder, Location loc, Value row, Value begin,
+                     Value end, Value elem) {
+    builder.create<scf::ForOp>(
+        loc, begin, end, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value i, ValueRange) {
+          builder.create<memref::StoreOp>(loc, elem, buffer,
+                                          ValueRange{row, i});
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+
+  // Columns left and right of the image.
+  builder.create<scf::ForOp>(
+      loc, firstValid, endValid, c1, std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value j, ValueRange) {
+        Value row = builder.create<arith::AddIOp>(loc, base, j);
+        Value left = constantValue, right = constantValue;
+        if (!constantPadding) {
+          left = builder.create<memref::LoadOp>(loc, buffer,
+                                                ValueRange{row, centerX});
+          right = builder.create<memref::LoadOp>(loc, buffer,
+                                                 ValueRange{row, lastCol});
+        }
+        fillRow(builder, loc, row, c0, centerX, left);
+        fillRow(builder, loc, row, rightBegin, width, right);
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  // Rows above and below the image.
+  auto padRows = [&](Value begin, Value end, Value edge) {
+    builder.create<scf::ForOp>(
+        loc, begin, end, c1, std::nullopt,
+        [&](OpBuilder &builder, Location loc, Value j, ValueRange) {
+          Value row = builder.create<arith::AddIOp>(loc, base, j);
+          if (constantPadding) {
+            fillRow(builder, loc, row, c0, width, constantValue);
+          } else {
+            Value edgeRow = builder.create<arith::AddIOp>(loc, base, edge);
+            builder.create<scf::ForOp>(
+                loc, c0, width, c1, std::nullopt,
+                [&](OpBuilder &builder, Location loc, Value i, ValueRange) {
+                  Value elem = builder.create<memref::LoadOp>(
+                      loc, buffer, ValueRange{edgeRow, i});
+                  builder.create<memref::StoreOp>(loc, elem, buffer,
+                                                  ValueRange{row, i});
+                  builder.create<scf::YieldOp>(loc);
+                });
+          }
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+  padRows(c0, firstValid, firstValid);
+  padRows(endValid, height, builder.create<arith::SubIOp>(loc, endValid, c1));
+}
+
+// Band geometry of bandedPipeline. It is computed before morphologyPipeline
+// enters any region, so that `count` is a valid affine symbol for the loop over
+// the bands.
+struct MorphologyBands {
+  // Output rows per band.
+  Value rows;
+  // Rows and columns of one of the two halves of a band buffer.
+  Value bufferRows;
+  Value bufferCols;
+  // Number of bands.
+  Value count;
+};
+
+static MorphologyBands
+planMorphologyBands(OpBuilder &builder, Location loc, Value input, Value kernel,
+                    Value centerX, Value iterations,
+                    buddy::dip::BoundaryOption boundaryOption, int64_t stride,
+                    ArrayRef<MorphologyChain> chains) {
+  MLIRContext *ctx = builder.getContext();
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value kernelRow = builder.create<memref::DimOp>(loc, kernel, c0);
+  Value kernelCol = builder.create<memref::DimOp>(loc, kernel, c1);
+
+  // Every application but the last widens the band by kernelRow - 1 rows.
+  size_t maxStages = 0;
+  for (const MorphologyChain &chain : chains)
+    maxStages = std::max(maxStages, chain.stages.size());
+  Value maxApplications = builder.create<arith::MulIOp>(
+      loc, iterations, builder.create<arith::ConstantIndexOp>(loc, maxStages));
+  Value windowRows = builder.create<arith::SubIOp>(loc, kernelRow, c1);
+  Value halo = builder.create<arith::MulIOp>(
+      loc, builder.create<arith::SubIOp>(loc, maxApplications, c1),
+      windowRows);
+
+  MorphologyBands bands;
+  bands.rows = builder.create<arith::MaxSIOp>(
+      loc, builder.create<arith::ConstantIndexOp>(loc, kMorphologyBandRows),
+      builder.create<arith::MulIOp>(loc, halo, c2));
+  if (isPeriodicBoundary(boundaryOption)) {
+    // Reflect and wrap padding take the rows above and below the image from
+    // anywhere in it, which only the first application can read from the
+    // input, so longer chains run on a single band holding the whole image.
+    Value chained = builder.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::sgt, maxApplications, c1);
+    bands.rows = builder.create<arith::SelectOp>(
+        loc, chained,
+        builder.create<arith::MaxSIOp>(loc, bands.rows, inputRow), bands.rows);
+  }
+  bands.bufferRows = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::AddIOp>(loc, bands.rows, halo), windowRows);
+
+  // Columns: centerX on the left, the image rounded up to whole vectors, and
+  // kernelCol on the right, so that every window is an unmasked vector load.
+  AffineExpr d0;
+  bindDims(ctx, d0);
+  AffineMap roundUp =
+      AffineMap::get(1, 0, {d0.ceilDiv(stride) * stride}, ctx);
+  Value paddedCol =
+      builder.create<affine::AffineApplyOp>(loc, roundUp, ValueRange{inputCol});
+  bands.bufferCols = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::AddIOp>(loc, centerX, paddedCol), kernelCol);
+  bands.count = builder.create<arith::CeilDivUIOp>(loc, inputRow, bands.rows);
+  return bands;
+}
+
+// Chains of morphologyPipeline for any structuring element, in bands of output
+// rows. Application s of a chain with n applications computes the band
+// widened by n - 1 - s halos, from a buffer holding the previous application
+// plus the rows and columns its window reaches. Two such buffers take turns,
+// so nothing but the epilogue of the last application touches a full image.
+static void bandedPipeline(OpBuilder &builder, Location loc, Value input,
+                           Value kernel, Value output, Value centerX,
+                           Value centerY, Value iterations,
+                           Value constantValue, Type elemTy,
+                           buddy::dip::BoundaryOption boundaryOption,
+                           int64_t stride, int64_t rowGrain,
+                           const MorphologyBands &bands,
+                           ArrayRef<MorphologyChain> chains) {
+  MLIRContext *ctx = builder.getContext();
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value kernelRow = builder.create<memref::DimOp>(loc, kernel, c0);
+  Value kernelCol = builder.create<memref::DimOp>(loc, kernel, c1);
+  Value zeroElem = insertZeroConstantOp(ctx, builder, loc, elemTy);
+  Value bandRows = bands.rows;
+  Value bufferRows = bands.bufferRows;
+  Value bufferCol = bands.bufferCols;
+
+  VectorType vecTy = VectorType::get({stride}, elemTy);
+  VectorType maskTy = VectorType::get({stride}, builder.getI1Type());
+  MemRefType bufferTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+
+  // A window reaches centerY rows above its output row and kernelRow - 1 -
+  // centerY below it.
+  Value windowRows = builder.create<arith::SubIOp>(loc, kernelRow, c1);
+  Value below = builder.create<arith::SubIOp>(loc, windowRows, centerY);
+
+  auto storeRow = [&](OpBuilder &builder, Location loc, Value vec,
+                      Value memref, Value row, Value memrefCol, Value col) {
+    Value blockEnd = builder.create<arith::AddIOp>(loc, col, strideVal);
+    Value fullBlock = builder.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::sle, blockEnd, inputCol);
+    builder.create<scf::IfOp>(
+        loc, fullBlock,
+        [&](OpBuilder &builder, Location loc) {
+          builder.create<vector::StoreOp>(loc, vec, memref,
+                                          ValueRange{row, memrefCol});
+          builder.create<scf::YieldOp>(loc);
+        },
+        [&](OpBuilder &builder, Location loc) {
+          Value tailMask =
+              tailMaskCreator(builder, loc, inputCol, col, maskTy);
+          builder.create<vector::MaskedStoreOp>(
+              loc, memref, ValueRange{row, memrefCol}, tailMask, vec);
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+
+  SmallVector<Value, 8> lowerBounds{c0};
+  SmallVector<Value, 8> upperBounds{bands.count};
+  SmallVector<int64_t, 8> steps{1};
+  buildRowBandLoopNest(
+      builder, loc, lowerBounds, upperBounds, steps, rowGrain,
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value bandBegin = builder.create<arith::MulIOp>(loc, ivs[0], bandRows);
+        Value bandEnd = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, bandBegin, bandRows),
+            inputRow);
+        // Both halves of the buffer, the first one at row 0 and the second
+        // one at row bufferRows.
+        Value buffer = builder.create<memref::AllocOp>(
+            loc, bufferTy,
+            ValueRange{builder.create<arith::MulIOp>(loc, bufferRows, c2),
+                       bufferCol});
+
+        for (const MorphologyChain &chain : chains) {
+          Value stageCount =
+              builder.create<arith::ConstantIndexOp>(loc, chain.stages.size());
+          Value lastApplication = builder.create<arith::SubIOp>(
+              loc, builder.create<arith::MulIOp>(loc, iterations, stageCount),
+              c1);
+
+          // Output rows [begin, end) of application `application`.
+          auto rowRange = [&](OpBuilder &builder, Location loc,
+                              Value application) -> std::pair<Value, Value> {
+            Value remaining = builder.create<arith::SubIOp>(
+                loc, lastApplication, application);
+            Value begin = builder.create<arith::MaxSIOp>(
+                loc,
+                builder.create<arith::SubIOp>(
+                    loc, bandBegin,
+                    builder.create<arith::MulIOp>(loc, remaining, centerY)),
+                c0);
+            Value end = builder.create<arith::MinSIOp>(
+                loc,
+                builder.create<arith::AddIOp>(
+                    loc, bandEnd,
+                    builder.create<arith::MulIOp>(loc, remaining, below)),
+                inputRow);
+            return {begin, end};
+          };
+
+          // Source of the first application: the input rows it reads.
+          Value firstBegin, firstEnd;
+          std::tie(firstBegin, firstEnd) = rowRange(builder, loc, c0);
+          Value offset =
+              builder.create<arith::SubIOp>(loc, firstBegin, centerY);
+          Value height = builder.create<arith::AddIOp>(
+              loc, builder.create<arith::SubIOp>(loc, firstEnd, firstBegin),
+              windowRows);
+          Value validBegin = builder.create<arith::MaxSIOp>(loc, offset, c0);
+          Value validEnd = builder.create<arith::MinSIOp>(
+              loc, builder.create<arith::AddIOp>(loc, offset, height),
+              inputRow);
+          builder.create<scf::ForOp>(
+              loc, validBegin, validEnd, c1, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value row, ValueRange) {
+                Value bufferRow =
+                    builder.create<arith::SubIOp>(loc, row, offset);
+                builder.create<scf::ForOp>(
+                    loc, c0, inputCol, strideVal, std::nullopt,
+                    [&](OpBuilder &builder, Location loc, Value col,
+                        ValueRange) {
+                      Value tailMask =
+                          tailMaskCreator(builder, loc, inputCol, col, maskTy);
+                      Value zeroVec = builder.create<vector::BroadcastOp>(
+                          loc, vecTy, zeroElem);
+                      Value rowVec = builder.create<vector::MaskedLoadOp>(
+                          loc, vecTy, input, ValueRange{row, col}, tailMask,
+                          zeroVec);
+                      Value bufferCol =
+                          builder.create<arith::AddIOp>(loc, centerX, col);
+                      storeRow(builder, loc, rowVec, buffer, bufferRow,
+                               bufferCol, col);
+                      builder.create<scf::YieldOp>(loc);
+                    });
+                builder.create<scf::YieldOp>(loc);
+              });
+          padMorphologyBand(builder, loc, buffer, input, c0, offset, height,
+                            validBegin, validEnd, inputRow, inputCol, centerX,
+                            bufferCol, constantValue, boundaryOption);
+
+          for (size_t stageIdx = 0; stageIdx < chain.stages.size();
+               ++stageIdx) {
+            DIP_OP op = chain.stages[stageIdx];
+            Value stageBegin = builder.create<arith::MulIOp>(
+                loc, iterations,
+                builder.create<arith::ConstantIndexOp>(loc, stageIdx));
+            builder.create<scf::ForOp>(
+                loc, c0, iterations, c1, std::nullopt,
+                [&](OpBuilder &builder, Location loc, Value iv, ValueRange) {
+                  Value application =
+                      builder.create<arith::AddIOp>(loc, stageBegin, iv);
+                  Value isLast = builder.create<arith::CmpIOp>(
+                      loc, arith::CmpIPredicate::eq, application,
+                      lastApplication);
+                  Value odd = builder.create<arith::RemUIOp>(loc, application,
+                                                             c2);
+                  Value srcBase =
+                      builder.create<arith::MulIOp>(loc, odd, bufferRows);
+                  Value dstBase =
+                      builder.create<arith::SubIOp>(loc, bufferRows, srcBase);
+                  Value begin, end, nextBegin, nextEnd;
+                  std::tie(begin, end) = rowRange(builder, loc, application);
+                  std::tie(nextBegin, nextEnd) = rowRange(
+                      builder, loc,
+                      builder.create<arith::AddIOp>(loc, application, c1));
+                  Value nextOffset =
+                      builder.create<arith::SubIOp>(loc, nextBegin, centerY);
+                  Value nextHeight = builder.create<arith::AddIOp>(
+                      loc,
+                      builder.create<arith::SubIOp>(loc, nextEnd, nextBegin),
+                      windowRows);
+                  // Source row of the window of output row r is
+                  // srcBase + r - begin + ky.
+                  Value srcShift =
+                      builder.create<arith::SubIOp>(loc, srcBase, begin);
+                  Value dstShift =
+                      builder.create<arith::SubIOp>(loc, dstBase, nextOffset);
+                  Value identity =
+                      insertMorphIdentity(builder, loc, elemTy, op);
+                  Value identityVec =
+                      builder.create<vector::BroadcastOp>(loc, vecTy, identity);
+
+                  builder.create<scf::ForOp>(
+                      loc, begin, end, c1, std::nullopt,
+                      [&](OpBuilder &builder, Location loc, Value row,
+                          ValueRange) {
+                        Value srcRow =
+                            builder.create<arith::AddIOp>(loc, srcShift, row);
+                        builder.create<scf::ForOp>(
+                            loc, c0, inputCol, strideVal, std::nullopt,
+                            [&](OpBuilder &builder, Location loc, Value col,
+                                ValueRange) {
+                              auto window = builder.create<scf::ForOp>(
+                                  loc, c0, kernelRow, c1,
+                                  ValueRange{identityVec},
+                                  [&](OpBuilder &builder, Location loc,
+                                      Value ky, ValueRange rowArgs) {
+                                    Value windowRow =
+                                        builder.create<arith::AddIOp>(
+                                            loc, srcRow, ky);
+                                    auto taps = builder.create<scf::ForOp>(
+                                        loc, c0, kernelCol, c1, rowArgs,
+                                        [&](OpBuilder &builder, Location loc,
+                                            Value kx, ValueRange args) {
+                                          Value kernelValue =
+                                              builder.create<memref::LoadOp>(
+                                                  loc, kernel,
+                                                  ValueRange{ky, kx});
+                                          Value nonZero =
+                                              zeroCond(builder, loc, elemTy,
+                                                       kernelValue, zeroElem);
+                                          auto acc = builder.create<scf::IfOp>(
+                                              loc, nonZero,
+                                              [&](OpBuilder &builder,
+                                                  Location loc) {
+                                                Value windowCol =
+                                                    builder.create<
+                                                        arith::AddIOp>(
+                                                        loc, col, kx);
+                                                Value tapVec = builder.create<
+                                                    vector::LoadOp>(
+                                                    loc, vecTy, buffer,
+                                                    ValueRange{windowRow,
+                                                               windowCol});
+                                                builder.create<scf::YieldOp>(
+                                                    loc,
+                                                    combineMorph(builder, loc,
+                                                                 vecTy, args[0],
+                                                                 tapVec, op));
+                                              },
+                                              [&](OpBuilder &builder,
+                                                  Location loc) {
+                                                builder.create<scf::YieldOp>(
+                                                    loc, args[0]);
+                                              });
+                                          builder.create<scf::YieldOp>(
+                                              loc, acc.getResult(0));
+                                        });
+                                    builder.create<scf::YieldOp>(
+                                        loc, taps.getResult(0));
+                                  });
+                              Value resVec = window.getResult(0);
+
+                              builder.create<scf::IfOp>(
+                                  loc, isLast,
+                                  [&](OpBuilder &builder, Location loc) {
+                                    storeMorphologyResult(
+                                        builder, loc, resVec, input, output,
+                                        row, col, inputCol, elemTy, stride,
+                                        chain.epilogue);
+                                    builder.create<scf::YieldOp>(loc);
+                                  },
+                                  [&](OpBuilder &builder, Location loc) {
+                                    Value dstRow =
+                                        builder.create<arith::AddIOp>(
+                                            loc, dstShift, row);
+                                    Value dstCol =
+                                        builder.create<arith::AddIOp>(
+                                            loc, centerX, col);
+                                    storeRow(builder, loc, resVec, buffer,
+                                             dstRow, dstCol, col);
+                                    builder.create<scf::YieldOp>(loc);
+                                  });
+                              builder.create<scf::YieldOp>(loc);
+                            });
+                        builder.create<scf::YieldOp>(loc);
+                      });
+
+                  // The next application reads this one with its halo.
+                  Value notLast = builder.create<arith::XOrIOp>(
+                      loc, isLast,
+                      builder.create<arith::ConstantIntOp>(loc, 1, 1));
+                  builder.create<scf::IfOp>(
+                      loc, notLast, [&](OpBuilder &builder, Location loc) {
+                        padMorphologyBand(builder, loc, buffer, Value(),
+                                          dstBase, nextOffset, nextHeight,
+                                          begin, end, inputRow, inputCol,
+                                          centerX, bufferCol, constantValue,
+                                          boundaryOption);
+                        builder.create<scf::YieldOp>(loc);
+                      });
+                  builder.create<scf::YieldOp>(loc);
+                });
+          }
+        }
+
+        builder.create<memref::DeallocOp>(loc, buffer);
+      });
+}
+
+// Runs `chains` on `input` and leaves the result in `output`, see the
+// declaration. Nothing is written when `iterations` is zero.
+void morphologyPipeline(OpBuilder &builder, Location loc, Value input,
+                        Value kernel, Value output, Value centerX,
+                        Value centerY, Value iterations, Value constantValue,
+                        Type elemTy,
+                        buddy::dip::BoundaryOption boundaryOptionAttr,
+                        int64_t stride, int64_t rowGrain,
+                        ArrayRef<MorphologyChain> chains) {
+  MorphologyBands bands =
+      planMorphologyBands(builder, loc, input, kernel, centerX, iterations,
+                          boundaryOptionAttr, stride, chains);
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value anyIteration = builder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::sgt, iterations, c0);
+
+  builder.create<scf::IfOp>(
+      loc, anyIteration, [&](OpBuilder &builder, Location loc) {
+        StructuringRectangle rect = detectStructuringRectangle(
+            builder, loc, kernel, centerX, centerY, elemTy);
+        builder.create<scf::IfOp>(
+            loc, rect.isRectangle,
+            [&](OpBuilder &builder, Location loc) {
+              rectangularPipeline(builder, loc, input, output, rect,
+                                  iterations, constantValue, elemTy,
+                                  boundaryOptionAttr, stride, rowGrain,
+                                  chains);
+              builder.create<scf::YieldOp>(loc);
+            },
+            [&](OpBuilder &builder, Location loc) {
+              bandedPipeline(builder, loc, input, kernel, output, centerX,
+                             centerY, iterations, constantValue, elemTy,
+                             boundaryOptionAttr, stride, rowGrain, bands,
+                             chains);
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+void correlationFFT2D(OpBuilder &builder, Location loc, Value input,
+                      Value kernelSpectrumReal, Value kernelSpectrumImag,
+                      Value rowTwiddles, Value colTwiddles, Value output,
+                      Value strideX, Value strideY, int64_t stride) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+
+  FloatType f32 = builder.getF32Type();
+  VectorType vectorTy32 = VectorType::get({stride}, f32);
+  MemRefType containerTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, f32);
+  SmallVector<int64_t, 8> steps(2, 1);
+
+  Value spectrumCol = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::DivUIOp>(loc, inputCol, c2), c1);
+  Value inputReal = builder.create<memref::AllocOp>(
+      loc, containerTy, ValueRange{inputRow, spectrumCol});
+  Value inputImag = builder.create<memref::AllocOp>(
+      loc, containerTy, ValueRange{inputRow, spectrumCol});
+
+  rfft2D(builder, loc, input, inputReal, inputImag, rowTwiddles, colTwiddles,
+         inputRow, inputCol, c0, c1);
+  vector2DMemRefMultiply(builder, loc, inputReal, inputImag,
+                         kernelSpectrumReal, kernelSpectrumImag, inputReal,
+                         inputImag, inputRow, spectrumCol, c0, vectorTy32);
+
+  // Strides dividing the padded sizes allow to fold the product spectrum onto
+  // the decimated grid, so that only the smaller inverse transform has to be
+  // computed.
+  auto divides = [&](Value factor, Value size) -> Value {
+    Value rem = builder.create<arith::RemUIOp>(loc, size, factor);
+    return builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, rem,
+                                         c0);
+  };
+  Value strideArea = builder.create<arith::MulIOp>(loc, strideX, strideY);
+  Value strided = builder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::ugt, strideArea, c1);
+  Value foldCond = builder.create<arith::AndIOp>(
+      loc, strided,
+      builder.create<arith::AndIOp>(loc, divides(strideY, inputRow),
+                                    divides(strideX, inputCol)));
+
+  builder.create<scf::IfOp>(
+      loc, foldCond,
+      [&](OpBuilder &builder, Location loc) {
+        Value foldedRow =
+            builder.create<arith::DivUIOp>(loc, inputRow, strideY);
+        Value foldedCol =
+            builder.create<arith::DivUIOp>(loc, inputCol, strideX);
+        Value foldedSpectrumCol = builder.create<arith::AddIOp>(
+            loc, builder.create<arith::DivUIOp>(loc, foldedCol, c2), c1);
+        Value foldedReal = builder.create<memref::AllocOp>(
+            loc, containerTy, ValueRange{foldedRow, foldedSpectrumCol});
+        Value foldedImag = builder.create<memref::AllocOp>(
+            loc, containerTy, ValueRange{foldedRow, foldedSpectrumCol});
+        Value folded = builder.create<memref::AllocOp>(
+            loc, containerTy, ValueRange{foldedRow, foldedCol});
+
+        halfSpectrum2DFold(builder, loc, inputReal, inputImag, inputRow,
+                           inputCol, foldedReal, foldedImag, foldedRow,
+                           foldedCol, c0, c1);
+        irfft2D(builder, loc, foldedReal, foldedImag, folded, rowTwiddles,
+                colTwiddles, foldedRow, foldedCol, c0, c1);
+
+        // The folded transform is normalized by the folded sizes only.
+        Value scale = indexToF32(builder, loc, strideArea);
+        affine::buildAffineLoopNest(
+            builder, loc, ValueRange{c0, c0}, ValueRange{outputRow, outputCol},
+            steps, [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+              Value val = builder.create<memref::LoadOp>(loc, folded, ivs);
+              Value res = builder.create<arith::DivFOp>(loc, val, scale);
+              builder.create<memref::StoreOp>(loc, res, output, ivs);
+            });
+
+        for (Value buffer : {foldedReal, foldedImag, folded})
+          builder.create<memref::DeallocOp>(loc, buffer);
+        builder.create<scf::YieldOp>(loc);
+      },
+      [&](OpBuilder &builder, Location loc) {
+        Value result = builder.create<memref::AllocOp>(
+            loc, containerTy, ValueRange{inputRow, inputCol});
+        irfft2D(builder, loc, inputReal, inputImag, result, rowTwiddles,
+                colTwiddles, inputRow, inputCol, c0, c1);
+
+        affine::buildAffineLoopNest(
+            builder, loc, ValueRange{c0, c0}, ValueRange{outputRow, outputCol},
+            steps, [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+              Value row = builder.create<arith::MulIOp>(loc, ivs[0], strideY);
+              Value col = builder.create<arith::MulIOp>(loc, ivs[1], strideX);
+              Value val = builder.create<memref::LoadOp>(loc, result,
+                                                         ValueRange{row, col});
+              builder.create<memref::StoreOp>(loc, val, output, ivs);
+            });
+
+        builder.create<memref::DeallocOp>(loc, result);
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  builder.create<memref::DeallocOp>(loc, inputReal);
+  builder.create<memref::DeallocOp>(loc, inputImag);
+}
+
 } // namespace dip
 } // namespace buddy
 
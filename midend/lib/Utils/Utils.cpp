@@ -633,6 +633,489 @@ void dft2D(OpBuilder &builder, Location loc, Value container2DReal,
       });
 }
 
+// Function for filling a twiddle factor table of the FFT utilities below:
+// twiddles[0][t] = cos(2 * pi * t / length) and
+// twiddles[1][t] = -sin(2 * pi * t / length), t = 0, ..., length - 1.
+void fftTwiddles(OpBuilder &builder, Location loc, Value twiddles,
+                 Value length, Value c0, Value c1) {
+  Value minusTwoPi = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)(float)(-2.0 * M_PI), builder.getF32Type());
+  Value lengthF32 = indexToF32(builder, loc, length);
+
+  builder.create<scf::ForOp>(
+      loc, c0, length, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, Value t, ValueRange iargs) {
+        Value tF32 = indexToF32(builder, loc, t);
+        Value angle = builder.create<arith::DivFOp>(
+            loc, builder.create<arith::MulFOp>(loc, minusTwoPi, tF32),
+            lengthF32);
+        builder.create<memref::StoreOp>(
+            loc, builder.create<math::CosOp>(loc, angle), twiddles,
+            ValueRange{c0, t});
+        builder.create<memref::StoreOp>(
+            loc, builder.create<math::SinOp>(loc, angle), twiddles,
+            ValueRange{c1, t});
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Function for calculating the discrete Fourier transform of a 1D complex
+// MemRef of any length with the self-sorting (Stockham) mixed-radix algorithm.
+// Every stage splits off the smallest of the radices 2, 3 and 5 dividing the
+// remaining length, or the whole remaining length if none does, so lengths
+// with no other prime factors are the cheapest. The stages alternate between
+// the input and the scratch MemRefs, which are returned in the order holding
+// the result. The twiddle table is filled by fftTwiddles for a multiple of the
+// length, the inverse transform uses the conjugate factors and is not
+// normalized. Separate MemRefs for real and imaginary parts are expected.
+std::pair<Value, Value>
+fft1DStockham(OpBuilder &builder, Location loc, Value memRefReal,
+              Value memRefImag, Value scratchReal, Value scratchImag,
+              Value twiddles, Value length, bool inverse, Value c0, Value c1) {
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+  Value c5 = builder.create<arith::ConstantIndexOp>(loc, 5);
+  Value zero = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)0.0f, builder.getF32Type());
+  Value tableLength = builder.create<memref::DimOp>(loc, twiddles, c1);
+
+  Type indexTy = builder.getIndexType();
+  Type lineTy = memRefReal.getType();
+  SmallVector<Type, 6> stateTypes{indexTy, indexTy, lineTy,
+                                  lineTy,  lineTy,  lineTy};
+  // The state is (remaining length, stride, source real, source imaginary,
+  // destination real, destination imaginary).
+  auto stages = builder.create<scf::WhileOp>(
+      loc, stateTypes,
+      ValueRange{length, c1, memRefReal, memRefImag, scratchReal, scratchImag},
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        Value notDone = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ugt, args[0], c1);
+        builder.create<scf::ConditionOp>(loc, notDone, args);
+      },
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        Value n = args[0], s = args[1];
+        Value srcReal = args[2], srcImag = args[3];
+        Value dstReal = args[4], dstImag = args[5];
+
+        auto divides = [&](Value radix) -> Value {
+          Value rem = builder.create<arith::RemUIOp>(loc, n, radix);
+          return builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
+                                               rem, c0);
+        };
+        Value radix = builder.create<arith::SelectOp>(loc, divides(c5), c5, n);
+        radix = builder.create<arith::SelectOp>(loc, divides(c3), c3, radix);
+        radix = builder.create<arith::SelectOp>(loc, divides(c2), c2, radix);
+        Value m = builder.create<arith::DivUIOp>(loc, n, radix);
+        // exp(-2 * pi * i * t / n) is entry t * (tableLength / n) of the
+        // table.
+        Value twiddleStride =
+            builder.create<arith::DivUIOp>(loc, tableLength, n);
+
+        // dst[q + s * (radix * p + k)] is the sum over j of
+        // src[q + s * (p + j * m)] * exp(-2 * pi * i * k * (p + j * m) / n).
+        scf::buildLoopNest(
+            builder, loc, ValueRange{c0, c0, c0}, ValueRange{m, s, radix},
+            ValueRange{c1, c1, c1},
+            [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+              Value p = ivs[0], q = ivs[1], k = ivs[2];
+              auto sum = builder.create<scf::ForOp>(
+                  loc, c0, radix, c1, ValueRange{zero, zero},
+                  [&](OpBuilder &builder, Location loc, Value j,
+                      ValueRange acc) {
+                    Value offset = builder.create<arith::AddIOp>(
+                        loc, p, builder.create<arith::MulIOp>(loc, j, m));
+                    Value idx = builder.create<arith::AddIOp>(
+                        loc, q, builder.create<arith::MulIOp>(loc, s, offset));
+                    Value phase = builder.create<arith::RemUIOp>(
+                        loc, builder.create<arith::MulIOp>(loc, k, offset), n);
+                    Value t = builder.create<arith::MulIOp>(loc, phase,
+                                                            twiddleStride);
+                    Value xReal =
+                        builder.create<memref::LoadOp>(loc, srcReal, idx);
+                    Value xImag =
+                        builder.create<memref::LoadOp>(loc, srcImag, idx);
+                    Value wReal = builder.create<memref::LoadOp>(
+                        loc, twiddles, ValueRange{c0, t});
+                    Value wImag = builder.create<memref::LoadOp>(
+                        loc, twiddles, ValueRange{c1, t});
+                    if (inverse)
+                      wImag = builder.create<arith::NegFOp>(loc, wImag);
+                    std::vector<Value> prod = complexVecMulI(
+                        builder, loc, xReal, xImag, wReal, wImag);
+                    Value sumReal =
+                        builder.create<arith::AddFOp>(loc, acc[0], prod[0]);
+                    Value sumImag =
+                        builder.create<arith::AddFOp>(loc, acc[1], prod[1]);
+                    builder.create<scf::YieldOp>(loc,
+                                                 ValueRange{sumReal, sumImag});
+                  });
+              Value pos = builder.create<arith::AddIOp>(
+                  loc, builder.create<arith::MulIOp>(loc, radix, p), k);
+              Value idx = builder.create<arith::AddIOp>(
+                  loc, q, builder.create<arith::MulIOp>(loc, s, pos));
+              builder.create<memref::StoreOp>(loc, sum.getResult(0), dstReal,
+                                              idx);
+              builder.create<memref::StoreOp>(loc, sum.getResult(1), dstImag,
+                                              idx);
+            });
+
+        Value nextStride = builder.create<arith::MulIOp>(loc, s, radix);
+        builder.create<scf::YieldOp>(
+            loc, ValueRange{m, nextStride, dstReal, dstImag, srcReal, srcImag});
+      });
+
+  return {stages.getResult(2), stages.getResult(3)};
+}
+
+// Line buffers for the 1D transforms of rfft2D and irfft2D.
+struct FFT2DBuffers {
+  Value workReal, workImag, scratchReal, scratchImag;
+
+  FFT2DBuffers(OpBuilder &builder, Location loc, Value rows, Value cols) {
+    MemRefType lineTy =
+        MemRefType::get({ShapedType::kDynamic}, builder.getF32Type());
+    Value lineLength = builder.create<arith::MaxUIOp>(loc, rows, cols);
+    for (Value *buffer : {&workReal, &workImag, &scratchReal, &scratchImag})
+      *buffer = builder.create<memref::AllocOp>(loc, lineTy, lineLength);
+  }
+
+  void dealloc(OpBuilder &builder, Location loc) {
+    for (Value buffer : {workReal, workImag, scratchReal, scratchImag})
+      builder.create<memref::DeallocOp>(loc, buffer);
+  }
+};
+
+// Transform every column of a complex 2D MemRef in place.
+static void fftColumns(OpBuilder &builder, Location loc, FFT2DBuffers &buffers,
+                       Value memRefReal, Value memRefImag, Value twiddles,
+                       Value rows, Value cols, bool inverse, Value c0,
+                       Value c1) {
+  builder.create<scf::ForOp>(
+      loc, c0, cols, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, Value col, ValueRange iargs) {
+        builder.create<scf::ForOp>(
+            loc, c0, rows, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value row, ValueRange iargs) {
+              for (auto [src, dst] :
+                   {std::make_pair(memRefReal, buffers.workReal),
+                    std::make_pair(memRefImag, buffers.workImag)}) {
+                Value val = builder.create<memref::LoadOp>(
+                    loc, src, ValueRange{row, col});
+                builder.create<memref::StoreOp>(loc, val, dst, row);
+              }
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        Value resReal, resImag;
+        std::tie(resReal, resImag) = fft1DStockham(
+            builder, loc, buffers.workReal, buffers.workImag,
+            buffers.scratchReal, buffers.scratchImag, twiddles, rows, inverse,
+            c0, c1);
+
+        builder.create<scf::ForOp>(
+            loc, c0, rows, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value row, ValueRange iargs) {
+              for (auto [src, dst] : {std::make_pair(resReal, memRefReal),
+                                      std::make_pair(resImag, memRefImag)}) {
+                Value val = builder.create<memref::LoadOp>(loc, src, row);
+                builder.create<memref::StoreOp>(loc, val, dst,
+                                                ValueRange{row, col});
+              }
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Function for calculating the discrete Fourier transform of a real 2D MemRef.
+// Only the cols / 2 + 1 non-negative frequencies of every row are stored, the
+// others are their complex conjugates. Every two rows are transformed at once
+// as the real and imaginary parts of one complex row. The twiddle tables are
+// filled by fftTwiddles for the cols and the rows. Separate MemRefs for real
+// and imaginary parts of the spectrum are expected.
+void rfft2D(OpBuilder &builder, Location loc, Value input, Value spectrumReal,
+            Value spectrumImag, Value rowTwiddles, Value colTwiddles,
+            Value rows, Value cols, Value c0, Value c1) {
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value zero = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)0.0f, builder.getF32Type());
+  Value halfF32 = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)0.5f, builder.getF32Type());
+  Value half = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::DivUIOp>(loc, cols, c2), c1);
+  FFT2DBuffers buffers(builder, loc, rows, cols);
+
+  builder.create<scf::ForOp>(
+      loc, c0, rows, c2, ValueRange{},
+      [&](OpBuilder &builder, Location loc, Value row, ValueRange iargs) {
+        Value pairRow = builder.create<arith::AddIOp>(loc, row, c1);
+        Value hasPair = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ult, pairRow, rows);
+
+        builder.create<scf::ForOp>(
+            loc, c0, cols, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value col, ValueRange iargs) {
+              Value real = builder.create<memref::LoadOp>(
+                  loc, input, ValueRange{row, col});
+              auto imag = builder.create<scf::IfOp>(
+                  loc, hasPair,
+                  [&](OpBuilder &builder, Location loc) {
+                    Value val = builder.create<memref::LoadOp>(
+                        loc, input, ValueRange{pairRow, col});
+                    builder.create<scf::YieldOp>(loc, val);
+                  },
+                  [&](OpBuilder &builder, Location loc) {
+                    builder.create<scf::YieldOp>(loc, zero);
+                  });
+              builder.create<memref::StoreOp>(loc, real, buffers.workReal, col);
+              builder.create<memref::StoreOp>(loc, imag.getResult(0),
+                                              buffers.workImag, col);
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        Value zReal, zImag;
+        std::tie(zReal, zImag) = fft1DStockham(
+            builder, loc, buffers.workReal, buffers.workImag,
+            buffers.scratchReal, buffers.scratchImag, rowTwiddles, cols,
+            /*inverse=*/false, c0, c1);
+
+        // With Z = FFT(x1 + i * x2), X1[k] = (Z[k] + conj(Z[-k])) / 2 and
+        // X2[k] = (Z[k] - conj(Z[-k])) / 2i.
+        builder.create<scf::ForOp>(
+            loc, c0, half, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value k, ValueRange iargs) {
+              Value negK = builder.create<arith::RemUIOp>(
+                  loc, builder.create<arith::SubIOp>(loc, cols, k), cols);
+              Value zkReal = builder.create<memref::LoadOp>(loc, zReal, k);
+              Value zkImag = builder.create<memref::LoadOp>(loc, zImag, k);
+              Value znReal = builder.create<memref::LoadOp>(loc, zReal, negK);
+              Value znImag = builder.create<memref::LoadOp>(loc, zImag, negK);
+              auto halfOf = [&](Value val) -> Value {
+                return builder.create<arith::MulFOp>(loc, val, halfF32);
+              };
+
+              Value x1Real = halfOf(
+                  builder.create<arith::AddFOp>(loc, zkReal, znReal));
+              Value x1Imag = halfOf(
+                  builder.create<arith::SubFOp>(loc, zkImag, znImag));
+              builder.create<memref::StoreOp>(loc, x1Real, spectrumReal,
+                                              ValueRange{row, k});
+              builder.create<memref::StoreOp>(loc, x1Imag, spectrumImag,
+                                              ValueRange{row, k});
+
+              builder.create<scf::IfOp>(
+                  loc, hasPair, [&](OpBuilder &builder, Location loc) {
+                    Value x2Real = halfOf(
+                        builder.create<arith::AddFOp>(loc, zkImag, znImag));
+                    Value x2Imag = halfOf(
+                        builder.create<arith::SubFOp>(loc, znReal, zkReal));
+                    builder.create<memref::StoreOp>(loc, x2Real, spectrumReal,
+                                                    ValueRange{pairRow, k});
+                    builder.create<memref::StoreOp>(loc, x2Imag, spectrumImag,
+                                                    ValueRange{pairRow, k});
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  fftColumns(builder, loc, buffers, spectrumReal, spectrumImag, colTwiddles,
+             rows, half, /*inverse=*/false, c0, c1);
+  buffers.dealloc(builder, loc);
+}
+
+// Function for calculating the real inverse discrete Fourier transform of a 2D
+// spectrum stored as by rfft2D. The output has the given rows and cols, the
+// spectrum is clobbered. The twiddle tables are filled by fftTwiddles for
+// multiples of the cols and the rows. Separate MemRefs for real and imaginary
+// parts of the spectrum are expected.
+void irfft2D(OpBuilder &builder, Location loc, Value spectrumReal,
+             Value spectrumImag, Value output, Value rowTwiddles,
+             Value colTwiddles, Value rows, Value cols, Value c0, Value c1) {
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  FloatType f32 = builder.getF32Type();
+  Value zero =
+      builder.create<arith::ConstantFloatOp>(loc, (llvm::APFloat)0.0f, f32);
+  Value one =
+      builder.create<arith::ConstantFloatOp>(loc, (llvm::APFloat)1.0f, f32);
+  Value minusOne =
+      builder.create<arith::ConstantFloatOp>(loc, (llvm::APFloat)-1.0f, f32);
+  Value half = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::DivUIOp>(loc, cols, c2), c1);
+  Value scale = builder.create<arith::DivFOp>(
+      loc, one,
+      indexToF32(builder, loc, builder.create<arith::MulIOp>(loc, rows, cols)));
+  FFT2DBuffers buffers(builder, loc, rows, cols);
+
+  fftColumns(builder, loc, buffers, spectrumReal, spectrumImag, colTwiddles,
+             rows, half, /*inverse=*/true, c0, c1);
+
+  // Every row is now the spectrum of a real row, so X[k] = conj(X[cols - k])
+  // restores the missing frequencies and two rows are transformed at once as
+  // Z = X1 + i * X2.
+  builder.create<scf::ForOp>(
+      loc, c0, rows, c2, ValueRange{},
+      [&](OpBuilder &builder, Location loc, Value row, ValueRange iargs) {
+        Value pairRow = builder.create<arith::AddIOp>(loc, row, c1);
+        Value hasPair = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ult, pairRow, rows);
+
+        builder.create<scf::ForOp>(
+            loc, c0, cols, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value col, ValueRange iargs) {
+              Value mirrored = builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::uge, col, half);
+              Value k = builder.create<arith::SelectOp>(
+                  loc, mirrored, builder.create<arith::SubIOp>(loc, cols, col),
+                  col);
+              Value sign =
+                  builder.create<arith::SelectOp>(loc, mirrored, minusOne, one);
+
+              Value x1Real = builder.create<memref::LoadOp>(
+                  loc, spectrumReal, ValueRange{row, k});
+              Value x1Imag = builder.create<arith::MulFOp>(
+                  loc, sign,
+                  builder.create<memref::LoadOp>(loc, spectrumImag,
+                                                 ValueRange{row, k}));
+              auto x2 = builder.create<scf::IfOp>(
+                  loc, hasPair,
+                  [&](OpBuilder &builder, Location loc) {
+                    Value x2Real = builder.create<memref::LoadOp>(
+                        loc, spectrumReal, ValueRange{pairRow, k});
+                    Value x2Imag = builder.create<arith::MulFOp>(
+                        loc, sign,
+                        builder.create<memref::LoadOp>(loc, spectrumImag,
+                                                       ValueRange{pairRow, k}));
+                    builder.create<scf::YieldOp>(loc,
+                                                 ValueRange{x2Real, x2Imag});
+                  },
+                  [&](OpBuilder &builder, Location loc) {
+                    builder.create<scf::YieldOp>(loc, ValueRange{zero, zero});
+                  });
+
+              Value zReal = builder.create<arith::SubFOp>(loc, x1Real,
+                                                          x2.getResult(1));
+              Value zImag = builder.create<arith::AddFOp>(loc, x1Imag,
+                                                          x2.getResult(0));
+              builder.create<memref::StoreOp>(loc, zReal, buffers.workReal,
+                                              col);
+              builder.create<memref::StoreOp>(loc, zImag, buffers.workImag,
+                                              col);
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        Value resReal, resImag;
+        std::tie(resReal, resImag) = fft1DStockham(
+            builder, loc, buffers.workReal, buffers.workImag,
+            buffers.scratchReal, buffers.scratchImag, rowTwiddles, cols,
+            /*inverse=*/true, c0, c1);
+
+        builder.create<scf::ForOp>(
+            loc, c0, cols, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value col, ValueRange iargs) {
+              Value x1 = builder.create<arith::MulFOp>(
+                  loc, builder.create<memref::LoadOp>(loc, resReal, col),
+                  scale);
+              builder.create<memref::StoreOp>(loc, x1, output,
+                                              ValueRange{row, col});
+              builder.create<scf::IfOp>(
+                  loc, hasPair, [&](OpBuilder &builder, Location loc) {
+                    Value x2 = builder.create<arith::MulFOp>(
+                        loc, builder.create<memref::LoadOp>(loc, resImag, col),
+                        scale);
+                    builder.create<memref::StoreOp>(loc, x2, output,
+                                                    ValueRange{pairRow, col});
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  buffers.dealloc(builder, loc);
+}
+
+// Function for folding a 2D spectrum stored as by rfft2D onto a grid which is
+// smaller by an integer factor in each dimension, i.e. dst[r][c] is the sum of
+// all src[r + k * dstRows][c + l * dstCols]. The inverse transform of the
+// folded spectrum, divided by the two factors, samples the inverse transform
+// of the source spectrum at every (srcRows / dstRows)th row and
+// (srcCols / dstCols)th column.
+void halfSpectrum2DFold(OpBuilder &builder, Location loc, Value srcReal,
+                        Value srcImag, Value srcRows, Value srcCols,
+                        Value dstReal, Value dstImag, Value dstRows,
+                        Value dstCols, Value c0, Value c1) {
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value zero = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)0.0f, builder.getF32Type());
+  Value srcHalf = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::DivUIOp>(loc, srcCols, c2), c1);
+  Value dstHalf = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::DivUIOp>(loc, dstCols, c2), c1);
+
+  builder.create<scf::ForOp>(
+      loc, c0, dstRows, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, Value row, ValueRange iargs) {
+        builder.create<scf::ForOp>(
+            loc, c0, dstHalf, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value col, ValueRange iargs) {
+              builder.create<memref::StoreOp>(loc, zero, dstReal,
+                                              ValueRange{row, col});
+              builder.create<memref::StoreOp>(loc, zero, dstImag,
+                                              ValueRange{row, col});
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  builder.create<scf::ForOp>(
+      loc, c0, srcRows, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, Value row, ValueRange iargs) {
+        Value dstRow = builder.create<arith::RemUIOp>(loc, row, dstRows);
+        Value negRow = builder.create<arith::RemUIOp>(
+            loc, builder.create<arith::SubIOp>(loc, srcRows, row), srcRows);
+        builder.create<scf::ForOp>(
+            loc, c0, srcCols, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, Value col, ValueRange iargs) {
+              Value dstCol = builder.create<arith::RemUIOp>(loc, col, dstCols);
+              Value stored = builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::ult, dstCol, dstHalf);
+              builder.create<scf::IfOp>(
+                  loc, stored, [&](OpBuilder &builder, Location loc) {
+                    // The missing frequencies are the complex conjugates of
+                    // the stored ones at the negated position.
+                    Value mirrored = builder.create<arith::CmpIOp>(
+                        loc, arith::CmpIPredicate::uge, col, srcHalf);
+                    Value srcRow = builder.create<arith::SelectOp>(
+                        loc, mirrored, negRow, row);
+                    Value srcCol = builder.create<arith::SelectOp>(
+                        loc, mirrored,
+                        builder.create<arith::SubIOp>(loc, srcCols, col), col);
+                    Value valReal = builder.create<memref::LoadOp>(
+                        loc, srcReal, ValueRange{srcRow, srcCol});
+                    Value valImag = builder.create<memref::LoadOp>(
+                        loc, srcImag, ValueRange{srcRow, srcCol});
+                    valImag = builder.create<arith::SelectOp>(
+                        loc, mirrored,
+                        builder.create<arith::NegFOp>(loc, valImag), valImag);
+                    for (auto [dst, val] : {std::make_pair(dstReal, valReal),
+                                            std::make_pair(dstImag, valImag)}) {
+                      Value acc = builder.create<memref::LoadOp>(
+                          loc, dst, ValueRange{dstRow, dstCol});
+                      Value sum = builder.create<arith::AddFOp>(loc, acc, val);
+                      builder.create<memref::StoreOp>(
+                          loc, sum, dst, ValueRange{dstRow, dstCol});
+                    }
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
 } // namespace buddy
 
 #endif // UTILS_UTILS_DEF
@@ -0,0 +1,50 @@
+// RUN: buddy-opt %s -lower-dap="DAP-vector-splitting=16" -split-input-file -verify-diagnostics | FileCheck %s
+
+func.func @buddy_biquad_f64(%in : memref<?xf64>, %filter : memref<?xf64>, %out : memref<?xf64>) -> () {
+  // CHECK-LABEL: func.func @buddy_biquad_f64
+  // CHECK: vector.fma {{.*}} : vector<16xf64>
+  // CHECK-NOT: dap.biquad
+  dap.biquad %in, %filter, %out : memref<?xf64>, memref<?xf64>, memref<?xf64>
+  return
+}
+
+// -----
+
+func.func @buddy_iir_f16(%in : memref<?xf16>, %filter : memref<?x?xf16>, %out : memref<?xf16>) -> () {
+  // CHECK-LABEL: func.func @buddy_iir_f16
+  // CHECK: vector.fma {{.*}} : vector<16xf16>
+  // CHECK-NOT: dap.iir
+  dap.iir %in, %filter, %out : memref<?xf16>, memref<?x?xf16>, memref<?xf16>
+  return
+}
+
+// -----
+
+func.func @buddy_fir_q15(%in : memref<?xi16>, %filter : memref<?xi16>, %out : memref<?xi16>) -> () {
+  // CHECK-LABEL: func.func @buddy_fir_q15
+  // CHECK: vector.maskedload {{.*}} : memref<?xi16>, vector<16xi1>, vector<16xi16> into vector<16xi16>
+  // CHECK: arith.extsi {{.*}} : vector<16xi16> to vector<16xi64>
+  // CHECK: arith.shrsi
+  // CHECK: arith.maxsi
+  // CHECK: arith.minsi
+  // CHECK: arith.trunci {{.*}} : vector<16xi64> to vector<16xi16>
+  // CHECK: vector.maskedstore
+  dap.fir %in, %filter, %out : memref<?xi16>, memref<?xi16>, memref<?xi16>
+  return
+}
+
+// -----
+
+func.func @buddy_biquad_mixed(%in : memref<?xf32>, %filter : memref<?xf64>, %out : memref<?xf32>) -> () {
+  // expected-error @+1 {{'dap.biquad' op input, kernel and output must have the same element type}}
+  dap.biquad %in, %filter, %out : memref<?xf32>, memref<?xf64>, memref<?xf32>
+  return
+}
+
+// -----
+
+func.func @buddy_iir_i32(%in : memref<?xi32>, %filter : memref<?x?xi32>, %out : memref<?xi32>) -> () {
+  // expected-error @+1 {{'dap.iir' op supports only floating point and i16 (Q15) types. 'i32' is passed}}
+  dap.iir %in, %filter, %out : memref<?xi32>, memref<?x?xi32>, memref<?xi32>
+  return
+}
@@ -0,0 +1,57 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dap="DAP-vector-splitting=8" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Q15 samples: 0.5, 0.5, 0, 0, -1, -1, -1, -1
+memref.global "private" @global_biquad_input : memref<8xi16> = dense<[16384, 16384, 0, 0, -32768, -32768, -32768, -32768]>
+memref.global "private" @global_iir_input : memref<8xi16> = dense<[16384, 16384, 0, 0, -32768, -32768, -32768, -32768]>
+
+// Q14 coefficients: b = [0.5, 0.25, 0], a = [1, -0.5, 0]
+memref.global "private" @global_biquad_kernel : memref<6xi16> = dense<[8192, 4096, 0, 16384, -8192, 0]>
+memref.global "private" @global_iir_kernel : memref<1x6xi16> = dense<[[8192, 4096, 0, 16384, -8192, 0]]>
+
+memref.global "private" @global_biquad_output : memref<8xi16> = dense<0>
+memref.global "private" @global_iir_output : memref<8xi16> = dense<0>
+
+// Q15 samples: 0.5, -0.5, ~1, ~1, 0.25 and taps: 0.5, 0.5
+memref.global "private" @global_fir_input : memref<5xi16> = dense<[16384, -16384, 32767, 32767, 8192]>
+memref.global "private" @global_fir_kernel : memref<2xi16> = dense<[16384, 16384]>
+memref.global "private" @global_fir_output : memref<5xi16> = dense<0>
+
+func.func @main() -> i32 {
+  %c0 = arith.constant 0 : index
+
+  %biquad_input = memref.get_global @global_biquad_input : memref<8xi16>
+  %biquad_kernel = memref.get_global @global_biquad_kernel : memref<6xi16>
+  %biquad_output = memref.get_global @global_biquad_output : memref<8xi16>
+  dap.biquad %biquad_input, %biquad_kernel, %biquad_output : memref<8xi16>, memref<6xi16>, memref<8xi16>
+  %biquad_res = vector.load %biquad_output[%c0] : memref<8xi16>, vector<8xi16>
+  // The feedback drives the output into saturation.
+  // CHECK: ( 8192, 16384, 12288, 6144, -13312, -31232, -32768, -32768 )
+  vector.print %biquad_res : vector<8xi16>
+
+  %iir_input = memref.get_global @global_iir_input : memref<8xi16>
+  %iir_kernel = memref.get_global @global_iir_kernel : memref<1x6xi16>
+  %iir_output = memref.get_global @global_iir_output : memref<8xi16>
+  dap.iir %iir_input, %iir_kernel, %iir_output : memref<8xi16>, memref<1x6xi16>, memref<8xi16>
+  %iir_res = vector.load %iir_output[%c0] : memref<8xi16>, vector<8xi16>
+  // CHECK: ( 8192, 16384, 12288, 6144, -13312, -31232, -32768, -32768 )
+  vector.print %iir_res : vector<8xi16>
+
+  %fir_input = memref.get_global @global_fir_input : memref<5xi16>
+  %fir_kernel = memref.get_global @global_fir_kernel : memref<2xi16>
+  %fir_output = memref.get_global @global_fir_output : memref<5xi16>
+  dap.fir %fir_input, %fir_kernel, %fir_output : memref<5xi16>, memref<2xi16>, memref<5xi16>
+  %fir_res = vector.load %fir_output[%c0] : memref<5xi16>, vector<5xi16>
+  // 0.5 * (1 + 1) saturates to 32767, the last sample only sees one tap.
+  // CHECK: ( 0, 8192, 32767, 20480, 4096 )
+  vector.print %fir_res : vector<5xi16>
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,27 @@
+// RUN: buddy-opt %s -lower-dap="DAP-channel-lanes=8" | FileCheck %s
+
+func.func @buddy_biquad_multichannel(%in : memref<?x?xf32>, %filter : memref<?xf32>, %out : memref<?x?xf32>) -> () {
+  // CHECK-LABEL: func.func @buddy_biquad_multichannel
+  // CHECK: scf.for
+  // CHECK: vector.create_mask {{.*}} : vector<8xi1>
+  // CHECK: scf.for
+  // CHECK: vector.gather {{.*}} into vector<8xf32>
+  // CHECK: vector.scatter {{.*}} vector<8xf32>
+  // CHECK-NOT: dap.biquad
+  dap.biquad %in, %filter, %out : memref<?x?xf32>, memref<?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_iir_multichannel(%in : memref<?x?xf32>, %filter : memref<?x?xf32>, %out : memref<?x?xf32>) -> () {
+  // CHECK-LABEL: func.func @buddy_iir_multichannel
+  // CHECK: memref.copy
+  // CHECK: scf.for
+  // CHECK: vector.create_mask {{.*}} : vector<8xi1>
+  // CHECK: scf.for
+  // CHECK: scf.for
+  // CHECK: vector.gather {{.*}} into vector<8xf32>
+  // CHECK: vector.scatter {{.*}} vector<8xf32>
+  // CHECK-NOT: dap.iir
+  dap.iir %in, %filter, %out : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
@@ -0,0 +1,15 @@
+// RUN: buddy-opt %s -lower-dap="DAP-vector-splitting=16" | FileCheck %s
+
+func.func @buddy_resample(%in : memref<?xf32>, %kernel : memref<?x?xf32>, %out : memref<?xf32>, %down : index, %start : index) -> () {
+  // CHECK-LABEL: func.func @buddy_resample
+  // CHECK: scf.for
+  // CHECK: scf.for
+  // CHECK: vector.create_mask {{.*}} : vector<16xi1>
+  // CHECK: scf.for
+  // CHECK: vector.gather {{.*}} into vector<16xf32>
+  // CHECK: vector.fma {{.*}} : vector<16xf32>
+  // CHECK: vector.scatter {{.*}} vector<16xf32>
+  // CHECK-NOT: dap.resample
+  dap.resample %in, %kernel, %out, %down, %start : memref<?xf32>, memref<?x?xf32>, memref<?xf32>, index, index
+  return
+}
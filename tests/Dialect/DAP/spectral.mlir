@@ -0,0 +1,65 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dap="DAP-vector-splitting=4 DAP-channel-lanes=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-math-to-llvm --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Two frames of length 4 with hop 2: [1, 2, 3, 4] and [3, 4, 0, 0], the
+// second one runs past the end of the input and is zero padded.
+memref.global "private" @global_input : memref<4xf32> = dense<[1.0, 2.0, 3.0, 4.0]>
+memref.global "private" @global_window : memref<4xf32> = dense<1.0>
+memref.global "private" @global_real : memref<2x3xf32> = dense<0.0>
+memref.global "private" @global_imag : memref<2x3xf32> = dense<0.0>
+
+// Band 0 takes bin 0, band 1 takes bins 1 and 2.
+memref.global "private" @global_filterbank : memref<2x3xf32> = dense<[[1.0, 0.0, 0.0], [0.0, 1.0, 1.0]]>
+memref.global "private" @global_mel : memref<2x2xf32> = dense<0.0>
+
+memref.global "private" @global_dct : memref<1x2xf32> = dense<[[1.0, 1.0]]>
+memref.global "private" @global_mfcc : memref<2x1xf32> = dense<0.0>
+
+func.func @main() -> i32 {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %hop = arith.constant 2 : index
+
+  %input = memref.get_global @global_input : memref<4xf32>
+  %window = memref.get_global @global_window : memref<4xf32>
+  %real = memref.get_global @global_real : memref<2x3xf32>
+  %imag = memref.get_global @global_imag : memref<2x3xf32>
+  dap.stft %input, %window, %hop, %real, %imag : memref<4xf32>, memref<4xf32>, index, memref<2x3xf32>, memref<2x3xf32>
+  // X = [10, -2 + 2i, -2] and [7, 3 - 4i, -1]
+  %real0 = vector.load %real[%c0, %c0] : memref<2x3xf32>, vector<3xf32>
+  // CHECK: ( 10, -2, -2 )
+  vector.print %real0 : vector<3xf32>
+  %real1 = vector.load %real[%c1, %c0] : memref<2x3xf32>, vector<3xf32>
+  // CHECK: ( 7, 3, -1 )
+  vector.print %real1 : vector<3xf32>
+
+  %filterbank = memref.get_global @global_filterbank : memref<2x3xf32>
+  %mel = memref.get_global @global_mel : memref<2x2xf32>
+  dap.mel_filterbank %real, %imag, %filterbank, %mel : memref<2x3xf32>, memref<2x3xf32>, memref<2x3xf32>, memref<2x2xf32>
+  %mel0 = vector.load %mel[%c0, %c0] : memref<2x2xf32>, vector<2xf32>
+  // CHECK: ( 100, 12 )
+  vector.print %mel0 : vector<2xf32>
+  %mel1 = vector.load %mel[%c1, %c0] : memref<2x2xf32>, vector<2xf32>
+  // CHECK: ( 49, 26 )
+  vector.print %mel1 : vector<2xf32>
+
+  %dct = memref.get_global @global_dct : memref<1x2xf32>
+  %mfcc = memref.get_global @global_mfcc : memref<2x1xf32>
+  dap.mfcc %mel, %dct, %mfcc : memref<2x2xf32>, memref<1x2xf32>, memref<2x1xf32>
+  %mfcc0 = memref.load %mfcc[%c0, %c0] : memref<2x1xf32>
+  %mfcc1 = memref.load %mfcc[%c1, %c0] : memref<2x1xf32>
+  // log(100) + log(12) and log(49) + log(26)
+  // CHECK: 7.0900{{[0-9]*}}
+  vector.print %mfcc0 : f32
+  // CHECK: 7.1499{{[0-9]*}}
+  vector.print %mfcc1 : f32
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,171 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<6x5xf32> = dense<[[7., 3., 9., 1., 5.],
+                                                                 [2., 8., 4., 6., 0.],
+                                                                 [9., 1., 7., 3., 8.],
+                                                                 [4., 6., 2., 9., 5.],
+                                                                 [3., 9., 5., 1., 7.],
+                                                                 [8., 2., 6., 4., 3.]]>
+
+// Anchored at its bottom right corner, the kernel reaches two rows and columns
+// past the top left edges, where the three modes read the pixels
+//   reflect     1 0 | 0 1 2 ...
+//   reflect 101 2 1 | 0 1 2 ...
+//   wrap        n-2 n-1 | 0 1 2 ...
+// Anchored at its top left corner, it reaches two rows and columns past the
+// bottom right edges instead, where they read
+//   reflect     ... n-2 n-1 | n-1 n-2
+//   reflect 101 ... n-2 n-1 | n-2 n-3
+//   wrap        ... n-2 n-1 | 0 1
+memref.global "private" @global_kernel : memref<3x3xf32> = dense<[[1., 0., 2.],
+                                                                  [0., 1., 0.],
+                                                                  [3., 0., 1.]]>
+memref.global "private" @global_box : memref<3x3xf32> = dense<[[1., 1., 1.],
+                                                               [1., 1., 1.],
+                                                               [1., 1., 1.]]>
+memref.global "private" @global_holes : memref<3x3xf32> = dense<[[0., 1., 1.],
+                                                                 [1., 1., 1.],
+                                                                 [1., 1., 1.]]>
+
+memref.global "private" @global_output_reflect : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_reflect_101 : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_wrap : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_reflect_end : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_reflect_101_end : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_wrap_end : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_box : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_chain : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_holes : memref<6x5xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<6x5xf32>
+  %kernel = memref.get_global @global_kernel : memref<3x3xf32>
+  %box = memref.get_global @global_box : memref<3x3xf32>
+  %holes = memref.get_global @global_holes : memref<3x3xf32>
+  %output_reflect = memref.get_global @global_output_reflect : memref<6x5xf32>
+  %output_reflect_101 = memref.get_global @global_output_reflect_101 : memref<6x5xf32>
+  %output_wrap = memref.get_global @global_output_wrap : memref<6x5xf32>
+  %output_reflect_end = memref.get_global @global_output_reflect_end : memref<6x5xf32>
+  %output_reflect_101_end = memref.get_global @global_output_reflect_101_end : memref<6x5xf32>
+  %output_wrap_end = memref.get_global @global_output_wrap_end : memref<6x5xf32>
+  %output_box = memref.get_global @global_output_box : memref<6x5xf32>
+  %output_chain = memref.get_global @global_output_chain : memref<6x5xf32>
+  %output_holes = memref.get_global @global_output_holes : memref<6x5xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %zero = arith.constant 0. : f32
+
+  dip.corr_2d <REFLECT_PADDING> %input, %kernel, %output_reflect, %c2, %c2, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  %printed_reflect = memref.cast %output_reflect : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_reflect) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[35, 49, 43, 39, 37],
+  // CHECK{LITERAL}: [50, 34, 38, 44, 32],
+  // CHECK{LITERAL}: [31, 43, 67, 15, 54],
+  // CHECK{LITERAL}: [43, 45, 25, 54, 18],
+  // CHECK{LITERAL}: [53, 33, 43, 37, 54],
+  // CHECK{LITERAL}: [31, 45, 47, 39, 34]]
+
+  dip.corr_2d <REFLECT_101_PADDING> %input, %kernel, %output_reflect_101, %c2, %c2, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  %printed_reflect_101 = memref.cast %output_reflect_101 : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_reflect_101) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[67, 17, 61, 21, 61],
+  // CHECK{LITERAL}: [25, 63, 23, 59, 17],
+  // CHECK{LITERAL}: [61, 15, 67, 15, 54],
+  // CHECK{LITERAL}: [19, 57, 25, 54, 18],
+  // CHECK{LITERAL}: [49, 43, 43, 37, 54],
+  // CHECK{LITERAL}: [45, 29, 47, 39, 34]]
+
+  dip.corr_2d <WRAP_PADDING> %input, %kernel, %output_wrap, %c2, %c2, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  %printed_wrap = memref.cast %output_wrap : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_wrap) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[20, 51, 45, 27, 55],
+  // CHECK{LITERAL}: [45, 22, 33, 49, 25],
+  // CHECK{LITERAL}: [33, 38, 67, 15, 54],
+  // CHECK{LITERAL}: [49, 46, 25, 54, 18],
+  // CHECK{LITERAL}: [32, 44, 43, 37, 54],
+  // CHECK{LITERAL}: [44, 31, 47, 39, 34]]
+
+  dip.corr_2d <REFLECT_PADDING> %input, %kernel, %output_reflect_end, %c0, %c0, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  %printed_reflect_end = memref.cast %output_reflect_end : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_reflect_end) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[67, 15, 54, 28, 34],
+  // CHECK{LITERAL}: [25, 54, 18, 46, 44],
+  // CHECK{LITERAL}: [43, 37, 54, 34, 41],
+  // CHECK{LITERAL}: [47, 39, 34, 41, 43],
+  // CHECK{LITERAL}: [45, 27, 44, 33, 25],
+  // CHECK{LITERAL}: [36, 44, 38, 23, 36]]
+
+  dip.corr_2d <REFLECT_101_PADDING> %input, %kernel, %output_reflect_101_end, %c0, %c0, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  %printed_reflect_101_end = memref.cast %output_reflect_101_end : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_reflect_101_end) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[67, 15, 54, 15, 60],
+  // CHECK{LITERAL}: [25, 54, 18, 62, 28],
+  // CHECK{LITERAL}: [43, 37, 54, 18, 57],
+  // CHECK{LITERAL}: [47, 39, 34, 50, 25],
+  // CHECK{LITERAL}: [29, 45, 45, 10, 47],
+  // CHECK{LITERAL}: [43, 42, 24, 55, 33]]
+
+  dip.corr_2d <WRAP_PADDING> %input, %kernel, %output_wrap_end, %c0, %c0, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  %printed_wrap_end = memref.cast %output_wrap_end : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_wrap_end) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[67, 15, 54, 33, 38],
+  // CHECK{LITERAL}: [25, 54, 18, 49, 46],
+  // CHECK{LITERAL}: [43, 37, 54, 32, 44],
+  // CHECK{LITERAL}: [47, 39, 34, 44, 31],
+  // CHECK{LITERAL}: [45, 27, 55, 20, 51],
+  // CHECK{LITERAL}: [33, 49, 25, 45, 22]]
+
+  // The rectangle takes the van Herk/Gil-Werman path.
+  dip.erosion_2d <WRAP_PADDING> %input, %box, %output_box, %c2, %c2, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_box = memref.cast %output_box : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_box) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[1, 2, 2, 1, 1],
+  // CHECK{LITERAL}: [0, 0, 2, 1, 0],
+  // CHECK{LITERAL}: [0, 0, 1, 1, 0],
+  // CHECK{LITERAL}: [0, 0, 1, 1, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 1, 1],
+  // CHECK{LITERAL}: [1, 2, 2, 1, 1]]
+
+  // Two applications of any other shape run on one band holding the image.
+  dip.erosion_2d <WRAP_PADDING> %input, %holes, %output_chain, %c1, %c1, %c2, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_chain = memref.cast %output_chain : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_chain) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 1, 0, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 0, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 1, 1],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0]]
+
+  dip.dilation_2d <REFLECT_101_PADDING> %input, %holes, %output_holes, %c0, %c0, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_holes = memref.cast %output_holes : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_holes) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[9, 9, 8, 8, 9],
+  // CHECK{LITERAL}: [9, 9, 9, 9, 9],
+  // CHECK{LITERAL}: [9, 9, 9, 9, 9],
+  // CHECK{LITERAL}: [9, 9, 9, 9, 9],
+  // CHECK{LITERAL}: [9, 9, 7, 7, 7],
+  // CHECK{LITERAL}: [9, 9, 9, 9, 9]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
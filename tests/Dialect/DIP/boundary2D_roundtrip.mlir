@@ -0,0 +1,19 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_corr2d_REFLECT_PADDING_f32(%input : memref<?x?xf32>, %kernel : memref<?x?xf32>, %output : memref<?x?xf32>, %centerX : index, %centerY : index, %c : f32) -> () {
+  // CHECK: dip.corr_2d <REFLECT_PADDING>{{.*}} : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  dip.corr_2d <REFLECT_PADDING> %input, %kernel, %output, %centerX, %centerY, %c : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @buddy_corr2d_REFLECT_101_PADDING_i32(%input : memref<?x?xi32>, %kernel : memref<?x?xi32>, %output : memref<?x?xi32>, %centerX : index, %centerY : index, %c : i32) -> () {
+  // CHECK: dip.corr_2d <REFLECT_101_PADDING>{{.*}} : memref<?x?xi32>, memref<?x?xi32>, memref<?x?xi32>, index, index, i32
+  dip.corr_2d <REFLECT_101_PADDING> %input, %kernel, %output, %centerX, %centerY, %c : memref<?x?xi32>, memref<?x?xi32>, memref<?x?xi32>, index, index, i32
+  return
+}
+
+func.func @buddy_erosion2d_WRAP_PADDING_f32(%input : memref<?x?xf32>, %kernel : memref<?x?xf32>, %output : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %c : f32) -> () {
+  // CHECK: dip.erosion_2d <WRAP_PADDING>{{.*}} : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  dip.erosion_2d <WRAP_PADDING> %input, %kernel, %output, %centerX, %centerY, %iterations, %c : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
+  return
+}
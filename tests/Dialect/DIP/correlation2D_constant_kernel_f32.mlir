@@ -0,0 +1,72 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// The kernels are constant globals, so their taps are unrolled at compile
+// time. With vectors of 4 lanes every row ends with a tail.
+memref.global "private" @global_input : memref<4x6xf32> = dense<[[1., 2., 3., 4., 5., 6. ],
+                                                                 [2., 4., 6., 8., 10., 12.],
+                                                                 [9., 7., 5., 3., 1., 0. ],
+                                                                 [0., 5., 0., 5., 0., 5. ]]>
+
+memref.global "private" constant @global_laplacian : memref<3x3xf32> = dense<[[1., 1. , 1.],
+                                                                              [1., -8., 1.],
+                                                                              [1., 1. , 1.]]>
+
+// Zero, 1, -1 and other coefficients, anchored off center.
+memref.global "private" constant @global_kernel : memref<2x3xf32> = dense<[[1., 0. , -1.],
+                                                                           [2., -1., 0.5]]>
+
+memref.global "private" @global_output_laplacian : memref<4x6xf32> = dense<0.>
+memref.global "private" @global_output_reflect : memref<4x6xf32> = dense<0.>
+memref.global "private" @global_output_wrap : memref<4x6xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<4x6xf32>
+  %laplacian = memref.get_global @global_laplacian : memref<3x3xf32>
+  %kernel = memref.get_global @global_kernel : memref<2x3xf32>
+  %output_laplacian = memref.get_global @global_output_laplacian : memref<4x6xf32>
+  %output_reflect = memref.get_global @global_output_reflect : memref<4x6xf32>
+  %output_wrap = memref.get_global @global_output_wrap : memref<4x6xf32>
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %one = arith.constant 1. : f32
+  %zero = arith.constant 0. : f32
+
+  %dynamic_laplacian = memref.cast %laplacian : memref<3x3xf32> to memref<?x?xf32>
+  dip.corr_2d <CONSTANT_PADDING> %input, %dynamic_laplacian, %output_laplacian, %c1, %c1, %one : memref<4x6xf32>, memref<?x?xf32>, memref<4x6xf32>, index, index, f32
+  %printed_laplacian = memref.cast %output_laplacian : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_laplacian) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[5, 3, 3, 3, 3, -16],
+  // CHECK{LITERAL}: [10, 3, -12, -27, -41, -71],
+  // CHECK{LITERAL}: [-51, -25, -2, 11, 35, 31],
+  // CHECK{LITERAL}: [26, -16, 28, -28, 17, -34]]
+
+  dip.corr_2d <REFLECT_101_PADDING> %input, %kernel, %output_reflect, %c1, %c0, %zero : memref<4x6xf32>, memref<2x3xf32>, memref<4x6xf32>, index, index, f32
+  %printed_reflect = memref.cast %output_reflect : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_reflect) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[8, 1, 4, 7, 10, 13],
+  // CHECK{LITERAL}: [8.5, 9.5, 6.5, 3.5, 1, 2.5],
+  // CHECK{LITERAL}: [12.5, -1, 16.5, -1, 15.5, -5],
+  // CHECK{LITERAL}: [8.5, 13.5, 10.5, 7.5, 5, 2.5]]
+
+  dip.corr_2d <WRAP_PADDING> %input, %kernel, %output_wrap, %c1, %c0, %zero : memref<4x6xf32>, memref<2x3xf32>, memref<4x6xf32>, index, index, f32
+  %printed_wrap = memref.cast %output_wrap : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_wrap) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[28, 1, 4, 7, 10, 13],
+  // CHECK{LITERAL}: [2.5, 9.5, 6.5, 3.5, 1, 14.5],
+  // CHECK{LITERAL}: [5.5, -1, 16.5, -1, 15.5, -13],
+  // CHECK{LITERAL}: [12, 1.5, 3, 4.5, 6, 4.5]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
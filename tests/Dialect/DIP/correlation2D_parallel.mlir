@@ -0,0 +1,55 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-row-grain=2" \
+// RUN: | FileCheck %s --check-prefix=LOWER
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-row-grain=1" -arith-expand --convert-vector-to-scf --lower-affine \
+// RUN: -async-parallel-for="async-dispatch=true num-workers=-1 min-task-size=1" -async-to-async-runtime \
+// RUN: -async-runtime-ref-counting -async-runtime-ref-counting-opt -convert-async-to-llvm \
+// RUN: --convert-scf-to-cf --convert-vector-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_async_runtime%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<6x4xf32> = dense<[[0. , 1. , 2. , 3. ],
+                                                                 [10., 11., 12., 13.],
+                                                                 [20., 21., 22., 23.],
+                                                                 [30., 31., 32., 33.],
+                                                                 [40., 41., 42., 43.],
+                                                                 [50., 51., 52., 53.]]>
+
+memref.global "private" @global_sobel : memref<3x3xf32> = dense<[[1., 0., -1.],
+                                                                 [2., 0., -2.],
+                                                                 [1., 0., -1.]]>
+
+memref.global "private" @global_output : memref<6x4xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<6x4xf32>
+  %sobel = memref.get_global @global_sobel : memref<3x3xf32>
+  %output = memref.get_global @global_output : memref<6x4xf32>
+
+  %kernelAnchorX = arith.constant 1 : index
+  %kernelAnchorY = arith.constant 1 : index
+  %c = arith.constant 0. : f32
+
+  // Every band of rows reads a one row halo above and below it.
+  // LOWER: affine.parallel ({{.*}}) = ({{.*}}) to ({{.*}}) step (2)
+  // LOWER: affine.for %{{.*}} = %{{.*}} to min #{{.*}}(%{{.*}}, %{{.*}})
+  dip.corr_2d <CONSTANT_PADDING> %input, %sobel, %output, %kernelAnchorX, %kernelAnchorY, %c : memref<6x4xf32>, memref<3x3xf32>, memref<6x4xf32>, index, index, f32
+
+  %printed_output = memref.cast %output : memref<6x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_output) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[-13, -6, -6, 16],
+  // CHECK{LITERAL}: [-44, -8, -8, 48],
+  // CHECK{LITERAL}: [-84, -8, -8, 88],
+  // CHECK{LITERAL}: [-124, -8, -8, 128],
+  // CHECK{LITERAL}: [-164, -8, -8, 168],
+  // CHECK{LITERAL}: [-143, -6, -6, 146]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,137 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<6x5xf32> = dense<[[1., 2., 0., 4., 3.],
+                                                                 [5., 1., 2., 2., 0.],
+                                                                 [3., 3., 1., 0., 2.],
+                                                                 [0., 4., 2., 1., 1.],
+                                                                 [2., 0., 5., 3., 1.],
+                                                                 [1., 2., 3., 0., 4.]]>
+
+memref.global "private" @global_kernel : memref<3x3xf32> = dense<[[1. , 2., 0.],
+                                                                  [-1., 3., 1.],
+                                                                  [0. , 1., 2.]]>
+
+// The input padded with zeros and the flipped kernel with its center moved to
+// the top left corner, as prepared by dip::CorrFFT2D. The padded sizes take
+// the radix 3 and radix 5 paths, and the odd row count leaves one row without
+// a partner in the real transforms.
+memref.global "private" @global_input_padded : memref<9x10xf32> = dense<[[ 1.,  2.,  0.,  4.,  3.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 5.,  1.,  2.,  2.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 3.,  3.,  1.,  0.,  2.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 0.,  4.,  2.,  1.,  1.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 2.,  0.,  5.,  3.,  1.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 1.,  2.,  3.,  0.,  4.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                         [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.]]>
+
+memref.global "private" @global_kernel_padded : memref<9x10xf32> = dense<[[ 3., -1.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  1.],
+                                                                          [ 2.,  1.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 1.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  2.]]>
+
+memref.global "private" @global_output : memref<6x5xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+// Run dip.corrfft_2d with the given strides and compare the result with the
+// strided direct correlation.
+func.func @check_strided(%direct : memref<6x5xf32>, %strideX : index, %strideY : index) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c5 = arith.constant 5 : index
+  %c6 = arith.constant 6 : index
+  %zero = arith.constant 0. : f32
+  %tolerance = arith.constant 1.0e-3 : f32
+
+  %input_padded = memref.get_global @global_input_padded : memref<9x10xf32>
+  %kernel_padded = memref.get_global @global_kernel_padded : memref<9x10xf32>
+  %input = memref.cast %input_padded : memref<9x10xf32> to memref<?x?xf32>
+  %kernel = memref.cast %kernel_padded : memref<9x10xf32> to memref<?x?xf32>
+
+  // The output has ceil(6 / strideY) x ceil(5 / strideX) elements.
+  %strideY_minus_one = arith.subi %strideY, %c1 : index
+  %strideX_minus_one = arith.subi %strideX, %c1 : index
+  %rows_ceil = arith.addi %c6, %strideY_minus_one : index
+  %cols_ceil = arith.addi %c5, %strideX_minus_one : index
+  %rows = arith.divui %rows_ceil, %strideY : index
+  %cols = arith.divui %cols_ceil, %strideX : index
+  %output = memref.alloc(%rows, %cols) : memref<?x?xf32>
+
+  dip.corrfft_2d %input, %kernel, %output, %strideX, %strideY : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index
+
+  %error = scf.for %i = %c0 to %rows step %c1 iter_args(%row_error = %zero) -> (f32) {
+    %next_error = scf.for %j = %c0 to %cols step %c1 iter_args(%col_error = %row_error) -> (f32) {
+      %y = arith.muli %i, %strideY : index
+      %x = arith.muli %j, %strideX : index
+      %expected = memref.load %direct[%y, %x] : memref<6x5xf32>
+      %actual = memref.load %output[%i, %j] : memref<?x?xf32>
+      %diff = arith.subf %actual, %expected : f32
+      %abs = math.absf %diff : f32
+      %max = arith.maxf %col_error, %abs : f32
+      scf.yield %max : f32
+    }
+    scf.yield %next_error : f32
+  }
+  %agree = arith.cmpf olt, %error, %tolerance : f32
+  vector.print %rows : index
+  vector.print %cols : index
+  vector.print %agree : i1
+
+  memref.dealloc %output : memref<?x?xf32>
+  return
+}
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<6x5xf32>
+  %kernel = memref.get_global @global_kernel : memref<3x3xf32>
+  %direct = memref.get_global @global_output : memref<6x5xf32>
+
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %c3 = arith.constant 3 : index
+  %zero = arith.constant 0. : f32
+
+  dip.corr_2d <CONSTANT_PADDING> %input, %kernel, %direct, %c1, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  %printed_direct = memref.cast %direct : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_direct) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[12, 10, 8, 17, 5],
+  // CHECK{LITERAL}: [27, 10, 10, 16, 10],
+  // CHECK{LITERAL}: [30, 22, 9, 10, 9],
+  // CHECK{LITERAL}: [12, 33, 19, 8, 7],
+  // CHECK{LITERAL}: [11, 19, 29, 17, 7],
+  // CHECK{LITERAL}: [9, 10, 17, 12, 17]]
+
+  // Unit strides give the full correlation.
+  call @check_strided(%direct, %c1, %c1) : (memref<6x5xf32>, index, index) -> ()
+  // CHECK: 6
+  // CHECK-NEXT: 5
+  // CHECK-NEXT: 1
+
+  // Strides dividing the padded sizes fold the spectrum onto a 3x5 grid.
+  call @check_strided(%direct, %c2, %c3) : (memref<6x5xf32>, index, index) -> ()
+  // CHECK: 2
+  // CHECK-NEXT: 3
+  // CHECK-NEXT: 1
+
+  // Neither stride divides the padded sizes, the full result is sampled.
+  call @check_strided(%direct, %c3, %c2) : (memref<6x5xf32>, index, index) -> ()
+  // CHECK: 3
+  // CHECK-NEXT: 2
+  // CHECK-NEXT: 1
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
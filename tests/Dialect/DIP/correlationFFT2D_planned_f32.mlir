@@ -0,0 +1,183 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Two frames correlated with the same kernel, whose spectrum is computed once.
+memref.global "private" @global_frame_a : memref<6x5xf32> = dense<[[1., 2., 0., 4., 3.],
+                                                                   [5., 1., 2., 2., 0.],
+                                                                   [3., 3., 1., 0., 2.],
+                                                                   [0., 4., 2., 1., 1.],
+                                                                   [2., 0., 5., 3., 1.],
+                                                                   [1., 2., 3., 0., 4.]]>
+
+memref.global "private" @global_frame_b : memref<6x5xf32> = dense<[[1., 2., 3., 0., 4.],
+                                                                   [2., 0., 5., 3., 1.],
+                                                                   [0., 4., 2., 1., 1.],
+                                                                   [3., 3., 1., 0., 2.],
+                                                                   [5., 1., 2., 2., 0.],
+                                                                   [1., 2., 0., 4., 3.]]>
+
+memref.global "private" @global_kernel : memref<3x3xf32> = dense<[[1. , 2., 0.],
+                                                                  [-1., 3., 1.],
+                                                                  [0. , 1., 2.]]>
+
+// The frames padded with zeros and the flipped kernel with its center moved
+// to the top left corner, as prepared by dip::CorrFFT2DPlan.
+memref.global "private" @global_frame_a_padded : memref<9x10xf32> = dense<[[1., 2., 0., 4., 3., 0., 0., 0., 0., 0.],
+                                                                           [5., 1., 2., 2., 0., 0., 0., 0., 0., 0.],
+                                                                           [3., 3., 1., 0., 2., 0., 0., 0., 0., 0.],
+                                                                           [0., 4., 2., 1., 1., 0., 0., 0., 0., 0.],
+                                                                           [2., 0., 5., 3., 1., 0., 0., 0., 0., 0.],
+                                                                           [1., 2., 3., 0., 4., 0., 0., 0., 0., 0.],
+                                                                           [0., 0., 0., 0., 0., 0., 0., 0., 0., 0.],
+                                                                           [0., 0., 0., 0., 0., 0., 0., 0., 0., 0.],
+                                                                           [0., 0., 0., 0., 0., 0., 0., 0., 0., 0.]]>
+
+memref.global "private" @global_frame_b_padded : memref<9x10xf32> = dense<[[1., 2., 3., 0., 4., 0., 0., 0., 0., 0.],
+                                                                           [2., 0., 5., 3., 1., 0., 0., 0., 0., 0.],
+                                                                           [0., 4., 2., 1., 1., 0., 0., 0., 0., 0.],
+                                                                           [3., 3., 1., 0., 2., 0., 0., 0., 0., 0.],
+                                                                           [5., 1., 2., 2., 0., 0., 0., 0., 0., 0.],
+                                                                           [1., 2., 0., 4., 3., 0., 0., 0., 0., 0.],
+                                                                           [0., 0., 0., 0., 0., 0., 0., 0., 0., 0.],
+                                                                           [0., 0., 0., 0., 0., 0., 0., 0., 0., 0.],
+                                                                           [0., 0., 0., 0., 0., 0., 0., 0., 0., 0.]]>
+
+memref.global "private" @global_kernel_padded : memref<9x10xf32> = dense<[[ 3., -1.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  1.],
+                                                                          [ 2.,  1.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.],
+                                                                          [ 1.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  2.]]>
+
+memref.global "private" @global_direct_a : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_direct_b : memref<6x5xf32> = dense<0.>
+
+// Fill a [2, n] twiddle table with cos(2 * pi * t / n) and -sin(2 * pi * t / n).
+func.func @fill_twiddles(%twiddles : memref<2x?xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %two_pi = arith.constant 6.28318530717958647692 : f32
+  %n = memref.dim %twiddles, %c1 : memref<2x?xf32>
+  %n_i32 = arith.index_cast %n : index to i32
+  %n_f32 = arith.sitofp %n_i32 : i32 to f32
+  scf.for %t = %c0 to %n step %c1 {
+    %t_i32 = arith.index_cast %t : index to i32
+    %t_f32 = arith.sitofp %t_i32 : i32 to f32
+    %turns = arith.divf %t_f32, %n_f32 : f32
+    %angle = arith.mulf %turns, %two_pi : f32
+    %cos = math.cos %angle : f32
+    %sin = math.sin %angle : f32
+    %neg_sin = arith.negf %sin : f32
+    memref.store %cos, %twiddles[%c0, %t] : memref<2x?xf32>
+    memref.store %neg_sin, %twiddles[%c1, %t] : memref<2x?xf32>
+  }
+  return
+}
+
+// Run dip.corrfft_2d_planned on one frame with the given strides and compare
+// the result with the strided direct correlation.
+func.func @check_frame(%frame : memref<9x10xf32>, %direct : memref<6x5xf32>,
+                       %kernel_real : memref<?x?xf32>, %kernel_imag : memref<?x?xf32>,
+                       %row_twiddles : memref<?x?xf32>, %col_twiddles : memref<?x?xf32>,
+                       %strideX : index, %strideY : index) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c5 = arith.constant 5 : index
+  %c6 = arith.constant 6 : index
+  %zero = arith.constant 0. : f32
+  %tolerance = arith.constant 1.0e-3 : f32
+
+  %input = memref.cast %frame : memref<9x10xf32> to memref<?x?xf32>
+
+  // The output has ceil(6 / strideY) x ceil(5 / strideX) elements.
+  %strideY_minus_one = arith.subi %strideY, %c1 : index
+  %strideX_minus_one = arith.subi %strideX, %c1 : index
+  %rows_ceil = arith.addi %c6, %strideY_minus_one : index
+  %cols_ceil = arith.addi %c5, %strideX_minus_one : index
+  %rows = arith.divui %rows_ceil, %strideY : index
+  %cols = arith.divui %cols_ceil, %strideX : index
+  %output = memref.alloc(%rows, %cols) : memref<?x?xf32>
+
+  dip.corrfft_2d_planned %input, %kernel_real, %kernel_imag, %row_twiddles, %col_twiddles, %output, %strideX, %strideY : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index
+
+  %error = scf.for %i = %c0 to %rows step %c1 iter_args(%row_error = %zero) -> (f32) {
+    %next_error = scf.for %j = %c0 to %cols step %c1 iter_args(%col_error = %row_error) -> (f32) {
+      %y = arith.muli %i, %strideY : index
+      %x = arith.muli %j, %strideX : index
+      %expected = memref.load %direct[%y, %x] : memref<6x5xf32>
+      %actual = memref.load %output[%i, %j] : memref<?x?xf32>
+      %diff = arith.subf %actual, %expected : f32
+      %abs = math.absf %diff : f32
+      %max = arith.maxf %col_error, %abs : f32
+      scf.yield %max : f32
+    }
+    scf.yield %next_error : f32
+  }
+  %agree = arith.cmpf olt, %error, %tolerance : f32
+  vector.print %agree : i1
+
+  memref.dealloc %output : memref<?x?xf32>
+  return
+}
+
+func.func @main() -> i32 {
+  %frame_a = memref.get_global @global_frame_a : memref<6x5xf32>
+  %frame_b = memref.get_global @global_frame_b : memref<6x5xf32>
+  %frame_a_padded = memref.get_global @global_frame_a_padded : memref<9x10xf32>
+  %frame_b_padded = memref.get_global @global_frame_b_padded : memref<9x10xf32>
+  %kernel = memref.get_global @global_kernel : memref<3x3xf32>
+  %kernel_padded = memref.get_global @global_kernel_padded : memref<9x10xf32>
+  %direct_a = memref.get_global @global_direct_a : memref<6x5xf32>
+  %direct_b = memref.get_global @global_direct_b : memref<6x5xf32>
+
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %c3 = arith.constant 3 : index
+  %c6 = arith.constant 6 : index
+  %c9 = arith.constant 9 : index
+  %c10 = arith.constant 10 : index
+  %zero = arith.constant 0. : f32
+
+  dip.corr_2d <CONSTANT_PADDING> %frame_a, %kernel, %direct_a, %c1, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+  dip.corr_2d <CONSTANT_PADDING> %frame_b, %kernel, %direct_b, %c1, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, f32
+
+  // Build the plan: twiddle tables for 10 columns and 9 rows, and the
+  // 9 x (10 / 2 + 1) kernel spectrum.
+  %row_table = memref.alloc(%c10) : memref<2x?xf32>
+  %col_table = memref.alloc(%c9) : memref<2x?xf32>
+  call @fill_twiddles(%row_table) : (memref<2x?xf32>) -> ()
+  call @fill_twiddles(%col_table) : (memref<2x?xf32>) -> ()
+  %row_twiddles = memref.cast %row_table : memref<2x?xf32> to memref<?x?xf32>
+  %col_twiddles = memref.cast %col_table : memref<2x?xf32> to memref<?x?xf32>
+  %kernel_real = memref.alloc(%c9, %c6) : memref<?x?xf32>
+  %kernel_imag = memref.alloc(%c9, %c6) : memref<?x?xf32>
+  %kernel_input = memref.cast %kernel_padded : memref<9x10xf32> to memref<?x?xf32>
+  dip.rfft_2d %kernel_input, %kernel_real, %kernel_imag, %row_twiddles, %col_twiddles : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+
+  // Every frame reuses the same spectrum and tables.
+  call @check_frame(%frame_a_padded, %direct_a, %kernel_real, %kernel_imag, %row_twiddles, %col_twiddles, %c1, %c1) : (memref<9x10xf32>, memref<6x5xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index) -> ()
+  // CHECK: 1
+  call @check_frame(%frame_b_padded, %direct_b, %kernel_real, %kernel_imag, %row_twiddles, %col_twiddles, %c1, %c1) : (memref<9x10xf32>, memref<6x5xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index) -> ()
+  // CHECK-NEXT: 1
+
+  // The folded transforms read the same tables at a coarser step.
+  call @check_frame(%frame_b_padded, %direct_b, %kernel_real, %kernel_imag, %row_twiddles, %col_twiddles, %c2, %c3) : (memref<9x10xf32>, memref<6x5xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index) -> ()
+  // CHECK-NEXT: 1
+
+  memref.dealloc %row_table : memref<2x?xf32>
+  memref.dealloc %col_table : memref<2x?xf32>
+  memref.dealloc %kernel_real : memref<?x?xf32>
+  memref.dealloc %kernel_imag : memref<?x?xf32>
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
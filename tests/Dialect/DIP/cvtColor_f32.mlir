@@ -0,0 +1,121 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// A 2x3 NHWC RGB image.
+memref.global "private" @global_rgb : memref<1x2x3x3xf32> = dense<[[[[1., 0. , 0.  ], [0. , 1. , 0. ], [0. , 0. , 1. ]],
+                                                                    [[1., 1. , 1.  ], [0.5, 0.25, 0.75], [0.2, 0.4, 0.6]]]]>
+
+// 2x6 YUV 4:2:0 frames of u8 values, written as i8: the Y plane followed by
+// interleaved U and V (NV12) or the U plane and the V plane (I420).
+memref.global "private" @global_nv12 : memref<3x6xi8> = dense<[[16, 50, 100, -106, -21, -1 ],
+                                                               [0 , 80, 120, -96 , -56, -16],
+                                                               [-128, -128, 90, -16, -56, 60]]>
+memref.global "private" @global_i420 : memref<3x6xi8> = dense<[[16, 50, 100, -106, -21, -1 ],
+                                                               [0 , 80, 120, -96 , -56, -16],
+                                                               [-128, 90, -56, -128, -16, 60]]>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %rgb = memref.get_global @global_rgb : memref<1x2x3x3xf32>
+  %nv12 = memref.get_global @global_nv12 : memref<3x6xi8>
+  %i420 = memref.get_global @global_i420 : memref<3x6xi8>
+  %one = arith.constant 1. : f32
+  %normalize = arith.constant 0.00392156862 : f32
+
+  %gray = memref.alloc() : memref<2x3xf32>
+  dip.cvt_color RGB2GRAY %rgb, %gray, %one : memref<1x2x3x3xf32>, memref<2x3xf32>, f32
+  %printed_gray = memref.cast %gray : memref<2x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_gray) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[0.299, 0.587, 0.114],
+  // CHECK{LITERAL}: [1, 0.38175, 0.363]]
+
+  // Interleaved channels are split with shuffles.
+  %yuv = memref.alloc() : memref<1x2x3x3xf32>
+  dip.cvt_color RGB2YUV %rgb, %yuv, %one : memref<1x2x3x3xf32>, memref<1x2x3x3xf32>, f32
+  %printed_yuv = memref.cast %yuv : memref<1x2x3x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_yuv) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 4 offset = 0 sizes = \[1, 2, 3, 3\] strides = \[18, 9, 3, 1\] data =}}
+  // CHECK{LITERAL}: [0.299, 0.352892, 1.11478]
+  // CHECK{LITERAL}: [0.587, 0.211196, -0.014799]
+  // CHECK{LITERAL}: [0.114, 0.935912, 0.400022]
+  // CHECK{LITERAL}: [1, 0.5, 0.5]
+  // CHECK{LITERAL}: [0.38175, 0.681179, 0.603705]
+  // CHECK{LITERAL}: [0.363, 0.616604, 0.357049]
+
+  // From NHWC to NCHW: hue, saturation and value planes.
+  %hsv = memref.alloc() : memref<1x3x2x3xf32>
+  dip.cvt_color RGB2HSV %rgb, %hsv, %one : memref<1x2x3x3xf32>, memref<1x3x2x3xf32>, f32
+  %printed_hsv = memref.cast %hsv : memref<1x3x2x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_hsv) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 4 offset = 0 sizes = \[1, 3, 2, 3\] strides = \[18, 6, 3, 1\] data =}}
+  // CHECK{LITERAL}: [0, 120, 240]
+  // CHECK{LITERAL}: [0, 270, 210]
+  // CHECK{LITERAL}: [1, 1, 1]
+  // CHECK{LITERAL}: [0, 0.666667, 0.666667]
+  // CHECK{LITERAL}: [1, 1, 1]
+  // CHECK{LITERAL}: [1, 0.75, 0.6]
+
+  // And back, where the saturation of 1 / (1 + FLT_EPSILON) of pure colors
+  // leaves the other channels just above 0, as in OpenCV.
+  %back = memref.alloc() : memref<1x2x3x3xf32>
+  dip.cvt_color HSV2RGB %hsv, %back, %one : memref<1x3x2x3xf32>, memref<1x2x3x3xf32>, f32
+  %printed_back = memref.cast %back : memref<1x2x3x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_back) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 4 offset = 0 sizes = \[1, 2, 3, 3\] strides = \[18, 9, 3, 1\] data =}}
+  // CHECK{LITERAL}: [1, 1.19209e-07, 1.19209e-07]
+  // CHECK{LITERAL}: [1.19209e-07, 1, 1.19209e-07]
+  // CHECK{LITERAL}: [1.19209e-07, 1.19209e-07, 1]
+  // CHECK{LITERAL}: [1, 1, 1]
+  // CHECK{LITERAL}: [0.5, 0.25, 0.75]
+  // CHECK{LITERAL}: [0.2, 0.4, 0.6]
+
+  // u8 frames are normalized to [0, 1] by the conversion. Times 255, the
+  // results are those of cv::cvtColor before rounding.
+  %from_nv12 = memref.alloc() : memref<1x2x6x3xf32>
+  dip.cvt_color YUV2RGB_NV12 %nv12, %from_nv12, %normalize : memref<3x6xi8>, memref<1x2x6x3xf32>, f32
+  %printed_from_nv12 = memref.cast %from_nv12 : memref<1x2x6x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_from_nv12) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 4 offset = 0 sizes = \[1, 2, 6, 3\] strides = \[36, 18, 3, 1\] data =}}
+  // CHECK{LITERAL}: [0, 0, 0]
+  // CHECK{LITERAL}: [0.1552, 0.1552, 0.1552]
+  // CHECK{LITERAL}: [1, 0.0846196, 0.0827138]
+  // CHECK{LITERAL}: [1, 0.312855, 0.310949]
+  // CHECK{LITERAL}: [0.574071, 1, 1]
+  // CHECK{LITERAL}: [0.665365, 1, 1]
+  // CHECK{LITERAL}: [0, 0, 0]
+  // CHECK{LITERAL}: [0.292141, 0.292141, 0.292141]
+  // CHECK{LITERAL}: [1, 0.175914, 0.174008]
+  // CHECK{LITERAL}: [1, 0.358502, 0.356596]
+  // CHECK{LITERAL}: [0.414306, 0.946306, 1]
+  // CHECK{LITERAL}: [0.596894, 1, 1]
+
+  // The same frame in I420, to NCHW.
+  %from_i420 = memref.alloc() : memref<1x3x2x6xf32>
+  dip.cvt_color YUV2RGB_I420 %i420, %from_i420, %normalize : memref<3x6xi8>, memref<1x3x2x6xf32>, f32
+  %printed_from_i420 = memref.cast %from_i420 : memref<1x3x2x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_from_i420) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 4 offset = 0 sizes = \[1, 3, 2, 6\] strides = \[36, 12, 6, 1\] data =}}
+  // CHECK{LITERAL}: [0, 0.1552, 1, 1, 0.574071, 0.665365]
+  // CHECK{LITERAL}: [0, 0.292141, 1, 1, 0.414306, 0.596894]
+  // CHECK{LITERAL}: [0, 0.1552, 0.0846196, 0.312855, 1, 1]
+  // CHECK{LITERAL}: [0, 0.292141, 0.175914, 0.358502, 0.946306, 1]
+  // CHECK{LITERAL}: [0, 0.1552, 0.0827138, 0.310949, 1, 1]
+  // CHECK{LITERAL}: [0, 0.292141, 0.174008, 0.356596, 1, 1]
+
+  memref.dealloc %gray : memref<2x3xf32>
+  memref.dealloc %yuv : memref<1x2x3x3xf32>
+  memref.dealloc %hsv : memref<1x3x2x3xf32>
+  memref.dealloc %back : memref<1x2x3x3xf32>
+  memref.dealloc %from_nv12 : memref<1x2x6x3xf32>
+  memref.dealloc %from_i420 : memref<1x3x2x6xf32>
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
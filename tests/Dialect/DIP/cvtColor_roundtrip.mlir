@@ -0,0 +1,19 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_cvt_color_rgb2gray_f32(%input : memref<1x?x?x3xf32>, %output : memref<?x?xf32>, %scale : f32) -> () {
+  // CHECK: dip.cvt_color RGB2GRAY {{.*}} : memref<1x?x?x3xf32>, memref<?x?xf32>, f32
+  dip.cvt_color RGB2GRAY %input, %output, %scale : memref<1x?x?x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @buddy_cvt_color_rgb2hsv_u8(%input : memref<?x3x?x?xi8>, %output : memref<?x?x?x3xf32>, %scale : f32) -> () {
+  // CHECK: dip.cvt_color RGB2HSV {{.*}} : memref<?x3x?x?xi8>, memref<?x?x?x3xf32>, f32
+  dip.cvt_color RGB2HSV %input, %output, %scale : memref<?x3x?x?xi8>, memref<?x?x?x3xf32>, f32
+  return
+}
+
+func.func @buddy_cvt_color_nv12_f64(%input : memref<?x?xi8>, %output : memref<1x3x?x?xf64>, %scale : f64) -> () {
+  // CHECK: dip.cvt_color YUV2RGB_NV12 {{.*}} : memref<?x?xi8>, memref<1x3x?x?xf64>, f64
+  dip.cvt_color YUV2RGB_NV12 %input, %output, %scale : memref<?x?xi8>, memref<1x3x?x?xf64>, f64
+  return
+}
@@ -0,0 +1,99 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// A diagonal step edge. With vectors of 4 lanes every row ends with a tail.
+memref.global "private" @global_input : memref<4x6xf32> = dense<[[10., 10., 10., 10., 40., 40.],
+                                                                 [10., 10., 10., 40., 40., 40.],
+                                                                 [10., 10., 40., 40., 40., 40.],
+                                                                 [10., 40., 40., 40., 40., 10.]]>
+
+memref.global "private" @global_magnitude : memref<4x6xf32> = dense<0.>
+memref.global "private" @global_gx : memref<4x6xf32> = dense<0.>
+memref.global "private" @global_gy : memref<4x6xf32> = dense<0.>
+memref.global "private" @global_direction : memref<4x6xi32> = dense<0>
+memref.global "private" @global_magnitude_scharr : memref<4x6xf32> = dense<0.>
+memref.global "private" @global_magnitude_wrap : memref<4x6xf32> = dense<0.>
+memref.global "private" @global_direction_wrap : memref<4x6xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<4x6xf32>
+  %magnitude = memref.get_global @global_magnitude : memref<4x6xf32>
+  %gx = memref.get_global @global_gx : memref<4x6xf32>
+  %gy = memref.get_global @global_gy : memref<4x6xf32>
+  %direction = memref.get_global @global_direction : memref<4x6xi32>
+  %magnitude_scharr = memref.get_global @global_magnitude_scharr : memref<4x6xf32>
+  %magnitude_wrap = memref.get_global @global_magnitude_wrap : memref<4x6xf32>
+  %direction_wrap = memref.get_global @global_direction_wrap : memref<4x6xf32>
+  %zero = arith.constant 0. : f32
+
+  dip.gradient_2d SOBEL L1_NORM <REPLICATE_PADDING> %input, %magnitude, %zero derivatives(%gx, %gy : memref<4x6xf32>, memref<4x6xf32>) direction(%direction : memref<4x6xi32>) : memref<4x6xf32>, memref<4x6xf32>, f32
+  %printed_gx = memref.cast %gx : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_gx) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 30, 120, 90, 0],
+  // CHECK{LITERAL}: [0, 30, 90, 90, 30, 0],
+  // CHECK{LITERAL}: [30, 90, 90, 30, -30, -30],
+  // CHECK{LITERAL}: [90, 120, 30, 0, -90, -90]]
+
+  %printed_gy = memref.cast %gy : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_gy) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 30, 60, 30, 0],
+  // CHECK{LITERAL}: [0, 30, 90, 90, 30, 0],
+  // CHECK{LITERAL}: [30, 90, 90, 30, -30, -90],
+  // CHECK{LITERAL}: [30, 60, 30, 0, -30, -90]]
+
+  %printed_magnitude = memref.cast %magnitude : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_magnitude) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 60, 180, 120, 0],
+  // CHECK{LITERAL}: [0, 60, 180, 180, 60, 0],
+  // CHECK{LITERAL}: [60, 180, 180, 60, 60, 120],
+  // CHECK{LITERAL}: [120, 180, 60, 0, 120, 180]]
+
+  %printed_direction = memref.cast %direction : memref<4x6xi32> to memref<*xi32>
+  call @printMemrefI32(%printed_direction) : (memref<*xi32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 1, 1, 0, 0],
+  // CHECK{LITERAL}: [0, 1, 1, 1, 1, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 1, 1, 2],
+  // CHECK{LITERAL}: [0, 1, 1, 0, 0, 1]]
+
+  // Zeros around the image make the borders steep.
+  dip.gradient_2d SCHARR L2_NORM <CONSTANT_PADDING> %input, %magnitude_scharr, %zero : memref<4x6xf32>, memref<4x6xf32>, f32
+  %printed_magnitude_scharr = memref.cast %magnitude_scharr : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_magnitude_scharr) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[183.848, 160, 265.707, 674.24, 706.824, 735.391],
+  // CHECK{LITERAL}: [160, 127.279, 551.543, 551.543, 127.279, 640],
+  // CHECK{LITERAL}: [265.707, 551.543, 551.543, 127.279, 127.279, 706.824],
+  // CHECK{LITERAL}: [449.222, 463.249, 557.315, 640, 706.824, 735.391]]
+
+  dip.gradient_2d SOBEL L1_NORM <WRAP_PADDING> %input, %magnitude_wrap, %zero direction(%direction_wrap : memref<4x6xf32>) : memref<4x6xf32>, memref<4x6xf32>, f32
+  %printed_magnitude_wrap = memref.cast %magnitude_wrap : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_magnitude_wrap) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[60, 120, 120, 120, 60, 180],
+  // CHECK{LITERAL}: [120, 60, 180, 180, 60, 120],
+  // CHECK{LITERAL}: [60, 180, 180, 60, 60, 180],
+  // CHECK{LITERAL}: [0, 120, 120, 120, 60, 120]]
+
+  %printed_direction_wrap = memref.cast %direction_wrap : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_direction_wrap) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 2, 2, 0, 1, 3],
+  // CHECK{LITERAL}: [0, 1, 1, 1, 1, 0],
+  // CHECK{LITERAL}: [0, 1, 1, 1, 1, 1],
+  // CHECK{LITERAL}: [0, 0, 2, 2, 1, 0]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
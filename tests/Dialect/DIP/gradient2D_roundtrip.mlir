@@ -0,0 +1,13 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_gradient2d_SOBEL_L2_NORM_REPLICATE_PADDING_f32(%input : memref<?x?xf32>, %magnitude : memref<?x?xf32>, %c : f32) -> () {
+  // CHECK: dip.gradient_2d SOBEL L2_NORM <REPLICATE_PADDING>{{.*}} : memref<?x?xf32>, memref<?x?xf32>, f32
+  dip.gradient_2d SOBEL L2_NORM <REPLICATE_PADDING> %input, %magnitude, %c : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @buddy_gradient2d_SCHARR_L1_NORM_CONSTANT_PADDING_f64(%input : memref<?x?xf64>, %magnitude : memref<?x?xf64>, %gx : memref<?x?xf64>, %gy : memref<?x?xf64>, %direction : memref<?x?xi8>, %c : f64) -> () {
+  // CHECK: dip.gradient_2d SCHARR L1_NORM <CONSTANT_PADDING>{{.*}} derivatives({{.*}} : memref<?x?xf64>, memref<?x?xf64>) direction({{.*}} : memref<?x?xi8>) : memref<?x?xf64>, memref<?x?xf64>, f64
+  dip.gradient_2d SCHARR L1_NORM <CONSTANT_PADDING> %input, %magnitude, %c derivatives(%gx, %gy : memref<?x?xf64>, memref<?x?xf64>) direction(%direction : memref<?x?xi8>) : memref<?x?xf64>, memref<?x?xf64>, f64
+  return
+}
@@ -0,0 +1,103 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_image : memref<4x6xf32> = dense<[[10., 10. , 20. , 200., 250., 30. ],
+                                                                 [40., 10. , 90. , 90. , 120., 30. ],
+                                                                 [60., 60. , 70. , 255., 80. , 80. ],
+                                                                 [60., 100., 110., 130., 140., 150.]]>
+
+memref.global "private" @global_indices : memref<2x5xf32> = dense<[[0., 1. , 2.7, 3., 4. ],
+                                                                   [5., 6.5, 7. , 8., -1.]]>
+
+memref.global "private" @global_squares : memref<8xf32> = dense<[0., 1., 4., 9., 16., 25., 36., 49.]>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %image = memref.get_global @global_image : memref<4x6xf32>
+  %indices = memref.get_global @global_indices : memref<2x5xf32>
+  %squares = memref.get_global @global_squares : memref<8xf32>
+  %c2 = arith.constant 2 : index
+  %c3 = arith.constant 3 : index
+  %low = arith.constant 50. : f32
+  %high = arith.constant 200. : f32
+  %zero = arith.constant 0. : f32
+  %full = arith.constant 256. : f32
+  %clip2 = arith.constant 2. : f32
+  %clip40 = arith.constant 40. : f32
+
+  // As cv::calcHist with 4 bins over [0, 256).
+  %hist4 = memref.alloc() : memref<4xi32>
+  dip.histogram_2d %image, %hist4, %zero, %full : memref<4x6xf32>, memref<4xi32>, f32, f32
+  %printed_hist4 = memref.cast %hist4 : memref<4xi32> to memref<*xi32>
+  call @printMemrefI32(%printed_hist4) : (memref<*xi32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 1 offset = 0 sizes = \[4\] strides = \[1\] data =}}
+  // CHECK{LITERAL}: [10, 8, 3, 3]
+
+  // Pixels outside of [50, 200) are not counted.
+  %hist3 = memref.alloc() : memref<3xi32>
+  dip.histogram_2d %image, %hist3, %low, %high : memref<4x6xf32>, memref<3xi32>, f32, f32
+  %printed_hist3 = memref.cast %hist3 : memref<3xi32> to memref<*xi32>
+  call @printMemrefI32(%printed_hist3) : (memref<*xi32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 1 offset = 0 sizes = \[3\] strides = \[1\] data =}}
+  // CHECK{LITERAL}: [8, 5, 1]
+
+  // As cv::equalizeHist.
+  %equalized = memref.alloc() : memref<4x6xf32>
+  dip.equalize_hist_2d %image, %equalized : memref<4x6xf32>, memref<4x6xf32>
+  %printed_equalized = memref.cast %equalized : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_equalized) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 12, 231, 243, 36],
+  // CHECK{LITERAL}: [49, 0, 146, 146, 182, 36],
+  // CHECK{LITERAL}: [85, 85, 97, 255, 121, 121],
+  // CHECK{LITERAL}: [85, 158, 170, 194, 206, 219]]
+
+  // As cv::createCLAHE(2, Size(2, 2)): 2x3 tiles, whose bins are clipped to
+  // a single pixel.
+  %clahe_clipped = memref.alloc() : memref<4x6xf32>
+  dip.clahe_2d %image, %clahe_clipped, %c2, %c2, %clip2 : memref<4x6xf32>, memref<4x6xf32>, index, index, f32
+  %printed_clahe_clipped = memref.cast %clahe_clipped : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_clahe_clipped) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[85, 85, 114, 234, 255, 85],
+  // CHECK{LITERAL}: [170, 85, 198, 170, 177, 85],
+  // CHECK{LITERAL}: [128, 128, 135, 255, 96, 85],
+  // CHECK{LITERAL}: [85, 170, 191, 192, 184, 212]]
+
+  // As cv::createCLAHE(40, Size(3, 2)): 2x2 tiles, too small to clip.
+  %clahe = memref.alloc() : memref<4x6xf32>
+  dip.clahe_2d %image, %clahe, %c3, %c2, %clip40 : memref<4x6xf32>, memref<4x6xf32>, index, index, f32
+  %printed_clahe = memref.cast %clahe : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_clahe) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[128, 128, 128, 255, 255, 128],
+  // CHECK{LITERAL}: [191, 128, 191, 191, 191, 128],
+  // CHECK{LITERAL}: [160, 160, 128, 255, 112, 128],
+  // CHECK{LITERAL}: [128, 191, 160, 191, 191, 255]]
+
+  // Indices are truncated and clamped to the table.
+  %mapped = memref.alloc() : memref<2x5xf32>
+  dip.lut_2d %indices, %squares, %mapped : memref<2x5xf32>, memref<8xf32>, memref<2x5xf32>
+  %printed_mapped = memref.cast %mapped : memref<2x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_mapped) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 1, 4, 9, 16],
+  // CHECK{LITERAL}: [25, 36, 49, 49, 0]]
+
+  memref.dealloc %hist4 : memref<4xi32>
+  memref.dealloc %hist3 : memref<3xi32>
+  memref.dealloc %equalized : memref<4x6xf32>
+  memref.dealloc %clahe_clipped : memref<4x6xf32>
+  memref.dealloc %clahe : memref<4x6xf32>
+  memref.dealloc %mapped : memref<2x5xf32>
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,25 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_histogram2d_f32(%input : memref<?x?xf32>, %hist : memref<?xi32>, %low : f32, %high : f32) -> () {
+  // CHECK: dip.histogram_2d {{.*}} : memref<?x?xf32>, memref<?xi32>, f32, f32
+  dip.histogram_2d %input, %hist, %low, %high : memref<?x?xf32>, memref<?xi32>, f32, f32
+  return
+}
+
+func.func @buddy_equalize_hist2d_f32(%input : memref<?x?xf32>, %output : memref<?x?xf32>) -> () {
+  // CHECK: dip.equalize_hist_2d {{.*}} : memref<?x?xf32>, memref<?x?xf32>
+  dip.equalize_hist_2d %input, %output : memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_clahe2d_f64(%input : memref<?x?xf64>, %output : memref<?x?xf64>, %tilesX : index, %tilesY : index, %clipLimit : f64) -> () {
+  // CHECK: dip.clahe_2d {{.*}} : memref<?x?xf64>, memref<?x?xf64>, index, index, f64
+  dip.clahe_2d %input, %output, %tilesX, %tilesY, %clipLimit : memref<?x?xf64>, memref<?x?xf64>, index, index, f64
+  return
+}
+
+func.func @buddy_lut2d_f32_i32(%input : memref<?x?xf32>, %lut : memref<?xi32>, %output : memref<?x?xi32>) -> () {
+  // CHECK: dip.lut_2d {{.*}} : memref<?x?xf32>, memref<?xi32>, memref<?x?xi32>
+  dip.lut_2d %input, %lut, %output : memref<?x?xf32>, memref<?xi32>, memref<?x?xi32>
+  return
+}
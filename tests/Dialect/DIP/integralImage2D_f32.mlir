@@ -0,0 +1,71 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_ramp : memref<3x4xf32> = dense<[[0., 1., 2. , 3. ],
+                                                                [4., 5., 6. , 7. ],
+                                                                [8., 9., 10., 11.]]>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+func.func private @printMemrefF64(memref<*xf64>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %ramp = memref.get_global @global_ramp : memref<3x4xf32>
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %c4 = arith.constant 4 : index
+  %constant = arith.constant 4. : f32
+
+  // The sums may be wider than the input.
+  %sum = memref.alloc() : memref<4x5xf32>
+  %square_sum = memref.alloc() : memref<4x5xf64>
+  dip.integral_image_2d %ramp, %sum, %square_sum : memref<3x4xf32>, memref<4x5xf32>, memref<4x5xf64>
+  %printed_sum = memref.cast %sum : memref<4x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_sum) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 1, 3, 6],
+  // CHECK{LITERAL}: [0, 4, 10, 18, 28],
+  // CHECK{LITERAL}: [0, 12, 27, 45, 66]]
+  %printed_square_sum = memref.cast %square_sum : memref<4x5xf64> to memref<*xf64>
+  call @printMemrefF64(%printed_square_sum) : (memref<*xf64>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 1, 5, 14],
+  // CHECK{LITERAL}: [0, 16, 42, 82, 140],
+  // CHECK{LITERAL}: [0, 80, 187, 327, 506]]
+
+  // 2x2 boxes anchored at their top left corner read the constant past the
+  // bottom and right borders.
+  %box_constant = memref.alloc() : memref<3x4xf32>
+  dip.box_filter_2d <CONSTANT_PADDING> %ramp, %box_constant, %c2, %c2, %c0, %c0, %constant : memref<3x4xf32>, memref<3x4xf32>, index, index, index, index, f32
+  %printed_box_constant = memref.cast %box_constant : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_box_constant) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[2.5, 3.5, 4.5, 4.5],
+  // CHECK{LITERAL}: [6.5, 7.5, 8.5, 6.5],
+  // CHECK{LITERAL}: [6.25, 6.75, 7.25, 5.75]]
+
+  // 4x1 boxes replicate the first and last columns.
+  %box_replicate = memref.alloc() : memref<3x4xf32>
+  dip.box_filter_2d <REPLICATE_PADDING> %ramp, %box_replicate, %c4, %c1, %c1, %c0, %constant : memref<3x4xf32>, memref<3x4xf32>, index, index, index, index, f32
+  %printed_box_replicate = memref.cast %box_replicate : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_box_replicate) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0.75, 1.5, 2.25, 2.75],
+  // CHECK{LITERAL}: [4.75, 5.5, 6.25, 6.75],
+  // CHECK{LITERAL}: [8.75, 9.5, 10.25, 10.75]]
+
+  memref.dealloc %sum : memref<4x5xf32>
+  memref.dealloc %square_sum : memref<4x5xf64>
+  memref.dealloc %box_constant : memref<3x4xf32>
+  memref.dealloc %box_replicate : memref<3x4xf32>
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,19 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_integral_image2d_f32(%input : memref<?x?xf32>, %sum : memref<?x?xf64>) -> () {
+  // CHECK: dip.integral_image_2d {{.*}} : memref<?x?xf32>, memref<?x?xf64>
+  dip.integral_image_2d %input, %sum : memref<?x?xf32>, memref<?x?xf64>
+  return
+}
+
+func.func @buddy_integral_image2d_square_f64(%input : memref<?x?xf64>, %sum : memref<?x?xf64>, %square_sum : memref<?x?xf64>) -> () {
+  // CHECK: dip.integral_image_2d {{.*}} : memref<?x?xf64>, memref<?x?xf64>, memref<?x?xf64>
+  dip.integral_image_2d %input, %sum, %square_sum : memref<?x?xf64>, memref<?x?xf64>, memref<?x?xf64>
+  return
+}
+
+func.func @buddy_box_filter2d_f32(%input : memref<?x?xf32>, %output : memref<?x?xf32>, %width : index, %height : index, %centerX : index, %centerY : index, %constant : f32) -> () {
+  // CHECK: dip.box_filter_2d <REPLICATE_PADDING>{{.*}} : memref<?x?xf32>, memref<?x?xf32>, index, index, index, index, f32
+  dip.box_filter_2d <REPLICATE_PADDING> %input, %output, %width, %height, %centerX, %centerY, %constant : memref<?x?xf32>, memref<?x?xf32>, index, index, index, index, f32
+  return
+}
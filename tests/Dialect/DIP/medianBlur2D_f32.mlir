@@ -0,0 +1,75 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// A ramp with salt (255) and pepper (0) pixels. With vectors of 4 lanes the
+// 7x7 windows span three vectors of sorted columns.
+memref.global "private" @global_input : memref<5x7xf32> = dense<[[10., 11. , 255., 13., 14. , 15., 16. ],
+                                                                 [17., 0.  , 19. , 20., 255., 22., 23. ],
+                                                                 [255., 25., 26. , 27., 28. , 0. , 30. ],
+                                                                 [31., 32. , 33. , 0. , 35. , 36., 255.],
+                                                                 [38., 255., 40. , 41., 42. , 43., 44. ]]>
+
+memref.global "private" @global_output_3x3 : memref<5x7xf32> = dense<0.>
+memref.global "private" @global_output_5x5 : memref<5x7xf32> = dense<0.>
+memref.global "private" @global_output_7x7 : memref<5x7xf32> = dense<0.>
+memref.global "private" @global_output_wrap : memref<5x7xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<5x7xf32>
+  %output_3x3 = memref.get_global @global_output_3x3 : memref<5x7xf32>
+  %output_5x5 = memref.get_global @global_output_5x5 : memref<5x7xf32>
+  %output_7x7 = memref.get_global @global_output_7x7 : memref<5x7xf32>
+  %output_wrap = memref.get_global @global_output_wrap : memref<5x7xf32>
+  %zero = arith.constant 0. : f32
+
+  dip.median_blur_2d <REPLICATE_PADDING> %input, %output_3x3, %zero {kernel_size = 3} : memref<5x7xf32>, memref<5x7xf32>, f32
+  %printed_3x3 = memref.cast %output_3x3 : memref<5x7xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_3x3) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[10, 11, 13, 19, 15, 16, 16],
+  // CHECK{LITERAL}: [17, 19, 20, 26, 20, 22, 22],
+  // CHECK{LITERAL}: [31, 26, 25, 27, 27, 30, 30],
+  // CHECK{LITERAL}: [38, 33, 32, 33, 35, 36, 43],
+  // CHECK{LITERAL}: [38, 38, 40, 40, 41, 43, 44]]
+
+  // Windows reaching two pixels past the corners hold more zeros than pixels.
+  dip.median_blur_2d <CONSTANT_PADDING> %input, %output_5x5, %zero {kernel_size = 5} : memref<5x7xf32>, memref<5x7xf32>, f32
+  %printed_5x5 = memref.cast %output_5x5 : memref<5x7xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_5x5) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 11, 11, 14, 0, 0],
+  // CHECK{LITERAL}: [0, 11, 19, 19, 20, 14, 0],
+  // CHECK{LITERAL}: [11, 20, 28, 27, 28, 22, 15],
+  // CHECK{LITERAL}: [0, 19, 27, 26, 27, 22, 0],
+  // CHECK{LITERAL}: [0, 0, 26, 25, 26, 0, 0]]
+
+  dip.median_blur_2d <REFLECT_101_PADDING> %input, %output_7x7, %zero {kernel_size = 7} : memref<5x7xf32>, memref<5x7xf32>, f32
+  %printed_7x7 = memref.cast %output_7x7 : memref<5x7xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_7x7) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[25, 26, 25, 26, 25, 27, 23],
+  // CHECK{LITERAL}: [25, 26, 25, 26, 25, 27, 27],
+  // CHECK{LITERAL}: [25, 28, 27, 28, 27, 30, 27],
+  // CHECK{LITERAL}: [27, 28, 28, 30, 28, 28, 28],
+  // CHECK{LITERAL}: [26, 28, 28, 30, 28, 30, 28]]
+
+  dip.median_blur_2d <WRAP_PADDING> %input, %output_wrap, %zero {kernel_size = 3} : memref<5x7xf32>, memref<5x7xf32>, f32
+  %printed_wrap = memref.cast %output_wrap : memref<5x7xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_wrap) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[17, 19, 20, 40, 22, 23, 22],
+  // CHECK{LITERAL}: [17, 19, 20, 26, 20, 22, 17],
+  // CHECK{LITERAL}: [30, 26, 25, 27, 27, 30, 30],
+  // CHECK{LITERAL}: [38, 33, 32, 33, 35, 36, 38],
+  // CHECK{LITERAL}: [32, 33, 33, 35, 35, 36, 36]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,13 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_median_blur2d_REPLICATE_PADDING_f32(%input : memref<?x?xf32>, %output : memref<?x?xf32>, %c : f32) -> () {
+  // CHECK: dip.median_blur_2d <REPLICATE_PADDING>{{.*}}{kernel_size = 5 : i64} : memref<?x?xf32>, memref<?x?xf32>, f32
+  dip.median_blur_2d <REPLICATE_PADDING> %input, %output, %c {kernel_size = 5} : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @buddy_median_blur2d_CONSTANT_PADDING_i32(%input : memref<?x?xi32>, %output : memref<?x?xi32>, %c : i32) -> () {
+  // CHECK: dip.median_blur_2d <CONSTANT_PADDING>{{.*}}{kernel_size = 3 : i64} : memref<?x?xi32>, memref<?x?xi32>, i32
+  dip.median_blur_2d <CONSTANT_PADDING> %input, %output, %c {kernel_size = 3} : memref<?x?xi32>, memref<?x?xi32>, i32
+  return
+}
@@ -0,0 +1,105 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<6x5xf32> = dense<[[7., 3., 9., 1., 5.],
+                                                                 [2., 8., 4., 6., 0.],
+                                                                 [9., 1., 7., 3., 8.],
+                                                                 [4., 6., 2., 9., 5.],
+                                                                 [3., 9., 5., 1., 7.],
+                                                                 [8., 2., 6., 4., 3.]]>
+
+memref.global "private" @global_cross : memref<3x3xf32> = dense<[[0., 1., 0.],
+                                                                 [1., 1., 1.],
+                                                                 [0., 1., 0.]]>
+memref.global "private" @global_box : memref<3x3xf32> = dense<[[1., 1., 1.],
+                                                               [1., 1., 1.],
+                                                               [1., 1., 1.]]>
+
+memref.global "private" @global_output_opening : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_bottomhat : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_morphgrad : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_tophat_box : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_morphgrad_box : memref<6x5xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<6x5xf32>
+  %cross = memref.get_global @global_cross : memref<3x3xf32>
+  %box = memref.get_global @global_box : memref<3x3xf32>
+  %output_opening = memref.get_global @global_output_opening : memref<6x5xf32>
+  %output_bottomhat = memref.get_global @global_output_bottomhat : memref<6x5xf32>
+  %output_morphgrad = memref.get_global @global_output_morphgrad : memref<6x5xf32>
+  %output_tophat_box = memref.get_global @global_output_tophat_box : memref<6x5xf32>
+  %output_morphgrad_box = memref.get_global @global_output_morphgrad_box : memref<6x5xf32>
+
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %zero = arith.constant 0. : f32
+
+  // Four applications, alternating between the two halves of the band buffer.
+  dip.opening_2d <REPLICATE_PADDING> %input, %cross, %output_opening, %c1, %c1, %c2, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_opening = memref.cast %output_opening : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_opening) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[2, 2, 2, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 1, 1, 0],
+  // CHECK{LITERAL}: [2, 1, 1, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 1, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 2, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 1]]
+
+  dip.bottomhat_2d <REPLICATE_PADDING> %input, %cross, %output_bottomhat, %c1, %c1, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_bottomhat = memref.cast %output_bottomhat : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_bottomhat) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 4, 0, 4, 0],
+  // CHECK{LITERAL}: [5, 0, 2, 0, 5],
+  // CHECK{LITERAL}: [0, 6, 0, 3, 0],
+  // CHECK{LITERAL}: [5, 3, 5, 0, 2],
+  // CHECK{LITERAL}: [5, 0, 1, 5, 0],
+  // CHECK{LITERAL}: [0, 4, 0, 2, 3]]
+
+  // The dilation chain subtracts the erosion chain that it finds in the output.
+  dip.morphgrad_2d <REPLICATE_PADDING> %input, %cross, %output_morphgrad, %c1, %c1, %c2, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_morphgrad = memref.cast %output_morphgrad : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_morphgrad) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[7, 8, 8, 9, 9],
+  // CHECK{LITERAL}: [8, 8, 9, 9, 8],
+  // CHECK{LITERAL}: [8, 8, 8, 9, 9],
+  // CHECK{LITERAL}: [8, 8, 8, 8, 9],
+  // CHECK{LITERAL}: [7, 8, 8, 8, 8],
+  // CHECK{LITERAL}: [7, 7, 8, 8, 6]]
+
+  // Rectangular elements run every application in place on the output.
+  dip.tophat_2d <REPLICATE_PADDING> %input, %box, %output_tophat_box, %c1, %c1, %c2, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_tophat_box = memref.cast %output_tophat_box : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_tophat_box) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[6, 2, 8, 0, 5],
+  // CHECK{LITERAL}: [1, 7, 3, 5, 0],
+  // CHECK{LITERAL}: [8, 0, 6, 2, 7],
+  // CHECK{LITERAL}: [2, 4, 0, 8, 4],
+  // CHECK{LITERAL}: [1, 7, 3, 0, 6],
+  // CHECK{LITERAL}: [6, 0, 4, 3, 2]]
+
+  dip.morphgrad_2d <CONSTANT_PADDING> %input, %box, %output_morphgrad_box, %c1, %c1, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_morphgrad_box = memref.cast %output_morphgrad_box : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_morphgrad_box) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[8, 9, 9, 9, 6],
+  // CHECK{LITERAL}: [9, 8, 8, 9, 8],
+  // CHECK{LITERAL}: [9, 8, 8, 9, 9],
+  // CHECK{LITERAL}: [9, 8, 8, 8, 9],
+  // CHECK{LITERAL}: [9, 7, 8, 8, 9],
+  // CHECK{LITERAL}: [9, 9, 9, 7, 7]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,100 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<6x5xf32> = dense<[[7., 3., 9., 1., 5.],
+                                                                 [2., 8., 4., 6., 0.],
+                                                                 [9., 1., 7., 3., 8.],
+                                                                 [4., 6., 2., 9., 5.],
+                                                                 [3., 9., 5., 1., 7.],
+                                                                 [8., 2., 6., 4., 3.]]>
+
+// Rectangular structuring elements take the van Herk/Gil-Werman path.
+memref.global "private" @global_box : memref<3x3xf32> = dense<[[1., 1., 1.],
+                                                               [1., 1., 1.],
+                                                               [1., 1., 1.]]>
+memref.global "private" @global_line : memref<3x3xf32> = dense<[[0., 0., 0.],
+                                                                [1., 1., 1.],
+                                                                [0., 0., 0.]]>
+memref.global "private" @global_column : memref<4x1xf32> = dense<[[1.], [1.], [1.], [1.]]>
+// Any other shape takes the banded window traversal.
+memref.global "private" @global_holes : memref<3x3xf32> = dense<[[0., 1., 1.],
+                                                                 [1., 1., 1.],
+                                                                 [1., 1., 1.]]>
+
+memref.global "private" @global_output_box : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_line : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_column : memref<6x5xf32> = dense<0.>
+memref.global "private" @global_output_holes : memref<6x5xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<6x5xf32>
+  %box = memref.get_global @global_box : memref<3x3xf32>
+  %line = memref.get_global @global_line : memref<3x3xf32>
+  %column = memref.get_global @global_column : memref<4x1xf32>
+  %holes = memref.get_global @global_holes : memref<3x3xf32>
+  %output_box = memref.get_global @global_output_box : memref<6x5xf32>
+  %output_line = memref.get_global @global_output_line : memref<6x5xf32>
+  %output_column = memref.get_global @global_output_column : memref<6x5xf32>
+  %output_holes = memref.get_global @global_output_holes : memref<6x5xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %hundred = arith.constant 100. : f32
+  %zero = arith.constant 0. : f32
+  %minus_five = arith.constant -5. : f32
+
+  dip.erosion_2d <CONSTANT_PADDING> %input, %box, %output_box, %c1, %c1, %c1, %hundred : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_box = memref.cast %output_box : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_box) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[2, 2, 1, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 1, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 1, 1, 1]]
+
+  dip.dilation_2d <REPLICATE_PADDING> %input, %line, %output_line, %c1, %c1, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_line = memref.cast %output_line : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_line) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[7, 9, 9, 9, 5],
+  // CHECK{LITERAL}: [8, 8, 8, 6, 6],
+  // CHECK{LITERAL}: [9, 9, 7, 8, 8],
+  // CHECK{LITERAL}: [6, 6, 9, 9, 9],
+  // CHECK{LITERAL}: [9, 9, 9, 7, 7],
+  // CHECK{LITERAL}: [8, 8, 6, 6, 4]]
+
+  // An even height anchored off center; the padding never wins the max.
+  dip.dilation_2d <CONSTANT_PADDING> %input, %column, %output_column, %c0, %c1, %c1, %minus_five : memref<6x5xf32>, memref<4x1xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_column = memref.cast %output_column : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_column) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[9, 8, 9, 6, 8],
+  // CHECK{LITERAL}: [9, 8, 9, 9, 8],
+  // CHECK{LITERAL}: [9, 9, 7, 9, 8],
+  // CHECK{LITERAL}: [9, 9, 7, 9, 8],
+  // CHECK{LITERAL}: [8, 9, 6, 9, 7],
+  // CHECK{LITERAL}: [8, 9, 6, 4, 7]]
+
+  dip.erosion_2d <REPLICATE_PADDING> %input, %holes, %output_holes, %c1, %c1, %c1, %zero : memref<6x5xf32>, memref<3x3xf32>, memref<6x5xf32>, index, index, index, f32
+  %printed_holes = memref.cast %output_holes : memref<6x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_holes) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[2, 2, 1, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 0, 0],
+  // CHECK{LITERAL}: [1, 1, 1, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 1, 1, 1],
+  // CHECK{LITERAL}: [2, 2, 1, 1, 3]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,170 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=2" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_ramp : memref<4x6xf32> = dense<[[0. , 1. , 2. , 3. , 4. , 5. ],
+                                                                [6. , 7. , 8. , 9. , 10., 11.],
+                                                                [12., 13., 14., 15., 16., 17.],
+                                                                [18., 19., 20., 21., 22., 23.]]>
+
+memref.global "private" @global_flat : memref<5x7xf32> = dense<7.>
+
+memref.global "private" @global_pattern : memref<5x7xf32> = dense<[[0., 2., 0., 2., 0., 2., 0.],
+                                                                   [1., 0., 3., 2., 1., 0., 3.],
+                                                                   [2., 2., 2., 2., 2., 2., 2.],
+                                                                   [3., 0., 1., 2., 3., 0., 1.],
+                                                                   [0., 2., 0., 2., 0., 2., 0.]]>
+
+// Taps of the upsampling kernel at even and odd destinations, as cv::pyrUp.
+memref.global "private" @global_up_taps : memref<2x3xf32> = dense<[[0.125, 0.75, 0.125],
+                                                                   [0.   , 0.5 , 0.5  ]]>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+// output = laplacian + up(coarse) with replicated borders, which restores the
+// finer Gaussian level of a Laplacian pyramid.
+func.func @pyramidUpAdd(%coarse : memref<?x?xf32>, %laplacian : memref<?x?xf32>, %output : memref<?x?xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %c3 = arith.constant 3 : index
+  %taps = memref.get_global @global_up_taps : memref<2x3xf32>
+  %rows = memref.dim %output, %c0 : memref<?x?xf32>
+  %cols = memref.dim %output, %c1 : memref<?x?xf32>
+  %coarse_rows = memref.dim %coarse, %c0 : memref<?x?xf32>
+  %coarse_cols = memref.dim %coarse, %c1 : memref<?x?xf32>
+  %last_row = arith.subi %coarse_rows, %c1 : index
+  %last_col = arith.subi %coarse_cols, %c1 : index
+  scf.for %y = %c0 to %rows step %c1 {
+    %center_y = arith.divui %y, %c2 : index
+    %parity_y = arith.remui %y, %c2 : index
+    scf.for %x = %c0 to %cols step %c1 {
+      %center_x = arith.divui %x, %c2 : index
+      %parity_x = arith.remui %x, %c2 : index
+      %init = memref.load %laplacian[%y, %x] : memref<?x?xf32>
+      %sum = scf.for %ky = %c0 to %c3 step %c1 iter_args(%acc_y = %init) -> (f32) {
+        %weight_y = memref.load %taps[%parity_y, %ky] : memref<2x3xf32>
+        %next_y = arith.addi %center_y, %ky : index
+        %tap_y = arith.subi %next_y, %c1 : index
+        %low_y = arith.maxsi %tap_y, %c0 : index
+        %row = arith.minsi %low_y, %last_row : index
+        %row_sum = scf.for %kx = %c0 to %c3 step %c1 iter_args(%acc_x = %acc_y) -> (f32) {
+          %weight_x = memref.load %taps[%parity_x, %kx] : memref<2x3xf32>
+          %next_x = arith.addi %center_x, %kx : index
+          %tap_x = arith.subi %next_x, %c1 : index
+          %low_x = arith.maxsi %tap_x, %c0 : index
+          %col = arith.minsi %low_x, %last_col : index
+          %pixel = memref.load %coarse[%row, %col] : memref<?x?xf32>
+          %weight = arith.mulf %weight_y, %weight_x : f32
+          %term = arith.mulf %weight, %pixel : f32
+          %acc = arith.addf %acc_x, %term : f32
+          scf.yield %acc : f32
+        }
+        scf.yield %row_sum : f32
+      }
+      memref.store %sum, %output[%y, %x] : memref<?x?xf32>
+    }
+  }
+  return
+}
+
+func.func @main() -> i32 {
+  %ramp = memref.get_global @global_ramp : memref<4x6xf32>
+  %flat = memref.get_global @global_flat : memref<5x7xf32>
+  %pattern = memref.get_global @global_pattern : memref<5x7xf32>
+
+  // The blur keeps a ramp inside the image and bends it at the replicated
+  // borders.
+  %level1 = memref.alloc() : memref<2x3xf32>
+  %level2 = memref.alloc() : memref<1x2xf32>
+  dip.gaussian_pyramid_2d <REPLICATE_PADDING> %ramp, %level1, %level2 : memref<4x6xf32>, memref<2x3xf32>, memref<1x2xf32>
+  %printed_level1 = memref.cast %level1 : memref<2x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_level1) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[2.625, 4.25, 6.1875],
+  // CHECK{LITERAL}: [12, 13.625, 15.5625]]
+  %printed_level2 = memref.cast %level2 : memref<1x2xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_level2) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[1, 2\] strides = \[2, 1\] data =}}
+  // CHECK{LITERAL}: [[6.18359, 8.41016]]
+
+  // Upsampling reproduces a flat level, so its Laplacian levels are zero and
+  // the residual keeps the image.
+  %laplacian0 = memref.alloc() : memref<5x7xf32>
+  %laplacian1 = memref.alloc() : memref<3x4xf32>
+  %residual = memref.alloc() : memref<2x2xf32>
+  dip.laplacian_pyramid_2d <REPLICATE_PADDING> %flat, %laplacian0, %laplacian1, %residual : memref<5x7xf32>, memref<5x7xf32>, memref<3x4xf32>, memref<2x2xf32>
+  %printed_laplacian1 = memref.cast %laplacian1 : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_laplacian1) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0]]
+  %printed_residual = memref.cast %residual : memref<2x2xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_residual) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 2\] strides = \[2, 1\] data =}}
+  // CHECK{LITERAL}: [[7, 7],
+  // CHECK{LITERAL}: [7, 7]]
+
+  // Every level of a pattern in [0, 3] is exact in f32, so adding the
+  // upsampled levels back from the residual restores the input exactly.
+  %pattern_laplacian0 = memref.alloc() : memref<5x7xf32>
+  %pattern_laplacian1 = memref.alloc() : memref<3x4xf32>
+  %pattern_residual = memref.alloc() : memref<2x2xf32>
+  dip.laplacian_pyramid_2d <REPLICATE_PADDING> %pattern, %pattern_laplacian0, %pattern_laplacian1, %pattern_residual : memref<5x7xf32>, memref<5x7xf32>, memref<3x4xf32>, memref<2x2xf32>
+  %printed_pattern_laplacian0 = memref.cast %pattern_laplacian0 : memref<5x7xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_pattern_laplacian0) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[-0.859375, 0.953125, -1.2207, 0.757812, -1.18652, 0.871094, -1.08496],
+  // CHECK{LITERAL}: [-0.164062, -1.28125, 1.60938, 0.59375, -0.371094, -1.32812, 1.70703],
+  // CHECK{LITERAL}: [0.600586, 0.550781, 0.500977, 0.484375, 0.500977, 0.550781, 0.600586],
+  // CHECK{LITERAL}: [1.70703, -1.32812, -0.371094, 0.59375, 1.60938, -1.28125, -0.164062],
+  // CHECK{LITERAL}: [-1.08496, 0.871094, -1.18652, 0.757812, -1.2207, 0.953125, -0.859375]]
+  %printed_pattern_laplacian1 = memref.cast %pattern_laplacian1 : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_pattern_laplacian1) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[-0.394646, 0.113495, -0.0658646, -0.208984],
+  // CHECK{LITERAL}: [0.442932, 0.473389, 0.441345, 0.368164],
+  // CHECK{LITERAL}: [-0.15699, -0.0417175, 0.073555, -0.492188]]
+  %printed_pattern_residual = memref.cast %pattern_residual : memref<2x2xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_pattern_residual) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 2\] strides = \[2, 1\] data =}}
+  // CHECK{LITERAL}: [[1.04907, 1.21387],
+  // CHECK{LITERAL}: [1.1687, 1.1748]]
+
+  %gaussian1 = memref.alloc() : memref<3x4xf32>
+  %reconstructed = memref.alloc() : memref<5x7xf32>
+  %residual_dyn = memref.cast %pattern_residual : memref<2x2xf32> to memref<?x?xf32>
+  %laplacian1_dyn = memref.cast %pattern_laplacian1 : memref<3x4xf32> to memref<?x?xf32>
+  %gaussian1_dyn = memref.cast %gaussian1 : memref<3x4xf32> to memref<?x?xf32>
+  %laplacian0_dyn = memref.cast %pattern_laplacian0 : memref<5x7xf32> to memref<?x?xf32>
+  %reconstructed_dyn = memref.cast %reconstructed : memref<5x7xf32> to memref<?x?xf32>
+  call @pyramidUpAdd(%residual_dyn, %laplacian1_dyn, %gaussian1_dyn) : (memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>) -> ()
+  call @pyramidUpAdd(%gaussian1_dyn, %laplacian0_dyn, %reconstructed_dyn) : (memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>) -> ()
+  %printed_reconstructed = memref.cast %reconstructed : memref<5x7xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_reconstructed) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 2, 0, 2, 0, 2, 0],
+  // CHECK{LITERAL}: [1, 0, 3, 2, 1, 0, 3],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 2, 2, 2],
+  // CHECK{LITERAL}: [3, 0, 1, 2, 3, 0, 1],
+  // CHECK{LITERAL}: [0, 2, 0, 2, 0, 2, 0]]
+
+  memref.dealloc %level1 : memref<2x3xf32>
+  memref.dealloc %level2 : memref<1x2xf32>
+  memref.dealloc %laplacian0 : memref<5x7xf32>
+  memref.dealloc %laplacian1 : memref<3x4xf32>
+  memref.dealloc %residual : memref<2x2xf32>
+  memref.dealloc %pattern_laplacian0 : memref<5x7xf32>
+  memref.dealloc %pattern_laplacian1 : memref<3x4xf32>
+  memref.dealloc %pattern_residual : memref<2x2xf32>
+  memref.dealloc %gaussian1 : memref<3x4xf32>
+  memref.dealloc %reconstructed : memref<5x7xf32>
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
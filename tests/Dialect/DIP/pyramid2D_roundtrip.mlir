@@ -0,0 +1,13 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_gaussian_pyramid2d_f32(%input : memref<?x?xf32>, %level1 : memref<?x?xf32>, %level2 : memref<?x?xf32>) -> () {
+  // CHECK: dip.gaussian_pyramid_2d <REPLICATE_PADDING>{{.*}} : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  dip.gaussian_pyramid_2d <REPLICATE_PADDING> %input, %level1, %level2 : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_laplacian_pyramid2d_f64(%input : memref<?x?xf64>, %laplacian : memref<?x?xf64>, %residual : memref<?x?xf64>) -> () {
+  // CHECK: dip.laplacian_pyramid_2d <CONSTANT_PADDING>{{.*}} : memref<?x?xf64>, memref<?x?xf64>, memref<?x?xf64>
+  dip.laplacian_pyramid_2d <CONSTANT_PADDING> %input, %laplacian, %residual : memref<?x?xf64>, memref<?x?xf64>, memref<?x?xf64>
+  return
+}
@@ -0,0 +1,132 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=2" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_ramp : memref<4x6xf32> = dense<[[0. , 1. , 2. , 3. , 4. , 5. ],
+                                                                [6. , 7. , 8. , 9. , 10., 11.],
+                                                                [12., 13., 14., 15., 16., 17.],
+                                                                [18., 19., 20., 21., 22., 23.]]>
+
+memref.global "private" @global_flat : memref<5x7xf32> = dense<7.>
+
+memref.global "private" @global_square5 : memref<5x5xf32> = dense<[[3., 1., 6., 7., 2.],
+                                                                   [3., 2., 6., 8., 6.],
+                                                                   [5., 6., 3., 5., 5.],
+                                                                   [1., 5., 0., 5., 8.],
+                                                                   [7., 7., 0., 6., 5.]]>
+
+memref.global "private" @global_square3 : memref<3x3xf32> = dense<[[8., 4., 7.],
+                                                                   [6., 8., 6.],
+                                                                   [8., 8., 4.]]>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %ramp = memref.get_global @global_ramp : memref<4x6xf32>
+  %flat = memref.get_global @global_flat : memref<5x7xf32>
+  %c2 = arith.constant 2. : f32
+  %horizontal = arith.constant 1.75 : f32
+  %vertical = arith.constant 1.66666667 : f32
+  %square5 = memref.get_global @global_square5 : memref<5x5xf32>
+  %square3 = memref.get_global @global_square3 : memref<3x3xf32>
+  %down = arith.constant 1.66666667 : f32
+  %up = arith.constant 0.6 : f32
+
+  // Every output pixel averages a 2x2 block of the input.
+  %area = memref.alloc() : memref<2x3xf32>
+  dip.resize_2d AREA_INTERPOLATION %ramp, %c2, %c2, %area : memref<4x6xf32>, f32, f32, memref<2x3xf32>
+  %printed_area = memref.cast %area : memref<2x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_area) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[3.5, 5.5, 7.5],
+  // CHECK{LITERAL}: [15.5, 17.5, 19.5]]
+
+  // The normalized filters keep a flat image flat at fractional scales.
+  %lanczos = memref.alloc() : memref<3x4xf32>
+  dip.resize_2d LANCZOS_INTERPOLATION %flat, %horizontal, %vertical, %lanczos : memref<5x7xf32>, f32, f32, memref<3x4xf32>
+  %printed_lanczos = memref.cast %lanczos : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_lanczos) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[7, 7, 7, 7],
+  // CHECK{LITERAL}: [7, 7, 7, 7],
+  // CHECK{LITERAL}: [7, 7, 7, 7]]
+
+  // Downscaling from 5x5 to 3x3 widens the filters by the scale.
+  %area_down = memref.alloc() : memref<3x3xf32>
+  dip.resize_2d AREA_INTERPOLATION %square5, %down, %down, %area_down : memref<5x5xf32>, f32, f32, memref<3x3xf32>
+  %printed_area_down = memref.cast %area_down : memref<3x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_area_down) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[2.36, 5.36, 5.12],
+  // CHECK{LITERAL}: [4.28, 3.92, 5.72],
+  // CHECK{LITERAL}: [5.24, 2.36, 5.96]]
+
+  %bicubic_down = memref.alloc() : memref<3x3xf32>
+  dip.resize_2d BICUBIC_INTERPOLATION %square5, %down, %down, %bicubic_down : memref<5x5xf32>, f32, f32, memref<3x3xf32>
+  %printed_bicubic_down = memref.cast %bicubic_down : memref<3x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_bicubic_down) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[2.10222, 5.6619, 5.32555],
+  // CHECK{LITERAL}: [3.93597, 3.97676, 6.06529],
+  // CHECK{LITERAL}: [5.303, 2.31047, 5.91628]]
+
+  %lanczos_down = memref.alloc() : memref<3x3xf32>
+  dip.resize_2d LANCZOS_INTERPOLATION %square5, %down, %down, %lanczos_down : memref<5x5xf32>, f32, f32, memref<3x3xf32>
+  %printed_lanczos_down = memref.cast %lanczos_down : memref<3x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_lanczos_down) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[2.05471, 5.76289, 5.42579],
+  // CHECK{LITERAL}: [3.89955, 3.97739, 6.08562],
+  // CHECK{LITERAL}: [5.31094, 2.26622, 5.75017]]
+
+  // Upscaling from 3x3 to 5x5 replicates the border for the bicubic and
+  // Lanczos taps, as cv::resize does.
+  %area_up = memref.alloc() : memref<5x5xf32>
+  dip.resize_2d AREA_INTERPOLATION %square3, %up, %up, %area_up : memref<3x3xf32>, f32, f32, memref<5x5xf32>
+  %printed_area_up = memref.cast %area_up : memref<5x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_area_up) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[8, 6.66667, 4, 6, 7],
+  // CHECK{LITERAL}: [7.33333, 6.66667, 5.33333, 6.22222, 6.66667],
+  // CHECK{LITERAL}: [6, 6.66667, 8, 6.66667, 6],
+  // CHECK{LITERAL}: [7.33333, 7.55556, 8, 5.77778, 4.66667],
+  // CHECK{LITERAL}: [8, 8, 8, 5.33333, 4]]
+
+  %bicubic_up = memref.alloc() : memref<5x5xf32>
+  dip.resize_2d BICUBIC_INTERPOLATION %square3, %up, %up, %bicubic_up : memref<3x3xf32>, f32, f32, memref<5x5xf32>
+  %printed_bicubic_up = memref.cast %bicubic_up : memref<5x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_bicubic_up) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[8.6313, 6.16595, 3.616, 5.41629, 7.43008],
+  // CHECK{LITERAL}: [7.22669, 6.40045, 5.552, 6.17883, 6.87158],
+  // CHECK{LITERAL}: [5.808, 6.92, 8, 6.92, 5.808],
+  // CHECK{LITERAL}: [6.96403, 7.80675, 8.288, 6.18157, 4.35994],
+  // CHECK{LITERAL}: [8.21043, 8.41933, 8, 5.42067, 3.40557]]
+
+  %lanczos_up = memref.alloc() : memref<5x5xf32>
+  dip.resize_2d LANCZOS_INTERPOLATION %square3, %up, %up, %lanczos_up : memref<3x3xf32>, f32, f32, memref<5x5xf32>
+  %printed_lanczos_up = memref.cast %lanczos_up : memref<5x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_lanczos_up) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[8.84766, 6.13154, 3.60477, 5.2427, 7.53009],
+  // CHECK{LITERAL}: [7.22258, 6.32609, 5.53459, 6.17471, 6.99818],
+  // CHECK{LITERAL}: [5.73257, 6.97001, 8, 6.97001, 5.73257],
+  // CHECK{LITERAL}: [6.76355, 7.9367, 8.40543, 6.24, 4.24844],
+  // CHECK{LITERAL}: [8.16721, 8.51903, 7.86037, 5.33948, 3.454]]
+
+  memref.dealloc %area : memref<2x3xf32>
+  memref.dealloc %lanczos : memref<3x4xf32>
+  memref.dealloc %area_down : memref<3x3xf32>
+  memref.dealloc %bicubic_down : memref<3x3xf32>
+  memref.dealloc %lanczos_down : memref<3x3xf32>
+  memref.dealloc %area_up : memref<5x5xf32>
+  memref.dealloc %bicubic_up : memref<5x5xf32>
+  memref.dealloc %lanczos_up : memref<5x5xf32>
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
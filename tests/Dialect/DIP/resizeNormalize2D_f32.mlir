@@ -0,0 +1,79 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// A 4x4 NHWC RGB image whose pixel (y, x, c) is 12 y + 3 x + c, so that its
+// bilinear interpolation is 12 y + 3 x + c at the source coordinates.
+memref.global "private" @global_rgb : memref<1x4x4x3xf32> = dense<[[[[0. , 1. , 2. ], [3. , 4. , 5. ], [6. , 7. , 8. ], [9. , 10., 11.]],
+                                                                    [[12., 13., 14.], [15., 16., 17.], [18., 19., 20.], [21., 22., 23.]],
+                                                                    [[24., 25., 26.], [27., 28., 29.], [30., 31., 32.], [33., 34., 35.]],
+                                                                    [[36., 37., 38.], [39., 40., 41.], [42., 43., 44.], [45., 46., 47.]]]]>
+
+// A 2x2 NCHW image of u8 values, written as i8.
+memref.global "private" @global_u8 : memref<1x3x2x2xi8> = dense<[[[[10, -56], [60, -6]],
+                                                                   [[0, -128], [-1, 64]],
+                                                                   [[30, 30], [90, 90]]]]>
+
+memref.global "private" @global_mean : memref<3xf32> = dense<[1., 2., 3.]>
+memref.global "private" @global_std : memref<3xf32> = dense<[2., 4., 8.]>
+memref.global "private" @global_imagenet_mean : memref<3xf32> = dense<[0.485, 0.456, 0.406]>
+memref.global "private" @global_imagenet_std : memref<3xf32> = dense<[0.229, 0.224, 0.225]>
+
+// Batches to write a single image of.
+memref.global "private" @global_batch : memref<2x3x2x3xf32> = dense<0.>
+memref.global "private" @global_batch_u8 : memref<1x3x3x3xf32> = dense<0.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %rgb = memref.get_global @global_rgb : memref<1x4x4x3xf32>
+  %u8 = memref.get_global @global_u8 : memref<1x3x2x2xi8>
+  %mean = memref.get_global @global_mean : memref<3xf32>
+  %std = memref.get_global @global_std : memref<3xf32>
+  %imagenet_mean = memref.get_global @global_imagenet_mean : memref<3xf32>
+  %imagenet_std = memref.get_global @global_imagenet_std : memref<3xf32>
+  %batch = memref.get_global @global_batch : memref<2x3x2x3xf32>
+  %batch_u8 = memref.get_global @global_batch_u8 : memref<1x3x3x3xf32>
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %one = arith.constant 1. : f32
+  %normalize = arith.constant 0.00392156862 : f32
+
+  // Downscaling to 2x3 into the second image of the batch: (value - mean) /
+  // std of source coordinates (2 y + 0.5, 4 x / 3 + 1 / 6).
+  dip.resize_normalize_2d %rgb, %batch, %c1, %one, %mean, %std : memref<1x4x4x3xf32>, memref<2x3x2x3xf32>, index, f32, memref<3xf32>, memref<3xf32>
+  %printed_batch = memref.cast %batch : memref<2x3x2x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_batch) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 4 offset = 0 sizes = \[2, 3, 2, 3\] strides = \[18, 6, 3, 1\] data =}}
+  // CHECK{LITERAL}: [2.75, 4.75, 6.75]
+  // CHECK{LITERAL}: [14.75, 16.75, 18.75]
+  // CHECK{LITERAL}: [1.375, 2.375, 3.375]
+  // CHECK{LITERAL}: [7.375, 8.375, 9.375]
+  // CHECK{LITERAL}: [0.6875, 1.1875, 1.6875]
+  // CHECK{LITERAL}: [3.6875, 4.1875, 4.6875]
+
+  // Upscaling u8 pixels to 3x3, normalized to [0, 1] and then with the
+  // ImageNet mean and standard deviation. Source coordinates before the
+  // first pixel center are clamped to it.
+  dip.resize_normalize_2d %u8, %batch_u8, %c0, %normalize, %imagenet_mean, %imagenet_std : memref<1x3x2x2xi8>, memref<1x3x3x3xf32>, index, f32, memref<3xf32>, memref<3xf32>
+  %printed_batch_u8 = memref.cast %batch_u8 : memref<1x3x3x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_batch_u8) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 4 offset = 0 sizes = \[1, 3, 3, 3\] strides = \[27, 9, 3, 1\] data =}}
+  // CHECK{LITERAL}: [-1.94666, -0.319805, 1.30705]
+  // CHECK{LITERAL}: [-1.51854, 0.108314, 1.73517]
+  // CHECK{LITERAL}: [-1.09042, 0.536433, 2.16328]
+  // CHECK{LITERAL}: [-2.03571, -0.915266, 0.205182]
+  // CHECK{LITERAL}: [0.196429, -0.0793067, -0.355042]
+  // CHECK{LITERAL}: [2.42857, 0.756653, -0.915266]
+  // CHECK{LITERAL}: [-1.28157, -1.28157, -1.28157]
+  // CHECK{LITERAL}: [-0.758693, -0.758693, -0.758693]
+  // CHECK{LITERAL}: [-0.235817, -0.235817, -0.235817]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
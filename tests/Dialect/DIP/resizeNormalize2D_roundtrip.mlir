@@ -0,0 +1,13 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_resize_normalize_2d_u8(%input : memref<1x?x?x3xi8>, %batch : memref<?x3x?x?xf32>, %index : index, %scale : f32, %mean : memref<3xf32>, %std : memref<3xf32>) -> () {
+  // CHECK: dip.resize_normalize_2d {{.*}} : memref<1x?x?x3xi8>, memref<?x3x?x?xf32>, index, f32, memref<3xf32>, memref<3xf32>
+  dip.resize_normalize_2d %input, %batch, %index, %scale, %mean, %std : memref<1x?x?x3xi8>, memref<?x3x?x?xf32>, index, f32, memref<3xf32>, memref<3xf32>
+  return
+}
+
+func.func @buddy_resize_normalize_2d_f64(%input : memref<1x3x?x?xf64>, %batch : memref<?x3x224x224xf64>, %index : index, %scale : f64, %mean : memref<3xf64>, %std : memref<3xf64>) -> () {
+  // CHECK: dip.resize_normalize_2d {{.*}} : memref<1x3x?x?xf64>, memref<?x3x224x224xf64>, index, f64, memref<3xf64>, memref<3xf64>
+  dip.resize_normalize_2d %input, %batch, %index, %scale, %mean, %std : memref<1x3x?x?xf64>, memref<?x3x224x224xf64>, index, f64, memref<3xf64>, memref<3xf64>
+  return
+}
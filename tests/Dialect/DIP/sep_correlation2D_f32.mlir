@@ -0,0 +1,83 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<6x4xf32> = dense<[[0. , 1. , 2. , 3. ],
+                                                                 [10., 11., 12., 13.],
+                                                                 [20., 21., 22., 23.],
+                                                                 [30., 31., 32., 33.],
+                                                                 [40., 41., 42., 43.],
+                                                                 [50., 51., 52., 53.]]>
+
+// The Sobel kernel [[1, 0, -1], [2, 0, -2], [1, 0, -1]] as its two factors.
+memref.global "private" @global_sobel_x : memref<3xf32> = dense<[1., 0., -1.]>
+memref.global "private" @global_sobel_y : memref<3xf32> = dense<[1., 2., 1.]>
+
+// A kernel wider than the image, anchored at its left column.
+memref.global "private" @global_wide_x : memref<5xf32> = dense<[1., 2., 1., 1., 1.]>
+memref.global "private" @global_wide_y : memref<3xf32> = dense<[1., -1., 2.]>
+
+memref.global "private" @global_output_constant : memref<6x4xf32> = dense<0.>
+memref.global "private" @global_output_replicate : memref<6x4xf32> = dense<0.>
+memref.global "private" @global_output_wide : memref<6x4xf32> = dense<0.>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<6x4xf32>
+  %sobel_x = memref.get_global @global_sobel_x : memref<3xf32>
+  %sobel_y = memref.get_global @global_sobel_y : memref<3xf32>
+  %wide_x = memref.get_global @global_wide_x : memref<5xf32>
+  %wide_y = memref.get_global @global_wide_y : memref<3xf32>
+  %output_constant = memref.get_global @global_output_constant : memref<6x4xf32>
+  %output_replicate = memref.get_global @global_output_replicate : memref<6x4xf32>
+  %output_wide = memref.get_global @global_output_wide : memref<6x4xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %zero = arith.constant 0. : f32
+  %five = arith.constant 5. : f32
+
+  // Same result as dip.corr_2d with the full Sobel kernel.
+  dip.sep_corr_2d <CONSTANT_PADDING> %input, %sobel_x, %sobel_y, %output_constant, %c1, %c1, %zero : memref<6x4xf32>, memref<3xf32>, memref<3xf32>, memref<6x4xf32>, index, index, f32
+  %printed_constant = memref.cast %output_constant : memref<6x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_constant) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[-13, -6, -6, 16],
+  // CHECK{LITERAL}: [-44, -8, -8, 48],
+  // CHECK{LITERAL}: [-84, -8, -8, 88],
+  // CHECK{LITERAL}: [-124, -8, -8, 128],
+  // CHECK{LITERAL}: [-164, -8, -8, 168],
+  // CHECK{LITERAL}: [-143, -6, -6, 146]]
+
+  dip.sep_corr_2d <REPLICATE_PADDING> %input, %sobel_x, %sobel_y, %output_replicate, %c1, %c1, %zero : memref<6x4xf32>, memref<3xf32>, memref<3xf32>, memref<6x4xf32>, index, index, f32
+  %printed_replicate = memref.cast %output_replicate : memref<6x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_replicate) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[-4, -8, -8, -4],
+  // CHECK{LITERAL}: [-4, -8, -8, -4],
+  // CHECK{LITERAL}: [-4, -8, -8, -4],
+  // CHECK{LITERAL}: [-4, -8, -8, -4],
+  // CHECK{LITERAL}: [-4, -8, -8, -4],
+  // CHECK{LITERAL}: [-4, -8, -8, -4]]
+
+  // Rows above the image read the constant 5 through every tap.
+  dip.sep_corr_2d <CONSTANT_PADDING> %input, %wide_x, %wide_y, %output_wide, %c0, %c2, %five : memref<6x4xf32>, memref<5xf32>, memref<3xf32>, memref<6x4xf32>, index, index, f32
+  %printed_wide = memref.cast %output_wide : memref<6x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_wide) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[24, 36, 46, 56],
+  // CHECK{LITERAL}: [142, 128, 113, 78],
+  // CHECK{LITERAL}: [174, 156, 136, 86],
+  // CHECK{LITERAL}: [274, 236, 196, 106],
+  // CHECK{LITERAL}: [374, 316, 256, 126],
+  // CHECK{LITERAL}: [474, 396, 316, 146]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,73 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<3x4xf32> = dense<[[0. , 1. , 2. , 3. ],
+                                                                 [10., 11., 12., 13.],
+                                                                 [20., 21., 22., 23.]]>
+
+// Shift right by half a pixel.
+memref.global "private" @global_half_shift : memref<2x3xf32> = dense<[[1., 0., 0.5],
+                                                                      [0., 1., 0. ]]>
+
+// Shift right and down by one pixel.
+memref.global "private" @global_shift : memref<2x3xf32> = dense<[[1., 0., 1.],
+                                                                 [0., 1., 1.]]>
+
+// The output pixel (x, y) samples the input at (x, y) / (1 - x / 2).
+memref.global "private" @global_homography : memref<3x3xf32> = dense<[[1. , 0., 0.],
+                                                                      [0. , 1., 0.],
+                                                                      [0.5, 0., 1.]]>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<3x4xf32>
+  %half_shift = memref.get_global @global_half_shift : memref<2x3xf32>
+  %shift = memref.get_global @global_shift : memref<2x3xf32>
+  %homography = memref.get_global @global_homography : memref<3x3xf32>
+  %c100 = arith.constant 100. : f32
+  %c0 = arith.constant 0. : f32
+  %cm1 = arith.constant -1. : f32
+
+  // Pixels left of the input read the constant.
+  %bilinear = memref.alloc() : memref<3x4xf32>
+  dip.warp_affine_2d BILINEAR_INTERPOLATION <CONSTANT_PADDING> %input, %half_shift, %bilinear, %c100 : memref<3x4xf32>, memref<2x3xf32>, memref<3x4xf32>, f32
+  %printed_bilinear = memref.cast %bilinear : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_bilinear) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[50, 0.5, 1.5, 2.5],
+  // CHECK{LITERAL}: [55, 10.5, 11.5, 12.5],
+  // CHECK{LITERAL}: [60, 20.5, 21.5, 22.5]]
+
+  // Pixels outside of the input repeat the first row and column.
+  %replicate = memref.alloc() : memref<3x4xf32>
+  dip.warp_affine_2d NEAREST_NEIGHBOUR_INTERPOLATION <REPLICATE_PADDING> %input, %shift, %replicate, %c0 : memref<3x4xf32>, memref<2x3xf32>, memref<3x4xf32>, f32
+  %printed_replicate = memref.cast %replicate : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_replicate) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 1, 2],
+  // CHECK{LITERAL}: [0, 0, 1, 2],
+  // CHECK{LITERAL}: [10, 10, 11, 12]]
+
+  // The output size is independent of the input size. Column 2 lies on the
+  // horizon line and maps to the origin.
+  %perspective = memref.alloc() : memref<2x5xf32>
+  dip.warp_perspective_2d NEAREST_NEIGHBOUR_INTERPOLATION <CONSTANT_PADDING> %input, %homography, %perspective, %cm1 : memref<3x4xf32>, memref<3x3xf32>, memref<2x5xf32>, f32
+  %printed_perspective = memref.cast %perspective : memref<2x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_perspective) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 2, 0, -1, -1],
+  // CHECK{LITERAL}: [10, 22, 0, -1, -1]]
+
+  memref.dealloc %bilinear : memref<3x4xf32>
+  memref.dealloc %replicate : memref<3x4xf32>
+  memref.dealloc %perspective : memref<2x5xf32>
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
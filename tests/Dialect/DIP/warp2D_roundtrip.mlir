@@ -0,0 +1,25 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_warp_affine2d_f32(%input : memref<?x?xf32>, %matrix : memref<2x3xf32>, %output : memref<?x?xf32>, %constant : f32) -> () {
+  // CHECK: dip.warp_affine_2d BILINEAR_INTERPOLATION <CONSTANT_PADDING>{{.*}} : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  dip.warp_affine_2d BILINEAR_INTERPOLATION <CONSTANT_PADDING> %input, %matrix, %output, %constant : memref<?x?xf32>, memref<2x3xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @buddy_warp_affine2d_i8(%input : memref<?x?xi8>, %matrix : memref<2x3xf32>, %output : memref<?x?xi8>, %constant : i8) -> () {
+  // CHECK: dip.warp_affine_2d NEAREST_NEIGHBOUR_INTERPOLATION <REPLICATE_PADDING>{{.*}} : memref<?x?xi8>, memref<2x3xf32>, memref<?x?xi8>, i8
+  dip.warp_affine_2d NEAREST_NEIGHBOUR_INTERPOLATION <REPLICATE_PADDING> %input, %matrix, %output, %constant : memref<?x?xi8>, memref<2x3xf32>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @buddy_warp_perspective2d_f64(%input : memref<?x?xf64>, %matrix : memref<3x3xf32>, %output : memref<?x?xf64>, %constant : f64) -> () {
+  // CHECK: dip.warp_perspective_2d LANCZOS_INTERPOLATION <REPLICATE_PADDING>{{.*}} : memref<?x?xf64>, memref<3x3xf32>, memref<?x?xf64>, f64
+  dip.warp_perspective_2d LANCZOS_INTERPOLATION <REPLICATE_PADDING> %input, %matrix, %output, %constant : memref<?x?xf64>, memref<3x3xf32>, memref<?x?xf64>, f64
+  return
+}
+
+func.func @buddy_warp_perspective2d_i32(%input : memref<?x?xi32>, %matrix : memref<3x3xf32>, %output : memref<?x?xi32>, %constant : i32) -> () {
+  // CHECK: dip.warp_perspective_2d NEAREST_NEIGHBOUR_INTERPOLATION <CONSTANT_PADDING>{{.*}} : memref<?x?xi32>, memref<3x3xf32>, memref<?x?xi32>, i32
+  dip.warp_perspective_2d NEAREST_NEIGHBOUR_INTERPOLATION <CONSTANT_PADDING> %input, %matrix, %output, %constant : memref<?x?xi32>, memref<3x3xf32>, memref<?x?xi32>, i32
+  return
+}
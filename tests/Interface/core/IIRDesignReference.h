@@ -0,0 +1,121 @@
+//===- IIRDesignReference.h -----------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// Reference second order sections and magnitude responses of IIR filters
+// designed at fs = 16000 Hz, computed in double precision with
+// scipy.signal.iirfilter(..., output='sos') (Bessel filters use
+// norm='phase'). Magnitudes are taken at REFERENCE_FREQUENCIES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TESTS_INTERFACE_CORE_IIRDESIGNREFERENCE_H
+#define TESTS_INTERFACE_CORE_IIRDESIGNREFERENCE_H
+
+constexpr float REFERENCE_FS = 16000;
+constexpr int REFERENCE_POINTS = 6;
+constexpr float REFERENCE_FREQUENCIES[REFERENCE_POINTS] = {250,  750,  1500,
+                                                           2500, 4000, 6000};
+
+// dap::chebyshev1<float>(5, 1), lowpass 1000 Hz.
+constexpr float CHEBY1_LOWPASS_SOS[3][6] = {
+    {3.03122174e-05, 6.06244348e-05, 3.03122174e-05, 1, -0.891103087, 0},
+    {1, 2, 1, 1, -1.7709446, 0.832145447},
+    {1, 1, 0, 1, -1.78822531, 0.933769431},
+};
+constexpr float CHEBY1_LOWPASS_MAGNITUDE[REFERENCE_POINTS] = {
+    0.90063092, 0.913444185, 0.0286068763,
+    0.00105252632, 4.02167235e-05, 4.70346425e-07};
+
+// dap::chebyshev1<float>(6, 0.5), highpass 2000 Hz.
+constexpr float CHEBY1_HIGHPASS_SOS[3][6] = {
+    {0.133323284, -0.266646569, 0.133323284, 1, 0.0512639805, 0.155628351},
+    {1, -2, 1, 1, -0.892829156, 0.625007137},
+    {1, -2, 1, 1, -1.35266392, 0.897805628},
+};
+constexpr float CHEBY1_HIGHPASS_MAGNITUDE[REFERENCE_POINTS] = {
+    2.54341461e-07, 0.000231018164, 0.0391244349,
+    0.980704576, 0.959822458, 0.984445553};
+
+// dap::chebyshev2<float>(6, 40), lowpass 3000 Hz.
+constexpr float CHEBY2_LOWPASS_SOS[3][6] = {
+    {0.0301177159, 0.04451819, 0.0301177159, 1, -0.44470388, 0.0797682814},
+    {1, -0.113131364, 1, 1, -0.730254682, 0.346406016},
+    {1, -0.705413104, 1, 1, -1.09215825, 0.746096528},
+};
+constexpr float CHEBY2_LOWPASS_MAGNITUDE[REFERENCE_POINTS] = {
+    1, 0.999999919, 0.999267593, 0.305021371, 0.00316327651, 0.00111555143};
+
+// dap::bessel<float>(4), lowpass 1000 Hz.
+constexpr float BESSEL_LOWPASS_SOS[2][6] = {
+    {0.000859253439, 0.00171850688, 0.000859253439, 1, -1.38286746,
+     0.484047812},
+    {1, 2, 1, 1, -1.46367541, 0.599552135},
+};
+constexpr float BESSEL_LOWPASS_MAGNITUDE[REFERENCE_POINTS] = {
+    0.955937856, 0.63561507, 0.137501384,
+    0.0177759035, 0.00153454813, 4.59301321e-05};
+
+// dap::bessel<float>(12), lowpass 1000 Hz, and its group delay in samples at
+// BESSEL12_DELAY_FREQUENCIES from scipy.signal.group_delay.
+constexpr float BESSEL12_LOWPASS_SOS[6][6] = {
+    {7.15275672e-10, 1.43055134e-09, 7.15275672e-10, 1, -1.38693964,
+     0.481642812},
+    {1, 2, 1, 1, -1.39596009, 0.493989259},
+    {1, 2, 1, 1, -1.41494799, 0.520237505},
+    {1, 2, 1, 1, -1.44622231, 0.564256668},
+    {1, 2, 1, 1, -1.49489439, 0.634798229},
+    {1, 2, 1, 1, -1.57469702, 0.756202817},
+};
+constexpr float BESSEL12_LOWPASS_MAGNITUDE[REFERENCE_POINTS] = {
+    0.895805776,    0.348523885,    0.00440248055,
+    6.54151518e-06, 3.76279052e-09, 9.75509211e-14};
+constexpr int BESSEL12_DELAY_POINTS = 4;
+constexpr float BESSEL12_DELAY_FREQUENCIES[BESSEL12_DELAY_POINTS] = {100, 250,
+                                                                     500, 750};
+constexpr float BESSEL12_GROUP_DELAY[BESSEL12_DELAY_POINTS] = {
+    22.8459766, 22.8922861, 23.0587027, 23.3371882};
+
+// dap::elliptic<float>(4, 1, 40), lowpass 1000 Hz.
+constexpr float ELLIP_LOWPASS_SOS[2][6] = {
+    {0.0131192612, -0.00894050137, 0.0131192612, 1, -1.70057674, 0.749967026},
+    {1, -1.62811103, 1, 1, -1.77639814, 0.922537824},
+};
+constexpr float ELLIP_LOWPASS_MAGNITUDE[REFERENCE_POINTS] = {
+    0.950558842, 0.891581514, 0.00868673872,
+    0.00540946211, 0.00476269429, 0.00906123514};
+
+// dap::butterworth<float>(4), bandpass 500 - 2000 Hz.
+constexpr float BUTTER_BANDPASS_SOS[4][6] = {
+    {0.00386951832, 0.00773903664, 0.00386951832, 1, -1.22208752, 0.462237244},
+    {1, 2, 1, 1, -1.63387256, 0.69581695},
+    {1, -2, 1, 1, -1.23798184, 0.715128571},
+    {1, -2, 1, 1, -1.86909484, 0.908002142},
+};
+constexpr float BUTTER_BANDPASS_MAGNITUDE[REFERENCE_POINTS] = {
+    0.0266553669, 0.999664038, 0.996669238,
+    0.219930785, 0.0117367344, 0.000300829032};
+
+// dap::elliptic<float>(3, 1, 50), bandstop 1000 - 3000 Hz.
+constexpr float ELLIP_BANDSTOP_SOS[3][6] = {
+    {0.406722833, -0.622584359, 0.406722833, 1, -0.842992036, 0.101422174},
+    {1, -1.37985342, 1, 1, -0.700571347, 0.787078961},
+    {1, -1.64872046, 1, 1, -1.75656295, 0.904640484},
+};
+constexpr float ELLIP_BANDSTOP_MAGNITUDE[REFERENCE_POINTS] = {
+    0.969330931, 0.907834354, 0.0029869572,
+    0.131241917, 0.892464879, 0.962378213};
+
+#endif // TESTS_INTERFACE_CORE_IIRDESIGNREFERENCE_H
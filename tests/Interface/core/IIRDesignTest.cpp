@@ -0,0 +1,208 @@
+//===- IIRDesignTest.cpp --------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This is the IIR design test file. It compares the second order sections and
+// the magnitude responses of the Chebyshev, Bessel, elliptic and Butterworth
+// designers with reference tables, and runs a designed bandpass filter through
+// dap::iir.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: buddy-iir-design-test 2>&1 | FileCheck %s
+
+#include "IIRDesignReference.h"
+#include <buddy/DAP/DAP.h>
+#include <cmath>
+#include <complex>
+#include <iostream>
+
+using namespace std;
+
+// H(e^jw) of a cascade of second order sections at `freq` Hz.
+complex<double> responseAt(MemRef<float, 2> &sos, intptr_t rows, double freq) {
+  complex<double> zInv = polar(1.0, -2 * M_PI * freq / REFERENCE_FS);
+  complex<double> response = 1;
+  for (intptr_t r = 0; r < rows; ++r) {
+    double c[6];
+    for (int j = 0; j < 6; ++j)
+      c[j] = sos[r * 6 + j];
+    response *= (c[0] + (c[1] + c[2] * zInv) * zInv) /
+                (c[3] + (c[4] + c[5] * zInv) * zInv);
+  }
+  return response;
+}
+
+double magnitudeAt(MemRef<float, 2> &sos, intptr_t rows, double freq) {
+  return abs(responseAt(sos, rows, freq));
+}
+
+// Group delay in samples at `freq` Hz, from the phase change over 1 Hz.
+double groupDelayAt(MemRef<float, 2> &sos, intptr_t rows, double freq) {
+  complex<double> ratio =
+      responseAt(sos, rows, freq + 0.5) / responseAt(sos, rows, freq - 0.5);
+  return -arg(ratio) / (2 * M_PI / REFERENCE_FS);
+}
+
+// Design a filter into a [Rows, 6] SOS matrix and compare it with the
+// reference sections and magnitudes.
+template <size_t Rows, typename Design>
+void check(const char *name, Design design, const float (&sos)[Rows][6],
+           const float (&magnitude)[REFERENCE_POINTS]) {
+  intptr_t sizes[2] = {Rows, 6};
+  MemRef<float, 2> designed(sizes);
+  design(designed);
+
+  float sosErr = 0;
+  for (size_t r = 0; r < Rows; ++r)
+    for (size_t j = 0; j < 6; ++j)
+      sosErr = max(sosErr, fabs(designed[r * 6 + j] - sos[r][j]));
+  double magErr = 0;
+  for (int p = 0; p < REFERENCE_POINTS; ++p)
+    magErr = max(magErr,
+                 fabs(magnitudeAt(designed, Rows, REFERENCE_FREQUENCIES[p]) -
+                      magnitude[p]));
+
+  bool pass = sosErr < 1e-4 && magErr < 1e-4;
+  fprintf(stderr, "%s %s (sos error %g, magnitude error %g)\n", name,
+          pass ? "PASS" : "FAIL", sosErr, magErr);
+}
+
+// Peak output of `sos` for a unit sine of `freq` Hz once the filter settled.
+float filteredPeak(MemRef<float, 2> &sos, float freq) {
+  intptr_t samples = 16000;
+  MemRef<float, 1> input(&samples);
+  MemRef<float, 1> output(&samples);
+  for (intptr_t i = 0; i < samples; ++i)
+    input[i] = sin(2 * M_PI * freq * i / REFERENCE_FS);
+  dap::iir(&input, &sos, &output);
+  float peak = 0;
+  for (intptr_t i = samples / 2; i < samples; ++i)
+    peak = max(peak, fabs(output[i]));
+  return peak;
+}
+
+int main() {
+  float fs = REFERENCE_FS;
+
+  // CHECK: chebyshev1 lowpass PASS
+  check(
+      "chebyshev1 lowpass",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirLowpass<float, 2>(sos, dap::chebyshev1<float>(5, 1), 1000, fs);
+      },
+      CHEBY1_LOWPASS_SOS, CHEBY1_LOWPASS_MAGNITUDE);
+
+  // CHECK: chebyshev1 highpass PASS
+  check(
+      "chebyshev1 highpass",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirHighpass<float, 2>(sos, dap::chebyshev1<float>(6, 0.5), 2000,
+                                   fs);
+      },
+      CHEBY1_HIGHPASS_SOS, CHEBY1_HIGHPASS_MAGNITUDE);
+
+  // CHECK: chebyshev2 lowpass PASS
+  check(
+      "chebyshev2 lowpass",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirLowpass<float, 2>(sos, dap::chebyshev2<float>(6, 40), 3000,
+                                  fs);
+      },
+      CHEBY2_LOWPASS_SOS, CHEBY2_LOWPASS_MAGNITUDE);
+
+  // CHECK: bessel lowpass PASS
+  check(
+      "bessel lowpass",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirLowpass<float, 2>(sos, dap::bessel<float>(4), 1000, fs);
+      },
+      BESSEL_LOWPASS_SOS, BESSEL_LOWPASS_MAGNITUDE);
+
+  // From order 8 in float the poles used to come out as NaN and the sections
+  // of the missing poles as pass-through.
+  // CHECK: bessel order 12 lowpass PASS
+  check(
+      "bessel order 12 lowpass",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirLowpass<float, 2>(sos, dap::bessel<float>(12), 1000, fs);
+      },
+      BESSEL12_LOWPASS_SOS, BESSEL12_LOWPASS_MAGNITUDE);
+
+  // A Bessel prototype has all N poles in the left half plane and a nearly
+  // flat group delay in the passband.
+  {
+    dap::zpk<float> prototype = dap::bessel<float>(12);
+    bool stable = prototype.p.size() == 12;
+    for (const complex<float> &p : prototype.p)
+      stable = stable && p.real() < 0;
+    intptr_t sizes[2] = {6, 6};
+    MemRef<float, 2> sos(sizes);
+    dap::iirLowpass<float, 2>(sos, prototype, 1000, fs);
+    double delayErr = 0;
+    for (int p = 0; p < BESSEL12_DELAY_POINTS; ++p)
+      delayErr = max(delayErr,
+                     fabs(groupDelayAt(sos, 6, BESSEL12_DELAY_FREQUENCIES[p]) -
+                          BESSEL12_GROUP_DELAY[p]));
+    // CHECK: bessel order 12 group delay PASS
+    bool pass = stable && delayErr < 1e-3;
+    fprintf(stderr,
+            "bessel order 12 group delay %s (%zu poles, delay error %g)\n",
+            pass ? "PASS" : "FAIL", prototype.p.size(), delayErr);
+  }
+
+  // CHECK: elliptic lowpass PASS
+  check(
+      "elliptic lowpass",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirLowpass<float, 2>(sos, dap::elliptic<float>(4, 1, 40), 1000,
+                                  fs);
+      },
+      ELLIP_LOWPASS_SOS, ELLIP_LOWPASS_MAGNITUDE);
+
+  // CHECK: butterworth bandpass PASS
+  check(
+      "butterworth bandpass",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirBandpass<float, 2>(sos, dap::butterworth<float>(4), 500, 2000,
+                                   fs);
+      },
+      BUTTER_BANDPASS_SOS, BUTTER_BANDPASS_MAGNITUDE);
+
+  // CHECK: elliptic bandstop PASS
+  check(
+      "elliptic bandstop",
+      [&](MemRef<float, 2> &sos) {
+        dap::iirBandstop<float, 2>(sos, dap::elliptic<float>(3, 1, 50), 1000,
+                                   3000, fs);
+      },
+      ELLIP_BANDSTOP_SOS, ELLIP_BANDSTOP_MAGNITUDE);
+
+  // A 1 kHz tone passes the 500 - 2000 Hz bandpass, a 6 kHz tone is rejected.
+  intptr_t sizes[2] = {4, 6};
+  MemRef<float, 2> bandpass(sizes);
+  dap::iirBandpass<float, 2>(bandpass, dap::butterworth<float>(4), 500, 2000,
+                             fs);
+  float inBand = filteredPeak(bandpass, 1000);
+  float outBand = filteredPeak(bandpass, 6000);
+  double expected = magnitudeAt(bandpass, 4, 1000);
+
+  // CHECK: bandpass filtering PASS
+  bool pass = fabs(inBand - expected) < 1e-2 && outBand < 1e-2;
+  fprintf(stderr, "bandpass filtering %s (1 kHz peak %g, 6 kHz peak %g)\n",
+          pass ? "PASS" : "FAIL", inBand, outBand);
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+//===- MFCCTest.cpp -------------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This is the STFT / mel filterbank / MFCC test file. The MFCCs of the first
+// frames of NASA_Mars.wav are compared against a double precision reference.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: buddy-mfcc-test 2>&1 | FileCheck %s
+
+#include "NASA_Mars_MFCC.h"
+#include <buddy/DAP/DAP.h>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+int main() {
+  dap::Audio<float, 1> aud("../../../../tests/Interface/core/NASA_Mars.wav");
+  float sampleRate = aud.getAudioFile().getSampleRate();
+  MemRef<float, 1> &input = aud.getMemRef();
+
+  intptr_t nfft = 512, hop = 256, mels = 40;
+  intptr_t bins = nfft / 2 + 1;
+  intptr_t frames = GOLDEN_MFCC_FRAMES, coeffs = GOLDEN_MFCC_COEFFS;
+
+  MemRef<float, 1> window(&nfft);
+  dap::makeWindow(window, dap::WINDOW_TYPE::HANN);
+
+  intptr_t spectrumSizes[2] = {frames, bins};
+  MemRef<float, 2> real(spectrumSizes);
+  MemRef<float, 2> imag(spectrumSizes);
+  dap::stft(&input, &window, hop, &real, &imag);
+
+  intptr_t filterbankSizes[2] = {mels, bins};
+  MemRef<float, 2> filterbank(filterbankSizes);
+  dap::melFilterbankMatrix<float>(filterbank, nfft, sampleRate, 0,
+                                  sampleRate / 2);
+  intptr_t melSizes[2] = {frames, mels};
+  MemRef<float, 2> mel(melSizes);
+  dap::melFilterbank(&real, &imag, &filterbank, &mel);
+
+  intptr_t dctSizes[2] = {coeffs, mels};
+  MemRef<float, 2> dct(dctSizes);
+  dap::dctMatrix(dct);
+  intptr_t mfccSizes[2] = {frames, coeffs};
+  MemRef<float, 2> mfcc(mfccSizes);
+  dap::mfcc(&mel, &dct, &mfcc);
+
+  float maxError = 0;
+  for (intptr_t f = 0; f < frames; ++f)
+    for (intptr_t c = 0; c < coeffs; ++c)
+      maxError = max(maxError, fabs(mfcc[f * coeffs + c] - GOLDEN_MFCC[f][c]));
+
+  // CHECK: MFCC PASS
+  fprintf(stderr, "MFCC %s (max error %g)\n", maxError < 1e-2 ? "PASS" : "FAIL",
+          maxError);
+
+  return 0;
+}
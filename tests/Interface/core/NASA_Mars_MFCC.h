@@ -0,0 +1,77 @@
+//===- NASA_Mars_MFCC.h ---------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// Reference MFCCs of the first 16 frames of NASA_Mars.wav, computed in double
+// precision with a direct DFT: nfft = 512, hop = 256, symmetric Hann window,
+// power spectrum, 40 HTK mel bands between 0 Hz and fs / 2, natural logarithm
+// floored at 1e-10 and 13 orthonormal DCT-II coefficients.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TESTS_INTERFACE_CORE_NASA_MARS_MFCC_H
+#define TESTS_INTERFACE_CORE_NASA_MARS_MFCC_H
+
+constexpr int GOLDEN_MFCC_FRAMES = 16;
+constexpr int GOLDEN_MFCC_COEFFS = 13;
+
+constexpr float GOLDEN_MFCC[GOLDEN_MFCC_FRAMES][GOLDEN_MFCC_COEFFS] = {
+    {-82.034827, 27.949573, 13.830950, 5.806550, -0.212921, -4.421804,
+     -7.232566, -8.099463, -7.106227, -6.973910, -6.310877, -4.831801,
+     -4.550124},
+    {-87.496266, 29.963400, 14.207331, 7.612318, 2.102067, -2.768813, -6.494145,
+     -8.950624, -9.682481, -7.479015, -7.620164, -4.746739, -4.218862},
+    {-81.406418, 30.334568, 12.269538, 2.617017, -2.352634, -5.852210,
+     -7.718501, -6.786041, -7.003631, -6.601611, -5.517058, -4.293101,
+     -4.407337},
+    {-84.920985, 30.879166, 13.509646, 5.451982, -1.243065, -6.219442,
+     -8.797812, -7.050520, -6.789283, -6.437173, -6.339459, -5.030130,
+     -4.386445},
+    {-84.043705, 26.009308, 12.529677, 4.779285, -0.686231, -4.624819,
+     -5.723554, -6.425627, -7.270858, -6.720172, -6.216324, -6.022367,
+     -5.166363},
+    {-87.422729, 29.179225, 14.133203, 6.269061, 0.612664, -3.847623, -6.130373,
+     -6.978996, -7.467712, -7.662177, -7.920271, -5.779410, -4.966263},
+    {-82.619225, 28.143393, 12.215925, 4.050352, -1.751756, -5.600697,
+     -6.738538, -6.125299, -6.410518, -5.939089, -5.838736, -4.409554,
+     -3.515324},
+    {-83.107546, 28.182492, 10.477739, 1.761833, -3.170309, -5.632078,
+     -6.185273, -6.059160, -6.000031, -4.644191, -4.151346, -4.183752,
+     -3.424280},
+    {-82.077073, 31.543447, 16.539109, 6.356981, -2.074766, -6.909851,
+     -7.639640, -6.340022, -7.873243, -7.891325, -6.271625, -4.605403,
+     -5.401970},
+    {-80.444986, 33.362786, 14.402455, 3.471853, -2.162405, -5.125908,
+     -7.048620, -7.586433, -8.284670, -6.683203, -6.352146, -5.405717,
+     -4.899475},
+    {-83.111983, 28.518213, 11.649055, 1.984792, -4.136538, -6.926749,
+     -7.929012, -6.890875, -6.438787, -4.779266, -4.454066, -3.327090,
+     -3.566193},
+    {-84.544002, 27.756790, 10.895618, 2.745784, -3.585854, -7.615014,
+     -7.811616, -8.147506, -7.970710, -6.335623, -5.324736, -5.044736,
+     -3.621492},
+    {-87.652296, 28.285959, 14.612812, 6.628219, 0.002131, -4.065377, -6.530806,
+     -7.648151, -8.303264, -7.128194, -7.164439, -5.476293, -5.074176},
+    {-84.113756, 28.659123, 14.593031, 5.385114, 0.079019, -3.436301, -7.228000,
+     -8.454525, -7.332484, -6.563684, -7.146274, -5.523669, -4.085899},
+    {-85.301122, 30.458352, 13.320901, 4.029631, -2.620379, -5.213798,
+     -7.161409, -7.064822, -7.417670, -6.188107, -6.601493, -4.131435,
+     -5.337204},
+    {-82.887214, 29.566229, 12.393895, 4.429921, -0.810851, -4.584758,
+     -5.981688, -6.496792, -7.424685, -6.249338, -6.429206, -6.346847,
+     -5.473277},
+};
+
+#endif // TESTS_INTERFACE_CORE_NASA_MARS_MFCC_H
@@ -0,0 +1,111 @@
+//===- ResampleTest.cpp ---------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This is the polyphase resampler test file. It checks the passband accuracy
+// and the aliasing rejection of whole signal conversion, and that streaming
+// conversion matches it.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: buddy-resample-test 2>&1 | FileCheck %s
+
+#include <buddy/DAP/DAP.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+const intptr_t samples = 4800;
+
+MemRef<float, 1> tone(float freq, float rate) {
+  intptr_t size = samples;
+  MemRef<float, 1> signal(&size);
+  for (intptr_t i = 0; i < samples; ++i)
+    signal[i] = sin(2 * M_PI * freq * i / rate);
+  return signal;
+}
+
+// Largest difference between the resampled tone and the ideal tone (zero for
+// tones that cannot be represented at the output rate). The first and last
+// `taps` outputs see the zero padding and are skipped.
+float toneError(intptr_t inRate, intptr_t outRate, intptr_t up, intptr_t down,
+                intptr_t taps, float freq) {
+  intptr_t kernelSizes[2] = {up, taps};
+  MemRef<float, 2> kernel(kernelSizes);
+  dap::resampleKernel<float>(kernel, down);
+
+  MemRef<float, 1> input = tone(freq, inRate);
+  intptr_t outSize = dap::resampleLength(samples, up, down);
+  MemRef<float, 1> output(&outSize);
+  dap::resample(&input, &kernel, &output, down);
+
+  float err = 0;
+  for (intptr_t n = taps; n < outSize - taps; ++n) {
+    float expected = 2 * freq < outRate ? sin(2 * M_PI * freq * n / outRate) : 0;
+    err = max(err, fabs(output[n] - expected));
+  }
+  return err;
+}
+
+int main() {
+  // CHECK: 48000 -> 16000 passband PASS
+  float err = toneError(48000, 16000, 1, 3, 64, 1000);
+  fprintf(stderr, "48000 -> 16000 passband %s (max error %g)\n",
+          err < 1e-3 ? "PASS" : "FAIL", err);
+
+  // A 12 kHz tone would alias to 4 kHz at 16 kHz.
+  // CHECK: 48000 -> 16000 aliasing PASS
+  err = toneError(48000, 16000, 1, 3, 64, 12000);
+  fprintf(stderr, "48000 -> 16000 aliasing %s (max error %g)\n",
+          err < 1e-3 ? "PASS" : "FAIL", err);
+
+  // CHECK: 44100 -> 48000 passband PASS
+  err = toneError(44100, 48000, 160, 147, 32, 1000);
+  fprintf(stderr, "44100 -> 48000 passband %s (max error %g)\n",
+          err < 1e-3 ? "PASS" : "FAIL", err);
+
+  // Streaming in uneven blocks gives the whole signal output.
+  intptr_t up = 160, down = 147, taps = 32;
+  intptr_t kernelSizes[2] = {up, taps};
+  MemRef<float, 2> kernel(kernelSizes);
+  dap::resampleKernel<float>(kernel, down);
+  MemRef<float, 1> input = tone(1000, 44100);
+  intptr_t outSize = dap::resampleLength(samples, up, down);
+  MemRef<float, 1> whole(&outSize);
+  dap::resample(&input, &kernel, &whole, down);
+
+  dap::Resampler resampler(&kernel, down);
+  vector<float> streamed;
+  for (intptr_t begin = 0, blockSize = 1; begin < samples;
+       begin += blockSize, blockSize = blockSize * 2 + 7) {
+    intptr_t size = min(blockSize, samples - begin);
+    MemRef<float, 1> block(input.getData() + begin, &size);
+    MemRef<float, 1> out = resampler.process(block);
+    for (size_t n = 0; n < out.getSize(); ++n)
+      streamed.push_back(out[n]);
+  }
+  err = 0;
+  for (size_t n = 0; n < streamed.size(); ++n)
+    err = max(err, fabs(streamed[n] - whole[n]));
+  // CHECK: streaming PASS
+  fprintf(stderr, "streaming %s (%zu of %ld samples, max error %g)\n",
+          err < 1e-6 && streamed.size() + taps >= (size_t)outSize ? "PASS"
+                                                                 : "FAIL",
+          streamed.size(), (long)outSize, err);
+
+  return 0;
+}
@@ -59,6 +59,9 @@ tools = [
     'buddy-container-test',
     'buddy-audio-container-test',
     'buddy-text-container-test',
+    'buddy-mfcc-test',
+    'buddy-resample-test',
+    'buddy-iir-design-test',
     'mlir-cpu-runner',
 ]
 tools.extend([